@@ -0,0 +1,1096 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "async.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include async coroutines.  This #if is closed at the very bottom of this
+ * file.  If you want to include async coroutines then ensure
+ * configUSE_ASYNC_COROUTINES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build async.c
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configNUMBER_OF_CORES == 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build async.c
+    #endif
+
+/* Values that can be assigned to the ucAwaitState member of the coroutine
+ * structure. */
+    #define asyncAWAIT_IDLE         ( ( uint8_t ) 0U ) /* The coroutine is not waiting. */
+    #define asyncAWAIT_WAITING      ( ( uint8_t ) 1U ) /* The coroutine has returned errQUEUE_BLOCKED and is waiting to be woken or to time out. */
+    #define asyncAWAIT_TIMED_OUT    ( ( uint8_t ) 2U ) /* The wait timed out, or the delay expired. */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add a coroutine to the end of a wait list, or remove it from the wait list
+ * that holds it.  Wait lists are accessed by tasks and interrupts so these must
+ * only be called from within a critical section.
+ */
+    static void prvAddToWaitList( AsyncWaitList_t * pxWaitList,
+                                  AsyncCoroutine_t * pxCoroutine ) PRIVILEGED_FUNCTION;
+    static void prvRemoveFromWaitList( AsyncCoroutine_t * pxCoroutine ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the first coroutine in the wait list, or all of them if xWakeAll is
+ * pdTRUE, to the pending ready lists of their executors, and unblock the
+ * executors' host tasks.  Must be called from within a critical section.
+ */
+    static void prvWakeWaiters( AsyncWaitList_t * pxWaitList,
+                                BaseType_t xWakeAll,
+                                BaseType_t xFromISR,
+                                BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the await functions after finding that the coroutine cannot
+ * continue.  Starts the timeout on the first call of an await, and adds the
+ * coroutine to pxWaitList.  Returns pdFALSE, without adding the coroutine to
+ * pxWaitList, if xTicksToWait is 0 or the timeout has expired.
+ */
+    static BaseType_t prvBeginWait( AsyncCoroutine_t * pxCoroutine,
+                                    AsyncWaitList_t * pxWaitList,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the await functions when the await completes, to remove the
+ * coroutine from the wait list and delayed list that hold it.
+ */
+    static void prvEndWait( AsyncCoroutine_t * pxCoroutine ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a coroutine in its executor's delayed list to time out after
+ * xTicksToWait ticks.
+ */
+    static void prvAddToDelayedList( AsyncCoroutine_t * pxCoroutine,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the coroutines woken by tasks and interrupts to the ready list.
+ */
+    static void prvProcessPendingReadyList( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the coroutines whose timeouts have expired to the ready list.
+ */
+    static void prvCheckDelayedLists( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make a coroutine that was in the delayed list ready because its timeout
+ * expired.
+ */
+    static void prvTimeOut( AsyncExecutor_t * pxExecutor,
+                            AsyncCoroutine_t * pxCoroutine ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of ticks until the next timeout expires, or portMAX_DELAY if no
+ * coroutines are waiting with a timeout.
+ */
+    static TickType_t prvGetBlockTime( const AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvAddToWaitList( AsyncWaitList_t * pxWaitList,
+                                  AsyncCoroutine_t * pxCoroutine )
+    {
+        AsyncCoroutine_t * const pxFirst = *pxWaitList;
+
+        /* Wait lists are circular, so the last coroutine in the list is the
+         * one before the first. */
+        if( pxFirst == NULL )
+        {
+            pxCoroutine->pxNextWaiter = pxCoroutine;
+            pxCoroutine->pxPreviousWaiter = pxCoroutine;
+            *pxWaitList = pxCoroutine;
+        }
+        else
+        {
+            pxCoroutine->pxNextWaiter = pxFirst;
+            pxCoroutine->pxPreviousWaiter = pxFirst->pxPreviousWaiter;
+            pxFirst->pxPreviousWaiter->pxNextWaiter = pxCoroutine;
+            pxFirst->pxPreviousWaiter = pxCoroutine;
+        }
+
+        pxCoroutine->pxWaitList = pxWaitList;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveFromWaitList( AsyncCoroutine_t * pxCoroutine )
+    {
+        AsyncWaitList_t * const pxWaitList = pxCoroutine->pxWaitList;
+
+        if( pxCoroutine->pxNextWaiter == pxCoroutine )
+        {
+            *pxWaitList = NULL;
+        }
+        else
+        {
+            pxCoroutine->pxPreviousWaiter->pxNextWaiter = pxCoroutine->pxNextWaiter;
+            pxCoroutine->pxNextWaiter->pxPreviousWaiter = pxCoroutine->pxPreviousWaiter;
+
+            if( *pxWaitList == pxCoroutine )
+            {
+                *pxWaitList = pxCoroutine->pxNextWaiter;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxCoroutine->pxWaitList = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeWaiters( AsyncWaitList_t * pxWaitList,
+                                BaseType_t xWakeAll,
+                                BaseType_t xFromISR,
+                                BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        AsyncCoroutine_t * pxCoroutine = *pxWaitList;
+        AsyncExecutor_t * pxExecutor;
+        size_t xWaiters = 0;
+
+        /* Only the coroutines in the list now are woken.  Notifying a host
+         * task can switch to it before the critical section is exited on some
+         * ports, and a coroutine it runs may wait again at the end of the
+         * list. */
+        if( ( xWakeAll != pdFALSE ) && ( pxCoroutine != NULL ) )
+        {
+            do
+            {
+                xWaiters++;
+                pxCoroutine = pxCoroutine->pxNextWaiter;
+            } while( pxCoroutine != *pxWaitList );
+        }
+        else
+        {
+            xWaiters = 1;
+        }
+
+        while( xWaiters > ( size_t ) 0 )
+        {
+            xWaiters--;
+            pxCoroutine = *pxWaitList;
+
+            if( pxCoroutine == NULL )
+            {
+                break;
+            }
+
+            prvRemoveFromWaitList( pxCoroutine );
+
+            /* The executor's ready list can only be accessed by its host task,
+             * so the coroutine is placed in the pending ready list, and the host
+             * task is notified that it has work to do. */
+            pxExecutor = pxCoroutine->pxExecutor;
+            prvAddToWaitList( &( pxExecutor->xPendingReadyList ), pxCoroutine );
+
+            if( pxExecutor->xHostTask != NULL )
+            {
+                if( xFromISR != pdFALSE )
+                {
+                    vTaskNotifyGiveFromISR( pxExecutor->xHostTask, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    ( void ) xTaskNotifyGive( pxExecutor->xHostTask );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddToDelayedList( AsyncCoroutine_t * pxCoroutine,
+                                     TickType_t xTicksToWait )
+    {
+        AsyncExecutor_t * const pxExecutor = pxCoroutine->pxExecutor;
+        const TickType_t xTimeToWake = pxExecutor->xTickCount + xTicksToWait;
+
+        listSET_LIST_ITEM_VALUE( &( pxCoroutine->xStateListItem ), xTimeToWake );
+
+        if( xTimeToWake < pxExecutor->xTickCount )
+        {
+            /* Wake time has overflowed.  Place this item in the overflow
+             * list. */
+            vListInsert( pxExecutor->pxOverflowDelayedList, &( pxCoroutine->xStateListItem ) );
+        }
+        else
+        {
+            /* The wake time has not overflowed, so the current delayed list is
+             * used. */
+            vListInsert( pxExecutor->pxDelayedList, &( pxCoroutine->xStateListItem ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBeginWait( AsyncCoroutine_t * pxCoroutine,
+                                    AsyncWaitList_t * pxWaitList,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn = pdTRUE;
+        TickType_t xTimeWaited;
+
+        if( pxCoroutine->ucAwaitState == asyncAWAIT_IDLE )
+        {
+            /* This is the first call of the await, so start the timeout. */
+            if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                if( xTicksToWait != portMAX_DELAY )
+                {
+                    prvAddToDelayedList( pxCoroutine, xTicksToWait );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxCoroutine->ucAwaitState = asyncAWAIT_WAITING;
+            }
+        }
+        else if( pxCoroutine->ucAwaitState == asyncAWAIT_TIMED_OUT )
+        {
+            xReturn = pdFALSE;
+        }
+        else if( ( xTicksToWait != portMAX_DELAY ) &&
+                 ( listLIST_ITEM_CONTAINER( &( pxCoroutine->xStateListItem ) ) == NULL ) )
+        {
+            /* The coroutine was woken, so was removed from the delayed list,
+             * but whatever it was waiting for was no longer available when it
+             * ran.  The item value still holds the wake time, from which the
+             * time already waited is found. */
+            xTimeWaited = pxCoroutine->pxExecutor->xTickCount - ( listGET_LIST_ITEM_VALUE( &( pxCoroutine->xStateListItem ) ) - xTicksToWait );
+
+            if( xTimeWaited >= xTicksToWait )
+            {
+                pxCoroutine->ucAwaitState = asyncAWAIT_TIMED_OUT;
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                prvAddToDelayedList( pxCoroutine, xTicksToWait - xTimeWaited );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                prvAddToWaitList( pxWaitList, pxCoroutine );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEndWait( AsyncCoroutine_t * pxCoroutine )
+    {
+        if( pxCoroutine->ucAwaitState != asyncAWAIT_IDLE )
+        {
+            /* Tasks and interrupts can move the coroutine from the wait list of
+             * a kernel object to the pending ready list at any time. */
+            taskENTER_CRITICAL();
+            {
+                if( pxCoroutine->pxWaitList != NULL )
+                {
+                    prvRemoveFromWaitList( pxCoroutine );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( listLIST_ITEM_CONTAINER( &( pxCoroutine->xStateListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxCoroutine->xStateListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxCoroutine->ucAwaitState = asyncAWAIT_IDLE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessPendingReadyList( AsyncExecutor_t * pxExecutor )
+    {
+        AsyncCoroutine_t * pxCoroutine;
+        AsyncCoroutine_t * pxFirst;
+
+        /* Take the whole list at once.  Once it is removed from the executor
+         * no task or interrupt can access the coroutines in it. */
+        taskENTER_CRITICAL();
+        {
+            pxFirst = pxExecutor->xPendingReadyList;
+            pxExecutor->xPendingReadyList = NULL;
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxFirst != NULL )
+        {
+            pxCoroutine = pxFirst;
+
+            do
+            {
+                pxCoroutine->pxWaitList = NULL;
+
+                /* The coroutine was woken before its timeout expired. */
+                if( listLIST_ITEM_CONTAINER( &( pxCoroutine->xStateListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxCoroutine->xStateListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listINSERT_END( &( pxExecutor->xReadyList ), &( pxCoroutine->xStateListItem ) );
+                pxCoroutine = pxCoroutine->pxNextWaiter;
+            } while( pxCoroutine != pxFirst );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimeOut( AsyncExecutor_t * pxExecutor,
+                            AsyncCoroutine_t * pxCoroutine )
+    {
+        ( void ) uxListRemove( &( pxCoroutine->xStateListItem ) );
+
+        /* The coroutine may also be in the wait list of the object it is
+         * waiting for, or have been woken at the same time as it timed out. */
+        taskENTER_CRITICAL();
+        {
+            if( pxCoroutine->pxWaitList != NULL )
+            {
+                prvRemoveFromWaitList( pxCoroutine );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        pxCoroutine->ucAwaitState = asyncAWAIT_TIMED_OUT;
+        listINSERT_END( &( pxExecutor->xReadyList ), &( pxCoroutine->xStateListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckDelayedLists( AsyncExecutor_t * pxExecutor )
+    {
+        const TickType_t xConstTickCount = xTaskGetTickCount();
+        List_t * pxTemp;
+
+        if( xConstTickCount < pxExecutor->xTickCount )
+        {
+            /* The tick count has overflowed since the lists were last checked,
+             * so every timeout in the current delayed list has expired, and the
+             * overflow list becomes the current list. */
+            while( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE )
+            {
+                prvTimeOut( pxExecutor, listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) );
+            }
+
+            pxTemp = pxExecutor->pxDelayedList;
+            pxExecutor->pxDelayedList = pxExecutor->pxOverflowDelayedList;
+            pxExecutor->pxOverflowDelayedList = pxTemp;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxExecutor->xTickCount = xConstTickCount;
+
+        while( ( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE ) &&
+               ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) <= xConstTickCount ) )
+        {
+            prvTimeOut( pxExecutor, listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetBlockTime( const AsyncExecutor_t * pxExecutor )
+    {
+        TickType_t xReturn;
+
+        /* The subtraction gives the number of ticks until the timeout for both
+         * lists, as the wake times in the overflow list have wrapped. */
+        if( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE )
+        {
+            xReturn = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) - pxExecutor->xTickCount;
+        }
+        else if( listLIST_IS_EMPTY( pxExecutor->pxOverflowDelayedList ) == pdFALSE )
+        {
+            xReturn = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxOverflowDelayedList ) - pxExecutor->xTickCount;
+        }
+        else
+        {
+            xReturn = portMAX_DELAY;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncExecutorInitialise( AsyncExecutor_t * pxExecutor )
+    {
+        traceENTER_vAsyncExecutorInitialise( pxExecutor );
+
+        configASSERT( pxExecutor );
+
+        vListInitialise( &( pxExecutor->xReadyList ) );
+        vListInitialise( &( pxExecutor->xDelayedList1 ) );
+        vListInitialise( &( pxExecutor->xDelayedList2 ) );
+        pxExecutor->pxDelayedList = &( pxExecutor->xDelayedList1 );
+        pxExecutor->pxOverflowDelayedList = &( pxExecutor->xDelayedList2 );
+        pxExecutor->xPendingReadyList = NULL;
+        pxExecutor->xTickCount = ( TickType_t ) 0;
+        pxExecutor->xHostTask = NULL;
+
+        traceRETURN_vAsyncExecutorInitialise();
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncExecutorRun( AsyncExecutor_t * pxExecutor )
+    {
+        AsyncCoroutine_t * pxCoroutine;
+        UBaseType_t uxReadyCoroutines;
+
+        traceENTER_vAsyncExecutorRun( pxExecutor );
+
+        configASSERT( pxExecutor );
+        configASSERT( pxExecutor->xHostTask == NULL );
+
+        pxExecutor->xTickCount = xTaskGetTickCount();
+
+        /* From now on tasks and interrupts that wake a coroutine notify the
+         * host task. */
+        taskENTER_CRITICAL();
+        {
+            pxExecutor->xHostTask = xTaskGetCurrentTaskHandle();
+        }
+        taskEXIT_CRITICAL();
+
+        for( ; ; )
+        {
+            prvProcessPendingReadyList( pxExecutor );
+            prvCheckDelayedLists( pxExecutor );
+
+            uxReadyCoroutines = listCURRENT_LIST_LENGTH( &( pxExecutor->xReadyList ) );
+
+            if( uxReadyCoroutines == ( UBaseType_t ) 0 )
+            {
+                /* Nothing to do until a coroutine is woken or a timeout
+                 * expires.  A coroutine woken since the pending ready list was
+                 * processed will already have notified this task, so the
+                 * notification is not missed. */
+                ( void ) ulTaskNotifyTake( pdTRUE, prvGetBlockTime( pxExecutor ) );
+            }
+            else
+            {
+                /* Run each coroutine that is ready now once.  Coroutines that
+                 * become ready while these run wait for the next pass, so they
+                 * cannot starve the processing of wakes and timeouts. */
+                while( uxReadyCoroutines > ( UBaseType_t ) 0 )
+                {
+                    uxReadyCoroutines--;
+
+                    pxCoroutine = listGET_OWNER_OF_HEAD_ENTRY( &( pxExecutor->xReadyList ) );
+                    ( void ) uxListRemove( &( pxCoroutine->xStateListItem ) );
+
+                    pxCoroutine->pxFunction( pxCoroutine, pxCoroutine->pvParameters );
+
+                    if( pxCoroutine->ucAwaitState == asyncAWAIT_IDLE )
+                    {
+                        /* The coroutine returned without waiting, so it has
+                         * finished. */
+                        pxCoroutine->pxExecutor = NULL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncCoroutineStart( AsyncExecutor_t * pxExecutor,
+                               AsyncCoroutine_t * pxCoroutine,
+                               AsyncFunction_t pxFunction,
+                               void * pvParameters )
+    {
+        traceENTER_vAsyncCoroutineStart( pxExecutor, pxCoroutine, pxFunction, pvParameters );
+
+        configASSERT( pxExecutor );
+        configASSERT( pxCoroutine );
+        configASSERT( pxFunction );
+
+        vListInitialiseItem( &( pxCoroutine->xStateListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxCoroutine->xStateListItem ), pxCoroutine );
+        pxCoroutine->pxWaitList = NULL;
+        pxCoroutine->pxExecutor = pxExecutor;
+        pxCoroutine->pxFunction = pxFunction;
+        pxCoroutine->pvParameters = pvParameters;
+        pxCoroutine->xNotificationWaitList = NULL;
+        pxCoroutine->ulNotifiedValue = 0U;
+        pxCoroutine->ulResumePoint = 0U;
+        pxCoroutine->ucAwaitState = asyncAWAIT_IDLE;
+
+        /* The calling task may not be the host task, so the coroutine is made
+         * ready in the same way as a coroutine woken by a kernel object. */
+        taskENTER_CRITICAL();
+        {
+            prvAddToWaitList( &( pxExecutor->xPendingReadyList ), pxCoroutine );
+
+            if( pxExecutor->xHostTask != NULL )
+            {
+                ( void ) xTaskNotifyGive( pxExecutor->xHostTask );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vAsyncCoroutineStart();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncNotifyGive( AsyncCoroutine_t * pxCoroutine )
+    {
+        traceENTER_xAsyncNotifyGive( pxCoroutine );
+
+        configASSERT( pxCoroutine );
+
+        taskENTER_CRITICAL();
+        {
+            ( pxCoroutine->ulNotifiedValue )++;
+            prvWakeWaiters( &( pxCoroutine->xNotificationWaitList ), pdFALSE, pdFALSE, NULL );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xAsyncNotifyGive( pdPASS );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncNotifyGiveFromISR( AsyncCoroutine_t * pxCoroutine,
+                                  BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vAsyncNotifyGiveFromISR( pxCoroutine, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxCoroutine );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            ( pxCoroutine->ulNotifiedValue )++;
+            prvWakeWaiters( &( pxCoroutine->xNotificationWaitList ), pdFALSE, pdTRUE, pxHigherPriorityTaskWoken );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vAsyncNotifyGiveFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncWakeWaiters( AsyncWaitList_t * pxWaitList,
+                            BaseType_t xWakeAll )
+    {
+        taskENTER_CRITICAL();
+        {
+            prvWakeWaiters( pxWaitList, xWakeAll, pdFALSE, NULL );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vAsyncWakeWaitersFromISR( AsyncWaitList_t * pxWaitList,
+                                   BaseType_t xWakeAll,
+                                   BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            prvWakeWaiters( pxWaitList, xWakeAll, pdTRUE, pxHigherPriorityTaskWoken );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncDelay( AsyncCoroutine_t * pxCoroutine,
+                            TickType_t xTicksToDelay )
+    {
+        BaseType_t xReturn;
+
+        if( pxCoroutine->ucAwaitState == asyncAWAIT_IDLE )
+        {
+            if( xTicksToDelay == ( TickType_t ) 0 )
+            {
+                /* Just yield to the other ready coroutines. */
+                pxCoroutine->ucAwaitState = asyncAWAIT_TIMED_OUT;
+                listINSERT_END( &( pxCoroutine->pxExecutor->xReadyList ), &( pxCoroutine->xStateListItem ) );
+            }
+            else
+            {
+                pxCoroutine->ucAwaitState = asyncAWAIT_WAITING;
+                prvAddToDelayedList( pxCoroutine, xTicksToDelay );
+            }
+
+            xReturn = errQUEUE_BLOCKED;
+        }
+        else
+        {
+            /* A delayed coroutine is only resumed when its delay expires. */
+            pxCoroutine->ucAwaitState = asyncAWAIT_IDLE;
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncQueueSend( AsyncCoroutine_t * pxCoroutine,
+                                QueueHandle_t xQueue,
+                                const void * pvItemToQueue,
+                                TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        xReturn = xQueueSend( xQueue, pvItemToQueue, 0 );
+
+        if( xReturn != pdPASS )
+        {
+            if( prvBeginWait( pxCoroutine, pxQueueGetAsyncWaitList( xQueue, pdTRUE ), xTicksToWait ) != pdFALSE )
+            {
+                /* Space may have become available before the coroutine was
+                 * added to the wait list, in which case the coroutine would
+                 * not be woken. */
+                xReturn = xQueueSend( xQueue, pvItemToQueue, 0 );
+
+                if( xReturn != pdPASS )
+                {
+                    xReturn = errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != errQUEUE_BLOCKED )
+        {
+            prvEndWait( pxCoroutine );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncQueueReceive( AsyncCoroutine_t * pxCoroutine,
+                                   QueueHandle_t xQueue,
+                                   void * pvBuffer,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        xReturn = xQueueReceive( xQueue, pvBuffer, 0 );
+
+        if( xReturn != pdPASS )
+        {
+            if( prvBeginWait( pxCoroutine, pxQueueGetAsyncWaitList( xQueue, pdFALSE ), xTicksToWait ) != pdFALSE )
+            {
+                /* Data may have arrived before the coroutine was added to the
+                 * wait list. */
+                xReturn = xQueueReceive( xQueue, pvBuffer, 0 );
+
+                if( xReturn != pdPASS )
+                {
+                    xReturn = errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != errQUEUE_BLOCKED )
+        {
+            prvEndWait( pxCoroutine );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncNotifyTake( AsyncCoroutine_t * pxCoroutine,
+                                 BaseType_t xClearCountOnExit,
+                                 TickType_t xTicksToWait,
+                                 uint32_t * pulValue )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xTakeAttempts = 0;
+
+        /* The count is taken once before the coroutine is added to its
+         * notification wait list, and once after in case it was given in
+         * between. */
+        while( xTakeAttempts < 2 )
+        {
+            xTakeAttempts++;
+
+            taskENTER_CRITICAL();
+            {
+                *pulValue = pxCoroutine->ulNotifiedValue;
+
+                if( pxCoroutine->ulNotifiedValue != 0U )
+                {
+                    if( xClearCountOnExit != pdFALSE )
+                    {
+                        pxCoroutine->ulNotifiedValue = 0U;
+                    }
+                    else
+                    {
+                        ( pxCoroutine->ulNotifiedValue )--;
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xReturn == pdPASS )
+            {
+                break;
+            }
+            else if( xTakeAttempts == 1 )
+            {
+                if( prvBeginWait( pxCoroutine, &( pxCoroutine->xNotificationWaitList ), xTicksToWait ) == pdFALSE )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = errQUEUE_BLOCKED;
+            }
+        }
+
+        if( xReturn != errQUEUE_BLOCKED )
+        {
+            prvEndWait( pxCoroutine );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STREAM_BUFFERS == 1 )
+
+        BaseType_t xAsyncStreamBufferSend( AsyncCoroutine_t * pxCoroutine,
+                                           StreamBufferHandle_t xStreamBuffer,
+                                           const void * pvTxData,
+                                           size_t xDataLengthBytes,
+                                           TickType_t xTicksToWait,
+                                           size_t * pxBytesSent )
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            *pxBytesSent = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, 0 );
+
+            if( *pxBytesSent == ( size_t ) 0 )
+            {
+                if( prvBeginWait( pxCoroutine, pxStreamBufferGetAsyncWaitList( xStreamBuffer, pdTRUE ), xTicksToWait ) != pdFALSE )
+                {
+                    /* Space may have become available before the coroutine was
+                     * added to the wait list. */
+                    *pxBytesSent = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, 0 );
+
+                    if( *pxBytesSent == ( size_t ) 0 )
+                    {
+                        xReturn = errQUEUE_BLOCKED;
+                    }
+                    else
+                    {
+                        xReturn = pdPASS;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = pdPASS;
+            }
+
+            if( xReturn != errQUEUE_BLOCKED )
+            {
+                prvEndWait( pxCoroutine );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xAsyncStreamBufferReceive( AsyncCoroutine_t * pxCoroutine,
+                                              StreamBufferHandle_t xStreamBuffer,
+                                              void * pvRxData,
+                                              size_t xBufferLengthBytes,
+                                              TickType_t xTicksToWait,
+                                              size_t * pxReceivedBytes )
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            *pxReceivedBytes = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, 0 );
+
+            if( *pxReceivedBytes == ( size_t ) 0 )
+            {
+                if( prvBeginWait( pxCoroutine, pxStreamBufferGetAsyncWaitList( xStreamBuffer, pdFALSE ), xTicksToWait ) != pdFALSE )
+                {
+                    /* Data may have arrived before the coroutine was added to
+                     * the wait list. */
+                    *pxReceivedBytes = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, 0 );
+
+                    if( *pxReceivedBytes == ( size_t ) 0 )
+                    {
+                        xReturn = errQUEUE_BLOCKED;
+                    }
+                    else
+                    {
+                        xReturn = pdPASS;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = pdPASS;
+            }
+
+            if( xReturn != errQUEUE_BLOCKED )
+            {
+                prvEndWait( pxCoroutine );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUPS == 1 )
+
+        BaseType_t xAsyncEventGroupWaitBits( AsyncCoroutine_t * pxCoroutine,
+                                             EventGroupHandle_t xEventGroup,
+                                             EventBits_t uxBitsToWaitFor,
+                                             BaseType_t xClearOnExit,
+                                             BaseType_t xWaitForAllBits,
+                                             TickType_t xTicksToWait,
+                                             EventBits_t * puxBits )
+        {
+            BaseType_t xReturn = pdFAIL;
+            BaseType_t xTakeAttempts = 0;
+
+            /* As xAsyncNotifyTake(), the bits are tested a second time after
+             * the coroutine is added to the wait list. */
+            while( xTakeAttempts < 2 )
+            {
+                xTakeAttempts++;
+
+                /* With a block time of 0 xEventGroupWaitBits() only clears the
+                 * bits if the wait condition was met. */
+                *puxBits = xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, 0 );
+
+                if( xWaitForAllBits != pdFALSE )
+                {
+                    if( ( *puxBits & uxBitsToWaitFor ) == uxBitsToWaitFor )
+                    {
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( ( *puxBits & uxBitsToWaitFor ) != ( EventBits_t ) 0 )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xReturn == pdPASS )
+                {
+                    break;
+                }
+                else if( xTakeAttempts == 1 )
+                {
+                    if( prvBeginWait( pxCoroutine, pxEventGroupGetAsyncWaitList( xEventGroup ), xTicksToWait ) == pdFALSE )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    xReturn = errQUEUE_BLOCKED;
+                }
+            }
+
+            if( xReturn != errQUEUE_BLOCKED )
+            {
+                prvEndWait( pxCoroutine );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include async coroutines.  This #if is closed at the very bottom of this
+ * file.  If you want to include async coroutines then ensure
+ * configUSE_ASYNC_COROUTINES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ASYNC_COROUTINES == 1 */
@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+    #include "async.h"
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -63,8 +67,46 @@
         #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
             uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
         #endif
+
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
+            portSPINLOCK_TYPE xEventGroupSpinlock; /**< Protects the event bits when portUSING_GRANULAR_LOCKS is 1. */
+        #endif
+
+        #if ( configUSE_ASYNC_COROUTINES == 1 )
+            AsyncWaitList_t xAsyncWaitingForBits; /**< Async coroutines waiting for bits to be set. */
+        #endif
     } EventGroup_t;
 
+/*
+ * Macros to protect the event bits of an event group.  When
+ * portUSING_GRANULAR_LOCKS is 1 the event bits are protected by the event
+ * group's own spinlock.  The list of waiting tasks is only ever accessed with
+ * the scheduler suspended so it still relies on that for protection, but
+ * event bits read or written with the scheduler suspended must also be
+ * accessed from within eventLOCK_BITS() and eventUNLOCK_BITS(), and task lists
+ * must then only be accessed after calling eventLOCK_KERNEL().
+ */
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        #define eventSPINLOCK( pxEventBits )                                          ( ( portSPINLOCK_TYPE * ) &( ( pxEventBits )->xEventGroupSpinlock ) )
+        #define eventENTER_CRITICAL( pxEventBits )                                    taskDATA_GROUP_ENTER_CRITICAL( eventSPINLOCK( pxEventBits ) )
+        #define eventEXIT_CRITICAL( pxEventBits )                                     taskDATA_GROUP_EXIT_CRITICAL( eventSPINLOCK( pxEventBits ) )
+        #define eventENTER_CRITICAL_FROM_ISR( pxEventBits )                           taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( eventSPINLOCK( pxEventBits ) )
+        #define eventEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits )    taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( ( uxSavedInterruptStatus ), eventSPINLOCK( pxEventBits ) )
+        #define eventLOCK_BITS( pxEventBits )                                         eventENTER_CRITICAL( pxEventBits )
+        #define eventUNLOCK_BITS( pxEventBits )                                       eventEXIT_CRITICAL( pxEventBits )
+        #define eventLOCK_KERNEL()                                                    taskDATA_GROUP_LOCK_KERNEL()
+        #define eventUNLOCK_KERNEL()                                                  taskDATA_GROUP_UNLOCK_KERNEL()
+    #else
+        #define eventENTER_CRITICAL( pxEventBits )                                    taskENTER_CRITICAL()
+        #define eventEXIT_CRITICAL( pxEventBits )                                     taskEXIT_CRITICAL()
+        #define eventENTER_CRITICAL_FROM_ISR( pxEventBits )                           taskENTER_CRITICAL_FROM_ISR()
+        #define eventEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+        #define eventLOCK_BITS( pxEventBits )
+        #define eventUNLOCK_BITS( pxEventBits )
+        #define eventLOCK_KERNEL()
+        #define eventUNLOCK_KERNEL()
+    #endif /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -113,6 +155,18 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                {
+                    portINIT_SPINLOCK( &( pxEventBits->xEventGroupSpinlock ) );
+                }
+                #endif
+
+                #if ( configUSE_ASYNC_COROUTINES == 1 )
+                {
+                    pxEventBits->xAsyncWaitingForBits = NULL;
+                }
+                #endif
+
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -158,6 +212,18 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                {
+                    portINIT_SPINLOCK( &( pxEventBits->xEventGroupSpinlock ) );
+                }
+                #endif
+
+                #if ( configUSE_ASYNC_COROUTINES == 1 )
+                {
+                    pxEventBits->xAsyncWaitingForBits = NULL;
+                }
+                #endif
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -208,6 +274,8 @@
 
             ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
+            eventLOCK_BITS( pxEventBits );
+
             if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
             {
                 /* All the rendezvous bits are now set - no need to block. */
@@ -228,7 +296,9 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
+                    eventLOCK_KERNEL();
                     vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    eventUNLOCK_KERNEL();
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +314,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            eventUNLOCK_BITS( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -267,7 +339,7 @@
             if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
             {
                 /* The task timed out, just return the current event bit value. */
-                taskENTER_CRITICAL();
+                eventENTER_CRITICAL( pxEventBits );
                 {
                     uxReturn = pxEventBits->uxEventBits;
 
@@ -284,7 +356,7 @@
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                taskEXIT_CRITICAL();
+                eventEXIT_CRITICAL( pxEventBits );
 
                 xTimeoutOccurred = pdTRUE;
             }
@@ -335,7 +407,11 @@
 
         vTaskSuspendAll();
         {
-            const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
+            EventBits_t uxCurrentEventBits;
+
+            eventLOCK_BITS( pxEventBits );
+
+            uxCurrentEventBits = pxEventBits->uxEventBits;
 
             /* Check to see if the wait condition is already met or not. */
             xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
@@ -391,7 +467,9 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
+                eventLOCK_KERNEL();
                 vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                eventUNLOCK_KERNEL();
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -400,6 +478,8 @@
 
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
+
+            eventUNLOCK_BITS( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -422,7 +502,7 @@
 
             if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
             {
-                taskENTER_CRITICAL();
+                eventENTER_CRITICAL( pxEventBits );
                 {
                     /* The task timed out, just return the current event bit value. */
                     uxReturn = pxEventBits->uxEventBits;
@@ -447,7 +527,7 @@
 
                     xTimeoutOccurred = pdTRUE;
                 }
-                taskEXIT_CRITICAL();
+                eventEXIT_CRITICAL( pxEventBits );
             }
             else
             {
@@ -482,7 +562,7 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        taskENTER_CRITICAL();
+        eventENTER_CRITICAL( pxEventBits );
         {
             traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear );
 
@@ -493,7 +573,7 @@
             /* Clear the bits. */
             pxEventBits->uxEventBits &= ~uxBitsToClear;
         }
-        taskEXIT_CRITICAL();
+        eventEXIT_CRITICAL( pxEventBits );
 
         traceRETURN_xEventGroupClearBits( uxReturn );
 
@@ -532,11 +612,11 @@
         /* MISRA Ref 4.7.1 [Return value shall be checked] */
         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
         /* coverity[misra_c_2012_directive_4_7_violation] */
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        uxSavedInterruptStatus = eventENTER_CRITICAL_FROM_ISR( pxEventBits );
         {
             uxReturn = pxEventBits->uxEventBits;
         }
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        eventEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits );
 
         traceRETURN_xEventGroupGetBitsFromISR( uxReturn );
 
@@ -568,6 +648,8 @@
         {
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
+            eventLOCK_BITS( pxEventBits );
+
             pxListItem = listGET_HEAD_ENTRY( pxList );
 
             /* Set the bits. */
@@ -623,7 +705,9 @@
                      * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
                      * that is was unblocked due to its required bits matching, rather
                      * than because it timed out. */
+                    eventLOCK_KERNEL();
                     vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                    eventUNLOCK_KERNEL();
                 }
 
                 /* Move onto the next list item.  Note pxListItem->pxNext is not
@@ -638,9 +722,28 @@
 
             /* Snapshot resulting bits. */
             uxReturnBits = pxEventBits->uxEventBits;
+
+            eventUNLOCK_BITS( pxEventBits );
         }
         ( void ) xTaskResumeAll();
 
+        #if ( configUSE_ASYNC_COROUTINES == 1 )
+        {
+            /* Each waiting coroutine tests the bits itself when it runs, so
+             * all of them are woken.  The wait list is protected by the kernel
+             * critical section, so cannot be accessed while the bits are
+             * locked. */
+            if( pxEventBits->xAsyncWaitingForBits != NULL )
+            {
+                vAsyncWakeWaiters( &( pxEventBits->xAsyncWaitingForBits ), pdTRUE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_ASYNC_COROUTINES */
+
         traceRETURN_xEventGroupSetBits( uxReturnBits );
 
         return uxReturnBits;
@@ -667,7 +770,9 @@
                 /* Unblock the task, returning 0 as the event list is being deleted
                  * and cannot therefore have any bits set. */
                 configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                eventLOCK_KERNEL();
                 vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                eventUNLOCK_KERNEL();
             }
         }
         ( void ) xTaskResumeAll();
@@ -881,6 +986,24 @@
     #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+
+        AsyncWaitList_t * pxEventGroupGetAsyncWaitList( EventGroupHandle_t xEventGroup )
+        {
+            EventGroup_t * const pxEventBits = xEventGroup;
+
+            traceENTER_pxEventGroupGetAsyncWaitList( xEventGroup );
+
+            configASSERT( pxEventBits );
+
+            traceRETURN_pxEventGroupGetAsyncWaitList( &( pxEventBits->xAsyncWaitingForBits ) );
+
+            return &( pxEventBits->xAsyncWaitingForBits );
+        }
+
+    #endif /* configUSE_ASYNC_COROUTINES */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
  * to include event groups functionality. If you want to include event groups
  * then ensure configUSE_EVENT_GROUPS is set to 1 in FreeRTOSConfig.h. */
@@ -0,0 +1,166 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Configuration shared by the programs in this directory.  Each program turns
+ * on the features it exercises with compile definitions, which is why every
+ * setting is only given a value here if one has not been given already.  See
+ * CMakeLists.txt and ../template_configuration/FreeRTOSConfig.h. */
+
+/******************************************************************************/
+/* Hardware description related definitions. **********************************/
+/******************************************************************************/
+
+#ifndef configTICK_RATE_HZ
+    #define configTICK_RATE_HZ                  1000
+#endif
+
+/******************************************************************************/
+/* Scheduling behaviour related definitions. **********************************/
+/******************************************************************************/
+
+#ifndef configUSE_PREEMPTION
+    #define configUSE_PREEMPTION                1
+#endif
+
+#ifndef configUSE_TIME_SLICING
+    #define configUSE_TIME_SLICING              1
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#endif
+
+#ifndef configMAX_PRIORITIES
+    #define configMAX_PRIORITIES                8
+#endif
+
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES               1
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    #define configRUN_MULTIPLE_PRIORITIES       1
+#endif
+
+#ifndef configMINIMAL_STACK_SIZE
+    #define configMINIMAL_STACK_SIZE            1024
+#endif
+
+#define configMAX_TASK_NAME_LEN                 16
+#define configTICK_TYPE_WIDTH_IN_BITS           TICK_TYPE_WIDTH_64_BITS
+#define configIDLE_SHOULD_YIELD                 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   1
+#define configQUEUE_REGISTRY_SIZE               8
+
+/******************************************************************************/
+/* Software timer related definitions. ****************************************/
+/******************************************************************************/
+
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+#define configTIMER_QUEUE_LENGTH                20
+
+/******************************************************************************/
+/* Memory allocation related definitions. *************************************/
+/******************************************************************************/
+
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+    #define configSUPPORT_STATIC_ALLOCATION     1
+#endif
+
+#define configKERNEL_PROVIDED_STATIC_MEMORY     1
+#ifndef configTOTAL_HEAP_SIZE
+    #define configTOTAL_HEAP_SIZE               ( 64 * 1024 * 1024 )
+#endif
+
+/******************************************************************************/
+/* Hook and callback function related definitions. ****************************/
+/******************************************************************************/
+
+/* Each core of an SMP build runs in its own thread, so the idle tasks give the
+ * host processor to the other threads. */
+#if ( configNUMBER_OF_CORES > 1 )
+    #define configUSE_IDLE_HOOK                 1
+    #define configUSE_PASSIVE_IDLE_HOOK         1
+#else
+    #define configUSE_IDLE_HOOK                 0
+#endif
+
+#define configUSE_TICK_HOOK                     0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+#define configCHECK_FOR_STACK_OVERFLOW          0
+
+/******************************************************************************/
+/* Debugging assistance. ******************************************************/
+/******************************************************************************/
+
+extern void vAssertCalled( const char * pcFile,
+                           unsigned long ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#ifndef configUSE_TRACE_FACILITY
+    #define configUSE_TRACE_FACILITY            1
+#endif
+
+/******************************************************************************/
+/* Definitions that include or exclude functionality. *************************/
+/******************************************************************************/
+
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+
+#ifndef configUSE_QUEUE_SETS
+    #define configUSE_QUEUE_SETS                1
+#endif
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_xSemaphoreGetMutexHolder        1
+#define INCLUDE_xTimerPendFunctionCall          1
+
+#endif /* FREERTOS_CONFIG_H */
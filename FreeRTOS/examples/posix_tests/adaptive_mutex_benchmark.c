@@ -0,0 +1,155 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the throughput of one mutex taken and given by tasks on different
+ * cores of an SMP build, each holding it for a short critical section.  Built
+ * with configUSE_ADAPTIVE_MUTEXES set to 1, a task that finds the mutex taken
+ * by a task running on another core spins before it blocks, and with it set
+ * to 0 it blocks at once.  Every task increments a shared counter without
+ * atomic instructions while it holds the mutex, and the counter is checked at
+ * the end, so the program also serves as a test when run with few takes.
+ *
+ * Usage: adaptive_mutex_benchmark [tasks] [takes per task]
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define benchmarkTASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define benchmarkDEFAULT_TAKES    100000UL
+
+/* The length of the critical section. */
+#define benchmarkHOLD_LOOPS       50
+
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xMutex = NULL;
+static int iTasks = configNUMBER_OF_CORES;
+static uint32_t ulTakes = benchmarkDEFAULT_TAKES;
+static uint64_t ullStartTimeNs = 0;
+static int iTasksDone = 0;
+
+/* Only changed with the mutex held. */
+static volatile uint32_t ulCounter = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void * pvParameters )
+{
+    uint64_t ullExpected = 0, ullElapsedNs;
+    uint32_t ulTake;
+    volatile int iLoop;
+
+    ( void ) pvParameters;
+
+    /* The clock starts when the first task runs. */
+    ( void ) __atomic_compare_exchange_n( &ullStartTimeNs, &ullExpected, ullTestGetTimeNs(), pdFALSE,
+                                          __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+
+    for( ulTake = 0; ulTake < ulTakes; ulTake++ )
+    {
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+        {
+            ulCounter = ulCounter + 1U;
+
+            for( iLoop = 0; iLoop < benchmarkHOLD_LOOPS; iLoop++ )
+            {
+            }
+        }
+        ( void ) xSemaphoreGive( xMutex );
+    }
+
+    if( __atomic_add_fetch( &iTasksDone, 1, __ATOMIC_SEQ_CST ) == iTasks )
+    {
+        ullElapsedNs = ullTestGetTimeNs() - __atomic_load_n( &ullStartTimeNs, __ATOMIC_SEQ_CST );
+
+        testCHECK( ulCounter == ( ulTakes * ( uint32_t ) iTasks ) );
+
+        ( void ) printf( "adaptive mutexes %d: %d cores, %d tasks, %lu takes per task, "
+                         "%.1f ns per take, %.2f million takes per second\n",
+                         configUSE_ADAPTIVE_MUTEXES, configNUMBER_OF_CORES, iTasks, ( unsigned long ) ulTakes,
+                         ( double ) ullElapsedNs / ( ( double ) ulTakes * ( double ) iTasks ),
+                         ( ( double ) ulTakes * ( double ) iTasks * 1000.0 ) / ( double ) ullElapsedNs );
+        vTestFinish();
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( argc > 1 )
+    {
+        iTasks = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        ulTakes = ( uint32_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    if( ( iTasks < 1 ) || ( iTasks > configNUMBER_OF_CORES ) )
+    {
+        ( void ) printf( "tasks must be from 1 to %d\n", configNUMBER_OF_CORES );
+        return 1;
+    }
+
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( xMutex != NULL );
+
+    for( i = 0; i < iTasks; i++ )
+    {
+        ( void ) xTaskCreate( prvMutexTask, "mutex", configMINIMAL_STACK_SIZE, NULL, benchmarkTASK_PRIORITY, NULL );
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
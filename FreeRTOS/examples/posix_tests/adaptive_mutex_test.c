@@ -0,0 +1,305 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks when a task waiting for an adaptive mutex, enabled by
+ * configUSE_ADAPTIVE_MUTEXES, stops spinning.  The program includes queue.c so
+ * it can set the mutex's spin estimate high enough that a waiter would spin
+ * for minutes if nothing stopped it.  On core 1 of three, a holder task at
+ * priority 1 takes the mutex and runs until told what to do, and on core 2 a
+ * waiter at priority 3 then tries to take it.  After a few ticks the waiter
+ * must still be running, spinning.  Then, in turn:
+ *
+ * 1. The holder gives the mutex back.  The waiter takes it without blocking,
+ *    and the spin estimate is updated.
+ * 2. The holder blocks.  The waiter must block within a few ticks, the holder
+ *    must inherit the waiter's priority, and the estimate must not change.
+ * 3. A task at priority 2 on core 1 preempts the holder.  The waiter must again block,
+ *    the holder inherit its priority, and the estimate stay the same.
+ *
+ * In 2 and 3 the holder then gives the mutex back, the waiter takes it, and
+ * the holder returns to its own priority.
+ *
+ * Each task is kept to its core, so that the kernel never moves the holder to
+ * make room for another task, which would also stop the waiter spinning.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes.  queue.c includes FreeRTOS.h, task.h and queue.h. */
+#include "queue.c"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define adaptiveHOLDER_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+#define adaptiveHOG_PRIORITY        ( tskIDLE_PRIORITY + 2 )
+#define adaptiveWAITER_PRIORITY     ( tskIDLE_PRIORITY + 3 )
+#define adaptiveCONTROL_PRIORITY    ( tskIDLE_PRIORITY + 4 )
+#define adaptiveSTACK_SIZE          ( configMINIMAL_STACK_SIZE * 4 )
+#define adaptiveCONTROL_CORES       ( ( UBaseType_t ) ( 1U << 0 ) )
+#define adaptiveHOLDER_CORES        ( ( UBaseType_t ) ( 1U << 1 ) )
+#define adaptiveWAITER_CORES        ( ( UBaseType_t ) ( 1U << 2 ) )
+
+/* An estimate that gives a spin limit just under configADAPTIVE_MUTEX_MAX_SPINS,
+ * which the program sets to 0x7FFFFFFF. */
+#define adaptiveLARGE_ESTIMATE      ( ( uint32_t ) 0x3FFFFFF0UL )
+
+/* How long the waiter is left to spin before it is checked, and how long it
+ * may take to block once the holder stops running. */
+#define adaptiveSPIN_TICKS          ( ( TickType_t ) 5 )
+#define adaptiveBLOCK_TICKS         ( ( TickType_t ) 20 )
+#define adaptiveDONE_TICKS          ( ( TickType_t ) 200 )
+
+/*-----------------------------------------------------------*/
+
+/* What the holder does once it has taken the mutex. */
+typedef enum
+{
+    eHolderRun,
+    eHolderGive,
+    eHolderBlock
+} HolderCommand_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvHolderTask( void * pvParameters );
+static void prvWaiterTask( void * pvParameters );
+static void prvHogTask( void * pvParameters );
+static BaseType_t prvWaitForWaiterToBlock( void );
+static void prvStartScenario( void );
+static void prvFinishScenario( void );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xMutex = NULL;
+static SemaphoreHandle_t xHolderWake = NULL;
+static TaskHandle_t xHolder = NULL, xWaiter = NULL;
+
+static volatile HolderCommand_t eHolderCommand = eHolderRun;
+static volatile BaseType_t xHolderHasMutex = pdFALSE;
+static volatile BaseType_t xHolderDone = pdFALSE;
+static volatile UBaseType_t uxHolderPriorityAfterGive = 0;
+static volatile BaseType_t xWaiterStarted = pdFALSE;
+static volatile BaseType_t xWaiterDone = pdFALSE;
+static volatile BaseType_t xHogRun = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static void prvHolderTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    testCHECK( xSemaphoreTake( xMutex, 0 ) == pdPASS );
+    xHolderHasMutex = pdTRUE;
+
+    /* Keep running, so that a waiter spins, until told otherwise. */
+    while( eHolderCommand == eHolderRun )
+    {
+    }
+
+    if( eHolderCommand == eHolderBlock )
+    {
+        ( void ) xSemaphoreTake( xHolderWake, portMAX_DELAY );
+    }
+
+    testCHECK( xSemaphoreGive( xMutex ) == pdPASS );
+    uxHolderPriorityAfterGive = uxTaskPriorityGet( NULL );
+
+    /* Keep running until the waiter has the mutex, as a waiter that sees the
+     * holder stop running stops spinning whether or not the mutex is free. */
+    while( xWaiterDone == pdFALSE )
+    {
+    }
+
+    xHolderDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    xWaiterStarted = pdTRUE;
+    testCHECK( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+    testCHECK( xSemaphoreGive( xMutex ) == pdPASS );
+    xWaiterDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    while( xHogRun != pdFALSE )
+    {
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWaitForWaiterToBlock( void )
+{
+    const TickType_t xStart = xTaskGetTickCount();
+
+    while( eTaskGetState( xWaiter ) != eBlocked )
+    {
+        if( ( xTaskGetTickCount() - xStart ) > adaptiveBLOCK_TICKS )
+        {
+            return pdFALSE;
+        }
+
+        vTaskDelay( 1 );
+    }
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartScenario( void )
+{
+    Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+    eHolderCommand = eHolderRun;
+    xHolderHasMutex = pdFALSE;
+    xHolderDone = pdFALSE;
+    xWaiterStarted = pdFALSE;
+    xWaiterDone = pdFALSE;
+
+    pxMutex->ulSpinEstimate = adaptiveLARGE_ESTIMATE;
+
+    ( void ) xTaskCreateAffinitySet( prvHolderTask, "holder", adaptiveSTACK_SIZE, NULL, adaptiveHOLDER_PRIORITY,
+                                     adaptiveHOLDER_CORES, &xHolder );
+
+    while( xHolderHasMutex == pdFALSE )
+    {
+        vTaskDelay( 1 );
+    }
+
+    ( void ) xTaskCreateAffinitySet( prvWaiterTask, "waiter", adaptiveSTACK_SIZE, NULL, adaptiveWAITER_PRIORITY,
+                                     adaptiveWAITER_CORES, &xWaiter );
+
+    /* The holder is running on another core, so the waiter spins.  On a
+     * loaded host the waiter's thread may take a while to start. */
+    while( xWaiterStarted == pdFALSE )
+    {
+        vTaskDelay( 1 );
+    }
+
+    vTaskDelay( adaptiveSPIN_TICKS );
+    testCHECK( eTaskGetState( xWaiter ) == eRunning );
+    testCHECK( xWaiterDone == pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinishScenario( void )
+{
+    const TickType_t xStart = xTaskGetTickCount();
+
+    while( ( ( xHolderDone == pdFALSE ) || ( xWaiterDone == pdFALSE ) ) &&
+           ( ( xTaskGetTickCount() - xStart ) < adaptiveDONE_TICKS ) )
+    {
+        vTaskDelay( 1 );
+    }
+
+    testCHECK( xHolderDone == pdTRUE );
+    testCHECK( xWaiterDone == pdTRUE );
+    testCHECK( uxHolderPriorityAfterGive == adaptiveHOLDER_PRIORITY );
+
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+    uint32_t ulEstimateAfterGive;
+    BaseType_t xBlocked;
+
+    ( void ) pvParameters;
+
+    /* 1. The mutex is given back while the waiter spins. */
+    prvStartScenario();
+    eHolderCommand = eHolderGive;
+    prvFinishScenario();
+    ulEstimateAfterGive = pxMutex->ulSpinEstimate;
+    testCHECK( ulEstimateAfterGive < adaptiveLARGE_ESTIMATE );
+
+    /* 2. The holder blocks. */
+    prvStartScenario();
+    eHolderCommand = eHolderBlock;
+    xBlocked = prvWaitForWaiterToBlock();
+    testCHECK( xBlocked == pdTRUE );
+    testCHECK( uxTaskPriorityGet( xHolder ) == adaptiveWAITER_PRIORITY );
+    testCHECK( pxMutex->ulSpinEstimate == adaptiveLARGE_ESTIMATE );
+    ( void ) xSemaphoreGive( xHolderWake );
+    prvFinishScenario();
+
+    /* 3. The holder is preempted by a task on its core. */
+    prvStartScenario();
+    xHogRun = pdTRUE;
+    ( void ) xTaskCreateAffinitySet( prvHogTask, "hog", adaptiveSTACK_SIZE, NULL, adaptiveHOG_PRIORITY,
+                                     adaptiveHOLDER_CORES, NULL );
+    xBlocked = prvWaitForWaiterToBlock();
+    testCHECK( xBlocked == pdTRUE );
+    testCHECK( uxTaskPriorityGet( xHolder ) == adaptiveWAITER_PRIORITY );
+    testCHECK( pxMutex->ulSpinEstimate == adaptiveLARGE_ESTIMATE );
+    eHolderCommand = eHolderGive;
+    xHogRun = pdFALSE;
+    prvFinishScenario();
+
+    ( void ) printf( "spin estimate %lu, and %lu after the mutex was given back to a spinning waiter\n",
+                     ( unsigned long ) adaptiveLARGE_ESTIMATE, ( unsigned long ) ulEstimateAfterGive );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xMutex = xSemaphoreCreateMutex();
+    xHolderWake = xSemaphoreCreateBinary();
+    configASSERT( ( xMutex != NULL ) && ( xHolderWake != NULL ) );
+
+    ( void ) xTaskCreateAffinitySet( prvControlTask, "control", adaptiveSTACK_SIZE, NULL, adaptiveCONTROL_PRIORITY,
+                                     adaptiveCONTROL_CORES, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
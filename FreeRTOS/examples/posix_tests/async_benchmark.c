@@ -0,0 +1,246 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Compares async coroutines with tasks doing the same work.  Both pass a
+ * notification around a ring of flows: each flow waits to be notified, then
+ * notifies the next flow in the ring.  The coroutine ring is run by one
+ * executor in one host task, so passing the notification on is a switch
+ * between coroutines.  The task ring needs a context switch for each pass.
+ * The memory used by each ring is measured with heap_4, with the coroutines
+ * counted as the size of their structures plus the host task.
+ *
+ * The POSIX port runs each task in its own thread, so the task ring is limited
+ * to ringMAX_TASKS tasks and its time per pass includes a host thread switch.
+ * The port also masks signals with a system call to enter a critical section,
+ * which both rings do several times per pass, so the time taken by a critical
+ * section is printed too.
+ *
+ * Usage: async_benchmark [flows] [passes]
+ * Prints the time taken by one pass and the memory used by each ring.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "async.h"
+
+#include "test_support.h"
+
+#define ringDEFAULT_FLOWS       1000
+#define ringDEFAULT_PASSES      100000UL
+#define ringMAX_TASKS           100
+#define ringCRITICAL_SECTIONS   100000UL
+#define ringCONTROL_PRIORITY    ( tskIDLE_PRIORITY + 3 )
+#define ringFLOW_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+
+/*-----------------------------------------------------------*/
+
+static void prvCoroutineFlow( AsyncCoroutine_t * pxCoroutine,
+                              void * pvParameters );
+static void prvTaskFlow( void * pvParameters );
+static void prvHostTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static int iFlows = ringDEFAULT_FLOWS;
+static unsigned long ulPasses = ringDEFAULT_PASSES;
+
+static AsyncExecutor_t xExecutor;
+static AsyncCoroutine_t * pxCoroutines = NULL;
+static TaskHandle_t xTasks[ ringMAX_TASKS ];
+static int iTaskFlows;
+
+static TaskHandle_t xControlTask = NULL;
+static volatile unsigned long ulPassesDone = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvCoroutineFlow( AsyncCoroutine_t * pxCoroutine,
+                              void * pvParameters )
+{
+    const int iFlow = ( int ) ( intptr_t ) pvParameters;
+    uint32_t ulValue;
+
+    asyncBEGIN( pxCoroutine );
+
+    for( ; ; )
+    {
+        asyncAWAIT_NOTIFY_TAKE( pxCoroutine, pdTRUE, portMAX_DELAY, &ulValue );
+
+        ulPassesDone++;
+
+        if( ulPassesDone < ulPasses )
+        {
+            ( void ) xAsyncNotifyGive( &( pxCoroutines[ ( iFlow + 1 ) % iFlows ] ) );
+        }
+        else
+        {
+            ( void ) xTaskNotifyGive( xControlTask );
+        }
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskFlow( void * pvParameters )
+{
+    const int iFlow = ( int ) ( intptr_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        ulPassesDone++;
+
+        if( ulPassesDone < ulPasses )
+        {
+            ( void ) xTaskNotifyGive( xTasks[ ( iFlow + 1 ) % iTaskFlows ] );
+        }
+        else
+        {
+            ( void ) xTaskNotifyGive( xControlTask );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHostTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vAsyncExecutorRun( &xExecutor );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    size_t xFreeBefore, xCoroutineBytes, xTaskBytes;
+    uint64_t ullStart, ullCoroutineNs, ullTaskNs, ullCriticalNs;
+    unsigned long ul;
+    int i;
+
+    ( void ) pvParameters;
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ul = 0; ul < ringCRITICAL_SECTIONS; ul++ )
+    {
+        taskENTER_CRITICAL();
+        taskEXIT_CRITICAL();
+    }
+
+    ullCriticalNs = ullTestGetTimeNs() - ullStart;
+
+    /* The coroutine ring. */
+    xFreeBefore = xPortGetFreeHeapSize();
+
+    pxCoroutines = pvPortMalloc( sizeof( AsyncCoroutine_t ) * ( size_t ) iFlows );
+    configASSERT( pxCoroutines );
+    vAsyncExecutorInitialise( &xExecutor );
+
+    for( i = 0; i < iFlows; i++ )
+    {
+        vAsyncCoroutineStart( &xExecutor, &( pxCoroutines[ i ] ), prvCoroutineFlow, ( void * ) ( intptr_t ) i );
+    }
+
+    ( void ) xTaskCreate( prvHostTask, "host", configMINIMAL_STACK_SIZE, NULL, ringFLOW_PRIORITY, NULL );
+    xCoroutineBytes = xFreeBefore - xPortGetFreeHeapSize();
+
+    /* Let every coroutine start waiting. */
+    vTaskDelay( 10 );
+
+    ulPassesDone = 0;
+    ullStart = ullTestGetTimeNs();
+    ( void ) xAsyncNotifyGive( &( pxCoroutines[ 0 ] ) );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    ullCoroutineNs = ullTestGetTimeNs() - ullStart;
+    testCHECK( ulPassesDone == ulPasses );
+
+    /* The task ring. */
+    iTaskFlows = ( iFlows < ringMAX_TASKS ) ? iFlows : ringMAX_TASKS;
+    xFreeBefore = xPortGetFreeHeapSize();
+
+    for( i = 0; i < iTaskFlows; i++ )
+    {
+        ( void ) xTaskCreate( prvTaskFlow, "flow", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) i, ringFLOW_PRIORITY, &( xTasks[ i ] ) );
+        configASSERT( xTasks[ i ] );
+    }
+
+    xTaskBytes = xFreeBefore - xPortGetFreeHeapSize();
+
+    vTaskDelay( 10 );
+
+    ulPassesDone = 0;
+    ullStart = ullTestGetTimeNs();
+    ( void ) xTaskNotifyGive( xTasks[ 0 ] );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    ullTaskNs = ullTestGetTimeNs() - ullStart;
+    testCHECK( ulPassesDone == ulPasses );
+
+    ( void ) printf( "coroutines: %d flows, %.1f ns per pass, %lu bytes (%lu per flow plus %lu for the host task)\n",
+                     iFlows, ( double ) ullCoroutineNs / ( double ) ulPasses, ( unsigned long ) xCoroutineBytes,
+                     ( unsigned long ) sizeof( AsyncCoroutine_t ),
+                     ( unsigned long ) ( xCoroutineBytes - ( sizeof( AsyncCoroutine_t ) * ( size_t ) iFlows ) ) );
+    ( void ) printf( "tasks:      %d flows, %.1f ns per pass, %lu bytes (%lu per flow)\n",
+                     iTaskFlows, ( double ) ullTaskNs / ( double ) ulPasses, ( unsigned long ) xTaskBytes,
+                     ( unsigned long ) ( xTaskBytes / ( size_t ) iTaskFlows ) );
+    ( void ) printf( "critical section: %.1f ns\n", ( double ) ullCriticalNs / ( double ) ringCRITICAL_SECTIONS );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        iFlows = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        ulPasses = strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    configASSERT( ( iFlows > 0 ) && ( ulPasses > 0UL ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 2, NULL, ringCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
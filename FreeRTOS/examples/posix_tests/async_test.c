@@ -0,0 +1,574 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the async coroutines enabled by configUSE_ASYNC_COROUTINES.  One host
+ * task runs an executor with the following coroutines, while a driver task at
+ * a lower priority feeds them:
+ *
+ * 1. A coroutine receives counted items from the driver through a queue.
+ * 2. A coroutine sends counted items to the driver through a queue.
+ * 3. A coroutine takes a counting semaphore the driver gives.
+ * 4. Two coroutines pass a byte pattern through a stream buffer, in chunks of
+ *    different sizes, so each waits for the other.
+ * 5. A coroutine waits for two event bits the driver sets one at a time.
+ * 6. A coroutine takes notifications the driver gives.
+ * 7. A coroutine delays, then waits with a timeout on a queue that stays
+ *    empty.  Both must take the requested number of ticks.
+ * 8. A coroutine waits with a timeout on a queue.  A task above the host
+ *    sends to the queue, waking the coroutine, then receives the item back
+ *    before the coroutine runs.  The coroutine must carry on waiting until its
+ *    timeout.
+ * 9. 100 coroutines share one short queue, each waiting with a short timeout
+ *    until it has received three items.  Every item must be received and
+ *    every coroutine must finish.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+#include "async.h"
+
+#include "test_support.h"
+
+#define coroHOST_PRIORITY          ( tskIDLE_PRIORITY + 2 )
+#define coroDRIVER_PRIORITY        ( tskIDLE_PRIORITY + 1 )
+#define coroRACE_PRIORITY          ( tskIDLE_PRIORITY + 3 )
+#define coroSTACK_SIZE             ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Checks 1 to 6. */
+#define coroQUEUE_ITEMS            200U
+#define coroSEMAPHORE_GIVES        50U
+#define coroSTREAM_BYTES           10000U
+#define coroSTREAM_SEND_CHUNK      64U
+#define coroSTREAM_RECEIVE_CHUNK   48U
+#define coroEVENT_ROUNDS           20U
+#define coroNOTIFICATIONS          100U
+
+/* Checks 7 and 8.  A timeout may end up to two ticks late on a busy host. */
+#define coroDELAY_TICKS            ( ( TickType_t ) 25 )
+#define coroTIMEOUT_TICKS          ( ( TickType_t ) 30 )
+#define coroRACE_TIMEOUT_TICKS     ( ( TickType_t ) 60 )
+#define coroTICKS_LATE             ( ( TickType_t ) 2 )
+
+/* Check 9. */
+#define coroMANY                   100
+#define coroMANY_ITEMS_EACH        3U
+#define coroMANY_TIMEOUT_TICKS     ( ( TickType_t ) 3 )
+
+/*-----------------------------------------------------------*/
+
+static void prvQueueReceiver( AsyncCoroutine_t * pxCoroutine,
+                              void * pvParameters );
+static void prvQueueSender( AsyncCoroutine_t * pxCoroutine,
+                            void * pvParameters );
+static void prvSemaphoreTaker( AsyncCoroutine_t * pxCoroutine,
+                               void * pvParameters );
+static void prvStreamSender( AsyncCoroutine_t * pxCoroutine,
+                             void * pvParameters );
+static void prvStreamReceiver( AsyncCoroutine_t * pxCoroutine,
+                               void * pvParameters );
+static void prvEventBitsWaiter( AsyncCoroutine_t * pxCoroutine,
+                                void * pvParameters );
+static void prvNotificationTaker( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters );
+static void prvTimeouts( AsyncCoroutine_t * pxCoroutine,
+                         void * pvParameters );
+static void prvRaceLoser( AsyncCoroutine_t * pxCoroutine,
+                          void * pvParameters );
+static void prvSharedQueueReceiver( AsyncCoroutine_t * pxCoroutine,
+                                    void * pvParameters );
+static void prvHostTask( void * pvParameters );
+static void prvRaceTask( void * pvParameters );
+static void prvDriverTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static AsyncExecutor_t xExecutor;
+
+static QueueHandle_t xToCoroutine = NULL;
+static QueueHandle_t xFromCoroutine = NULL;
+static QueueHandle_t xEmptyQueue = NULL;
+static QueueHandle_t xRaceQueue = NULL;
+static QueueHandle_t xSharedQueue = NULL;
+static SemaphoreHandle_t xSemaphore = NULL;
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static EventGroupHandle_t xEventGroup = NULL;
+
+/* Check 1. */
+static AsyncCoroutine_t xQueueReceiverCoroutine;
+static uint32_t ulQueueItemsReceived = 0;
+static uint32_t ulQueueOrderErrors = 0;
+
+/* Check 2. */
+static AsyncCoroutine_t xQueueSenderCoroutine;
+static uint32_t ulQueueItemsSent = 0;
+
+/* Check 3. */
+static AsyncCoroutine_t xSemaphoreCoroutine;
+static uint32_t ulSemaphoresTaken = 0;
+
+/* Check 4. */
+static AsyncCoroutine_t xStreamSenderCoroutine;
+static AsyncCoroutine_t xStreamReceiverCoroutine;
+static size_t xStreamBytesSent = 0;
+static size_t xStreamBytesReceived = 0;
+static uint32_t ulStreamErrors = 0;
+static uint8_t ucStreamChunk[ coroSTREAM_SEND_CHUNK ];
+
+/* Check 5. */
+static AsyncCoroutine_t xEventBitsCoroutine;
+static uint32_t ulEventRounds = 0;
+static uint32_t ulEventErrors = 0;
+
+/* Check 6. */
+static AsyncCoroutine_t xNotificationCoroutine;
+static uint32_t ulNotificationsTaken = 0;
+
+/* Check 7. */
+static AsyncCoroutine_t xTimeoutCoroutine;
+static TickType_t xStartTick;
+static TickType_t xDelayTicks = 0;
+static TickType_t xTimeoutTicks = 0;
+static BaseType_t xTimeoutResult = pdPASS;
+
+/* Check 8. */
+static AsyncCoroutine_t xRaceCoroutine;
+static TickType_t xRaceStartTick;
+static TickType_t xRaceTicks = 0;
+static BaseType_t xRaceResult = pdPASS;
+
+/* Check 9. */
+static AsyncCoroutine_t xManyCoroutines[ coroMANY ];
+static uint32_t ulItemsLeft[ coroMANY ];
+static uint32_t ulSharedItemsReceived = 0;
+static uint32_t ulSharedTimeouts = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvQueueReceiver( AsyncCoroutine_t * pxCoroutine,
+                              void * pvParameters )
+{
+    BaseType_t xResult;
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulQueueItemsReceived < coroQUEUE_ITEMS )
+    {
+        asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xToCoroutine, &ulValue, portMAX_DELAY, &xResult );
+
+        if( ( xResult != pdPASS ) || ( ulValue != ulQueueItemsReceived ) )
+        {
+            ulQueueOrderErrors++;
+        }
+
+        ulQueueItemsReceived++;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueSender( AsyncCoroutine_t * pxCoroutine,
+                            void * pvParameters )
+{
+    BaseType_t xResult;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulQueueItemsSent < coroQUEUE_ITEMS )
+    {
+        asyncAWAIT_QUEUE_SEND( pxCoroutine, xFromCoroutine, &ulQueueItemsSent, portMAX_DELAY, &xResult );
+
+        if( xResult == pdPASS )
+        {
+            ulQueueItemsSent++;
+        }
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreTaker( AsyncCoroutine_t * pxCoroutine,
+                               void * pvParameters )
+{
+    BaseType_t xResult;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulSemaphoresTaken < coroSEMAPHORE_GIVES )
+    {
+        asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xSemaphore, NULL, portMAX_DELAY, &xResult );
+
+        if( xResult == pdPASS )
+        {
+            ulSemaphoresTaken++;
+        }
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamSender( AsyncCoroutine_t * pxCoroutine,
+                             void * pvParameters )
+{
+    size_t xSent, x;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( xStreamBytesSent < coroSTREAM_BYTES )
+    {
+        for( x = 0; x < sizeof( ucStreamChunk ); x++ )
+        {
+            ucStreamChunk[ x ] = ( uint8_t ) ( xStreamBytesSent + x );
+        }
+
+        asyncAWAIT_STREAM_BUFFER_SEND( pxCoroutine, xStreamBuffer, ucStreamChunk, sizeof( ucStreamChunk ), portMAX_DELAY, &xSent );
+        xStreamBytesSent += xSent;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamReceiver( AsyncCoroutine_t * pxCoroutine,
+                               void * pvParameters )
+{
+    uint8_t ucReceived[ coroSTREAM_RECEIVE_CHUNK ];
+    size_t xReceived, x;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( xStreamBytesReceived < coroSTREAM_BYTES )
+    {
+        asyncAWAIT_STREAM_BUFFER_RECEIVE( pxCoroutine, xStreamBuffer, ucReceived, sizeof( ucReceived ), portMAX_DELAY, &xReceived );
+
+        for( x = 0; x < xReceived; x++ )
+        {
+            if( ucReceived[ x ] != ( uint8_t ) ( xStreamBytesReceived + x ) )
+            {
+                ulStreamErrors++;
+            }
+        }
+
+        xStreamBytesReceived += xReceived;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventBitsWaiter( AsyncCoroutine_t * pxCoroutine,
+                                void * pvParameters )
+{
+    EventBits_t uxBits;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulEventRounds < coroEVENT_ROUNDS )
+    {
+        asyncAWAIT_EVENT_BITS( pxCoroutine, xEventGroup, 0x03, pdTRUE, pdTRUE, portMAX_DELAY, &uxBits );
+
+        if( ( uxBits & 0x03 ) != 0x03 )
+        {
+            ulEventErrors++;
+        }
+
+        ulEventRounds++;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotificationTaker( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulNotificationsTaken < coroNOTIFICATIONS )
+    {
+        asyncAWAIT_NOTIFY_TAKE( pxCoroutine, pdTRUE, portMAX_DELAY, &ulValue );
+        ulNotificationsTaken += ulValue;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimeouts( AsyncCoroutine_t * pxCoroutine,
+                         void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    xStartTick = xTaskGetTickCount();
+    asyncDELAY( pxCoroutine, coroDELAY_TICKS );
+    xDelayTicks = xTaskGetTickCount() - xStartTick;
+
+    xStartTick = xTaskGetTickCount();
+    asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xEmptyQueue, &ulValue, coroTIMEOUT_TICKS, &xTimeoutResult );
+    xTimeoutTicks = xTaskGetTickCount() - xStartTick;
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaceLoser( AsyncCoroutine_t * pxCoroutine,
+                          void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    xRaceStartTick = xTaskGetTickCount();
+    asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xRaceQueue, &ulValue, coroRACE_TIMEOUT_TICKS, &xRaceResult );
+    xRaceTicks = xTaskGetTickCount() - xRaceStartTick;
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSharedQueueReceiver( AsyncCoroutine_t * pxCoroutine,
+                                    void * pvParameters )
+{
+    uint32_t * const pulItemsLeft = ( uint32_t * ) pvParameters;
+    BaseType_t xResult;
+    uint32_t ulValue;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( *pulItemsLeft > 0U )
+    {
+        asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xSharedQueue, &ulValue, coroMANY_TIMEOUT_TICKS, &xResult );
+
+        if( xResult == pdPASS )
+        {
+            ulSharedItemsReceived++;
+            ( *pulItemsLeft )--;
+        }
+        else
+        {
+            ulSharedTimeouts++;
+        }
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHostTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vAsyncExecutorRun( &xExecutor );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaceTask( void * pvParameters )
+{
+    uint32_t ulValue = 7;
+
+    ( void ) pvParameters;
+
+    vTaskDelay( 10 );
+
+    /* Sending wakes the coroutine, but this task runs above the host so takes
+     * the item back before the coroutine can. */
+    testCHECK( xQueueSend( xRaceQueue, &ulValue, 0 ) == pdPASS );
+    testCHECK( xQueueReceive( xRaceQueue, &ulValue, 0 ) == pdPASS );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDriverTask( void * pvParameters )
+{
+    uint32_t ulValue, ul;
+    int i;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < coroQUEUE_ITEMS; ul++ )
+    {
+        ( void ) xQueueSend( xToCoroutine, &ul, portMAX_DELAY );
+
+        if( ( ul % 17U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    for( ul = 0; ul < coroQUEUE_ITEMS; ul++ )
+    {
+        testCHECK( xQueueReceive( xFromCoroutine, &ulValue, 1000 ) == pdPASS );
+        testCHECK( ulValue == ul );
+    }
+
+    for( ul = 0; ul < coroSEMAPHORE_GIVES; ul++ )
+    {
+        ( void ) xSemaphoreGive( xSemaphore );
+
+        if( ( ul % 5U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    for( ul = 0; ul < coroEVENT_ROUNDS; ul++ )
+    {
+        ( void ) xEventGroupSetBits( xEventGroup, 0x01 );
+        vTaskDelay( 1 );
+        ( void ) xEventGroupSetBits( xEventGroup, 0x02 );
+        vTaskDelay( 1 );
+    }
+
+    for( ul = 0; ul < coroNOTIFICATIONS; ul++ )
+    {
+        ( void ) xAsyncNotifyGive( &xNotificationCoroutine );
+
+        if( ( ul % 7U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    for( ul = 0; ul < ( coroMANY * coroMANY_ITEMS_EACH ); ul++ )
+    {
+        ( void ) xQueueSend( xSharedQueue, &ul, portMAX_DELAY );
+
+        if( ( ul % 13U ) == 0U )
+        {
+            vTaskDelay( 2 );
+        }
+    }
+
+    /* Give the last coroutines time to finish. */
+    vTaskDelay( 200 );
+
+    testCHECK( ulQueueItemsReceived == coroQUEUE_ITEMS );
+    testCHECK( ulQueueOrderErrors == 0U );
+    testCHECK( ulQueueItemsSent == coroQUEUE_ITEMS );
+    testCHECK( ulSemaphoresTaken == coroSEMAPHORE_GIVES );
+    testCHECK( xStreamBytesReceived == coroSTREAM_BYTES );
+    testCHECK( ulStreamErrors == 0U );
+    testCHECK( ulEventRounds == coroEVENT_ROUNDS );
+    testCHECK( ulEventErrors == 0U );
+    testCHECK( ulNotificationsTaken == coroNOTIFICATIONS );
+    testCHECK( ( xDelayTicks >= coroDELAY_TICKS ) && ( xDelayTicks <= ( coroDELAY_TICKS + coroTICKS_LATE ) ) );
+    testCHECK( xTimeoutResult == errQUEUE_EMPTY );
+    testCHECK( ( xTimeoutTicks >= coroTIMEOUT_TICKS ) && ( xTimeoutTicks <= ( coroTIMEOUT_TICKS + coroTICKS_LATE ) ) );
+    testCHECK( xRaceResult == errQUEUE_EMPTY );
+    testCHECK( ( xRaceTicks >= coroRACE_TIMEOUT_TICKS ) && ( xRaceTicks <= ( coroRACE_TIMEOUT_TICKS + coroTICKS_LATE ) ) );
+    testCHECK( ulSharedItemsReceived == ( coroMANY * coroMANY_ITEMS_EACH ) );
+
+    /* A coroutine that has returned is no longer run by the executor. */
+    for( i = 0; i < coroMANY; i++ )
+    {
+        testCHECK( xManyCoroutines[ i ].pxExecutor == NULL );
+    }
+
+    ( void ) printf( "delay %lu ticks, timeout %lu ticks, lost race timeout %lu ticks, %lu shared queue timeouts\n",
+                     ( unsigned long ) xDelayTicks, ( unsigned long ) xTimeoutTicks,
+                     ( unsigned long ) xRaceTicks, ( unsigned long ) ulSharedTimeouts );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    int i;
+
+    xToCoroutine = xQueueCreate( 2, sizeof( uint32_t ) );
+    xFromCoroutine = xQueueCreate( 3, sizeof( uint32_t ) );
+    xEmptyQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xRaceQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xSharedQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    xSemaphore = xSemaphoreCreateCounting( coroSEMAPHORE_GIVES, 0 );
+    xStreamBuffer = xStreamBufferCreate( 100, 1 );
+    xEventGroup = xEventGroupCreate();
+
+    vAsyncExecutorInitialise( &xExecutor );
+    vAsyncCoroutineStart( &xExecutor, &xQueueReceiverCoroutine, prvQueueReceiver, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xQueueSenderCoroutine, prvQueueSender, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xSemaphoreCoroutine, prvSemaphoreTaker, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xStreamSenderCoroutine, prvStreamSender, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xStreamReceiverCoroutine, prvStreamReceiver, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xEventBitsCoroutine, prvEventBitsWaiter, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xNotificationCoroutine, prvNotificationTaker, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xTimeoutCoroutine, prvTimeouts, NULL );
+    vAsyncCoroutineStart( &xExecutor, &xRaceCoroutine, prvRaceLoser, NULL );
+
+    for( i = 0; i < coroMANY; i++ )
+    {
+        ulItemsLeft[ i ] = coroMANY_ITEMS_EACH;
+        vAsyncCoroutineStart( &xExecutor, &( xManyCoroutines[ i ] ), prvSharedQueueReceiver, &( ulItemsLeft[ i ] ) );
+    }
+
+    ( void ) xTaskCreate( prvHostTask, "host", coroSTACK_SIZE, NULL, coroHOST_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvDriverTask, "driver", coroSTACK_SIZE, NULL, coroDRIVER_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvRaceTask, "race", coroSTACK_SIZE, NULL, coroRACE_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,400 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the earliest deadline first scheduling enabled by
+ * configUSE_EDF_SCHEDULING.  A control task above configEDF_TASK_PRIORITY
+ * runs four checks in turn:
+ *
+ * 1. Two periodic tasks that need 20 of every 50 ticks and 36 of every 70
+ *    ticks run for several periods.  Together they use 91% of the processor,
+ *    which is schedulable by deadline but not by rate monotonic priorities, so
+ *    the kernel must count no deadline misses.
+ * 2. The control task wakes worker tasks, changes their deadlines, and deletes
+ *    and recreates them at random.  Each worker checks that no ready task at
+ *    configEDF_TASK_PRIORITY has an earlier deadline than its own whenever it
+ *    runs.
+ * 3. A task that blocks on a queue after its deadline must have each of its
+ *    jobs counted as a miss.
+ * 4. A task without a deadline holds a mutex that a task with an early
+ *    deadline blocks on, while a task with a later deadline computes.  The
+ *    holder must inherit the early deadline so the waiter gets the mutex long
+ *    before the computing task finishes.
+ *
+ * Built with configEDF_TASK_PRIORITY below configMAX_PRIORITIES - 1 so the
+ * control task can preempt the deadline scheduled tasks.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#if ( configEDF_TASK_PRIORITY >= ( configMAX_PRIORITIES - 1 ) )
+    #error This test needs a priority above configEDF_TASK_PRIORITY for its control task.
+#endif
+
+#define edfCONTROL_PRIORITY         ( configEDF_TASK_PRIORITY + 1 )
+#define edfSTACK_SIZE               ( configMINIMAL_STACK_SIZE * 2 )
+
+/* Check 1 runs for two hyperperiods of the periodic tasks. */
+#define edfPERIODIC_RUN_TICKS       ( ( TickType_t ) 700 )
+
+/* Check 2. */
+#define edfNUM_WORKERS              24
+#define edfNUM_OPERATIONS           3000
+#define edfMAX_WORKER_DEADLINE      50
+
+/* Check 3. */
+#define edfSPORADIC_DEADLINE        ( ( TickType_t ) 3 )
+#define edfSPORADIC_WORK_TICKS      ( ( TickType_t ) 6 )
+#define edfSPORADIC_JOBS            3
+
+/* Check 4.  The waiter's deadline is earlier than the computing task's, which
+ * computes for far longer than the holder holds the mutex. */
+#define edfHOLDER_WORK_TICKS        ( ( TickType_t ) 20 )
+#define edfCOMPUTE_WORK_TICKS       ( ( TickType_t ) 300 )
+#define edfWAITER_DEADLINE          ( ( TickType_t ) 100 )
+#define edfCOMPUTE_DEADLINE         ( ( TickType_t ) 200 )
+#define edfMAX_WAIT_TICKS           ( ( TickType_t ) 100 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct PeriodicJob
+{
+    TickType_t xComputeTicks;
+    TickType_t xPeriod;
+    volatile uint32_t ulJobs;
+} PeriodicJob_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvComputeFor( TickType_t xTicks );
+static void prvPeriodicTask( void * pvParameters );
+static void prvCheckEarliestDeadline( void );
+static void prvWorkerTask( void * pvParameters );
+static void prvSporadicTask( void * pvParameters );
+static void prvHolderTask( void * pvParameters );
+static void prvComputeTask( void * pvParameters );
+static void prvWaiterTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static PeriodicJob_t xPeriodicJobs[ 2 ] =
+{
+    { 20, 50, 0 },
+    { 36, 70, 0 }
+};
+
+static TaskHandle_t xWorkers[ edfNUM_WORKERS ];
+static TaskStatus_t xStatus[ edfNUM_WORKERS + 8 ];
+static volatile uint32_t ulWorkerRuns = 0;
+static volatile uint32_t ulOrderErrors = 0;
+static QueueHandle_t xQueue = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static TaskHandle_t xControlTask = NULL;
+static volatile TickType_t xWaitTicks = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvComputeFor( TickType_t xTicks )
+{
+    TickType_t xCounted = 0, xLast = xTaskGetTickCount(), xNow;
+
+    /* Count the ticks seen while running, so time spent preempted is not
+     * counted as computing. */
+    while( xCounted < xTicks )
+    {
+        xNow = xTaskGetTickCount();
+
+        if( xNow != xLast )
+        {
+            xCounted++;
+            xLast = xNow;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void * pvParameters )
+{
+    PeriodicJob_t * const pxJob = ( PeriodicJob_t * ) pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    for( ;; )
+    {
+        prvComputeFor( pxJob->xComputeTicks );
+        pxJob->ulJobs++;
+        ( void ) xTaskDelayUntil( &xLastWakeTime, pxJob->xPeriod );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckEarliestDeadline( void )
+{
+    TaskStatus_t xMe;
+    UBaseType_t uxReported, ux;
+
+    vTaskSuspendAll();
+    {
+        vTaskGetInfo( NULL, &xMe, pdFALSE, eInvalid );
+
+        /* The deadline only orders the task while it has one. */
+        if( xMe.xRelativeDeadline != 0U )
+        {
+            uxReported = uxTaskGetSystemState( xStatus, edfNUM_WORKERS + 8, NULL );
+            testCHECK( uxReported != 0U );
+
+            for( ux = 0; ux < uxReported; ux++ )
+            {
+                if( ( xStatus[ ux ].eCurrentState == eReady ) &&
+                    ( xStatus[ ux ].uxCurrentPriority == configEDF_TASK_PRIORITY ) &&
+                    ( xStatus[ ux ].xRelativeDeadline != 0U ) &&
+                    ( ( int64_t ) ( xStatus[ ux ].xDeadline - xMe.xDeadline ) < 0 ) )
+                {
+                    ulOrderErrors++;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        prvCheckEarliestDeadline();
+        ulWorkerRuns++;
+        taskYIELD();
+        prvCheckEarliestDeadline();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSporadicTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        ( void ) xQueueReceive( xQueue, &ulValue, portMAX_DELAY );
+
+        /* Start a job that runs past its deadline before blocking again. */
+        vTaskSetDeadline( NULL, edfSPORADIC_DEADLINE );
+        prvComputeFor( edfSPORADIC_WORK_TICKS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHolderTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+    prvComputeFor( edfHOLDER_WORK_TICKS );
+    ( void ) xSemaphoreGive( xMutex );
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvComputeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vTaskDelay( 2 );
+    prvComputeFor( edfCOMPUTE_WORK_TICKS );
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+    TickType_t xStart;
+
+    ( void ) pvParameters;
+
+    vTaskDelay( 5 );
+    xStart = xTaskGetTickCount();
+    testCHECK( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+    xWaitTicks = xTaskGetTickCount() - xStart;
+    ( void ) xSemaphoreGive( xMutex );
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    TaskHandle_t xPeriodicTasks[ 2 ], xSporadic, xHolder, xCompute, xWaiter;
+    TaskStatus_t xInfo;
+    uint32_t ulPeriodicMisses = 0, ulValue = 0;
+    int i, iOperation;
+
+    ( void ) pvParameters;
+
+    /* 1. Periodic tasks. */
+    for( i = 0; i < 2; i++ )
+    {
+        ( void ) xTaskCreateDeadline( prvPeriodicTask, "periodic", edfSTACK_SIZE, &( xPeriodicJobs[ i ] ),
+                                      xPeriodicJobs[ i ].xPeriod, &( xPeriodicTasks[ i ] ) );
+    }
+
+    vTaskDelay( edfPERIODIC_RUN_TICKS );
+
+    for( i = 0; i < 2; i++ )
+    {
+        vTaskGetInfo( xPeriodicTasks[ i ], &xInfo, pdFALSE, eInvalid );
+        ulPeriodicMisses += ( uint32_t ) xInfo.uxDeadlineMisses;
+        testCHECK( xPeriodicJobs[ i ].ulJobs >= ( uint32_t ) ( ( edfPERIODIC_RUN_TICKS / xPeriodicJobs[ i ].xPeriod ) - 1U ) );
+        vTaskDelete( xPeriodicTasks[ i ] );
+    }
+
+    testCHECK( ulPeriodicMisses == 0U );
+
+    /* 2. Random wakes, deadline changes, deletes and creates. */
+    for( i = 0; i < edfNUM_WORKERS; i++ )
+    {
+        ( void ) xTaskCreateDeadline( prvWorkerTask, "worker", edfSTACK_SIZE, NULL,
+                                      ( TickType_t ) ( 1 + ( i * 3 ) ), &( xWorkers[ i ] ) );
+    }
+
+    srand( 7 );
+
+    for( i = 0; i < edfNUM_OPERATIONS; i++ )
+    {
+        const int iWorker = rand() % edfNUM_WORKERS;
+
+        iOperation = rand() % 6;
+
+        switch( iOperation )
+        {
+            case 0:
+            case 1:
+            case 2:
+                xTaskNotifyGive( xWorkers[ iWorker ] );
+                break;
+
+            case 3:
+
+                /* Sometimes remove the deadline altogether. */
+                vTaskSetDeadline( xWorkers[ iWorker ],
+                                  ( ( rand() % 4 ) == 0 ) ? 0U : ( TickType_t ) ( 1 + ( rand() % edfMAX_WORKER_DEADLINE ) ) );
+                break;
+
+            case 4:
+                vTaskDelete( xWorkers[ iWorker ] );
+                ( void ) xTaskCreateDeadline( prvWorkerTask, "worker", edfSTACK_SIZE, NULL,
+                                              ( TickType_t ) ( 1 + ( rand() % edfMAX_WORKER_DEADLINE ) ),
+                                              &( xWorkers[ iWorker ] ) );
+                break;
+
+            default:
+                vTaskDelay( 1 );
+                break;
+        }
+    }
+
+    /* Let the last woken workers run. */
+    vTaskDelay( 10 );
+
+    for( i = 0; i < edfNUM_WORKERS; i++ )
+    {
+        vTaskDelete( xWorkers[ i ] );
+    }
+
+    testCHECK( ulOrderErrors == 0U );
+    /* The workers only run while the control task is delayed, and a worker
+     * notified more than once in that time runs once. */
+    testCHECK( ulWorkerRuns > ( edfNUM_OPERATIONS / 6 ) );
+
+    /* 3. Jobs that block after their deadline. */
+    xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+    ( void ) xTaskCreateDeadline( prvSporadicTask, "sporadic", edfSTACK_SIZE, NULL, 100, &xSporadic );
+    vTaskDelay( 2 );
+
+    for( i = 0; i < edfSPORADIC_JOBS; i++ )
+    {
+        ( void ) xQueueSend( xQueue, &ulValue, 0 );
+        vTaskDelay( edfSPORADIC_WORK_TICKS * 3U );
+    }
+
+    vTaskGetInfo( xSporadic, &xInfo, pdFALSE, eInvalid );
+    testCHECK( xInfo.uxDeadlineMisses == edfSPORADIC_JOBS );
+    vTaskDelete( xSporadic );
+
+    /* 4. Deadline inheritance. */
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( xMutex != NULL );
+    ( void ) xTaskCreate( prvHolderTask, "holder", edfSTACK_SIZE, NULL, configEDF_TASK_PRIORITY, &xHolder );
+    ( void ) xTaskCreateDeadline( prvComputeTask, "compute", edfSTACK_SIZE, NULL, edfCOMPUTE_DEADLINE, &xCompute );
+    ( void ) xTaskCreateDeadline( prvWaiterTask, "waiter", edfSTACK_SIZE, NULL, edfWAITER_DEADLINE, &xWaiter );
+
+    testCHECK( ulTaskNotifyTake( pdTRUE, edfCOMPUTE_WORK_TICKS * 2U ) == 1U );
+    testCHECK( xWaitTicks < edfMAX_WAIT_TICKS );
+
+    ( void ) printf( "edf: %lu periodic deadline misses, %lu worker runs, %lu order errors, "
+                     "%lu sporadic misses, waited %lu ticks for the mutex\n",
+                     ( unsigned long ) ulPeriodicMisses, ( unsigned long ) ulWorkerRuns,
+                     ( unsigned long ) ulOrderErrors, ( unsigned long ) xInfo.uxDeadlineMisses,
+                     ( unsigned long ) xWaitTicks );
+
+    ( void ) xHolder;
+    ( void ) xCompute;
+    ( void ) xWaiter;
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "control", edfSTACK_SIZE * 2, NULL, edfCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,179 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of a task blocking on a queue that many tasks are already
+ * waiting on, with and without configUSE_EVENT_LIST_BUCKETS.  The scheduler is
+ * not started.  Instead the program includes tasks.c and drives an event list
+ * directly.  Tasks at random priorities are placed on the list.  Then, over
+ * and over, a random task is removed from the list, as when it receives an
+ * item, times out or is deleted, and placed back on it, as when it blocks on
+ * the queue again.  The list is checked to still be in priority order at the
+ * end.
+ *
+ * Usage: event_list_benchmark [waiting tasks] [cycles]
+ * Prints the time taken by one remove and place cycle.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The kernel, so its event lists can be used directly. */
+#include "tasks.c"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_TASKS     64
+#define benchmarkDEFAULT_CYCLES    2000000UL
+
+/*-----------------------------------------------------------*/
+
+static void prvIdleWorkTask( void * pvParameters );
+static void prvPlaceOnEventList( TCB_t * pxTCB );
+static void prvRemoveFromEventList( TCB_t * pxTCB );
+
+/*-----------------------------------------------------------*/
+
+static List_t xEventList;
+
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    static EventListBuckets_t xBuckets;
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvIdleWorkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceOnEventList( TCB_t * pxTCB )
+{
+    #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    {
+        prvInsertIntoBucketedEventList( pxTCB, &xEventList, &xBuckets );
+    }
+    #else
+    {
+        vListInsert( &xEventList, &( pxTCB->xEventListItem ) );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFromEventList( TCB_t * pxTCB )
+{
+    taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
+    ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int iTasks = benchmarkDEFAULT_TASKS;
+    unsigned long ulCycles = benchmarkDEFAULT_CYCLES;
+    unsigned long ulCycle;
+    TaskHandle_t xTask = NULL;
+    TCB_t ** ppxTasks;
+    int * piOrder;
+    const ListItem_t * pxItem;
+    const TCB_t * pxTCB;
+    UBaseType_t uxPreviousPriority = ( UBaseType_t ) configMAX_PRIORITIES;
+    uint64_t ullStart, ullElapsed;
+    int i;
+
+    if( argc > 1 )
+    {
+        iTasks = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        ulCycles = strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    configASSERT( ( iTasks > 0 ) && ( ulCycles > 0UL ) );
+
+    ppxTasks = malloc( sizeof( TCB_t * ) * ( size_t ) iTasks );
+    piOrder = malloc( sizeof( int ) * ( size_t ) ulCycles );
+    configASSERT( ( ppxTasks != NULL ) && ( piOrder != NULL ) );
+
+    srand( 1 );
+    vListInitialise( &xEventList );
+
+    for( i = 0; i < iTasks; i++ )
+    {
+        ( void ) xTaskCreate( prvIdleWorkTask, "waiter", configMINIMAL_STACK_SIZE, NULL,
+                              ( UBaseType_t ) ( 1 + ( rand() % ( configMAX_PRIORITIES - 1 ) ) ), &xTask );
+        configASSERT( xTask );
+        ppxTasks[ i ] = xTask;
+        prvPlaceOnEventList( ppxTasks[ i ] );
+    }
+
+    /* Choose the tasks beforehand so rand() is not timed. */
+    for( ulCycle = 0UL; ulCycle < ulCycles; ulCycle++ )
+    {
+        piOrder[ ulCycle ] = rand() % iTasks;
+    }
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ulCycle = 0UL; ulCycle < ulCycles; ulCycle++ )
+    {
+        prvRemoveFromEventList( ppxTasks[ piOrder[ ulCycle ] ] );
+        prvPlaceOnEventList( ppxTasks[ piOrder[ ulCycle ] ] );
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+
+    testCHECK( listCURRENT_LIST_LENGTH( &xEventList ) == ( UBaseType_t ) iTasks );
+
+    for( pxItem = listGET_HEAD_ENTRY( &xEventList ); pxItem != listGET_END_MARKER( &xEventList ); pxItem = listGET_NEXT( pxItem ) )
+    {
+        pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+        testCHECK( pxTCB->uxPriority <= uxPreviousPriority );
+        uxPreviousPriority = pxTCB->uxPriority;
+    }
+
+    ( void ) printf( "event list buckets %d, %d priorities, %d waiting tasks: %.1f ns per remove and place\n",
+                     configUSE_EVENT_LIST_BUCKETS, configMAX_PRIORITIES, iTasks,
+                     ( double ) ullElapsed / ( double ) ulCycles );
+
+    free( piOrder );
+    free( ppxTasks );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
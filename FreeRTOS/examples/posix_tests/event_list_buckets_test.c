@@ -0,0 +1,254 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the order in which tasks blocked on a queue are woken, with and
+ * without configUSE_EVENT_LIST_BUCKETS.  60 worker tasks at random priorities
+ * block to receive from one queue.  A control task at the highest priority
+ * repeatedly:
+ *
+ * 1. Sends a burst of items, one at a time, and checks that they were received
+ *    in priority order, and in the order the tasks blocked within a priority.
+ * 2. Suspends, resumes, aborts the delay of, and deletes and recreates workers
+ *    at random, interleaved with more sends, so tasks leave the middle of the
+ *    list of waiting tasks and not just its head.  Then resumes every worker
+ *    and aborts every wait so each worker blocks again.
+ *
+ * Built with time slicing off so a woken worker blocks again before a worker
+ * at the same priority can run.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define eventNUM_WORKERS          60
+#define eventNUM_ROUNDS           200
+#define eventMAX_BURST            20
+#define eventCHANGES_PER_ROUND    20
+#define eventMAX_ITEM             4096
+#define eventQUEUE_LENGTH         64
+#define eventWORKER_PRIORITY()    ( ( UBaseType_t ) ( 1 + ( rand() % ( configMAX_PRIORITIES - 2 ) ) ) )
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters );
+static void prvWaitForWorkersToBlock( void );
+static void prvCheckBurst( int iFirstItem,
+                           int iEndItem );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xWorkers[ eventNUM_WORKERS ];
+static QueueHandle_t xQueue = NULL;
+
+/* The worker that received each item, and the order in which that worker
+ * blocked to receive it. */
+static volatile int iReceivedBy[ eventMAX_ITEM ];
+static volatile uint32_t ulBlockedOrder[ eventMAX_ITEM ];
+static volatile uint32_t ulNextBlockedOrder = 0;
+static volatile uint32_t ulItemsReceived = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    const int iWorker = ( int ) ( intptr_t ) pvParameters;
+    uint32_t ulOrder;
+    int iItem;
+
+    for( ; ; )
+    {
+        ulOrder = ulNextBlockedOrder++;
+
+        /* Fails when the control task aborts the wait. */
+        if( xQueueReceive( xQueue, &iItem, portMAX_DELAY ) == pdPASS )
+        {
+            iReceivedBy[ iItem ] = iWorker;
+            ulBlockedOrder[ iItem ] = ulOrder;
+            ulItemsReceived++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForWorkersToBlock( void )
+{
+    int iWorker = 0;
+
+    while( iWorker < eventNUM_WORKERS )
+    {
+        if( eTaskGetState( xWorkers[ iWorker ] ) == eBlocked )
+        {
+            iWorker++;
+        }
+        else
+        {
+            vTaskDelay( 1 );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckBurst( int iFirstItem,
+                           int iEndItem )
+{
+    UBaseType_t uxPrevious, uxThis;
+    int iItem;
+
+    for( iItem = iFirstItem + 1; iItem < iEndItem; iItem++ )
+    {
+        uxPrevious = uxTaskPriorityGet( xWorkers[ iReceivedBy[ iItem - 1 ] ] );
+        uxThis = uxTaskPriorityGet( xWorkers[ iReceivedBy[ iItem ] ] );
+
+        testCHECK( uxPrevious >= uxThis );
+
+        if( uxPrevious == uxThis )
+        {
+            testCHECK( ulBlockedOrder[ iItem - 1 ] < ulBlockedOrder[ iItem ] );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    int iRound, iChange, iWorker, iBurst, iFirstItem, iItem = 0;
+
+    ( void ) pvParameters;
+
+    srand( 7 );
+
+    xQueue = xQueueCreate( eventQUEUE_LENGTH, sizeof( int ) );
+    configASSERT( xQueue );
+
+    for( iWorker = 0; iWorker < eventNUM_WORKERS; iWorker++ )
+    {
+        ( void ) xTaskCreate( prvWorkerTask, "worker", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) iWorker,
+                              eventWORKER_PRIORITY(), &( xWorkers[ iWorker ] ) );
+    }
+
+    for( iRound = 0; iRound < eventNUM_ROUNDS; iRound++ )
+    {
+        prvWaitForWorkersToBlock();
+
+        /* 1. Each item goes to the highest priority task that has waited
+         * longest.  The worker that receives an item must block again before
+         * the next is sent, or it could take the next item from the queue
+         * ahead of the task that the send woke. */
+        iFirstItem = iItem;
+        iBurst = 1 + ( rand() % eventMAX_BURST );
+
+        while( iBurst-- > 0 )
+        {
+            testCHECK( xQueueSend( xQueue, &iItem, 0 ) == pdPASS );
+            iItem++;
+            prvWaitForWorkersToBlock();
+        }
+
+        prvCheckBurst( iFirstItem, iItem );
+
+        /* 2. Tasks leave the list of waiting tasks from anywhere in it. */
+        for( iChange = 0; iChange < eventCHANGES_PER_ROUND; iChange++ )
+        {
+            iWorker = rand() % eventNUM_WORKERS;
+
+            switch( rand() % 5 )
+            {
+                case 0:
+                    vTaskSuspend( xWorkers[ iWorker ] );
+                    break;
+
+                case 1:
+                    vTaskResume( xWorkers[ iWorker ] );
+                    break;
+
+                case 2:
+                    ( void ) xTaskAbortDelay( xWorkers[ iWorker ] );
+                    break;
+
+                case 3:
+                    vTaskDelete( xWorkers[ iWorker ] );
+                    ( void ) xTaskCreate( prvWorkerTask, "worker", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) iWorker,
+                                          eventWORKER_PRIORITY(), &( xWorkers[ iWorker ] ) );
+                    break;
+
+                default:
+                    ( void ) xQueueSend( xQueue, &iItem, 0 );
+                    iItem++;
+                    break;
+            }
+        }
+
+        for( iWorker = 0; iWorker < eventNUM_WORKERS; iWorker++ )
+        {
+            vTaskResume( xWorkers[ iWorker ] );
+        }
+
+        /* A resumed worker blocks again inside xQueueReceive() without
+         * taking a new place in the order, so once every worker is blocked
+         * again, make each return from xQueueReceive() and take a new one. */
+        prvWaitForWorkersToBlock();
+
+        for( iWorker = 0; iWorker < eventNUM_WORKERS; iWorker++ )
+        {
+            ( void ) xTaskAbortDelay( xWorkers[ iWorker ] );
+        }
+
+        /* Leave room for the largest possible round. */
+        if( iItem > ( eventMAX_ITEM - eventMAX_BURST - eventCHANGES_PER_ROUND ) )
+        {
+            iItem = 0;
+        }
+    }
+
+    ( void ) printf( "event list buckets %d, %d priorities: %d rounds, %lu items received\n",
+                     configUSE_EVENT_LIST_BUCKETS, configMAX_PRIORITIES, iRound,
+                     ( unsigned long ) ulItemsReceived );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 2, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
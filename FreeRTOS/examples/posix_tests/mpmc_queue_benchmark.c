@@ -0,0 +1,274 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the throughput of one queue shared by several producers and
+ * consumers on an SMP build, for an MPMC queue created by xMpmcQueueCreate()
+ * and for a queue created by xQueueCreate().  Every producer and consumer runs
+ * on its own core and polls with a block time of 0, so the MPMC queue never
+ * enters the kernel critical section, while every xQueueSend() and
+ * xQueueReceive() does.
+ *
+ * Usage: mpmc_queue_benchmark [producers] [consumers] [items per producer] [queue]
+ *
+ * With "queue" the program uses a queue created by xQueueCreate().  Each
+ * consumer checks that it sees the items from any one producer in order, and
+ * the sum of all the items received is checked at the end, so the program
+ * also serves as a test when run with few items.
+ */
+
+/* Standard includes. */
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "mpmc_queue.h"
+
+#include "test_support.h"
+
+#define benchmarkQUEUE_LENGTH       16
+#define benchmarkTASK_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+#define benchmarkDEFAULT_ITEMS      200000UL
+#define benchmarkPRODUCER_SHIFT     24
+#define benchmarkSEQUENCE_MASK      0xFFFFFFUL
+#define benchmarkNONE_SEEN          0xFFFFFFFFUL
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSend( const uint32_t * pulValue );
+static BaseType_t prvReceive( uint32_t * pulValue );
+static void prvSuspend( void );
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static MpmcQueueHandle_t xMpmcQueue = NULL;
+static QueueHandle_t xQueue = NULL;
+static int iProducers = 2;
+static int iConsumers = 2;
+static uint32_t ulItems = benchmarkDEFAULT_ITEMS;
+static uint64_t ullStartTimeNs = 0;
+static uint32_t ulItemsReceived = 0;
+static uint64_t ullSequenceSum = 0;
+static uint32_t ulOutOfOrder = 0;
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSend( const uint32_t * pulValue )
+{
+    BaseType_t xReturn;
+
+    if( xMpmcQueue != NULL )
+    {
+        xReturn = xMpmcQueueSend( xMpmcQueue, pulValue, 0 );
+    }
+    else
+    {
+        xReturn = xQueueSend( xQueue, pulValue, 0 );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReceive( uint32_t * pulValue )
+{
+    BaseType_t xReturn;
+
+    if( xMpmcQueue != NULL )
+    {
+        xReturn = xMpmcQueueReceive( xMpmcQueue, pulValue, 0 );
+    }
+    else
+    {
+        xReturn = xQueueReceive( xQueue, pulValue, 0 );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspend( void )
+{
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    const uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+    uint64_t ullExpected = 0;
+    uint32_t ulSequence, ulValue;
+
+    /* The clock starts when the first task runs. */
+    ( void ) __atomic_compare_exchange_n( &ullStartTimeNs, &ullExpected, ullTestGetTimeNs(), pdFALSE,
+                                          __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+
+    for( ulSequence = 0; ulSequence < ulItems; ulSequence++ )
+    {
+        ulValue = ( ulProducer << benchmarkPRODUCER_SHIFT ) | ulSequence;
+
+        while( prvSend( &ulValue ) != pdPASS )
+        {
+            /* Give the host processor to the threads running the consumers,
+             * in case the host has fewer processors than there are cores. */
+            ( void ) sched_yield();
+        }
+    }
+
+    prvSuspend();
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    const uint32_t ulTotal = ulItems * ( uint32_t ) iProducers;
+    const uint64_t ullExpectedSum = ( uint64_t ) iProducers * ( ( ( uint64_t ) ulItems * ( ulItems - 1U ) ) / 2U );
+    uint32_t ulLastSeen[ configNUMBER_OF_CORES ];
+    uint32_t ulValue, ulProducer, ulSequence;
+    uint64_t ullElapsedNs;
+    int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < iProducers; i++ )
+    {
+        ulLastSeen[ i ] = benchmarkNONE_SEEN;
+    }
+
+    while( __atomic_load_n( &ulItemsReceived, __ATOMIC_SEQ_CST ) < ulTotal )
+    {
+        if( prvReceive( &ulValue ) != pdPASS )
+        {
+            ( void ) sched_yield();
+            continue;
+        }
+
+        ulProducer = ulValue >> benchmarkPRODUCER_SHIFT;
+        ulSequence = ulValue & benchmarkSEQUENCE_MASK;
+
+        if( ( ulProducer >= ( uint32_t ) iProducers ) ||
+            ( ( ulLastSeen[ ulProducer ] != benchmarkNONE_SEEN ) && ( ulSequence <= ulLastSeen[ ulProducer ] ) ) )
+        {
+            ( void ) __atomic_add_fetch( &ulOutOfOrder, 1, __ATOMIC_SEQ_CST );
+        }
+        else
+        {
+            ulLastSeen[ ulProducer ] = ulSequence;
+        }
+
+        ( void ) __atomic_add_fetch( &ullSequenceSum, ulSequence, __ATOMIC_SEQ_CST );
+
+        /* The consumer that receives the last item reports. */
+        if( __atomic_add_fetch( &ulItemsReceived, 1, __ATOMIC_SEQ_CST ) == ulTotal )
+        {
+            ullElapsedNs = ullTestGetTimeNs() - __atomic_load_n( &ullStartTimeNs, __ATOMIC_SEQ_CST );
+
+            testCHECK( __atomic_load_n( &ulOutOfOrder, __ATOMIC_SEQ_CST ) == 0U );
+            testCHECK( __atomic_load_n( &ullSequenceSum, __ATOMIC_SEQ_CST ) == ullExpectedSum );
+
+            ( void ) printf( "%s: %d cores, %d producers, %d consumers, %lu items per producer, "
+                             "%.1f ns per item, %.2f million items per second\n",
+                             ( xMpmcQueue != NULL ) ? "mpmc queue" : "queue",
+                             configNUMBER_OF_CORES, iProducers, iConsumers, ( unsigned long ) ulItems,
+                             ( double ) ullElapsedNs / ( double ) ulTotal,
+                             ( ( double ) ulTotal * 1000.0 ) / ( double ) ullElapsedNs );
+            vTestFinish();
+        }
+    }
+
+    prvSuspend();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    uintptr_t ux;
+
+    if( argc > 1 )
+    {
+        iProducers = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        iConsumers = atoi( argv[ 2 ] );
+    }
+
+    if( argc > 3 )
+    {
+        ulItems = ( uint32_t ) strtoul( argv[ 3 ], NULL, 10 );
+    }
+
+    if( ( iProducers < 1 ) || ( iConsumers < 1 ) || ( ( iProducers + iConsumers ) > configNUMBER_OF_CORES ) ||
+        ( ulItems < 1U ) || ( ulItems > benchmarkSEQUENCE_MASK ) )
+    {
+        ( void ) printf( "producers and consumers must be at least 1 and together no more than %d, "
+                         "and items from 1 to %lu\n", configNUMBER_OF_CORES, ( unsigned long ) benchmarkSEQUENCE_MASK );
+        return 1;
+    }
+
+    if( ( argc > 4 ) && ( strcmp( argv[ 4 ], "queue" ) == 0 ) )
+    {
+        xQueue = xQueueCreate( benchmarkQUEUE_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xQueue != NULL );
+    }
+    else
+    {
+        xMpmcQueue = xMpmcQueueCreate( benchmarkQUEUE_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xMpmcQueue != NULL );
+    }
+
+    for( ux = 0; ux < ( uintptr_t ) iProducers; ux++ )
+    {
+        ( void ) xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, ( void * ) ux,
+                              benchmarkTASK_PRIORITY, NULL );
+    }
+
+    for( ux = 0; ux < ( uintptr_t ) iConsumers; ux++ )
+    {
+        ( void ) xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE * 2, ( void * ) ux,
+                              benchmarkTASK_PRIORITY, NULL );
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,307 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the multiple producer, multiple consumer queues enabled by
+ * configUSE_MPMC_QUEUES.  A control task runs the following checks in turn:
+ *
+ * 1. A queue fills, refuses a send when full, and empties in order.  A send to
+ *    a full queue and a receive from an empty one with a timeout block for that
+ *    timeout.  Items sent from an interrupt wrap around the storage many times.
+ * 2. A statically allocated queue passes 7 byte items intact.
+ * 3. Four producers at different priorities each send 20000 numbered items to
+ *    one queue, blocking when it is full, while three consumers receive them,
+ *    blocking when it is empty.  Every item must arrive exactly once, and each
+ *    consumer must see the items from any one producer in order.
+ * 4. A timer callback, standing in for an interrupt, sends 3000 items with
+ *    xMpmcQueueSendFromISR(), which must arrive in order.
+ *
+ * Built for the SMP port too, where the producers and consumers of check 3 run
+ * on different cores at the same time.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "mpmc_queue.h"
+
+#include "test_support.h"
+
+#define mpmcCONTROL_PRIORITY     ( tskIDLE_PRIORITY + 4 )
+#define mpmcSTACK_SIZE           ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Check 1. */
+#define mpmcSHORT_LENGTH         4U
+#define mpmcTIMEOUT_TICKS        ( ( TickType_t ) 20 )
+#define mpmcTICKS_LATE           ( ( TickType_t ) 2 )
+#define mpmcWRAP_ITEMS           1000U
+
+/* Checks 3 and 4.  Each item holds the number of its producer in the top byte
+ * and its sequence number in the rest. */
+#define mpmcPRODUCERS            4
+#define mpmcCONSUMERS            3
+#define mpmcITEMS_PER_PRODUCER   20000U
+#define mpmcSTRESS_LENGTH        8U
+#define mpmcPRODUCER_SHIFT       24
+#define mpmcSEQUENCE_MASK        0xFFFFFFUL
+#define mpmcNONE_SEEN            0xFFFFFFFFUL
+#define mpmcISR_ITEMS            3000U
+#define mpmcISR_LENGTH           4U
+#define mpmcISR_ITEMS_PER_TICK   3
+
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static MpmcQueueHandle_t xStressQueue = NULL;
+static MpmcQueueHandle_t xIsrQueue = NULL;
+
+static uint32_t ulProducersDone = 0;
+static uint32_t ulItemsReceived = 0;
+static uint64_t ullSequenceSum = 0;
+static uint32_t ulOutOfOrder = 0;
+
+/* Only written by the timer callback. */
+static uint32_t ulIsrItemsSent = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    const uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+    uint32_t ulSequence, ulValue;
+
+    for( ulSequence = 0; ulSequence < mpmcITEMS_PER_PRODUCER; ulSequence++ )
+    {
+        ulValue = ( ulProducer << mpmcPRODUCER_SHIFT ) | ulSequence;
+        testCHECK( xMpmcQueueSend( xStressQueue, &ulValue, portMAX_DELAY ) == pdPASS );
+
+        /* Let the lower priority producers run now and then. */
+        if( ( ulSequence % 1013U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    ( void ) __atomic_add_fetch( &ulProducersDone, 1, __ATOMIC_SEQ_CST );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    uint32_t ulLastSeen[ mpmcPRODUCERS ];
+    uint32_t ulValue, ulProducer, ulSequence;
+
+    ( void ) pvParameters;
+
+    for( ulProducer = 0; ulProducer < mpmcPRODUCERS; ulProducer++ )
+    {
+        ulLastSeen[ ulProducer ] = mpmcNONE_SEEN;
+    }
+
+    for( ; ; )
+    {
+        if( xMpmcQueueReceive( xStressQueue, &ulValue, portMAX_DELAY ) == pdPASS )
+        {
+            ulProducer = ulValue >> mpmcPRODUCER_SHIFT;
+            ulSequence = ulValue & mpmcSEQUENCE_MASK;
+
+            if( ( ulProducer >= mpmcPRODUCERS ) ||
+                ( ( ulLastSeen[ ulProducer ] != mpmcNONE_SEEN ) && ( ulSequence <= ulLastSeen[ ulProducer ] ) ) )
+            {
+                ( void ) __atomic_add_fetch( &ulOutOfOrder, 1, __ATOMIC_SEQ_CST );
+            }
+            else
+            {
+                ulLastSeen[ ulProducer ] = ulSequence;
+            }
+
+            ( void ) __atomic_add_fetch( &ullSequenceSum, ulSequence, __ATOMIC_SEQ_CST );
+            ( void ) __atomic_add_fetch( &ulItemsReceived, 1, __ATOMIC_SEQ_CST );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    int i;
+
+    ( void ) xTimer;
+
+    for( i = 0; ( i < mpmcISR_ITEMS_PER_TICK ) && ( ulIsrItemsSent < mpmcISR_ITEMS ); i++ )
+    {
+        if( xMpmcQueueSendFromISR( xIsrQueue, &ulIsrItemsSent, &xHigherPriorityTaskWoken ) == pdPASS )
+        {
+            ulIsrItemsSent++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    static StaticMpmcQueue_t xStaticQueue;
+    static uint32_t ulStaticStorage[ mpmcQUEUE_STORAGE_WORDS( 4, 7 ) ];
+    const char cSent[ 7 ] = "abcdef";
+    char cReceived[ 7 ] = { 0 };
+    const uint64_t ullExpectedSum = ( uint64_t ) mpmcPRODUCERS *
+                                    ( ( ( uint64_t ) mpmcITEMS_PER_PRODUCER * ( mpmcITEMS_PER_PRODUCER - 1U ) ) / 2U );
+    MpmcQueueHandle_t xQueue;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ul, ulValue = 0;
+    TickType_t xStart, xElapsed;
+    TimerHandle_t xTimer;
+    uintptr_t ux;
+
+    ( void ) pvParameters;
+
+    /* 1. Full, empty, timeouts and wrap around. */
+    xQueue = xMpmcQueueCreate( mpmcSHORT_LENGTH, sizeof( uint32_t ) );
+    testCHECK( xQueue != NULL );
+
+    for( ul = 0; ul < mpmcSHORT_LENGTH; ul++ )
+    {
+        testCHECK( xMpmcQueueSend( xQueue, &ul, 0 ) == pdPASS );
+    }
+
+    testCHECK( xMpmcQueueSend( xQueue, &ul, 0 ) == errQUEUE_FULL );
+    testCHECK( uxMpmcQueueMessagesWaiting( xQueue ) == mpmcSHORT_LENGTH );
+
+    xStart = xTaskGetTickCount();
+    testCHECK( xMpmcQueueSend( xQueue, &ul, mpmcTIMEOUT_TICKS ) == errQUEUE_FULL );
+    xElapsed = xTaskGetTickCount() - xStart;
+    testCHECK( ( xElapsed >= mpmcTIMEOUT_TICKS ) && ( xElapsed <= ( mpmcTIMEOUT_TICKS + mpmcTICKS_LATE ) ) );
+
+    for( ul = 0; ul < mpmcSHORT_LENGTH; ul++ )
+    {
+        testCHECK( xMpmcQueueReceiveFromISR( xQueue, &ulValue, &xHigherPriorityTaskWoken ) == pdPASS );
+        testCHECK( ulValue == ul );
+    }
+
+    testCHECK( xMpmcQueueReceive( xQueue, &ulValue, 0 ) == errQUEUE_EMPTY );
+
+    xStart = xTaskGetTickCount();
+    testCHECK( xMpmcQueueReceive( xQueue, &ulValue, mpmcTIMEOUT_TICKS ) == errQUEUE_EMPTY );
+    xElapsed = xTaskGetTickCount() - xStart;
+    testCHECK( ( xElapsed >= mpmcTIMEOUT_TICKS ) && ( xElapsed <= ( mpmcTIMEOUT_TICKS + mpmcTICKS_LATE ) ) );
+
+    for( ul = 0; ul < mpmcWRAP_ITEMS; ul++ )
+    {
+        testCHECK( xMpmcQueueSendFromISR( xQueue, &ul, &xHigherPriorityTaskWoken ) == pdPASS );
+        testCHECK( xMpmcQueueReceive( xQueue, &ulValue, 0 ) == pdPASS );
+        testCHECK( ulValue == ul );
+    }
+
+    /* No task was waiting on the queue. */
+    testCHECK( xHigherPriorityTaskWoken == pdFALSE );
+    vMpmcQueueDelete( xQueue );
+
+    /* 2. Static allocation, with an item size that is not a multiple of 4. */
+    xQueue = xMpmcQueueCreateStatic( 4, sizeof( cSent ), ulStaticStorage, &xStaticQueue );
+    testCHECK( xQueue != NULL );
+    testCHECK( xMpmcQueueSend( xQueue, cSent, 0 ) == pdPASS );
+    testCHECK( xMpmcQueueReceive( xQueue, cReceived, 0 ) == pdPASS );
+    testCHECK( memcmp( cSent, cReceived, sizeof( cSent ) ) == 0 );
+    vMpmcQueueDelete( xQueue );
+
+    /* 3. Several producers and consumers on one queue. */
+    for( ux = 0; ux < mpmcCONSUMERS; ux++ )
+    {
+        ( void ) xTaskCreate( prvConsumerTask, "consumer", mpmcSTACK_SIZE, ( void * ) ux,
+                              tskIDLE_PRIORITY + 2 + ( ux & 1U ), NULL );
+    }
+
+    for( ux = 0; ux < mpmcPRODUCERS; ux++ )
+    {
+        ( void ) xTaskCreate( prvProducerTask, "producer", mpmcSTACK_SIZE, ( void * ) ux,
+                              tskIDLE_PRIORITY + 1 + ( ux % 3U ), NULL );
+    }
+
+    while( ( __atomic_load_n( &ulProducersDone, __ATOMIC_SEQ_CST ) < mpmcPRODUCERS ) ||
+           ( uxMpmcQueueMessagesWaiting( xStressQueue ) != 0U ) )
+    {
+        vTaskDelay( 10 );
+    }
+
+    /* Let the consumers count the last items they took. */
+    vTaskDelay( 100 );
+
+    testCHECK( ulItemsReceived == ( mpmcPRODUCERS * mpmcITEMS_PER_PRODUCER ) );
+    testCHECK( ullSequenceSum == ullExpectedSum );
+    testCHECK( ulOutOfOrder == 0U );
+
+    /* 4. Sending from a timer callback. */
+    xTimer = xTimerCreate( "sender", 1, pdTRUE, NULL, prvTimerCallback );
+    testCHECK( xTimer != NULL );
+    ( void ) xTimerStart( xTimer, 0 );
+
+    for( ul = 0; ul < mpmcISR_ITEMS; ul++ )
+    {
+        if( xMpmcQueueReceive( xIsrQueue, &ulValue, 100 ) != pdPASS )
+        {
+            testCHECK( pdFALSE );
+            break;
+        }
+
+        testCHECK( ulValue == ul );
+    }
+
+    ( void ) printf( "%lu items from %d producers, %lu items from the timer\n",
+                     ( unsigned long ) ulItemsReceived, mpmcPRODUCERS, ( unsigned long ) ul );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xStressQueue = xMpmcQueueCreate( mpmcSTRESS_LENGTH, sizeof( uint32_t ) );
+    xIsrQueue = xMpmcQueueCreate( mpmcISR_LENGTH, sizeof( uint32_t ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", mpmcSTACK_SIZE, NULL, mpmcCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,212 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Compares one priority ordered queue with a FIFO queue for each priority
+ * level.  Each cycle sends one message at a random priority and then receives
+ * the message with the highest priority, while the queues hold a fixed number
+ * of other messages.  The priority queue orders messages itself, while with
+ * FIFO queues the receiver checks the queues from the highest priority down
+ * and receives from the first that is not empty.
+ *
+ * The scheduler is not started, so the POSIX port does not make a system
+ * call to enter each critical section and the times are those of the kernel.
+ *
+ * Usage: priority_queue_benchmark [cycles]
+ * Prints the time taken by one cycle for 2, 4, 8 and 32 priority levels and
+ * 1, 8 and 32 messages waiting.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_CYCLES    1000000UL
+#define benchmarkMAX_LEVELS        32
+#define benchmarkRANDOM_LEVELS     4096
+
+/*-----------------------------------------------------------*/
+
+typedef struct Message
+{
+    uint32_t ulValue;
+    uint32_t ulPriority;
+} Message_t;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunPriorityQueue( int iWaiting );
+static uint64_t prvRunFifoQueues( int iLevels,
+                                  int iWaiting );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulCycles = benchmarkDEFAULT_CYCLES;
+static uint8_t ucRandomLevels[ benchmarkRANDOM_LEVELS ];
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunPriorityQueue( int iWaiting )
+{
+    QueueHandle_t xQueue;
+    Message_t xMessage = { 0, 0 }, xReceived;
+    uint64_t ullStart, ullElapsed;
+    unsigned long ul;
+    int i;
+
+    xQueue = xQueueCreatePriorityQueue( ( UBaseType_t ) ( iWaiting + 1 ), sizeof( Message_t ) );
+    configASSERT( xQueue != NULL );
+
+    for( i = 0; i < iWaiting; i++ )
+    {
+        xMessage.ulPriority = ucRandomLevels[ i ];
+        ( void ) xQueueSendWithPriority( xQueue, &xMessage, xMessage.ulPriority, 0 );
+    }
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ul = 0; ul < ulCycles; ul++ )
+    {
+        xMessage.ulValue = ( uint32_t ) ul;
+        xMessage.ulPriority = ucRandomLevels[ ul % benchmarkRANDOM_LEVELS ];
+        ( void ) xQueueSendWithPriority( xQueue, &xMessage, xMessage.ulPriority, 0 );
+        ( void ) xQueueReceive( xQueue, &xReceived, 0 );
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+
+    /* The last message received has the highest priority of those left. */
+    while( xQueueReceive( xQueue, &xMessage, 0 ) == pdPASS )
+    {
+        testCHECK( xMessage.ulPriority <= xReceived.ulPriority );
+        xReceived = xMessage;
+    }
+
+    vQueueDelete( xQueue );
+
+    return ullElapsed;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunFifoQueues( int iLevels,
+                                  int iWaiting )
+{
+    QueueHandle_t xQueues[ benchmarkMAX_LEVELS ];
+    Message_t xMessage = { 0, 0 }, xReceived;
+    uint64_t ullStart, ullElapsed;
+    unsigned long ul;
+    int i;
+
+    for( i = 0; i < iLevels; i++ )
+    {
+        xQueues[ i ] = xQueueCreate( ( UBaseType_t ) ( iWaiting + 1 ), sizeof( Message_t ) );
+        configASSERT( xQueues[ i ] != NULL );
+    }
+
+    for( i = 0; i < iWaiting; i++ )
+    {
+        xMessage.ulPriority = ucRandomLevels[ i ];
+        ( void ) xQueueSend( xQueues[ xMessage.ulPriority ], &xMessage, 0 );
+    }
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ul = 0; ul < ulCycles; ul++ )
+    {
+        xMessage.ulValue = ( uint32_t ) ul;
+        xMessage.ulPriority = ucRandomLevels[ ul % benchmarkRANDOM_LEVELS ];
+        ( void ) xQueueSend( xQueues[ xMessage.ulPriority ], &xMessage, 0 );
+
+        for( i = iLevels - 1; i >= 0; i-- )
+        {
+            if( uxQueueMessagesWaiting( xQueues[ i ] ) != 0U )
+            {
+                ( void ) xQueueReceive( xQueues[ i ], &xReceived, 0 );
+                break;
+            }
+        }
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+
+    for( i = 0; i < iLevels; i++ )
+    {
+        testCHECK( uxQueueMessagesWaiting( xQueues[ i ] ) <= ( UBaseType_t ) iWaiting );
+        vQueueDelete( xQueues[ i ] );
+    }
+
+    return ullElapsed;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    static const int iLevels[] = { 2, 4, 8, 32 };
+    static const int iWaiting[] = { 1, 8, 32 };
+    uint64_t ullPriorityNs, ullFifoNs;
+    size_t xLevel, xWaiting;
+    int i;
+
+    if( argc > 1 )
+    {
+        ulCycles = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    configASSERT( ulCycles > 0U );
+
+    for( xLevel = 0; xLevel < ( sizeof( iLevels ) / sizeof( iLevels[ 0 ] ) ); xLevel++ )
+    {
+        srand( 3 );
+
+        for( i = 0; i < benchmarkRANDOM_LEVELS; i++ )
+        {
+            ucRandomLevels[ i ] = ( uint8_t ) ( rand() % iLevels[ xLevel ] );
+        }
+
+        for( xWaiting = 0; xWaiting < ( sizeof( iWaiting ) / sizeof( iWaiting[ 0 ] ) ); xWaiting++ )
+        {
+            ullPriorityNs = prvRunPriorityQueue( iWaiting[ xWaiting ] );
+            ullFifoNs = prvRunFifoQueues( iLevels[ xLevel ], iWaiting[ xWaiting ] );
+
+            ( void ) printf( "%2d levels, %2d waiting: priority queue %.1f ns, %2d FIFO queues %.1f ns per cycle\n",
+                             iLevels[ xLevel ], iWaiting[ xWaiting ],
+                             ( double ) ullPriorityNs / ( double ) ulCycles, iLevels[ xLevel ],
+                             ( double ) ullFifoNs / ( double ) ulCycles );
+        }
+    }
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,354 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the priority ordered queues enabled by configUSE_PRIORITY_QUEUES.  A
+ * control task runs the following checks in turn:
+ *
+ * 1. A full queue of 20 messages at random priorities refuses another, and a
+ *    peek returns the message with the highest priority without removing it.
+ * 2. 200000 random sends and receives, from tasks and from interrupts, with
+ *    xQueueSend() sending at priority 0, are compared against a simple model
+ *    that returns the highest priority message sent first.
+ * 3. A reset empties the queue.
+ * 4. A receive from an empty queue and a send to a full one time out, a send
+ *    wakes a blocked receiver, and a receive wakes a blocked sender.
+ * 5. A member of a queue set is selected once for each message.
+ * 6. A statically allocated queue returns its buffers, and orders messages of
+ *    two priorities.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define priorityCONTROL_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#define priorityHELPER_PRIORITY     ( tskIDLE_PRIORITY + 3 )
+#define prioritySTACK_SIZE          ( configMINIMAL_STACK_SIZE * 4 )
+#define priorityLENGTH              20
+#define prioritySHORT_LENGTH        3
+#define prioritySTATIC_LENGTH       7
+#define priorityRANDOM_STEPS        200000
+#define priorityTIMEOUT_TICKS       ( ( TickType_t ) 20 )
+#define priorityHELPER_WAIT         pdMS_TO_TICKS( 2000 )
+
+/*-----------------------------------------------------------*/
+
+/* Each message carries its own priority and the order in which it was sent. */
+typedef struct Message
+{
+    uint32_t ulPriority;
+    uint32_t ulSequence;
+} Message_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvModelPush( const Message_t * pxMessage );
+static void prvModelPop( Message_t * pxMessage );
+static void prvReceiverTask( void * pvParameters );
+static void prvSenderTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueue = NULL, xShortQueue = NULL, xStaticQueue = NULL;
+static QueueSetHandle_t xSet = NULL;
+
+static StaticQueue_t xStaticQueueBuffer;
+static StaticPriorityQueueNode_t xStaticNodes[ prioritySTATIC_LENGTH ];
+static uint8_t ucStaticStorage[ prioritySTATIC_LENGTH * sizeof( Message_t ) ];
+
+/* The messages the queue should hold, in the order they were sent. */
+static Message_t xModel[ priorityLENGTH ];
+static int iModelCount = 0;
+
+static volatile BaseType_t xReceiverDone = pdFALSE;
+static volatile BaseType_t xSenderDone = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static void prvModelPush( const Message_t * pxMessage )
+{
+    configASSERT( iModelCount < priorityLENGTH );
+    xModel[ iModelCount++ ] = *pxMessage;
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelPop( Message_t * pxMessage )
+{
+    int i, iBest = 0;
+
+    /* The first of the messages with the highest priority. */
+    for( i = 1; i < iModelCount; i++ )
+    {
+        if( xModel[ i ].ulPriority > xModel[ iBest ].ulPriority )
+        {
+            iBest = i;
+        }
+    }
+
+    *pxMessage = xModel[ iBest ];
+    ( void ) memmove( &( xModel[ iBest ] ), &( xModel[ iBest + 1 ] ),
+                      ( size_t ) ( iModelCount - iBest - 1 ) * sizeof( Message_t ) );
+    iModelCount--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverTask( void * pvParameters )
+{
+    Message_t xMessage;
+
+    ( void ) pvParameters;
+
+    testCHECK( xQueueReceive( xShortQueue, &xMessage, priorityHELPER_WAIT ) == pdPASS );
+    testCHECK( xMessage.ulPriority == 9U );
+    xReceiverDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void * pvParameters )
+{
+    const Message_t xMessage = { 1, 99 };
+
+    ( void ) pvParameters;
+
+    /* Blocks until the control task makes space. */
+    testCHECK( xQueueSendWithPriority( xShortQueue, &xMessage, xMessage.ulPriority, priorityHELPER_WAIT ) == pdPASS );
+    xSenderDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    Message_t xMessage, xExpected;
+    uint32_t ulSequence = 0;
+    TickType_t xStart;
+    uint8_t * pucStorage;
+    StaticQueue_t * pxStaticBuffer;
+    int i;
+
+    ( void ) pvParameters;
+
+    srand( 11 );
+
+    /* 1. Fill the queue, then peek at the highest priority message. */
+    for( i = 0; i < priorityLENGTH; i++ )
+    {
+        xMessage.ulPriority = ( uint32_t ) ( rand() % 4 );
+        xMessage.ulSequence = ulSequence++;
+        testCHECK( xQueueSendWithPriority( xQueue, &xMessage, xMessage.ulPriority, 0 ) == pdPASS );
+        prvModelPush( &xMessage );
+    }
+
+    testCHECK( xQueueSendWithPriority( xQueue, &xMessage, 0, 0 ) == errQUEUE_FULL );
+    testCHECK( uxQueueMessagesWaiting( xQueue ) == priorityLENGTH );
+
+    testCHECK( xQueuePeek( xQueue, &xMessage, 0 ) == pdPASS );
+    prvModelPop( &xExpected );
+    prvModelPush( &xExpected );
+    testCHECK( ( xMessage.ulPriority == xExpected.ulPriority ) && ( xMessage.ulSequence == xExpected.ulSequence ) );
+    testCHECK( uxQueueMessagesWaiting( xQueue ) == priorityLENGTH );
+
+    /* The model now has the peeked message at its end, so empty both. */
+    while( iModelCount > 0 )
+    {
+        prvModelPop( &xExpected );
+    }
+
+    xQueueReset( xQueue );
+
+    /* 2. Random sends and receives against the model. */
+    for( i = 0; i < priorityRANDOM_STEPS; i++ )
+    {
+        if( ( iModelCount == 0 ) || ( ( iModelCount < priorityLENGTH ) && ( ( rand() & 1 ) != 0 ) ) )
+        {
+            xMessage.ulPriority = ( ( rand() % 3 ) == 0 ) ? 0U : ( uint32_t ) ( rand() % ( queueMAX_MESSAGE_PRIORITY + 1U ) );
+            xMessage.ulSequence = ulSequence++;
+
+            if( ( xMessage.ulPriority == 0U ) && ( ( rand() & 1 ) != 0 ) )
+            {
+                testCHECK( xQueueSend( xQueue, &xMessage, 0 ) == pdPASS );
+            }
+            else if( ( rand() & 1 ) != 0 )
+            {
+                testCHECK( xQueueSendWithPriorityFromISR( xQueue, &xMessage, xMessage.ulPriority, &xHigherPriorityTaskWoken ) == pdPASS );
+            }
+            else
+            {
+                testCHECK( xQueueSendWithPriority( xQueue, &xMessage, xMessage.ulPriority, 0 ) == pdPASS );
+            }
+
+            prvModelPush( &xMessage );
+        }
+        else
+        {
+            prvModelPop( &xExpected );
+
+            if( ( rand() & 1 ) != 0 )
+            {
+                testCHECK( xQueueReceive( xQueue, &xMessage, 0 ) == pdPASS );
+            }
+            else
+            {
+                testCHECK( xQueueReceiveFromISR( xQueue, &xMessage, &xHigherPriorityTaskWoken ) == pdPASS );
+            }
+
+            if( ( xMessage.ulPriority != xExpected.ulPriority ) || ( xMessage.ulSequence != xExpected.ulSequence ) )
+            {
+                testCHECK( pdFALSE );
+                break;
+            }
+        }
+
+        testCHECK( ( int ) uxQueueMessagesWaiting( xQueue ) == iModelCount );
+    }
+
+    while( iModelCount > 0 )
+    {
+        prvModelPop( &xExpected );
+        testCHECK( xQueueReceive( xQueue, &xMessage, 0 ) == pdPASS );
+        testCHECK( ( xMessage.ulPriority == xExpected.ulPriority ) && ( xMessage.ulSequence == xExpected.ulSequence ) );
+    }
+
+    testCHECK( xQueueReceive( xQueue, &xMessage, 0 ) == errQUEUE_EMPTY );
+
+    /* 3. Reset. */
+    for( i = 0; i < 5; i++ )
+    {
+        testCHECK( xQueueSendWithPriority( xQueue, &xMessage, ( UBaseType_t ) i, 0 ) == pdPASS );
+    }
+
+    xQueueReset( xQueue );
+    testCHECK( uxQueueMessagesWaiting( xQueue ) == 0U );
+    testCHECK( xQueueReceive( xQueue, &xMessage, 0 ) == errQUEUE_EMPTY );
+
+    /* 4. Timeouts and blocked tasks. */
+    xStart = xTaskGetTickCount();
+    testCHECK( xQueueReceive( xShortQueue, &xMessage, priorityTIMEOUT_TICKS ) == errQUEUE_EMPTY );
+    testCHECK( ( xTaskGetTickCount() - xStart ) >= priorityTIMEOUT_TICKS );
+
+    ( void ) xTaskCreate( prvReceiverTask, "receiver", prioritySTACK_SIZE, NULL, priorityHELPER_PRIORITY, NULL );
+    vTaskDelay( 10 );
+    xMessage.ulPriority = 9;
+    testCHECK( xQueueSendWithPriority( xShortQueue, &xMessage, xMessage.ulPriority, 0 ) == pdPASS );
+    vTaskDelay( 10 );
+    testCHECK( xReceiverDone == pdTRUE );
+
+    for( i = 0; i < prioritySHORT_LENGTH; i++ )
+    {
+        xMessage.ulPriority = 5;
+        xMessage.ulSequence = ( uint32_t ) i;
+        testCHECK( xQueueSendWithPriority( xShortQueue, &xMessage, xMessage.ulPriority, 0 ) == pdPASS );
+    }
+
+    xStart = xTaskGetTickCount();
+    testCHECK( xQueueSendWithPriority( xShortQueue, &xMessage, 5, priorityTIMEOUT_TICKS ) == errQUEUE_FULL );
+    testCHECK( ( xTaskGetTickCount() - xStart ) >= priorityTIMEOUT_TICKS );
+
+    ( void ) xTaskCreate( prvSenderTask, "sender", prioritySTACK_SIZE, NULL, priorityHELPER_PRIORITY, NULL );
+    vTaskDelay( 10 );
+    testCHECK( xSenderDone == pdFALSE );
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == 0U ) );
+    vTaskDelay( 10 );
+    testCHECK( xSenderDone == pdTRUE );
+
+    /* The lower priority message sent by the woken task comes last. */
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == 1U ) );
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == 2U ) );
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == 99U ) );
+
+    /* 5. Queue sets. */
+    testCHECK( xQueueAddToSet( xShortQueue, xSet ) == pdPASS );
+    xMessage.ulPriority = 2;
+    ( void ) xQueueSendWithPriority( xShortQueue, &xMessage, xMessage.ulPriority, 0 );
+    xMessage.ulPriority = 7;
+    ( void ) xQueueSendWithPriority( xShortQueue, &xMessage, xMessage.ulPriority, 0 );
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == xShortQueue );
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulPriority == 7U ) );
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == xShortQueue );
+    testCHECK( ( xQueueReceive( xShortQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulPriority == 2U ) );
+    testCHECK( xQueueSelectFromSet( xSet, 5 ) == NULL );
+
+    /* 6. Static allocation. */
+    testCHECK( xQueueGetStaticBuffers( xStaticQueue, &pucStorage, &pxStaticBuffer ) == pdTRUE );
+    testCHECK( ( pucStorage == ucStaticStorage ) && ( pxStaticBuffer == &xStaticQueueBuffer ) );
+
+    for( i = 0; i < prioritySTATIC_LENGTH; i++ )
+    {
+        xMessage.ulPriority = ( uint32_t ) ( i & 1 );
+        xMessage.ulSequence = ( uint32_t ) i;
+        testCHECK( xQueueSendWithPriority( xStaticQueue, &xMessage, xMessage.ulPriority, 0 ) == pdPASS );
+    }
+
+    testCHECK( xQueueSendWithPriority( xStaticQueue, &xMessage, 1, 0 ) == errQUEUE_FULL );
+
+    for( i = 1; i < prioritySTATIC_LENGTH; i += 2 )
+    {
+        testCHECK( ( xQueueReceive( xStaticQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == ( uint32_t ) i ) );
+    }
+
+    for( i = 0; i < prioritySTATIC_LENGTH; i += 2 )
+    {
+        testCHECK( ( xQueueReceive( xStaticQueue, &xMessage, 0 ) == pdPASS ) && ( xMessage.ulSequence == ( uint32_t ) i ) );
+    }
+
+    ( void ) printf( "%lu messages sent\n", ( unsigned long ) ulSequence );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xQueue = xQueueCreatePriorityQueue( priorityLENGTH, sizeof( Message_t ) );
+    xShortQueue = xQueueCreatePriorityQueue( prioritySHORT_LENGTH, sizeof( Message_t ) );
+    xStaticQueue = xQueueCreatePriorityQueueStatic( prioritySTATIC_LENGTH, sizeof( Message_t ), ucStaticStorage,
+                                                    xStaticNodes, &xStaticQueueBuffer );
+    xSet = xQueueCreateSet( prioritySHORT_LENGTH );
+    configASSERT( ( xQueue != NULL ) && ( xShortQueue != NULL ) && ( xStaticQueue != NULL ) && ( xSet != NULL ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", prioritySTACK_SIZE, NULL, priorityCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
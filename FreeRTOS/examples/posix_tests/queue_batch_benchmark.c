@@ -0,0 +1,172 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost per item of passing 32 item bursts through a queue with
+ * xQueueSend() and xQueueReceive(), and with uxQueueSendMultiple() and
+ * uxQueueReceiveMultiple() in batches of 1 to 32 items.
+ *
+ * Each measurement is made twice: first before the scheduler is started, when
+ * entering a critical section on the POSIX port costs a few instructions, and
+ * then from a task, when it costs a system call to mask signals.  A batch
+ * enters one critical section where single item calls enter one per item, so
+ * the second run shows the gain on a port with expensive critical sections.
+ *
+ * Usage: queue_batch_benchmark [items]
+ * Prints the time taken to send and receive one item for each batch size.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_ITEMS    640000UL
+#define benchmarkBURST            32U
+
+/*-----------------------------------------------------------*/
+
+static void prvRunAll( const char * pcWhen );
+static void prvBenchmarkTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulItems = benchmarkDEFAULT_ITEMS;
+static QueueHandle_t xQueue = NULL;
+
+/*-----------------------------------------------------------*/
+
+static void prvRunAll( const char * pcWhen )
+{
+    static const UBaseType_t uxBatchSizes[] = { 1, 2, 4, 8, 16, 32 };
+    uint32_t ulSent[ benchmarkBURST ], ulReceived[ benchmarkBURST ];
+    uint32_t ulSum = 0, ulExpectedSum = 0;
+    uint64_t ullStart, ullElapsed;
+    unsigned long ul;
+    UBaseType_t uxBatch, ux;
+    size_t x;
+
+    for( ux = 0; ux < benchmarkBURST; ux++ )
+    {
+        ulSent[ ux ] = ( uint32_t ) ux;
+        ulExpectedSum += ( uint32_t ) ux;
+    }
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ul = 0; ul < ulItems; ul += benchmarkBURST )
+    {
+        for( ux = 0; ux < benchmarkBURST; ux++ )
+        {
+            ( void ) xQueueSend( xQueue, &( ulSent[ ux ] ), 0 );
+        }
+
+        for( ux = 0; ux < benchmarkBURST; ux++ )
+        {
+            ( void ) xQueueReceive( xQueue, &( ulReceived[ ux ] ), 0 );
+            ulSum += ulReceived[ ux ];
+        }
+
+        testCHECK( ulSum == ulExpectedSum );
+        ulSum = 0;
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+    ( void ) printf( "%s, single item calls: %.1f ns per item\n", pcWhen, ( double ) ullElapsed / ( double ) ulItems );
+
+    for( x = 0; x < ( sizeof( uxBatchSizes ) / sizeof( uxBatchSizes[ 0 ] ) ); x++ )
+    {
+        uxBatch = uxBatchSizes[ x ];
+        ullStart = ullTestGetTimeNs();
+
+        for( ul = 0; ul < ulItems; ul += benchmarkBURST )
+        {
+            for( ux = 0; ux < benchmarkBURST; ux += uxBatch )
+            {
+                ( void ) uxQueueSendMultiple( xQueue, &( ulSent[ ux ] ), uxBatch, 0 );
+            }
+
+            for( ux = 0; ux < benchmarkBURST; ux += uxBatch )
+            {
+                testCHECK( uxQueueReceiveMultiple( xQueue, &( ulReceived[ ux ] ), uxBatch, 0 ) == uxBatch );
+            }
+
+            for( ux = 0; ux < benchmarkBURST; ux++ )
+            {
+                ulSum += ulReceived[ ux ];
+            }
+
+            testCHECK( ulSum == ulExpectedSum );
+            ulSum = 0;
+        }
+
+        ullElapsed = ullTestGetTimeNs() - ullStart;
+        ( void ) printf( "%s, batches of %2lu: %.1f ns per item\n", pcWhen, ( unsigned long ) uxBatch,
+                         ( double ) ullElapsed / ( double ) ulItems );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvRunAll( "in a task" );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        ulItems = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    configASSERT( ulItems >= benchmarkBURST );
+
+    xQueue = xQueueCreate( benchmarkBURST, sizeof( uint32_t ) );
+    configASSERT( xQueue );
+
+    prvRunAll( "no scheduler" );
+
+    ( void ) xTaskCreate( prvBenchmarkTask, "benchmark", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,389 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks uxQueueSendMultiple(), uxQueueReceiveMultiple() and their FromISR
+ * versions.  A control task runs the following checks in turn:
+ *
+ * 1. Batches of one to five items, some followed by a single send, go round a
+ *    five item queue 200 times, so batches wrap around the storage at every
+ *    position.  Every item must come out in order.
+ * 2. A batch sent to a queue with too little space posts as many items as fit.
+ *    A batch received from a queue with too few items receives what is there.
+ *    Either returns 0 after its timeout if it can move no items at all.
+ * 3. One batch sent wakes every task blocked to receive an item from it, and
+ *    one batch received wakes every task blocked to send.  A batch sent from
+ *    an interrupt reports that a higher priority task was woken.
+ * 4. One batch sent wakes every coroutine waiting to receive from the queue.
+ * 5. Batches sent to queues in a queue set add one set entry per item.
+ * 6. A producer task sends batches of 13 items and a consumer task receives
+ *    batches of up to 9, through a 16 item queue, and every item must arrive
+ *    in order.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "async.h"
+
+#include "test_support.h"
+
+#define batchCONTROL_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+#define batchBLOCKING_PRIORITY      ( tskIDLE_PRIORITY + 3 )
+#define batchSTACK_SIZE             ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Checks 1 to 3. */
+#define batchSHORT_QUEUE_LENGTH     5U
+#define batchWRAP_ROUNDS            200U
+#define batchBLOCKED_TASKS          3U
+
+/* Check 4. */
+#define batchCOROUTINES             3
+
+/* Check 6. */
+#define batchSTREAM_ITEMS           5000U
+#define batchSTREAM_QUEUE_LENGTH    16U
+#define batchSEND_BATCH             13U
+#define batchRECEIVE_BATCH          9U
+
+/*-----------------------------------------------------------*/
+
+static void prvBlockedReceiverTask( void * pvParameters );
+static void prvBlockedSenderTask( void * pvParameters );
+static void prvReceiverCoroutine( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters );
+static void prvHostTask( void * pvParameters );
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xShortQueue = NULL;
+static QueueHandle_t xCoroutineQueue = NULL;
+static QueueHandle_t xStreamQueue = NULL;
+
+static AsyncExecutor_t xExecutor;
+static AsyncCoroutine_t xCoroutines[ batchCOROUTINES ];
+static volatile uint32_t ulCoroutineItems = 0;
+
+static volatile uint32_t ulReceiversWoken = 0;
+static volatile uint32_t ulSendersWoken = 0;
+
+static volatile uint32_t ulStreamItemsReceived = 0;
+static volatile uint32_t ulStreamOrderErrors = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvBlockedReceiverTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    testCHECK( xQueueReceive( xShortQueue, &ulValue, 1000 ) == pdPASS );
+    ulReceiversWoken++;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockedSenderTask( void * pvParameters )
+{
+    uint32_t ulValue = 1000;
+
+    ( void ) pvParameters;
+
+    testCHECK( xQueueSend( xShortQueue, &ulValue, 1000 ) == pdPASS );
+    ulSendersWoken++;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverCoroutine( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters )
+{
+    BaseType_t xResult;
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xCoroutineQueue, &ulValue, portMAX_DELAY, &xResult );
+
+    if( xResult == pdPASS )
+    {
+        ulCoroutineItems++;
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHostTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vAsyncExecutorRun( &xExecutor );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    uint32_t ulBatch[ batchSEND_BATCH ];
+    uint32_t ulSent = 0, ulCount, ul;
+
+    ( void ) pvParameters;
+
+    while( ulSent < batchSTREAM_ITEMS )
+    {
+        for( ul = 0; ul < batchSEND_BATCH; ul++ )
+        {
+            ulBatch[ ul ] = ulSent + ul;
+        }
+
+        ulCount = ( ( batchSTREAM_ITEMS - ulSent ) < batchSEND_BATCH ) ? ( batchSTREAM_ITEMS - ulSent ) : batchSEND_BATCH;
+        ulCount = ( uint32_t ) uxQueueSendMultiple( xStreamQueue, ulBatch, ( UBaseType_t ) ulCount, portMAX_DELAY );
+        testCHECK( ulCount > 0U );
+        ulSent += ulCount;
+
+        if( ( ulSent % 7U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    uint32_t ulBatch[ batchRECEIVE_BATCH ];
+    uint32_t ulCount, ul;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulCount = ( uint32_t ) uxQueueReceiveMultiple( xStreamQueue, ulBatch, batchRECEIVE_BATCH, portMAX_DELAY );
+        testCHECK( ( ulCount > 0U ) && ( ulCount <= batchRECEIVE_BATCH ) );
+
+        for( ul = 0; ul < ulCount; ul++ )
+        {
+            if( ulBatch[ ul ] != ( ulStreamItemsReceived + ul ) )
+            {
+                ulStreamOrderErrors++;
+            }
+        }
+
+        ulStreamItemsReceived += ulCount;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    uint32_t ulSent[ 8 ], ulReceived[ 8 ];
+    uint32_t ulRound, ulCount, ulValue, ul;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    QueueHandle_t xMember1, xMember2;
+    QueueSetHandle_t xQueueSet;
+    QueueSetMemberHandle_t xSelected;
+    TickType_t xStart;
+
+    ( void ) pvParameters;
+
+    /* 1. Wrapping around the storage. */
+    for( ulRound = 0; ulRound < batchWRAP_ROUNDS; ulRound++ )
+    {
+        ulCount = 1U + ( ulRound % batchSHORT_QUEUE_LENGTH );
+
+        for( ul = 0; ul < ulCount; ul++ )
+        {
+            ulSent[ ul ] = ( ulRound * 10U ) + ul;
+        }
+
+        testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, ulCount, 0 ) == ulCount );
+
+        if( ( ulRound % 3U ) == 0U )
+        {
+            ulValue = 77;
+
+            if( ulCount < batchSHORT_QUEUE_LENGTH )
+            {
+                testCHECK( xQueueSend( xShortQueue, &ulValue, 0 ) == pdPASS );
+                ulSent[ ulCount ] = ulValue;
+                ulCount++;
+            }
+            else
+            {
+                testCHECK( xQueueSend( xShortQueue, &ulValue, 0 ) == errQUEUE_FULL );
+            }
+        }
+
+        testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 8, 0 ) == ulCount );
+
+        for( ul = 0; ul < ulCount; ul++ )
+        {
+            testCHECK( ulReceived[ ul ] == ulSent[ ul ] );
+        }
+    }
+
+    /* 2. Partial batches. */
+    for( ul = 0; ul < 8U; ul++ )
+    {
+        ulSent[ ul ] = ul;
+    }
+
+    testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, 8, 0 ) == batchSHORT_QUEUE_LENGTH );
+    testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, 1, 0 ) == 0U );
+    testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, 1, 3 ) == 0U );
+    testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 2, 0 ) == 2U );
+    testCHECK( ( ulReceived[ 0 ] == 0U ) && ( ulReceived[ 1 ] == 1U ) );
+    testCHECK( uxQueueReceiveMultipleFromISR( xShortQueue, ulReceived, 8, &xHigherPriorityTaskWoken ) == 3U );
+    testCHECK( ( ulReceived[ 0 ] == 2U ) && ( ulReceived[ 2 ] == 4U ) );
+    testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 2, 2 ) == 0U );
+
+    /* 3. One batch wakes several blocked receivers, then several blocked
+     * senders.  The blocked tasks run above this task, so each runs as soon as
+     * it is created or woken. */
+    for( ul = 0; ul < batchBLOCKED_TASKS; ul++ )
+    {
+        ( void ) xTaskCreate( prvBlockedReceiverTask, "receiver", batchSTACK_SIZE, NULL, batchBLOCKING_PRIORITY, NULL );
+    }
+
+    testCHECK( ulReceiversWoken == 0U );
+    testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, batchBLOCKED_TASKS, 0 ) == batchBLOCKED_TASKS );
+    testCHECK( ulReceiversWoken == batchBLOCKED_TASKS );
+
+    testCHECK( uxQueueSendMultiple( xShortQueue, ulSent, batchSHORT_QUEUE_LENGTH, 0 ) == batchSHORT_QUEUE_LENGTH );
+
+    for( ul = 0; ul < batchBLOCKED_TASKS; ul++ )
+    {
+        ( void ) xTaskCreate( prvBlockedSenderTask, "sender", batchSTACK_SIZE, NULL, batchBLOCKING_PRIORITY, NULL );
+    }
+
+    testCHECK( ulSendersWoken == 0U );
+    testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 4, 0 ) == 4U );
+    testCHECK( ulSendersWoken == batchBLOCKED_TASKS );
+    testCHECK( uxQueueMessagesWaiting( xShortQueue ) == 4U );
+    testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 8, 0 ) == 4U );
+    testCHECK( ( ulReceived[ 0 ] == 4U ) && ( ulReceived[ 1 ] == 1000U ) );
+
+    ( void ) xTaskCreate( prvBlockedReceiverTask, "receiver", batchSTACK_SIZE, NULL, batchBLOCKING_PRIORITY, NULL );
+    xHigherPriorityTaskWoken = pdFALSE;
+
+    /* Called as if from an interrupt that this task's critical section
+     * masks. */
+    taskENTER_CRITICAL();
+    {
+        testCHECK( uxQueueSendMultipleFromISR( xShortQueue, ulSent, 2, &xHigherPriorityTaskWoken ) == 2U );
+    }
+    taskEXIT_CRITICAL();
+
+    testCHECK( xHigherPriorityTaskWoken == pdTRUE );
+    vTaskDelay( 1 );
+    testCHECK( ulReceiversWoken == ( batchBLOCKED_TASKS + 1U ) );
+    testCHECK( uxQueueReceiveMultiple( xShortQueue, ulReceived, 8, 0 ) == 1U );
+
+    /* 4. Coroutines. */
+    vTaskDelay( 5 );
+    testCHECK( uxQueueSendMultiple( xCoroutineQueue, ulSent, batchCOROUTINES, 0 ) == batchCOROUTINES );
+    vTaskDelay( 5 );
+    testCHECK( ulCoroutineItems == batchCOROUTINES );
+
+    /* 5. Queue sets. */
+    xMember1 = xQueueCreate( 4, sizeof( uint32_t ) );
+    xMember2 = xQueueCreate( 4, sizeof( uint32_t ) );
+    xQueueSet = xQueueCreateSet( 8 );
+    ( void ) xQueueAddToSet( xMember1, xQueueSet );
+    ( void ) xQueueAddToSet( xMember2, xQueueSet );
+    testCHECK( uxQueueSendMultiple( xMember1, ulSent, 3, 0 ) == 3U );
+    testCHECK( uxQueueSendMultiple( xMember2, ulSent, 2, 0 ) == 2U );
+
+    for( ul = 0; ul < 5U; ul++ )
+    {
+        xSelected = xQueueSelectFromSet( xQueueSet, 0 );
+        testCHECK( ( xSelected == xMember1 ) || ( xSelected == xMember2 ) );
+        testCHECK( xQueueReceive( xSelected, ulReceived, 0 ) == pdPASS );
+    }
+
+    testCHECK( xQueueSelectFromSet( xQueueSet, 0 ) == NULL );
+
+    /* 6. Producer and consumer with different batch sizes. */
+    ( void ) xTaskCreate( prvProducerTask, "producer", batchSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+    ( void ) xTaskCreate( prvConsumerTask, "consumer", batchSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    xStart = xTaskGetTickCount();
+
+    while( ( ulStreamItemsReceived < batchSTREAM_ITEMS ) && ( ( xTaskGetTickCount() - xStart ) < 3000U ) )
+    {
+        vTaskDelay( 10 );
+    }
+
+    testCHECK( ulStreamItemsReceived == batchSTREAM_ITEMS );
+    testCHECK( ulStreamOrderErrors == 0U );
+
+    ( void ) printf( "%lu streamed items, %lu out of order\n",
+                     ( unsigned long ) ulStreamItemsReceived, ( unsigned long ) ulStreamOrderErrors );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    int i;
+
+    xShortQueue = xQueueCreate( batchSHORT_QUEUE_LENGTH, sizeof( uint32_t ) );
+    xCoroutineQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    xStreamQueue = xQueueCreate( batchSTREAM_QUEUE_LENGTH, sizeof( uint32_t ) );
+
+    vAsyncExecutorInitialise( &xExecutor );
+
+    for( i = 0; i < batchCOROUTINES; i++ )
+    {
+        vAsyncCoroutineStart( &xExecutor, &( xCoroutines[ i ] ), prvReceiverCoroutine, NULL );
+    }
+
+    ( void ) xTaskCreate( prvHostTask, "host", batchSTACK_SIZE, NULL, batchCONTROL_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvControlTask, "control", batchSTACK_SIZE, NULL, batchCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,211 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures passing items through a queue by copy and by loan, for item sizes
+ * from 4 bytes to 4 KB.  For each size a queue of benchmarkQUEUE_LENGTH items
+ * is filled and then emptied, over and over.  The sender writes each item
+ * and the receiver reads it, either in a local buffer that xQueueSend() and
+ * xQueueReceive() copy, or in the queue's own storage through a loaned slot
+ * and a borrowed item.
+ *
+ * The scheduler is not started, so the POSIX port does not make a system
+ * call to enter each critical section and the times are those of the kernel.
+ *
+ * Usage: queue_loan_benchmark [items]
+ * Prints the time taken to send and receive one item of each size.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_ITEMS    1000000UL
+#define benchmarkQUEUE_LENGTH     8UL
+#define benchmarkMAX_ITEM_SIZE    4096
+
+/*-----------------------------------------------------------*/
+
+static void prvWriteItem( uint8_t * pucItem,
+                          size_t xItemSize,
+                          uint32_t ulValue );
+static uint32_t prvReadItem( const uint8_t * pucItem,
+                             size_t xItemSize );
+static uint64_t prvRunCopies( QueueHandle_t xQueue,
+                              size_t xItemSize,
+                              unsigned long ulItems );
+static uint64_t prvRunLoans( QueueHandle_t xQueue,
+                             size_t xItemSize,
+                             unsigned long ulItems );
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ucSendBuffer[ benchmarkMAX_ITEM_SIZE ];
+static uint8_t ucReceiveBuffer[ benchmarkMAX_ITEM_SIZE ];
+
+/* Stops the compiler discarding the reads. */
+static volatile uint32_t ulChecksum = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvWriteItem( uint8_t * pucItem,
+                          size_t xItemSize,
+                          uint32_t ulValue )
+{
+    ( void ) memset( pucItem, ( int ) ( ulValue & 0xFFU ), xItemSize );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvReadItem( const uint8_t * pucItem,
+                             size_t xItemSize )
+{
+    uint32_t ulSum = 0;
+    size_t x;
+
+    for( x = 0; x < xItemSize; x += sizeof( uint32_t ) )
+    {
+        ulSum += pucItem[ x ];
+    }
+
+    return ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunCopies( QueueHandle_t xQueue,
+                              size_t xItemSize,
+                              unsigned long ulItems )
+{
+    uint64_t ullStart = ullTestGetTimeNs();
+    uint32_t ulSum = 0;
+    unsigned long ul, ulItem;
+
+    for( ul = 0; ul < ulItems; ul += benchmarkQUEUE_LENGTH )
+    {
+        for( ulItem = 0; ulItem < benchmarkQUEUE_LENGTH; ulItem++ )
+        {
+            prvWriteItem( ucSendBuffer, xItemSize, ( uint32_t ) ulItem );
+            ( void ) xQueueSend( xQueue, ucSendBuffer, 0 );
+        }
+
+        for( ulItem = 0; ulItem < benchmarkQUEUE_LENGTH; ulItem++ )
+        {
+            ( void ) xQueueReceive( xQueue, ucReceiveBuffer, 0 );
+            ulSum += prvReadItem( ucReceiveBuffer, xItemSize );
+        }
+    }
+
+    ulChecksum += ulSum;
+
+    return ullTestGetTimeNs() - ullStart;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunLoans( QueueHandle_t xQueue,
+                             size_t xItemSize,
+                             unsigned long ulItems )
+{
+    uint64_t ullStart = ullTestGetTimeNs();
+    uint32_t ulSum = 0;
+    unsigned long ul, ulItem;
+    void * pvItem;
+
+    for( ul = 0; ul < ulItems; ul += benchmarkQUEUE_LENGTH )
+    {
+        for( ulItem = 0; ulItem < benchmarkQUEUE_LENGTH; ulItem++ )
+        {
+            ( void ) xQueueAcquireSendSlot( xQueue, &pvItem, 0 );
+            prvWriteItem( pvItem, xItemSize, ( uint32_t ) ulItem );
+            ( void ) xQueueCommitSendSlot( xQueue );
+        }
+
+        for( ulItem = 0; ulItem < benchmarkQUEUE_LENGTH; ulItem++ )
+        {
+            ( void ) xQueueBorrowItem( xQueue, &pvItem, 0 );
+            ulSum += prvReadItem( pvItem, xItemSize );
+            vQueueReleaseItem( xQueue );
+        }
+    }
+
+    ulChecksum += ulSum;
+
+    return ullTestGetTimeNs() - ullStart;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    static const size_t xItemSizes[] = { 4, 16, 64, 256, 1024, 4096 };
+    unsigned long ulItems = benchmarkDEFAULT_ITEMS;
+    uint64_t ullCopyNs, ullLoanNs;
+    uint32_t ulCopySum, ulLoanSum;
+    QueueHandle_t xQueue;
+    size_t x;
+
+    if( argc > 1 )
+    {
+        ulItems = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    configASSERT( ulItems >= benchmarkQUEUE_LENGTH );
+
+    for( x = 0; x < ( sizeof( xItemSizes ) / sizeof( xItemSizes[ 0 ] ) ); x++ )
+    {
+        xQueue = xQueueCreate( benchmarkQUEUE_LENGTH, xItemSizes[ x ] );
+        configASSERT( xQueue );
+
+        ulChecksum = 0;
+        ullCopyNs = prvRunCopies( xQueue, xItemSizes[ x ], ulItems );
+        ulCopySum = ulChecksum;
+
+        ulChecksum = 0;
+        ullLoanNs = prvRunLoans( xQueue, xItemSizes[ x ], ulItems );
+        ulLoanSum = ulChecksum;
+
+        /* Both ways must have passed the same data. */
+        testCHECK( ulCopySum == ulLoanSum );
+        testCHECK( uxQueueMessagesWaiting( xQueue ) == 0U );
+
+        ( void ) printf( "%4lu byte items: copy %.1f ns, loan %.1f ns per item\n",
+                         ( unsigned long ) xItemSizes[ x ],
+                         ( double ) ullCopyNs / ( double ) ulItems,
+                         ( double ) ullLoanNs / ( double ) ulItems );
+
+        vQueueDelete( xQueue );
+    }
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,370 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the queue loans enabled by configUSE_QUEUE_LOANS.  A control task
+ * runs the following checks in turn:
+ *
+ * 1. A producer task alternates between loaned and copied sends, and a
+ *    consumer task alternates between borrowed and copied receives, of 64
+ *    byte messages.  Every message must arrive in order and intact.
+ * 2. While a send slot is on loan the queue has one less space, so a task
+ *    sending to the full queue blocks until the slot is committed.  While an
+ *    item is borrowed it stays in the queue, so a task receiving the next item
+ *    blocks until the borrowed item is released.
+ * 3. A cancelled slot adds nothing to the queue.
+ * 4. Loaned sends and borrowed receives wrap around the queue storage.
+ * 5. Committing a slot notifies the queue set the queue is in, and wakes a
+ *    coroutine waiting to receive from the queue.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "async.h"
+
+#include "test_support.h"
+
+#define loanCONTROL_PRIORITY        ( tskIDLE_PRIORITY + 2 )
+#define loanBLOCKING_PRIORITY       ( tskIDLE_PRIORITY + 3 )
+#define loanSTACK_SIZE              ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Check 1. */
+#define loanMESSAGES                2000U
+#define loanMESSAGE_QUEUE_LENGTH    4
+
+/* Check 4. */
+#define loanWRAP_ITEMS              101U
+
+/*-----------------------------------------------------------*/
+
+typedef struct Message
+{
+    uint32_t ulSequence;
+    uint8_t ucPayload[ 60 ];
+} Message_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvFillMessage( Message_t * pxMessage,
+                            uint32_t ulSequence );
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+static void prvBlockedSenderTask( void * pvParameters );
+static void prvBlockedReceiverTask( void * pvParameters );
+static void prvReceiverCoroutine( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters );
+static void prvHostTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xMessageQueue = NULL;
+static QueueHandle_t xShortQueue = NULL;
+static QueueHandle_t xSetMemberQueue = NULL;
+static QueueHandle_t xCoroutineQueue = NULL;
+static QueueSetHandle_t xQueueSet = NULL;
+
+static AsyncExecutor_t xExecutor;
+static AsyncCoroutine_t xReceiverCoroutine;
+static uint32_t ulCoroutineItems = 0;
+
+static volatile uint32_t ulMessagesReceived = 0;
+static volatile uint32_t ulMessageErrors = 0;
+
+/* Set by the blocking tasks in check 2 as they pass each step. */
+static volatile int iBlockedStep = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvFillMessage( Message_t * pxMessage,
+                            uint32_t ulSequence )
+{
+    pxMessage->ulSequence = ulSequence;
+    ( void ) memset( pxMessage->ucPayload, ( int ) ( ulSequence & 0xFFU ), sizeof( pxMessage->ucPayload ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    Message_t xMessage;
+    Message_t * pxSlot;
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < loanMESSAGES; ul += 2U )
+    {
+        testCHECK( xQueueAcquireSendSlot( xMessageQueue, ( void ** ) &pxSlot, portMAX_DELAY ) == pdPASS );
+        prvFillMessage( pxSlot, ul );
+        testCHECK( xQueueCommitSendSlot( xMessageQueue ) == pdPASS );
+
+        prvFillMessage( &xMessage, ul + 1U );
+        testCHECK( xQueueSend( xMessageQueue, &xMessage, portMAX_DELAY ) == pdPASS );
+
+        if( ( ul % 50U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    Message_t xMessage;
+    Message_t * pxMessage;
+    size_t x;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Borrow two messages in every three. */
+        if( ( ulMessagesReceived % 3U ) == 0U )
+        {
+            testCHECK( xQueueReceive( xMessageQueue, &xMessage, portMAX_DELAY ) == pdPASS );
+            pxMessage = &xMessage;
+        }
+        else
+        {
+            testCHECK( xQueueBorrowItem( xMessageQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdPASS );
+        }
+
+        if( pxMessage->ulSequence != ulMessagesReceived )
+        {
+            ulMessageErrors++;
+        }
+
+        for( x = 0; x < sizeof( pxMessage->ucPayload ); x++ )
+        {
+            if( pxMessage->ucPayload[ x ] != ( uint8_t ) ( ulMessagesReceived & 0xFFU ) )
+            {
+                ulMessageErrors++;
+            }
+        }
+
+        if( pxMessage != &xMessage )
+        {
+            vQueueReleaseItem( xMessageQueue );
+        }
+
+        ulMessagesReceived++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockedSenderTask( void * pvParameters )
+{
+    uint32_t ulValue = 99;
+
+    ( void ) pvParameters;
+
+    testCHECK( xQueueSend( xShortQueue, &ulValue, 0 ) == errQUEUE_FULL );
+    iBlockedStep = 1;
+    testCHECK( xQueueSend( xShortQueue, &ulValue, 100 ) == pdPASS );
+    iBlockedStep = 2;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockedReceiverTask( void * pvParameters )
+{
+    uint32_t ulValue = 0;
+
+    ( void ) pvParameters;
+
+    testCHECK( xQueueReceive( xShortQueue, &ulValue, 0 ) == errQUEUE_EMPTY );
+    iBlockedStep = 3;
+    testCHECK( xQueueReceive( xShortQueue, &ulValue, 100 ) == pdPASS );
+    testCHECK( ulValue == 99U );
+    iBlockedStep = 4;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverCoroutine( AsyncCoroutine_t * pxCoroutine,
+                                  void * pvParameters )
+{
+    BaseType_t xResult;
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    asyncBEGIN( pxCoroutine );
+
+    while( ulCoroutineItems < 2U )
+    {
+        asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xCoroutineQueue, &ulValue, portMAX_DELAY, &xResult );
+
+        if( ( xResult == pdPASS ) && ( ulValue == ( ulCoroutineItems + 1U ) ) )
+        {
+            ulCoroutineItems++;
+        }
+    }
+
+    asyncEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHostTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vAsyncExecutorRun( &xExecutor );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    uint32_t * pulSlot;
+    uint32_t * pulItem;
+    uint32_t ulValue;
+    TickType_t xStart;
+
+    ( void ) pvParameters;
+
+    /* 1. Loaned and copied messages mixed. */
+    ( void ) xTaskCreate( prvProducerTask, "producer", loanSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+    ( void ) xTaskCreate( prvConsumerTask, "consumer", loanSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    xStart = xTaskGetTickCount();
+
+    while( ( ulMessagesReceived < loanMESSAGES ) && ( ( xTaskGetTickCount() - xStart ) < 3000U ) )
+    {
+        vTaskDelay( 10 );
+    }
+
+    testCHECK( ulMessagesReceived == loanMESSAGES );
+    testCHECK( ulMessageErrors == 0U );
+
+    /* 2. xShortQueue holds two items.  With one slot on loan a second slot can
+     * be acquired but not a third, and a send blocks until the loaned slot is
+     * committed. */
+    testCHECK( xQueueAcquireSendSlot( xShortQueue, ( void ** ) &pulSlot, 0 ) == pdPASS );
+    testCHECK( uxQueueSpacesAvailable( xShortQueue ) == 1U );
+    testCHECK( xQueueAcquireSendSlot( xShortQueue, ( void ** ) &pulItem, 0 ) == errQUEUE_FULL );
+    ( void ) xTaskCreate( prvBlockedSenderTask, "sender", loanSTACK_SIZE, NULL, loanBLOCKING_PRIORITY, NULL );
+    testCHECK( iBlockedStep == 1 );
+    vTaskDelay( 5 );
+    testCHECK( iBlockedStep == 1 );
+    *pulSlot = 5;
+    testCHECK( xQueueCommitSendSlot( xShortQueue ) == pdPASS );
+    testCHECK( iBlockedStep == 2 );
+    testCHECK( xQueueCommitSendSlot( xShortQueue ) == pdFAIL );
+
+    /* The queue now holds 5 then 99.  The borrowed 5 stays at the front of the
+     * queue, so a receive for the next item blocks until it is released. */
+    testCHECK( xQueueBorrowItem( xShortQueue, ( void ** ) &pulItem, 0 ) == pdPASS );
+    testCHECK( *pulItem == 5U );
+    testCHECK( uxQueueMessagesWaiting( xShortQueue ) == 2U );
+    testCHECK( xQueuePeek( xShortQueue, &ulValue, 0 ) == pdPASS );
+    testCHECK( ulValue == 5U );
+    ( void ) xTaskCreate( prvBlockedReceiverTask, "receiver", loanSTACK_SIZE, NULL, loanBLOCKING_PRIORITY, NULL );
+    testCHECK( iBlockedStep == 3 );
+    vTaskDelay( 5 );
+    testCHECK( iBlockedStep == 3 );
+    vQueueReleaseItem( xShortQueue );
+    testCHECK( iBlockedStep == 4 );
+    testCHECK( uxQueueMessagesWaiting( xShortQueue ) == 0U );
+
+    /* 3. Cancelling a slot. */
+    testCHECK( xQueueAcquireSendSlot( xShortQueue, ( void ** ) &pulSlot, 0 ) == pdPASS );
+    vQueueCancelSendSlot( xShortQueue );
+    testCHECK( uxQueueMessagesWaiting( xShortQueue ) == 0U );
+    testCHECK( uxQueueSpacesAvailable( xShortQueue ) == 2U );
+    testCHECK( xQueueBorrowItem( xShortQueue, ( void ** ) &pulItem, 0 ) == errQUEUE_EMPTY );
+
+    /* 4. Wrapping around the two item storage area. */
+    for( ulValue = 0; ulValue < loanWRAP_ITEMS; ulValue++ )
+    {
+        testCHECK( xQueueAcquireSendSlot( xShortQueue, ( void ** ) &pulSlot, 0 ) == pdPASS );
+        *pulSlot = ulValue;
+        testCHECK( xQueueCommitSendSlot( xShortQueue ) == pdPASS );
+        testCHECK( xQueueBorrowItem( xShortQueue, ( void ** ) &pulItem, 0 ) == pdPASS );
+        testCHECK( *pulItem == ulValue );
+        vQueueReleaseItem( xShortQueue );
+    }
+
+    /* 5. Queue sets and coroutines. */
+    testCHECK( xQueueAcquireSendSlot( xSetMemberQueue, ( void ** ) &pulSlot, 0 ) == pdPASS );
+    *pulSlot = 42;
+    testCHECK( xQueueCommitSendSlot( xSetMemberQueue ) == pdPASS );
+    testCHECK( xQueueSelectFromSet( xQueueSet, 0 ) == xSetMemberQueue );
+    testCHECK( xQueueBorrowItem( xSetMemberQueue, ( void ** ) &pulItem, 0 ) == pdPASS );
+    testCHECK( *pulItem == 42U );
+    vQueueReleaseItem( xSetMemberQueue );
+    testCHECK( xQueueSelectFromSet( xQueueSet, 0 ) == NULL );
+
+    for( ulValue = 1; ulValue <= 2U; ulValue++ )
+    {
+        vTaskDelay( 5 );
+        testCHECK( xQueueAcquireSendSlot( xCoroutineQueue, ( void ** ) &pulSlot, 0 ) == pdPASS );
+        *pulSlot = ulValue;
+        testCHECK( xQueueCommitSendSlot( xCoroutineQueue ) == pdPASS );
+    }
+
+    vTaskDelay( 5 );
+    testCHECK( ulCoroutineItems == 2U );
+
+    ( void ) printf( "%lu messages, %lu errors\n", ( unsigned long ) ulMessagesReceived, ( unsigned long ) ulMessageErrors );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xMessageQueue = xQueueCreate( loanMESSAGE_QUEUE_LENGTH, sizeof( Message_t ) );
+    xShortQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    xSetMemberQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    xCoroutineQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    xQueueSet = xQueueCreateSet( 2 );
+    ( void ) xQueueAddToSet( xSetMemberQueue, xQueueSet );
+
+    vAsyncExecutorInitialise( &xExecutor );
+    vAsyncCoroutineStart( &xExecutor, &xReceiverCoroutine, prvReceiverCoroutine, NULL );
+
+    ( void ) xTaskCreate( prvHostTask, "host", loanSTACK_SIZE, NULL, loanCONTROL_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvControlTask, "control", loanSTACK_SIZE, NULL, loanCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,199 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the throughput of independent producer and consumer pairs on an
+ * SMP build, to compare portUSING_GRANULAR_LOCKS set to 1, where each queue is
+ * protected by its own spinlock, against 0, where every queue operation takes
+ * the kernel's TASK and ISR locks.  Each pair has its own queue and its own two
+ * cores, so the pairs only contend for kernel locks, never for a queue.
+ *
+ * Usage: queue_pairs_benchmark [pairs] [items per pair] [block]
+ *
+ * By default producers and consumers poll with a block time of 0, so no task
+ * ever blocks.  With "block" they wait with portMAX_DELAY, and so take the
+ * TASK lock to block and unblock whatever portUSING_GRANULAR_LOCKS is set to.
+ * Consumers check every item arrives in order, so the program also serves as
+ * a test when run with few items.
+ */
+
+/* Standard includes. */
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define pairsMAX_PAIRS           ( configNUMBER_OF_CORES / 2 )
+#define pairsQUEUE_LENGTH        16
+#define pairsTASK_PRIORITY       ( tskIDLE_PRIORITY + 1 )
+#define pairsDEFAULT_ITEMS       1000000UL
+
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherCores( void );
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueues[ pairsMAX_PAIRS ];
+static int iPairs = pairsMAX_PAIRS;
+static uint32_t ulItems = pairsDEFAULT_ITEMS;
+static TickType_t xBlockTime = 0;
+static uint64_t ullStartTimeNs = 0;
+static int iConsumersDone = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherCores( void )
+{
+    /* Give the host processor to the thread running the other end of the
+     * queue, in case the host has fewer processors than there are cores. */
+    ( void ) sched_yield();
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    const QueueHandle_t xQueue = xQueues[ ( intptr_t ) pvParameters ];
+    uint64_t ullExpected = 0;
+    uint32_t ulValue;
+
+    /* The clock starts when the first task runs. */
+    ( void ) __atomic_compare_exchange_n( &ullStartTimeNs, &ullExpected, ullTestGetTimeNs(), pdFALSE,
+                                          __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+
+    for( ulValue = 0; ulValue < ulItems; ulValue++ )
+    {
+        while( xQueueSend( xQueue, &ulValue, xBlockTime ) != pdPASS )
+        {
+            prvWaitForOtherCores();
+        }
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    const QueueHandle_t xQueue = xQueues[ ( intptr_t ) pvParameters ];
+    uint32_t ulExpected, ulValue;
+    uint64_t ullElapsedNs;
+    uint32_t ulOutOfOrder = 0;
+
+    for( ulExpected = 0; ulExpected < ulItems; ulExpected++ )
+    {
+        while( xQueueReceive( xQueue, &ulValue, xBlockTime ) != pdPASS )
+        {
+            prvWaitForOtherCores();
+        }
+
+        if( ulValue != ulExpected )
+        {
+            ulOutOfOrder++;
+        }
+    }
+
+    testCHECK( ulOutOfOrder == 0U );
+
+    if( __atomic_add_fetch( &iConsumersDone, 1, __ATOMIC_SEQ_CST ) == iPairs )
+    {
+        ullElapsedNs = ullTestGetTimeNs() - __atomic_load_n( &ullStartTimeNs, __ATOMIC_SEQ_CST );
+
+        ( void ) printf( "queue pairs: %d cores, %d pairs, granular locks %d, %s, %lu items per pair, "
+                         "%.1f ns per item, %.2f million items per second\n",
+                         configNUMBER_OF_CORES, iPairs, portUSING_GRANULAR_LOCKS,
+                         ( xBlockTime == 0U ) ? "polling" : "blocking",
+                         ( unsigned long ) ulItems,
+                         ( double ) ullElapsedNs / ( ( double ) ulItems * ( double ) iPairs ),
+                         ( ( double ) ulItems * ( double ) iPairs * 1000.0 ) / ( double ) ullElapsedNs );
+        vTestFinish();
+    }
+
+    vTaskSuspend( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    intptr_t xPair;
+
+    if( argc > 1 )
+    {
+        iPairs = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        ulItems = ( uint32_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    if( ( argc > 3 ) && ( strcmp( argv[ 3 ], "block" ) == 0 ) )
+    {
+        xBlockTime = portMAX_DELAY;
+    }
+
+    if( ( iPairs < 1 ) || ( iPairs > pairsMAX_PAIRS ) )
+    {
+        ( void ) printf( "pairs must be from 1 to %d\n", pairsMAX_PAIRS );
+        return 1;
+    }
+
+    for( xPair = 0; xPair < iPairs; xPair++ )
+    {
+        xQueues[ xPair ] = xQueueCreate( pairsQUEUE_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xQueues[ xPair ] != NULL );
+
+        ( void ) xTaskCreate( prvProducerTask, "producer", configMINIMAL_STACK_SIZE, ( void * ) xPair,
+                              pairsTASK_PRIORITY, NULL );
+        ( void ) xTaskCreate( prvConsumerTask, "consumer", configMINIMAL_STACK_SIZE, ( void * ) xPair,
+                              pairsTASK_PRIORITY, NULL );
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,172 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures queue sets with and without configUSE_QUEUE_SET_READY_LISTS.  A
+ * number of queues belong to one set whose length is the sum of their lengths,
+ * as a set without ready lists requires.  Each cycle sends 4 items to every
+ * queue, then selects from the set and receives from the selected queue until
+ * all the items have been received.  The heap used by the set, and the time
+ * taken to send, select and receive one item, are printed.
+ *
+ * The cycles run once before the scheduler starts, when a critical section
+ * costs no more than on a microcontroller, and again from a task, when each
+ * critical section is a system call on this port.
+ *
+ * Usage: queue_set_benchmark [queues] [queue length] [cycles]
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define benchmarkMAX_QUEUES       64
+#define benchmarkITEMS_PER_QUEUE  4U
+
+/*-----------------------------------------------------------*/
+
+static void prvRunCycles( const char * pcWhen );
+static void prvBenchmarkTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueues[ benchmarkMAX_QUEUES ];
+static QueueSetHandle_t xSet = NULL;
+static int iQueues = 8;
+static UBaseType_t uxQueueLength = 16;
+static unsigned long ulCycles = 20000;
+
+/*-----------------------------------------------------------*/
+
+static void prvRunCycles( const char * pcWhen )
+{
+    const unsigned long ulItems = ( unsigned long ) iQueues * benchmarkITEMS_PER_QUEUE;
+    QueueSetMemberHandle_t xMember;
+    uint32_t ulValue = 0;
+    uint64_t ullStart;
+    unsigned long ulCycle, ul;
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ulCycle = 0; ulCycle < ulCycles; ulCycle++ )
+    {
+        for( ul = 0; ul < ulItems; ul++ )
+        {
+            ( void ) xQueueSend( xQueues[ ul % ( unsigned long ) iQueues ], &ulValue, 0 );
+        }
+
+        for( ul = 0; ul < ulItems; ul++ )
+        {
+            xMember = xQueueSelectFromSet( xSet, 0 );
+            testCHECK( ( xMember != NULL ) && ( xQueueReceive( ( QueueHandle_t ) xMember, &ulValue, 0 ) == pdPASS ) );
+        }
+    }
+
+    ( void ) printf( "%s: %.1f ns to send, select and receive an item\n", pcWhen,
+                     ( double ) ( ullTestGetTimeNs() - ullStart ) / ( double ) ( ulCycles * ulItems ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvRunCycles( "from a task" );
+
+    /* Every item was received. */
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == NULL );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    size_t xFreeBefore;
+    int i;
+
+    if( argc > 1 )
+    {
+        iQueues = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        uxQueueLength = ( UBaseType_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    if( argc > 3 )
+    {
+        ulCycles = strtoul( argv[ 3 ], NULL, 10 );
+    }
+
+    if( ( iQueues < 1 ) || ( iQueues > benchmarkMAX_QUEUES ) || ( uxQueueLength < benchmarkITEMS_PER_QUEUE ) )
+    {
+        ( void ) printf( "queues must be from 1 to %d, and the queue length at least %u\n",
+                         benchmarkMAX_QUEUES, benchmarkITEMS_PER_QUEUE );
+        return 1;
+    }
+
+    /* Create the queues first, as heap_4 only reports its free space once
+     * something has been allocated. */
+    for( i = 0; i < iQueues; i++ )
+    {
+        xQueues[ i ] = xQueueCreate( uxQueueLength, sizeof( uint32_t ) );
+        configASSERT( xQueues[ i ] != NULL );
+    }
+
+    xFreeBefore = xPortGetFreeHeapSize();
+    xSet = xQueueCreateSet( ( UBaseType_t ) iQueues * uxQueueLength );
+    configASSERT( xSet != NULL );
+
+    ( void ) printf( "ready lists %d: %d queues of %lu items, the set used %lu bytes of heap\n",
+                     configUSE_QUEUE_SET_READY_LISTS, iQueues, ( unsigned long ) uxQueueLength,
+                     ( unsigned long ) ( xFreeBefore - xPortGetFreeHeapSize() ) );
+
+    for( i = 0; i < iQueues; i++ )
+    {
+        ( void ) xQueueAddToSet( xQueues[ i ], xSet );
+    }
+
+    prvRunCycles( "no scheduler" );
+
+    ( void ) xTaskCreate( prvBenchmarkTask, "benchmark", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
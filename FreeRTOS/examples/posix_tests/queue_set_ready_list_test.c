@@ -0,0 +1,313 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks queue sets built with configUSE_QUEUE_SET_READY_LISTS, where a set
+ * keeps a list of its members that hold items rather than a queue of events.
+ * Two queues, a third queue, a binary semaphore and a counting semaphore
+ * belong to a set whose length is 1.  A control task runs the following checks
+ * in turn:
+ *
+ * 1. Two members that each hold two items are each listed once, and are
+ *    selected in turn while they both hold items.
+ * 2. A member emptied without selecting it is dropped from the list, and a
+ *    select from an empty set blocks for its timeout.  The FromISR select
+ *    returns ready members too.
+ * 3. Members removed from the set while listed, or while listed but empty,
+ *    leave the list, and one of them can be added to and selected from a
+ *    second, statically allocated, set.
+ * 4. A producer sends 3000 items to a queue of length 20, 1500 to a queue of
+ *    length 50 and gives both semaphores, while a consumer selects from the
+ *    set and receives each item, which must arrive in order.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define setCONTROL_PRIORITY     ( tskIDLE_PRIORITY + 2 )
+#define setPRODUCER_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#define setCONSUMER_PRIORITY    ( tskIDLE_PRIORITY + 3 )
+#define setSTACK_SIZE           ( configMINIMAL_STACK_SIZE * 4 )
+#define setTIMEOUT_TICKS        ( ( TickType_t ) 20 )
+#define setTICKS_LATE           ( ( TickType_t ) 2 )
+#define setITEMS                3000U
+#define setMAX_COUNT            1000U
+
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters );
+static void prvConsumerTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueue1 = NULL, xQueue2 = NULL, xQueue3 = NULL;
+static SemaphoreHandle_t xBinary = NULL, xCounting = NULL;
+static QueueSetHandle_t xSet = NULL, xStaticSet = NULL;
+
+static volatile BaseType_t xProducerDone = pdFALSE;
+static volatile BaseType_t xConsumerDone = pdFALSE;
+static volatile uint32_t ulQueue1Items = 0, ulQueue2Items = 0;
+static volatile uint32_t ulBinaryTakes = 0, ulCountingTakes = 0;
+static volatile uint32_t ulErrors = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < setITEMS; ul++ )
+    {
+        ( void ) xQueueSend( xQueue1, &ul, portMAX_DELAY );
+
+        if( ( ul % 2U ) == 0U )
+        {
+            ( void ) xQueueSend( xQueue2, &ul, portMAX_DELAY );
+        }
+
+        /* The binary semaphore may already be given. */
+        if( ( ul % 5U ) == 0U )
+        {
+            ( void ) xSemaphoreGive( xBinary );
+        }
+
+        if( ( ul % 3U ) == 0U )
+        {
+            ( void ) xSemaphoreGive( xCounting );
+        }
+
+        if( ( ul % 37U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    xProducerDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    QueueSetMemberHandle_t xMember;
+    uint32_t ulExpected1 = 0, ulExpected2 = 0, ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xMember = xQueueSelectFromSet( xSet, 50 );
+
+        if( xMember == NULL )
+        {
+            if( xProducerDone != pdFALSE )
+            {
+                break;
+            }
+        }
+        else if( xMember == xQueue1 )
+        {
+            if( ( xQueueReceive( xQueue1, &ulValue, 0 ) != pdPASS ) || ( ulValue != ulExpected1 ) )
+            {
+                ulErrors++;
+            }
+
+            ulExpected1++;
+            ulQueue1Items++;
+        }
+        else if( xMember == xQueue2 )
+        {
+            if( ( xQueueReceive( xQueue2, &ulValue, 0 ) != pdPASS ) || ( ulValue != ulExpected2 ) )
+            {
+                ulErrors++;
+            }
+
+            ulExpected2 += 2U;
+            ulQueue2Items++;
+        }
+        else if( xMember == xBinary )
+        {
+            if( xSemaphoreTake( xBinary, 0 ) != pdPASS )
+            {
+                ulErrors++;
+            }
+
+            ulBinaryTakes++;
+        }
+        else if( xMember == xCounting )
+        {
+            if( xSemaphoreTake( xCounting, 0 ) != pdPASS )
+            {
+                ulErrors++;
+            }
+
+            ulCountingTakes++;
+        }
+        else
+        {
+            ulErrors++;
+        }
+    }
+
+    xConsumerDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    QueueSetMemberHandle_t xFirst, xSecond, xThird;
+    TickType_t xStart, xElapsed;
+    uint32_t ulValue = 1;
+
+    ( void ) pvParameters;
+
+    /* 1. Each member is listed once however many items it holds, so a set of
+     * length 1 reports two ready members, and the two are selected in turn. */
+    ( void ) xQueueSend( xQueue1, &ulValue, 0 );
+    ( void ) xQueueSend( xQueue1, &ulValue, 0 );
+    ( void ) xQueueSend( xQueue2, &ulValue, 0 );
+    ( void ) xQueueSend( xQueue2, &ulValue, 0 );
+    testCHECK( uxQueueMessagesWaiting( xSet ) == 2U );
+    testCHECK( uxQueueSpacesAvailable( xSet ) == 0U );
+
+    xFirst = xQueueSelectFromSet( xSet, 0 );
+    xSecond = xQueueSelectFromSet( xSet, 0 );
+    xThird = xQueueSelectFromSet( xSet, 0 );
+    testCHECK( ( xFirst == xQueue1 ) && ( xSecond == xQueue2 ) && ( xThird == xQueue1 ) );
+
+    /* 2. Members emptied directly are dropped when the set is next selected
+     * from. */
+    while( xQueueReceive( xQueue1, &ulValue, 0 ) == pdPASS )
+    {
+    }
+
+    while( xQueueReceive( xQueue2, &ulValue, 0 ) == pdPASS )
+    {
+    }
+
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == NULL );
+    testCHECK( uxQueueMessagesWaiting( xSet ) == 0U );
+
+    xStart = xTaskGetTickCount();
+    testCHECK( xQueueSelectFromSet( xSet, setTIMEOUT_TICKS ) == NULL );
+    xElapsed = xTaskGetTickCount() - xStart;
+    testCHECK( ( xElapsed >= setTIMEOUT_TICKS ) && ( xElapsed <= ( setTIMEOUT_TICKS + setTICKS_LATE ) ) );
+
+    ( void ) xQueueSend( xQueue2, &ulValue, 0 );
+    testCHECK( xQueueSelectFromSetFromISR( xSet ) == xQueue2 );
+    ( void ) xQueueReceive( xQueue2, &ulValue, 0 );
+    testCHECK( xQueueSelectFromSetFromISR( xSet ) == NULL );
+
+    /* 3. Remove listed members, one of them already emptied, from the middle
+     * and the end of the list. */
+    ( void ) xQueueSend( xQueue1, &ulValue, 0 );
+    ( void ) xQueueSend( xQueue3, &ulValue, 0 );
+    ( void ) xQueueSend( xQueue2, &ulValue, 0 );
+    ( void ) xQueueReceive( xQueue3, &ulValue, 0 );
+    testCHECK( xQueueRemoveFromSet( xQueue3, xSet ) == pdPASS );
+    ( void ) xQueueReceive( xQueue2, &ulValue, 0 );
+    testCHECK( xQueueRemoveFromSet( xQueue2, xSet ) == pdPASS );
+    testCHECK( uxQueueMessagesWaiting( xSet ) == 1U );
+
+    testCHECK( xQueueAddToSet( xQueue3, xStaticSet ) == pdPASS );
+    ( void ) xQueueSend( xQueue3, &ulValue, 0 );
+    testCHECK( xQueueSelectFromSet( xStaticSet, 0 ) == xQueue3 );
+    ( void ) xQueueReceive( xQueue3, &ulValue, 0 );
+
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == xQueue1 );
+    ( void ) xQueueReceive( xQueue1, &ulValue, 0 );
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == NULL );
+    testCHECK( xQueueAddToSet( xQueue2, xSet ) == pdPASS );
+
+    /* 4. Members far longer than the set. */
+    ( void ) xTaskCreate( prvConsumerTask, "consumer", setSTACK_SIZE, NULL, setCONSUMER_PRIORITY, NULL );
+    ( void ) xTaskCreate( prvProducerTask, "producer", setSTACK_SIZE, NULL, setPRODUCER_PRIORITY, NULL );
+
+    while( xConsumerDone == pdFALSE )
+    {
+        vTaskDelay( 10 );
+    }
+
+    testCHECK( ulQueue1Items == setITEMS );
+    testCHECK( ulQueue2Items == ( setITEMS / 2U ) );
+    testCHECK( ulCountingTakes == ( setITEMS / 3U ) );
+    testCHECK( ( ulBinaryTakes > 0U ) && ( ulBinaryTakes <= ( setITEMS / 5U ) ) );
+    testCHECK( ulErrors == 0U );
+
+    ( void ) printf( "%lu and %lu items, %lu and %lu semaphore takes, %lu errors\n",
+                     ( unsigned long ) ulQueue1Items, ( unsigned long ) ulQueue2Items,
+                     ( unsigned long ) ulBinaryTakes, ( unsigned long ) ulCountingTakes,
+                     ( unsigned long ) ulErrors );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static StaticQueue_t xStaticSetBuffer;
+
+    xQueue1 = xQueueCreate( 20, sizeof( uint32_t ) );
+    xQueue2 = xQueueCreate( 50, sizeof( uint32_t ) );
+    xQueue3 = xQueueCreate( 4, sizeof( uint32_t ) );
+    xBinary = xSemaphoreCreateBinary();
+    xCounting = xSemaphoreCreateCounting( setMAX_COUNT, 0 );
+
+    /* A set of ready lists needs no storage area, whatever its length. */
+    xSet = xQueueCreateSet( 1 );
+    xStaticSet = xQueueCreateSetStatic( 1, NULL, &xStaticSetBuffer );
+    configASSERT( ( xSet != NULL ) && ( xStaticSet != NULL ) );
+
+    ( void ) xQueueAddToSet( xQueue1, xSet );
+    ( void ) xQueueAddToSet( xQueue2, xSet );
+    ( void ) xQueueAddToSet( xQueue3, xSet );
+    ( void ) xQueueAddToSet( xBinary, xSet );
+    ( void ) xQueueAddToSet( xCounting, xSet );
+
+    ( void ) xTaskCreate( prvControlTask, "control", setSTACK_SIZE, NULL, setCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
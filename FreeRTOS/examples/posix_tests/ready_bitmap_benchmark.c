@@ -0,0 +1,123 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures how long the scheduler takes to find the next task to run, with
+ * and without configUSE_READY_PRIORITY_BITMAP.  The scheduler is not started.
+ * Instead the program includes tasks.c and drives the ready lists directly.
+ * A task at a low priority is always ready.  A task at a high priority is
+ * repeatedly made ready, selected, removed from the ready list again, and the
+ * next task selected, as happens when a high priority task handles an event.
+ *
+ * Usage: ready_bitmap_benchmark [low priority] [high priority]
+ * Prints the time taken by one ready, select, remove, select cycle.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The kernel, so its ready lists can be used directly. */
+#include "tasks.c"
+
+#include "test_support.h"
+
+#define benchmarkCYCLES    5000000UL
+
+/*-----------------------------------------------------------*/
+
+static void prvIdleWorkTask( void * pvParameters );
+static void prvRemoveFromReadyList( TCB_t * pxTCB );
+
+/*-----------------------------------------------------------*/
+
+static void prvIdleWorkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFromReadyList( TCB_t * pxTCB )
+{
+    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    {
+        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    UBaseType_t uxLowPriority = 1U;
+    UBaseType_t uxHighPriority = ( UBaseType_t ) ( configMAX_PRIORITIES - 1 );
+    TaskHandle_t xHighTask;
+    TCB_t * pxHighTCB;
+    uint64_t ullStart, ullElapsed;
+    unsigned long ulCycle;
+
+    if( argc > 2 )
+    {
+        uxLowPriority = ( UBaseType_t ) strtoul( argv[ 1 ], NULL, 10 );
+        uxHighPriority = ( UBaseType_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    configASSERT( ( uxLowPriority < uxHighPriority ) && ( uxHighPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+    ( void ) xTaskCreate( prvIdleWorkTask, "low", configMINIMAL_STACK_SIZE, NULL, uxLowPriority, NULL );
+    ( void ) xTaskCreate( prvIdleWorkTask, "high", configMINIMAL_STACK_SIZE, NULL, uxHighPriority, &xHighTask );
+    pxHighTCB = xHighTask;
+
+    prvRemoveFromReadyList( pxHighTCB );
+    taskSELECT_HIGHEST_PRIORITY_TASK();
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ulCycle = 0UL; ulCycle < benchmarkCYCLES; ulCycle++ )
+    {
+        prvAddTaskToReadyList( pxHighTCB );
+        taskSELECT_HIGHEST_PRIORITY_TASK();
+        configASSERT( pxCurrentTCB == pxHighTCB );
+        prvRemoveFromReadyList( pxHighTCB );
+        taskSELECT_HIGHEST_PRIORITY_TASK();
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+
+    ( void ) printf( "ready bitmap %d, %d priorities, low %lu, high %lu: %.1f ns per cycle\n",
+                     configUSE_READY_PRIORITY_BITMAP, configMAX_PRIORITIES,
+                     ( unsigned long ) uxLowPriority, ( unsigned long ) uxHighPriority,
+                     ( double ) ullElapsed / ( double ) benchmarkCYCLES );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,185 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks that the highest priority Ready state task always runs when
+ * configUSE_READY_PRIORITY_BITMAP is 1.  A control task at the highest
+ * priority gives worker tasks new random priorities and resumes them all with
+ * the scheduler suspended.  It then blocks and lets them run.  Each worker
+ * records its priority when it runs and suspends itself again, so the
+ * recorded priorities must never increase.  The control task also has a mutex
+ * holder inherit a priority and give it back each round, which moves the
+ * holder between ready lists.
+ *
+ * Built with configUSE_TIME_SLICING set to 0.  The POSIX port switches tasks on
+ * a tick from another thread, so a time slice switch between two workers of
+ * equal priority can let one record its priority after a lower priority worker
+ * has run.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define bitmapNUM_WORKERS         120
+#define bitmapNUM_ROUNDS          200
+#define bitmapCONTROL_PRIORITY    ( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+static UBaseType_t prvRandomWorkerPriority( void );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xWorkers[ bitmapNUM_WORKERS ];
+static SemaphoreHandle_t xMutex = NULL;
+static uint32_t ulSeed = 1UL;
+
+/* The priority of each worker that runs, in the order in which they ran. */
+static volatile UBaseType_t uxRunLog[ bitmapNUM_WORKERS * 2 ];
+static volatile UBaseType_t uxRunLogLength = 0U;
+
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvRandomWorkerPriority( void )
+{
+    ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+
+    /* Between 1 and bitmapCONTROL_PRIORITY - 1 inclusive. */
+    return ( UBaseType_t ) ( 1U + ( ( ulSeed >> 8 ) % ( UBaseType_t ) ( configMAX_PRIORITIES - 2 ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+
+    for( ; ; )
+    {
+        if( uxRunLogLength < ( bitmapNUM_WORKERS * 2 ) )
+        {
+            uxRunLog[ uxRunLogLength ] = uxTaskPriorityGet( NULL );
+            uxRunLogLength++;
+        }
+
+        /* Yielding must not let a lower priority task run. */
+        if( ( uxIndex % 7U ) == 0U )
+        {
+            taskYIELD();
+        }
+
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    UBaseType_t uxIndex, uxOrderViolations = 0U;
+    int iRound;
+
+    ( void ) pvParameters;
+
+    for( iRound = 0; iRound < bitmapNUM_ROUNDS; iRound++ )
+    {
+        vTaskSuspendAll();
+        {
+            for( uxIndex = 0U; uxIndex < bitmapNUM_WORKERS; uxIndex++ )
+            {
+                if( ( uxIndex % 3U ) == ( ( UBaseType_t ) iRound % 3U ) )
+                {
+                    vTaskPrioritySet( xWorkers[ uxIndex ], prvRandomWorkerPriority() );
+                }
+
+                vTaskResume( xWorkers[ uxIndex ] );
+            }
+
+            uxRunLogLength = 0U;
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Let every worker run once. */
+        vTaskDelay( pdMS_TO_TICKS( 20 ) );
+
+        testCHECK( uxRunLogLength == bitmapNUM_WORKERS );
+
+        for( uxIndex = 1U; uxIndex < uxRunLogLength; uxIndex++ )
+        {
+            if( uxRunLog[ uxIndex ] > uxRunLog[ uxIndex - 1U ] )
+            {
+                uxOrderViolations++;
+            }
+        }
+
+        /* Drop to the lowest worker priority while holding the mutex, then
+         * return to the control priority, which moves this task between the
+         * ready lists at both ends of the bitmap. */
+        testCHECK( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+        vTaskPrioritySet( NULL, tskIDLE_PRIORITY + 1 );
+        testCHECK( uxTaskPriorityGet( NULL ) == ( tskIDLE_PRIORITY + 1 ) );
+        vTaskPrioritySet( NULL, bitmapCONTROL_PRIORITY );
+        testCHECK( xSemaphoreGive( xMutex ) == pdPASS );
+    }
+
+    testCHECK( uxOrderViolations == 0U );
+
+    ( void ) printf( "ready bitmap %d: %d priorities, %d rounds, %lu order violations\n",
+                     configUSE_READY_PRIORITY_BITMAP, configMAX_PRIORITIES, iRound,
+                     ( unsigned long ) uxOrderViolations );
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    UBaseType_t uxIndex;
+
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( xMutex != NULL );
+
+    for( uxIndex = 0U; uxIndex < bitmapNUM_WORKERS; uxIndex++ )
+    {
+        ( void ) xTaskCreate( prvWorkerTask, "worker", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) uxIndex,
+                              prvRandomWorkerPriority(), &( xWorkers[ uxIndex ] ) );
+    }
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, bitmapCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,279 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures read throughput with many reader tasks sharing a table guarded by a
+ * reader-writer lock, against the same table guarded by a mutex.  Reader tasks
+ * at one priority repeatedly lock the table, sum it and unlock it.  A writer
+ * at a higher priority wakes every 10 ticks and adds one to every entry, and
+ * each reader checks it never sees a table part way through a write.
+ *
+ * A reader can optionally hold the table for some ticks after summing it, as a
+ * reader that waits on a peripheral would.  Readers holding a reader-writer
+ * lock then wait together, while readers holding a mutex wait one after
+ * another.
+ *
+ * Usage: rwlock_benchmark [readers] [hold ticks] [run ticks] [mutex]
+ * Prints the reads and writes made each second.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rwlock.h"
+
+#include "test_support.h"
+
+#define benchmarkTABLE_ENTRIES      256
+#define benchmarkWRITE_PERIOD       ( ( TickType_t ) 10 )
+#define benchmarkREADER_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define benchmarkWRITER_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#define benchmarkCONTROL_PRIORITY   ( tskIDLE_PRIORITY + 3 )
+
+/*-----------------------------------------------------------*/
+
+static void prvTakeRead( void );
+static void prvGiveRead( void );
+static void prvTakeWrite( void );
+static void prvGiveWrite( void );
+static void prvReaderTask( void * pvParameters );
+static void prvWriterTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static RwLockHandle_t xLock = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static BaseType_t xUseMutex = pdFALSE;
+static int iReaders = 8;
+static TickType_t xHoldTicks = 0;
+static TickType_t xRunTicks = 2000;
+
+static volatile uint32_t ulTable[ benchmarkTABLE_ENTRIES ];
+static volatile unsigned long ulReads = 0;
+static volatile unsigned long ulWrites = 0;
+static volatile unsigned long ulTornReads = 0;
+static volatile BaseType_t xStop = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static void prvTakeRead( void )
+{
+    if( xUseMutex != pdFALSE )
+    {
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+    }
+    else
+    {
+        ( void ) xRwLockTakeRead( xLock, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveRead( void )
+{
+    if( xUseMutex != pdFALSE )
+    {
+        ( void ) xSemaphoreGive( xMutex );
+    }
+    else
+    {
+        ( void ) xRwLockGiveRead( xLock );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTakeWrite( void )
+{
+    if( xUseMutex != pdFALSE )
+    {
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+    }
+    else
+    {
+        ( void ) xRwLockTakeWrite( xLock, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveWrite( void )
+{
+    if( xUseMutex != pdFALSE )
+    {
+        ( void ) xSemaphoreGive( xMutex );
+    }
+    else
+    {
+        ( void ) xRwLockGiveWrite( xLock );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    uint32_t ulFirst, ulSum;
+    int i;
+
+    ( void ) pvParameters;
+
+    while( xStop == pdFALSE )
+    {
+        prvTakeRead();
+
+        ulFirst = ulTable[ 0 ];
+        ulSum = 0;
+
+        for( i = 0; i < benchmarkTABLE_ENTRIES; i++ )
+        {
+            ulSum += ulTable[ i ];
+        }
+
+        if( xHoldTicks > 0U )
+        {
+            vTaskDelay( xHoldTicks );
+        }
+
+        prvGiveRead();
+
+        if( ulSum != ( ulFirst * benchmarkTABLE_ENTRIES ) )
+        {
+            ulTornReads++;
+        }
+
+        ulReads++;
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    int i;
+
+    ( void ) pvParameters;
+
+    while( xStop == pdFALSE )
+    {
+        vTaskDelayUntil( &xLastWake, benchmarkWRITE_PERIOD );
+
+        prvTakeWrite();
+
+        for( i = 0; i < benchmarkTABLE_ENTRIES; i++ )
+        {
+            ulTable[ i ]++;
+
+            /* Give the readers every chance to see a partial write. */
+            if( ( i % 64 ) == 63 )
+            {
+                taskYIELD();
+            }
+        }
+
+        prvGiveWrite();
+
+        ulWrites++;
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    const double dSeconds = ( double ) xRunTicks / ( double ) configTICK_RATE_HZ;
+    int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < iReaders; i++ )
+    {
+        ( void ) xTaskCreate( prvReaderTask, "reader", configMINIMAL_STACK_SIZE, NULL, benchmarkREADER_PRIORITY, NULL );
+    }
+
+    ( void ) xTaskCreate( prvWriterTask, "writer", configMINIMAL_STACK_SIZE, NULL, benchmarkWRITER_PRIORITY, NULL );
+
+    vTaskDelay( xRunTicks );
+    xStop = pdTRUE;
+
+    ( void ) printf( "%s, %d readers holding for %lu ticks: %.0f reads and %.0f writes per second\n",
+                     ( xUseMutex != pdFALSE ) ? "mutex" : "reader-writer lock", iReaders,
+                     ( unsigned long ) xHoldTicks, ( double ) ulReads / dSeconds, ( double ) ulWrites / dSeconds );
+
+    /* The writer preference means writes are not starved by the readers. */
+    testCHECK( ulReads > 0U );
+    testCHECK( ulWrites >= ( unsigned long ) ( xRunTicks / benchmarkWRITE_PERIOD / 2U ) );
+    testCHECK( ulTornReads == 0U );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        iReaders = atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        xHoldTicks = ( TickType_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    if( argc > 3 )
+    {
+        xRunTicks = ( TickType_t ) strtoul( argv[ 3 ], NULL, 10 );
+    }
+
+    if( argc > 4 )
+    {
+        xUseMutex = ( strcmp( argv[ 4 ], "mutex" ) == 0 ) ? pdTRUE : pdFALSE;
+    }
+
+    configASSERT( ( iReaders > 0 ) && ( xRunTicks >= benchmarkWRITE_PERIOD ) );
+
+    xLock = xRwLockCreate();
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( ( xLock != NULL ) && ( xMutex != NULL ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 2, NULL, benchmarkCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
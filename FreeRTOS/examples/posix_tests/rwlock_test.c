@@ -0,0 +1,268 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks reader-writer locks.  A control task at priority 2:
+ *
+ * 1. Creates, takes and deletes a statically allocated lock.
+ * 2. Takes the lock for reading twice and checks a writer cannot take it, then
+ *    for writing and checks neither readers nor a second writer can.
+ * 3. Holds the lock for reading while a writer blocks for it, and checks that
+ *    a new reader is then held back.  When the last reader gives the lock the
+ *    writer has it first, then the readers that blocked behind it, in
+ *    priority order.
+ * 4. Lets a writer time out while waiting behind a reader, and checks the
+ *    reader that was held back behind it then takes the lock.
+ * 5. Holds the lock for writing while a higher priority reader blocks for it,
+ *    and checks the control task inherits the reader's priority until it
+ *    gives the lock.
+ * 6. Holds the lock for writing while a higher priority writer waits for it
+ *    with a timeout, and checks the inherited priority is dropped when that
+ *    writer times out.
+ * 7. Holds the lock for reading while a higher priority writer blocks for it,
+ *    and checks the reader does not inherit and the writer runs as soon as
+ *    the lock is given.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#include "test_support.h"
+
+#define rwCONTROL_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#define rwMAX_EVENTS          16
+
+/* The events that the tasks log, with the reader events numbered by the
+ * reader. */
+#define rwEVENT_WRITER_TOOK       10
+#define rwEVENT_WRITER_GAVE       11
+#define rwEVENT_READER            20
+#define rwEVENT_WRITER_TIMED_OUT  30
+#define rwEVENT_HIGH_WRITER       40
+
+/*-----------------------------------------------------------*/
+
+static void prvLogEvent( int iEvent );
+static void prvWriterTask( void * pvParameters );
+static void prvReaderTask( void * pvParameters );
+static void prvTimeoutWriterTask( void * pvParameters );
+static void prvHighWriterTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static RwLockHandle_t xLock = NULL;
+static StaticRwLock_t xStaticLock;
+static TaskHandle_t xControlTask = NULL;
+static volatile int iEvents[ rwMAX_EVENTS ];
+static volatile int iEventCount = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvLogEvent( int iEvent )
+{
+    configASSERT( iEventCount < rwMAX_EVENTS );
+    iEvents[ iEventCount ] = iEvent;
+    iEventCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    testCHECK( xRwLockTakeWrite( xLock, portMAX_DELAY ) == pdPASS );
+    prvLogEvent( rwEVENT_WRITER_TOOK );
+    testCHECK( xRwLockGetWriter( xLock ) == xTaskGetCurrentTaskHandle() );
+
+    /* Let the readers that are waiting run if they could. */
+    vTaskDelay( 5 );
+
+    prvLogEvent( rwEVENT_WRITER_GAVE );
+    testCHECK( xRwLockGiveWrite( xLock ) == pdPASS );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    testCHECK( xRwLockTakeRead( xLock, portMAX_DELAY ) == pdPASS );
+    prvLogEvent( ( int ) ( intptr_t ) pvParameters );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimeoutWriterTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    testCHECK( xRwLockTakeWrite( xLock, 20 ) == pdFAIL );
+    prvLogEvent( rwEVENT_WRITER_TIMED_OUT );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighWriterTask( void * pvParameters )
+{
+    const TickType_t xTicksToWait = ( TickType_t ) ( uintptr_t ) pvParameters;
+
+    if( xTicksToWait == portMAX_DELAY )
+    {
+        testCHECK( xRwLockTakeWrite( xLock, xTicksToWait ) == pdPASS );
+        prvLogEvent( rwEVENT_HIGH_WRITER );
+        testCHECK( xRwLockGiveWrite( xLock ) == pdPASS );
+    }
+    else
+    {
+        testCHECK( xRwLockTakeWrite( xLock, xTicksToWait ) == pdFAIL );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    RwLockHandle_t xStatic;
+
+    ( void ) pvParameters;
+
+    /* 1. Static allocation. */
+    xStatic = xRwLockCreateStatic( &xStaticLock );
+    testCHECK( xStatic != NULL );
+    testCHECK( xRwLockTakeWrite( xStatic, 0 ) == pdPASS );
+    testCHECK( xRwLockGiveWrite( xStatic ) == pdPASS );
+    vRwLockDelete( xStatic );
+
+    /* 2. Readers share the lock and a writer has it alone. */
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdPASS );
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdPASS );
+    testCHECK( uxRwLockGetReaderCount( xLock ) == 2U );
+    testCHECK( xRwLockTakeWrite( xLock, 0 ) == pdFAIL );
+    testCHECK( xRwLockTakeWrite( xLock, 5 ) == pdFAIL );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+    testCHECK( xRwLockGiveRead( xLock ) == pdFAIL );
+
+    testCHECK( xRwLockTakeWrite( xLock, 0 ) == pdPASS );
+    testCHECK( xRwLockGetWriter( xLock ) == xControlTask );
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdFAIL );
+    testCHECK( xRwLockTakeRead( xLock, 3 ) == pdFAIL );
+    testCHECK( xRwLockGiveWrite( xLock ) == pdPASS );
+    testCHECK( xRwLockGiveWrite( xLock ) == pdFAIL );
+    testCHECK( xRwLockGetWriter( xLock ) == NULL );
+
+    /* 3. A waiting writer holds back new readers and has the lock before
+     * the readers that blocked after it. */
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdPASS );
+    ( void ) xTaskCreate( prvWriterTask, "writer", configMINIMAL_STACK_SIZE, NULL, rwCONTROL_PRIORITY + 1, NULL );
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdFAIL );
+    ( void ) xTaskCreate( prvReaderTask, "reader1", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) ( rwEVENT_READER + 1 ),
+                          rwCONTROL_PRIORITY + 1, NULL );
+    ( void ) xTaskCreate( prvReaderTask, "reader2", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) ( rwEVENT_READER + 2 ),
+                          rwCONTROL_PRIORITY + 2, NULL );
+    testCHECK( iEventCount == 0 );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+    vTaskDelay( 20 );
+    testCHECK( iEventCount == 4 );
+    testCHECK( ( iEvents[ 0 ] == rwEVENT_WRITER_TOOK ) && ( iEvents[ 1 ] == rwEVENT_WRITER_GAVE ) );
+    testCHECK( ( iEvents[ 2 ] == ( rwEVENT_READER + 2 ) ) && ( iEvents[ 3 ] == ( rwEVENT_READER + 1 ) ) );
+
+    /* 4. A writer that times out lets in the readers it held back. */
+    iEventCount = 0;
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdPASS );
+    ( void ) xTaskCreate( prvTimeoutWriterTask, "timeout", configMINIMAL_STACK_SIZE, NULL, rwCONTROL_PRIORITY + 1, NULL );
+    ( void ) xTaskCreate( prvReaderTask, "reader3", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) ( rwEVENT_READER + 3 ),
+                          rwCONTROL_PRIORITY + 1, NULL );
+    testCHECK( iEventCount == 0 );
+    vTaskDelay( 40 );
+    testCHECK( iEventCount == 2 );
+    testCHECK( ( iEvents[ 0 ] == rwEVENT_WRITER_TIMED_OUT ) && ( iEvents[ 1 ] == ( rwEVENT_READER + 3 ) ) );
+    testCHECK( uxRwLockGetReaderCount( xLock ) == 1U );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+
+    /* 5. The writer inherits the priority of a reader waiting for it. */
+    iEventCount = 0;
+    testCHECK( xRwLockTakeWrite( xLock, 0 ) == pdPASS );
+    ( void ) xTaskCreate( prvReaderTask, "reader4", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) ( rwEVENT_READER + 4 ),
+                          rwCONTROL_PRIORITY + 3, NULL );
+    testCHECK( uxTaskPriorityGet( NULL ) == ( rwCONTROL_PRIORITY + 3 ) );
+    testCHECK( xRwLockGiveWrite( xLock ) == pdPASS );
+    testCHECK( uxTaskPriorityGet( NULL ) == rwCONTROL_PRIORITY );
+    testCHECK( ( iEventCount == 1 ) && ( iEvents[ 0 ] == ( rwEVENT_READER + 4 ) ) );
+
+    /* 6. The inherited priority is dropped when the waiting writer times
+     * out. */
+    testCHECK( xRwLockTakeWrite( xLock, 0 ) == pdPASS );
+    ( void ) xTaskCreate( prvHighWriterTask, "high1", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) 10,
+                          rwCONTROL_PRIORITY + 4, NULL );
+    testCHECK( uxTaskPriorityGet( NULL ) == ( rwCONTROL_PRIORITY + 4 ) );
+    vTaskDelay( 30 );
+    testCHECK( uxTaskPriorityGet( NULL ) == rwCONTROL_PRIORITY );
+    testCHECK( xRwLockGiveWrite( xLock ) == pdPASS );
+    testCHECK( uxTaskPriorityGet( NULL ) == rwCONTROL_PRIORITY );
+
+    /* 7. Readers are not tracked, so do not inherit, but the last one to give
+     * the lock hands it to the waiting writer. */
+    iEventCount = 0;
+    testCHECK( xRwLockTakeRead( xLock, 0 ) == pdPASS );
+    ( void ) xTaskCreate( prvHighWriterTask, "high2", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) portMAX_DELAY,
+                          rwCONTROL_PRIORITY + 4, NULL );
+    testCHECK( uxTaskPriorityGet( NULL ) == rwCONTROL_PRIORITY );
+    testCHECK( iEventCount == 0 );
+    testCHECK( xRwLockGiveRead( xLock ) == pdPASS );
+    testCHECK( ( iEventCount == 1 ) && ( iEvents[ 0 ] == rwEVENT_HIGH_WRITER ) );
+    testCHECK( ( xRwLockGetWriter( xLock ) == NULL ) && ( uxRwLockGetReaderCount( xLock ) == 0U ) );
+
+    vRwLockDelete( xLock );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xLock = xRwLockCreate();
+    configASSERT( xLock != NULL );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 2, NULL, rwCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
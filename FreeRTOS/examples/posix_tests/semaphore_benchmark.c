@@ -0,0 +1,153 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures uncontended give and take pairs on a binary semaphore, a counting
+ * semaphore and a mutex, with and without configUSE_SEMAPHORE_FAST_PATH.  No
+ * task waits for any of them, so with the fast path the semaphores change
+ * their count with a compare and swap and do not enter a critical section.
+ * Mutexes always take the full path and are measured for comparison.
+ *
+ * The pairs run once before the scheduler starts, when a critical section
+ * costs no more than on a microcontroller, and again from a task, when each
+ * critical section is a system call on this port.
+ *
+ * Usage: semaphore_benchmark [pairs]
+ * Prints the time taken by one give and take pair.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_PAIRS      1000000UL
+#define benchmarkCOUNTING_MAX       4
+
+/*-----------------------------------------------------------*/
+
+static double prvRunPairs( SemaphoreHandle_t xSemaphore );
+static void prvRunAll( const char * pcWhen );
+static void prvBenchmarkTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xBinary = NULL;
+static SemaphoreHandle_t xCounting = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static unsigned long ulPairs = benchmarkDEFAULT_PAIRS;
+
+/*-----------------------------------------------------------*/
+
+static double prvRunPairs( SemaphoreHandle_t xSemaphore )
+{
+    const UBaseType_t uxCountBefore = uxSemaphoreGetCount( xSemaphore );
+    unsigned long ulPassed = 0;
+    uint64_t ullStart, ullElapsed;
+    unsigned long ul;
+
+    ullStart = ullTestGetTimeNs();
+
+    for( ul = 0; ul < ulPairs; ul++ )
+    {
+        /* A mutex is created available, so is taken first. */
+        if( xSemaphoreTake( xSemaphore, 0 ) == pdPASS )
+        {
+            ulPassed++;
+        }
+
+        if( xSemaphoreGive( xSemaphore ) == pdPASS )
+        {
+            ulPassed++;
+        }
+    }
+
+    ullElapsed = ullTestGetTimeNs() - ullStart;
+
+    testCHECK( ulPassed == ( 2UL * ulPairs ) );
+    testCHECK( uxSemaphoreGetCount( xSemaphore ) == uxCountBefore );
+
+    return ( double ) ullElapsed / ( double ) ulPairs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunAll( const char * pcWhen )
+{
+    double dBinaryNs, dCountingNs, dMutexNs;
+
+    dBinaryNs = prvRunPairs( xBinary );
+    dCountingNs = prvRunPairs( xCounting );
+    dMutexNs = prvRunPairs( xMutex );
+
+    ( void ) printf( "semaphore fast path %d, %s: binary %.1f ns, counting %.1f ns, mutex %.1f ns per take and give\n",
+                     configUSE_SEMAPHORE_FAST_PATH, pcWhen, dBinaryNs, dCountingNs, dMutexNs );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvRunAll( "from a task" );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        ulPairs = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    configASSERT( ulPairs > 0U );
+
+    /* Both semaphores start with a count to take. */
+    xBinary = xSemaphoreCreateBinary();
+    xCounting = xSemaphoreCreateCounting( benchmarkCOUNTING_MAX, benchmarkCOUNTING_MAX / 2 );
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( ( xBinary != NULL ) && ( xCounting != NULL ) && ( xMutex != NULL ) );
+    ( void ) xSemaphoreGive( xBinary );
+
+    prvRunAll( "no scheduler" );
+
+    ( void ) xTaskCreate( prvBenchmarkTask, "benchmark", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
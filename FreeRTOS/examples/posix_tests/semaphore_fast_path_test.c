@@ -0,0 +1,226 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks binary and counting semaphores with configUSE_SEMAPHORE_FAST_PATH,
+ * which gives and takes a semaphore that no task is waiting for with a compare
+ * and swap of its count.  A control task:
+ *
+ * 1. Gives and takes a binary semaphore until it is full and empty, and checks
+ *    each give or take that has to fail does.
+ * 2. Fills a counting semaphore, then checks its count and, when
+ *    configUSE_QUEUE_STATS is 1, its high water mark and failed gives.
+ * 3. Lets a task at a higher priority block giving to the full counting
+ *    semaphore, then takes from it and checks the task ran at once.
+ * 4. Lets a task at a higher priority block taking the empty binary semaphore,
+ *    then gives it and checks the task ran at once.
+ * 5. Gives the binary semaphore from an interrupt.
+ * 6. Adds the binary semaphore to a queue set and checks a give is seen by
+ *    the set.
+ * 7. Takes a mutex, which keeps the full path, and checks it records its
+ *    holder and that the holder inherits the priority of a task waiting for
+ *    it.
+ *
+ * Built with the trace facility on, when the count is changed with interrupts
+ * masked, and off, when it is changed with the compiler's compare and swap.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "test_support.h"
+
+#define semCOUNTING_MAX         5
+#define semCONTROL_PRIORITY     ( tskIDLE_PRIORITY + 2 )
+#define semHELPER_PRIORITY      ( tskIDLE_PRIORITY + 3 )
+#define semHELPER_WAIT_TICKS    ( ( TickType_t ) 500 )
+
+/*-----------------------------------------------------------*/
+
+static void prvTakeTask( void * pvParameters );
+static void prvGiveTask( void * pvParameters );
+static void prvMutexTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xBinary = NULL;
+static SemaphoreHandle_t xCounting = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static QueueSetHandle_t xSet = NULL;
+
+/* Set by each helper task once its give or take has returned. */
+static volatile BaseType_t xTakeDone = pdFALSE;
+static volatile BaseType_t xGiveDone = pdFALSE;
+static volatile BaseType_t xMutexDone = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static void prvTakeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    testCHECK( xSemaphoreTake( xBinary, semHELPER_WAIT_TICKS ) == pdPASS );
+    xTakeDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* xSemaphoreGive() does not wait, so give with a block time directly. */
+    testCHECK( xQueueGenericSend( xCounting, NULL, semHELPER_WAIT_TICKS, queueSEND_TO_BACK ) == pdPASS );
+    xGiveDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    testCHECK( xSemaphoreTake( xMutex, semHELPER_WAIT_TICKS ) == pdPASS );
+    xMutexDone = pdTRUE;
+    testCHECK( xSemaphoreGive( xMutex ) == pdPASS );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    int i;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats;
+    #endif
+
+    ( void ) pvParameters;
+
+    /* 1. A binary semaphore is created empty. */
+    testCHECK( xSemaphoreTake( xBinary, 0 ) == pdFAIL );
+    testCHECK( xSemaphoreGive( xBinary ) == pdPASS );
+    testCHECK( xSemaphoreGive( xBinary ) == pdFAIL );
+    testCHECK( xSemaphoreTake( xBinary, 0 ) == pdPASS );
+    testCHECK( xSemaphoreTake( xBinary, 0 ) == pdFAIL );
+
+    /* 2. The fast path still keeps the statistics. */
+    for( i = 0; i < semCOUNTING_MAX; i++ )
+    {
+        testCHECK( xSemaphoreGive( xCounting ) == pdPASS );
+    }
+
+    testCHECK( xSemaphoreGive( xCounting ) == pdFAIL );
+    testCHECK( uxSemaphoreGetCount( xCounting ) == semCOUNTING_MAX );
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        vQueueGetStats( xCounting, &xStats );
+        testCHECK( xStats.uxMessagesWaitingHighWaterMark == semCOUNTING_MAX );
+        testCHECK( xStats.ulSendsFailedFull == 1U );
+    }
+    #endif
+
+    /* 3. A take unblocks a task waiting to give to the full semaphore, which
+     * preempts this task as soon as the take returns. */
+    ( void ) xTaskCreate( prvGiveTask, "give", configMINIMAL_STACK_SIZE, NULL, semHELPER_PRIORITY, NULL );
+    testCHECK( xGiveDone == pdFALSE );
+    testCHECK( xSemaphoreTake( xCounting, 0 ) == pdPASS );
+    testCHECK( xGiveDone != pdFALSE );
+    testCHECK( uxSemaphoreGetCount( xCounting ) == semCOUNTING_MAX );
+
+    for( i = 0; i < semCOUNTING_MAX; i++ )
+    {
+        testCHECK( xSemaphoreTake( xCounting, 0 ) == pdPASS );
+    }
+
+    testCHECK( xSemaphoreTake( xCounting, 0 ) == pdFAIL );
+
+    /* 4. A give unblocks a task waiting to take the empty semaphore. */
+    ( void ) xTaskCreate( prvTakeTask, "take", configMINIMAL_STACK_SIZE, NULL, semHELPER_PRIORITY, NULL );
+    testCHECK( xTakeDone == pdFALSE );
+    testCHECK( xSemaphoreGive( xBinary ) == pdPASS );
+    testCHECK( xTakeDone != pdFALSE );
+    testCHECK( uxSemaphoreGetCount( xBinary ) == 0U );
+
+    /* 5. Gives from an interrupt keep the path they had. */
+    testCHECK( xSemaphoreGiveFromISR( xBinary, &xHigherPriorityTaskWoken ) == pdPASS );
+    testCHECK( xHigherPriorityTaskWoken == pdFALSE );
+    testCHECK( xSemaphoreTake( xBinary, 0 ) == pdPASS );
+
+    /* 6. A semaphore in a set notifies the set of each give. */
+    testCHECK( xQueueAddToSet( xBinary, xSet ) == pdPASS );
+    testCHECK( xSemaphoreGive( xBinary ) == pdPASS );
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == xBinary );
+    testCHECK( xSemaphoreTake( xBinary, 0 ) == pdPASS );
+    testCHECK( xQueueSelectFromSet( xSet, 0 ) == NULL );
+    testCHECK( xQueueRemoveFromSet( xBinary, xSet ) == pdPASS );
+
+    /* 7. Mutexes keep the full path. */
+    testCHECK( xSemaphoreTake( xMutex, 0 ) == pdPASS );
+    testCHECK( xSemaphoreGetMutexHolder( xMutex ) == xTaskGetCurrentTaskHandle() );
+    ( void ) xTaskCreate( prvMutexTask, "mutex", configMINIMAL_STACK_SIZE, NULL, semHELPER_PRIORITY, NULL );
+    testCHECK( uxTaskPriorityGet( NULL ) == semHELPER_PRIORITY );
+    testCHECK( xSemaphoreGive( xMutex ) == pdPASS );
+    testCHECK( xMutexDone != pdFALSE );
+    testCHECK( uxTaskPriorityGet( NULL ) == semCONTROL_PRIORITY );
+    testCHECK( xSemaphoreGetMutexHolder( xMutex ) == NULL );
+
+    ( void ) printf( "semaphore fast path %d, trace facility %d, queue stats %d\n",
+                     configUSE_SEMAPHORE_FAST_PATH, configUSE_TRACE_FACILITY, configUSE_QUEUE_STATS );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xBinary = xSemaphoreCreateBinary();
+    xCounting = xSemaphoreCreateCounting( semCOUNTING_MAX, 0 );
+    xMutex = xSemaphoreCreateMutex();
+    xSet = xQueueCreateSet( 1 );
+    configASSERT( ( xBinary != NULL ) && ( xCounting != NULL ) && ( xMutex != NULL ) && ( xSet != NULL ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 2, NULL, semCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,633 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+* A port that runs the SMP kernel on a POSIX host, for the tests and
+* benchmarks in the directory above.  It is not for use in applications.
+*
+* As in the GCC POSIX port, each task has a pthread and threads for tasks
+* that are not running wait on an event.  Here, configNUMBER_OF_CORES tasks
+* run at once, each on its own thread, so tasks on different cores really do
+* run in parallel when the host has more than one processor.
+*
+* Interrupts are masked per thread with a flag rather than with the signal
+* mask, so masking them is cheap.  A signal that arrives while its thread has
+* interrupts masked is handled when they are unmasked.  A core is asked to
+* yield by setting a flag for the core and signalling the thread running on
+* it.  The flag, not the signal, is what records the request, so a request is
+* not lost if the core changes to another thread before the signal arrives.
+*
+* The tick is only processed by core 0.
+*
+* The TASK and ISR locks and the spinlocks are spinlocks on atomic variables.
+* A thread that spins gives up the host processor after a short while, so
+* the tests still make progress on a host with a single processor.
+*----------------------------------------------------------*/
+#ifdef __linux__
+    #define _GNU_SOURCE
+#endif
+#include "portmacro.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/times.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wait_for_event.h"
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES < 2 )
+    #error This port is only for SMP builds.  Use the GCC POSIX port when configNUMBER_OF_CORES is 1.
+#endif
+
+#define SIG_YIELD                  SIGUSR1
+#define SIG_TICK                   SIGALRM
+
+/* The number of times a lock is tried before the thread gives up the host
+ * processor. */
+#define portSPINS_BEFORE_YIELD     64
+
+#define portNO_OWNER               ( ( BaseType_t ) -1 )
+
+typedef struct THREAD
+{
+    pthread_t pthread;
+    TaskFunction_t pxCode;
+    void * pvParams;
+    BaseType_t xDying;
+    volatile BaseType_t xCoreID; /* The core the task runs on, set by the thread that resumes it. */
+    struct event * ev;
+} Thread_t;
+
+typedef struct RECURSIVE_LOCK
+{
+    BaseType_t xOwner; /* The core that holds the lock, or portNO_OWNER. */
+    UBaseType_t uxCount;
+} RecursiveLock_t;
+
+/*
+ * The additional per-thread data is stored at the beginning of the
+ * task's stack.
+ */
+static inline Thread_t * prvGetThreadFromTask( TaskHandle_t xTask )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+
+/*-----------------------------------------------------------*/
+
+static RecursiveLock_t xTaskLock = { portNO_OWNER, 0U };
+static RecursiveLock_t xIsrLock = { portNO_OWNER, 0U };
+
+/* The thread running on each core, and whether each core has been asked to
+ * yield. */
+static Thread_t * pxCoreThreads[ configNUMBER_OF_CORES ];
+static BaseType_t xYieldRequests[ configNUMBER_OF_CORES ];
+
+static struct event * pxSchedulerEndEvent = NULL;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+static pthread_t hTimerTickThread;
+static volatile BaseType_t xTimerTickThreadShouldRun = pdFALSE;
+
+/* The thread of the task running on this thread, NULL on threads that do not
+ * belong to a task, whether interrupts are masked on this thread, and whether
+ * a tick arrived while they were. */
+static __thread Thread_t * pxThisThread = NULL;
+static __thread volatile BaseType_t xInterruptsMasked = pdTRUE;
+static __thread volatile sig_atomic_t xTickPending = 0;
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignals( void );
+static void * prvWaitForStart( void * pvParams );
+static void * prvTimerTickHandler( void * pvParams );
+static void prvSignalHandler( int iSignal );
+static void prvHandleInterrupts( void );
+static void prvSwitchContext( BaseType_t xCoreID );
+static void prvSpin( UBaseType_t * puxSpins );
+static void prvGetRecursiveLock( RecursiveLock_t * pxLock,
+                                 BaseType_t xCoreID );
+static void prvReleaseRecursiveLock( RecursiveLock_t * pxLock,
+                                     BaseType_t xCoreID );
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcCall,
+                           int iErrno ) __attribute__( ( __noreturn__ ) );
+
+void prvFatalError( const char * pcCall,
+                    int iErrno )
+{
+    fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     StackType_t * pxEndOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    static pthread_once_t hSigSetupOnce = PTHREAD_ONCE_INIT;
+    Thread_t * thread;
+    size_t ulStackSize;
+    int iRet;
+
+    ( void ) pthread_once( &hSigSetupOnce, prvSetupSignals );
+
+    /*
+     * Store the additional thread data at the start of the stack.
+     */
+    thread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+    pxTopOfStack = ( StackType_t * ) thread - 1;
+
+    /* Ensure that there is enough space to store Thread_t on the stack. */
+    ulStackSize = ( size_t ) ( pxTopOfStack + 1 - pxEndOfStack ) * sizeof( *pxTopOfStack );
+    configASSERT( ulStackSize > sizeof( Thread_t ) );
+
+    thread->pxCode = pxCode;
+    thread->pvParams = pvParameters;
+    thread->xDying = pdFALSE;
+    thread->xCoreID = 0;
+    thread->ev = event_create();
+
+    iRet = pthread_create( &thread->pthread, NULL, prvWaitForStart, thread );
+
+    if( iRet != 0 )
+    {
+        prvFatalError( "pthread_create", iRet );
+    }
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    BaseType_t xCoreID;
+    Thread_t * pxThread;
+
+    pxSchedulerEndEvent = event_create();
+
+    /* Start the task the kernel chose for each core. */
+    for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+    {
+        pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+        pxThread->xCoreID = xCoreID;
+        __atomic_store_n( &( pxCoreThreads[ xCoreID ] ), pxThread, __ATOMIC_SEQ_CST );
+    }
+
+    for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+    {
+        event_signal( pxCoreThreads[ xCoreID ]->ev );
+    }
+
+    xTimerTickThreadShouldRun = pdTRUE;
+    pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
+
+    /* Wait until signaled by vPortEndScheduler(). */
+    while( xSchedulerEnd != pdTRUE )
+    {
+        event_wait( pxSchedulerEndEvent );
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    xTimerTickThreadShouldRun = pdFALSE;
+    pthread_join( hTimerTickThread, NULL );
+
+    xSchedulerEnd = pdTRUE;
+    event_signal( pxSchedulerEndEvent );
+
+    /* Waiting to be deleted here. */
+    if( pxThisThread != NULL )
+    {
+        event_wait( pxThisThread->ev );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortGetCoreID( void )
+{
+    BaseType_t xCoreID = 0;
+
+    if( pxThisThread != NULL )
+    {
+        xCoreID = pxThisThread->xCoreID;
+    }
+
+    return xCoreID;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xPortSetInterruptMask( void )
+{
+    UBaseType_t uxWasMasked = ( UBaseType_t ) xInterruptsMasked;
+
+    xInterruptsMasked = pdTRUE;
+    __atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+    return uxWasMasked;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+    if( uxMask == 0U )
+    {
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+        xInterruptsMasked = pdFALSE;
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+        if( pxThisThread != NULL )
+        {
+            if( ( xTickPending != 0 ) ||
+                ( __atomic_load_n( &( xYieldRequests[ pxThisThread->xCoreID ] ), __ATOMIC_SEQ_CST ) != pdFALSE ) )
+            {
+                prvHandleInterrupts();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    UBaseType_t uxWasMasked;
+    BaseType_t xCoreID;
+
+    /* This must never be called from outside of a FreeRTOS-owned thread, or
+     * the thread could get stuck in a suspended state. */
+    configASSERT( pxThisThread != NULL );
+
+    uxWasMasked = xPortSetInterruptMask();
+    {
+        xCoreID = pxThisThread->xCoreID;
+
+        /* This yield also serves any request for this core to yield. */
+        ( void ) __atomic_exchange_n( &( xYieldRequests[ xCoreID ] ), pdFALSE, __ATOMIC_SEQ_CST );
+        prvSwitchContext( xCoreID );
+    }
+    vPortClearInterruptMask( uxWasMasked );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( BaseType_t xCoreID )
+{
+    Thread_t * pxThread;
+
+    __atomic_store_n( &( xYieldRequests[ xCoreID ] ), pdTRUE, __ATOMIC_SEQ_CST );
+    pxThread = __atomic_load_n( &( pxCoreThreads[ xCoreID ] ), __ATOMIC_SEQ_CST );
+
+    if( pxThread == pxThisThread )
+    {
+        /* Handled when this thread unmasks interrupts. */
+    }
+    else if( pxThread != NULL )
+    {
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpin( UBaseType_t * puxSpins )
+{
+    ( *puxSpins )++;
+
+    if( *puxSpins >= portSPINS_BEFORE_YIELD )
+    {
+        *puxSpins = 0U;
+        ( void ) sched_yield();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetRecursiveLock( RecursiveLock_t * pxLock,
+                                 BaseType_t xCoreID )
+{
+    BaseType_t xExpected;
+    UBaseType_t uxSpins = 0U;
+
+    /* Only this core can have set the owner to this core. */
+    if( __atomic_load_n( &( pxLock->xOwner ), __ATOMIC_RELAXED ) != xCoreID )
+    {
+        for( ; ; )
+        {
+            xExpected = portNO_OWNER;
+
+            if( __atomic_compare_exchange_n( &( pxLock->xOwner ), &xExpected, xCoreID, pdFALSE,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) != 0 )
+            {
+                break;
+            }
+
+            prvSpin( &uxSpins );
+        }
+    }
+
+    pxLock->uxCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseRecursiveLock( RecursiveLock_t * pxLock,
+                                     BaseType_t xCoreID )
+{
+    configASSERT( pxLock->xOwner == xCoreID );
+    configASSERT( pxLock->uxCount > 0U );
+
+    pxLock->uxCount--;
+
+    if( pxLock->uxCount == 0U )
+    {
+        __atomic_store_n( &( pxLock->xOwner ), portNO_OWNER, __ATOMIC_RELEASE );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTaskLock( BaseType_t xCoreID )
+{
+    prvGetRecursiveLock( &xTaskLock, xCoreID );
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseTaskLock( BaseType_t xCoreID )
+{
+    prvReleaseRecursiveLock( &xTaskLock, xCoreID );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetIsrLock( BaseType_t xCoreID )
+{
+    prvGetRecursiveLock( &xIsrLock, xCoreID );
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseIsrLock( BaseType_t xCoreID )
+{
+    prvReleaseRecursiveLock( &xIsrLock, xCoreID );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetSpinlock( BaseType_t xCoreID,
+                       BaseType_t * pxSpinlock )
+{
+    UBaseType_t uxSpins = 0U;
+
+    ( void ) xCoreID;
+
+    while( __atomic_exchange_n( pxSpinlock, 1, __ATOMIC_ACQUIRE ) != 0 )
+    {
+        prvSpin( &uxSpins );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseSpinlock( BaseType_t xCoreID,
+                           BaseType_t * pxSpinlock )
+{
+    ( void ) xCoreID;
+
+    __atomic_store_n( pxSpinlock, 0, __ATOMIC_RELEASE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( BaseType_t xCoreID )
+{
+    Thread_t * pxThreadToSuspend = pxThisThread;
+    Thread_t * pxThreadToResume;
+
+    /* Called with interrupts masked. */
+    vTaskSwitchContext( xCoreID );
+
+    /* Only this core changes the task running on it. */
+    pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+    if( pxThreadToResume != pxThreadToSuspend )
+    {
+        pxThreadToResume->xCoreID = xCoreID;
+        __atomic_store_n( &( pxCoreThreads[ xCoreID ] ), pxThreadToResume, __ATOMIC_SEQ_CST );
+        event_signal( pxThreadToResume->ev );
+
+        if( pxThreadToSuspend->xDying == pdTRUE )
+        {
+            pthread_exit( NULL );
+        }
+
+        /* The task can be chosen to run on another core before this thread
+         * waits, in which case the event is already signalled.  Either way
+         * xCoreID must not be used after this. */
+        event_wait( pxThreadToSuspend->ev );
+        pthread_testcancel();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandleInterrupts( void )
+{
+    BaseType_t xCoreID;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xSwitchRequired;
+
+    do
+    {
+        xInterruptsMasked = pdTRUE;
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+        xCoreID = pxThisThread->xCoreID;
+
+        if( xTickPending != 0 )
+        {
+            xTickPending = 0;
+
+            if( xCoreID == 0 )
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    xSwitchRequired = xTaskIncrementTick();
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                if( xSwitchRequired != pdFALSE )
+                {
+                    __atomic_store_n( &( xYieldRequests[ xCoreID ] ), pdTRUE, __ATOMIC_SEQ_CST );
+                }
+            }
+        }
+
+        if( __atomic_exchange_n( &( xYieldRequests[ xCoreID ] ), pdFALSE, __ATOMIC_SEQ_CST ) != pdFALSE )
+        {
+            prvSwitchContext( xCoreID );
+        }
+
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+        xInterruptsMasked = pdFALSE;
+        __atomic_signal_fence( __ATOMIC_SEQ_CST );
+
+        /* The thread may now be running on another core. */
+        xCoreID = pxThisThread->xCoreID;
+    } while( ( xTickPending != 0 ) ||
+             ( __atomic_load_n( &( xYieldRequests[ xCoreID ] ), __ATOMIC_SEQ_CST ) != pdFALSE ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSignalHandler( int iSignal )
+{
+    if( pxThisThread != NULL )
+    {
+        if( iSignal == SIG_TICK )
+        {
+            xTickPending = 1;
+        }
+
+        if( xInterruptsMasked == pdFALSE )
+        {
+            prvHandleInterrupts();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTimerTickHandler( void * pvParams )
+{
+    Thread_t * pxThread;
+
+    ( void ) pvParams;
+
+    while( xTimerTickThreadShouldRun != pdFALSE )
+    {
+        pxThread = __atomic_load_n( &( pxCoreThreads[ 0 ] ), __ATOMIC_SEQ_CST );
+        ( void ) pthread_kill( pxThread->pthread, SIG_TICK );
+        usleep( portTICK_RATE_MICROSECONDS );
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    ( void ) pxPendYield;
+
+    pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
+
+    /*
+     * The thread has already been suspended so it can be safely cancelled.
+     */
+    pthread_cancel( pxThreadToCancel->pthread );
+    event_signal( pxThreadToCancel->ev );
+    pthread_join( pxThreadToCancel->pthread, NULL );
+    event_delete( pxThreadToCancel->ev );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvWaitForStart( void * pvParams )
+{
+    Thread_t * pxThread = pvParams;
+
+    pxThisThread = pxThread;
+
+    event_wait( pxThread->ev );
+    pthread_testcancel();
+
+    /* Resumed for the first time. */
+    vPortClearInterruptMask( 0 );
+
+    /* Call the task's entry point. */
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* A function that implements a task must not exit or attempt to return to
+     * its caller as there is nothing to return to. If a task wants to exit it
+     * should instead call vTaskDelete( NULL ). Artificially force an assert()
+     * to be triggered if configASSERT() is defined, so application writers can
+     * catch the error. */
+    configASSERT( pdFALSE );
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignals( void )
+{
+    struct sigaction xAction;
+
+    memset( &xAction, 0, sizeof( xAction ) );
+    xAction.sa_handler = prvSignalHandler;
+    xAction.sa_flags = SA_RESTART;
+    sigfillset( &xAction.sa_mask );
+
+    if( ( sigaction( SIG_YIELD, &xAction, NULL ) != 0 ) ||
+        ( sigaction( SIG_TICK, &xAction, NULL ) != 0 ) )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetRunTime( void )
+{
+    struct tms xTimes;
+
+    times( &xTimes );
+
+    return ( uint32_t ) xTimes.tms_utime;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetLatencyTimestamp( void )
+{
+    struct timespec t;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return ( uint32_t ) ( ( ( uint64_t ) t.tv_sec * 1000000U ) + ( ( uint64_t ) t.tv_nsec / 1000U ) );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,176 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#include <limits.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions for running the SMP kernel on a POSIX host, for
+ * the tests and benchmarks in the directory above only.  See port.c.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR                 char
+#define portFLOAT                float
+#define portDOUBLE               double
+#define portLONG                 long
+#define portSHORT                short
+#define portSTACK_TYPE           unsigned long
+#define portBASE_TYPE            long
+#define portPOINTER_SIZE_TYPE    intptr_t
+
+typedef portSTACK_TYPE   StackType_t;
+typedef long             BaseType_t;
+typedef unsigned long    UBaseType_t;
+
+typedef unsigned long    TickType_t;
+#define portMAX_DELAY              ( ( TickType_t ) ULONG_MAX )
+
+#define portTICK_TYPE_IS_ATOMIC    1
+
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH                   ( -1 )
+#define portHAS_STACK_OVERFLOW_CHECKING    ( 1 )
+#define portTICK_PERIOD_MS                 ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portTICK_RATE_MICROSECONDS         ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT                 8
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+extern void vPortYieldCore( BaseType_t xCoreID );
+extern BaseType_t xPortGetCoreID( void );
+
+#define portYIELD()                vPortYield()
+#define portYIELD_CORE( x )        vPortYieldCore( x )
+#define portGET_CORE_ID()          xPortGetCoreID()
+
+#define portEND_SWITCHING_ISR( xSwitchRequired ) \
+    do                                           \
+    {                                            \
+        if( xSwitchRequired != pdFALSE )         \
+        {                                        \
+            traceISR_EXIT_TO_SCHEDULER();        \
+            vPortYield();                        \
+        }                                        \
+        else                                     \
+        {                                        \
+            traceISR_EXIT();                     \
+        }                                        \
+    } while( 0 )
+#define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Interrupts are masked per thread, so masking
+ * them on one core does not mask them on the others. */
+extern UBaseType_t xPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+
+#define portSET_INTERRUPT_MASK()           xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK( x )      vPortClearInterruptMask( x )
+#define portDISABLE_INTERRUPTS()           ( ( void ) xPortSetInterruptMask() )
+#define portENABLE_INTERRUPTS()            vPortClearInterruptMask( 0 )
+
+#define portCRITICAL_NESTING_IN_TCB        1
+
+#define portENTER_CRITICAL()               vTaskEnterCritical()
+#define portEXIT_CRITICAL()                vTaskExitCritical()
+#define portENTER_CRITICAL_FROM_ISR()      vTaskEnterCriticalFromISR()
+#define portEXIT_CRITICAL_FROM_ISR( x )    vTaskExitCriticalFromISR( x )
+
+/* The TASK and ISR locks are recursive spinlocks owned by a core. */
+extern void vPortGetTaskLock( BaseType_t xCoreID );
+extern void vPortReleaseTaskLock( BaseType_t xCoreID );
+extern void vPortGetIsrLock( BaseType_t xCoreID );
+extern void vPortReleaseIsrLock( BaseType_t xCoreID );
+
+#define portGET_TASK_LOCK( xCoreID )        vPortGetTaskLock( xCoreID )
+#define portRELEASE_TASK_LOCK( xCoreID )    vPortReleaseTaskLock( xCoreID )
+#define portGET_ISR_LOCK( xCoreID )         vPortGetIsrLock( xCoreID )
+#define portRELEASE_ISR_LOCK( xCoreID )     vPortReleaseIsrLock( xCoreID )
+
+/* Spinlocks for the objects protected by their own lock when
+ * portUSING_GRANULAR_LOCKS is 1.  They are not recursive. */
+#ifndef portUSING_GRANULAR_LOCKS
+    #define portUSING_GRANULAR_LOCKS    0
+#endif
+
+extern void vPortGetSpinlock( BaseType_t xCoreID,
+                              BaseType_t * pxSpinlock );
+extern void vPortReleaseSpinlock( BaseType_t xCoreID,
+                                  BaseType_t * pxSpinlock );
+
+#define portSPINLOCK_TYPE                              BaseType_t
+#define portINIT_SPINLOCK( pxSpinlock )                ( *( pxSpinlock ) = 0 )
+#define portGET_SPINLOCK( xCoreID, pxSpinlock )        vPortGetSpinlock( ( xCoreID ), ( pxSpinlock ) )
+#define portRELEASE_SPINLOCK( xCoreID, pxSpinlock )    vPortReleaseSpinlock( ( xCoreID ), ( pxSpinlock ) )
+
+/*-----------------------------------------------------------*/
+
+extern void vPortThreadDying( void * pxTaskToDelete,
+                              volatile BaseType_t * pxPendYield );
+extern void vPortCancelThread( void * pxTaskToDelete );
+#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield )    vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+#define portCLEAN_UP_TCB( pxTCB )                                  vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )         void vFunction( void * pvParameters ) __attribute__( ( noreturn ) )
+#define portTASK_FUNCTION( vFunction, pvParameters )               void vFunction( void * pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Tasks on different cores run at the same time in different threads, so a
+ * full memory barrier is needed. */
+#define portMEMORY_BARRIER()                        __atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+extern uint32_t ulPortGetRunTime( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
+#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
+
+extern uint32_t ulPortGetLatencyTimestamp( void );
+#define portGET_LATENCY_TIMESTAMP()                 ulPortGetLatencyTimestamp()
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,153 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Compares passing items from an interrupt to a task through a queue and
+ * through a single producer, single consumer channel.  A task sends bursts of
+ * 32 items with xQueueSendFromISR() or xSpscChannelSendFromISR(), as an
+ * interrupt would, then receives them with xQueueReceive() or
+ * xSpscChannelReceive(), and the time taken by each side is measured
+ * separately.
+ *
+ * The POSIX port's interrupt mask functions do nothing, so the send times are
+ * those of the kernel.  xQueueReceive() enters a critical section, which costs
+ * a system call on this port, while xSpscChannelReceive() does not.
+ *
+ * Usage: spsc_channel_benchmark [items]
+ * Prints the time taken to send and to receive one item each way.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "spsc_channel.h"
+
+#include "test_support.h"
+
+#define benchmarkDEFAULT_ITEMS    640000UL
+#define benchmarkBURST            32U
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulItems = benchmarkDEFAULT_ITEMS;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void * pvParameters )
+{
+    QueueHandle_t xQueue;
+    SpscChannelHandle_t xChannel;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint64_t ullQueueSendNs = 0, ullQueueReceiveNs = 0;
+    uint64_t ullChannelSendNs = 0, ullChannelReceiveNs = 0;
+    uint64_t ullStart, ullMiddle;
+    uint32_t ulValue, ul;
+    unsigned long ulBurst;
+
+    ( void ) pvParameters;
+
+    xQueue = xQueueCreate( benchmarkBURST, sizeof( uint32_t ) );
+    xChannel = xSpscChannelCreate( benchmarkBURST, sizeof( uint32_t ) );
+    configASSERT( ( xQueue != NULL ) && ( xChannel != NULL ) );
+
+    for( ulBurst = 0; ulBurst < ( ulItems / benchmarkBURST ); ulBurst++ )
+    {
+        ullStart = ullTestGetTimeNs();
+
+        for( ul = 0; ul < benchmarkBURST; ul++ )
+        {
+            ( void ) xQueueSendFromISR( xQueue, &ul, &xHigherPriorityTaskWoken );
+        }
+
+        ullMiddle = ullTestGetTimeNs();
+
+        for( ul = 0; ul < benchmarkBURST; ul++ )
+        {
+            testCHECK( ( xQueueReceive( xQueue, &ulValue, 0 ) == pdPASS ) && ( ulValue == ul ) );
+        }
+
+        ullQueueSendNs += ullMiddle - ullStart;
+        ullQueueReceiveNs += ullTestGetTimeNs() - ullMiddle;
+
+        ullStart = ullTestGetTimeNs();
+
+        for( ul = 0; ul < benchmarkBURST; ul++ )
+        {
+            ( void ) xSpscChannelSendFromISR( xChannel, &ul, &xHigherPriorityTaskWoken );
+        }
+
+        ullMiddle = ullTestGetTimeNs();
+
+        for( ul = 0; ul < benchmarkBURST; ul++ )
+        {
+            testCHECK( ( xSpscChannelReceive( xChannel, &ulValue, 0 ) == pdPASS ) && ( ulValue == ul ) );
+        }
+
+        ullChannelSendNs += ullMiddle - ullStart;
+        ullChannelReceiveNs += ullTestGetTimeNs() - ullMiddle;
+    }
+
+    ulItems = ( ulItems / benchmarkBURST ) * benchmarkBURST;
+
+    ( void ) printf( "queue:   xQueueSendFromISR %.1f ns, xQueueReceive %.1f ns per item\n",
+                     ( double ) ullQueueSendNs / ( double ) ulItems,
+                     ( double ) ullQueueReceiveNs / ( double ) ulItems );
+    ( void ) printf( "channel: xSpscChannelSendFromISR %.1f ns, xSpscChannelReceive %.1f ns per item\n",
+                     ( double ) ullChannelSendNs / ( double ) ulItems,
+                     ( double ) ullChannelReceiveNs / ( double ) ulItems );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        ulItems = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    configASSERT( ulItems >= benchmarkBURST );
+
+    ( void ) xTaskCreate( prvBenchmarkTask, "benchmark", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,268 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks the single producer, single consumer channels enabled by
+ * configUSE_SPSC_CHANNELS.  A control task runs the following checks in turn:
+ *
+ * 1. A channel fills, refuses a send when full, empties in order, and refuses
+ *    a receive when empty.  A receive with a timeout on an empty channel
+ *    blocks for that timeout.  Items wrap around the storage many times.
+ * 2. A statically allocated channel passes 8 byte items intact, and the
+ *    static structure keeps each index on its own cache line.
+ * 3. The control task streams 200000 items to a reader task at a higher
+ *    priority, which blocks whenever the channel is empty.
+ * 4. A timer callback, standing in for an interrupt, sends 5000 items with
+ *    xSpscChannelSendFromISR() to the reader.
+ *
+ * Every item must arrive in order.  Built for the SMP port too, where the
+ * writer and reader of check 3 run on different cores at the same time.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "spsc_channel.h"
+
+#include "test_support.h"
+
+#define spscCONTROL_PRIORITY      ( tskIDLE_PRIORITY + 2 )
+#define spscREADER_PRIORITY       ( tskIDLE_PRIORITY + 3 )
+#define spscSTACK_SIZE            ( configMINIMAL_STACK_SIZE * 4 )
+
+/* Check 1. */
+#define spscSHORT_LENGTH          4U
+#define spscTIMEOUT_TICKS         ( ( TickType_t ) 20 )
+#define spscTICKS_LATE            ( ( TickType_t ) 2 )
+#define spscWRAP_ITEMS            1000U
+
+/* Checks 3 and 4. */
+#define spscSTREAM_ITEMS          200000U
+#define spscSTREAM_LENGTH         16U
+#define spscISR_ITEMS             5000U
+#define spscISR_LENGTH            8U
+#define spscISR_ITEMS_PER_TICK    3
+
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static SpscChannelHandle_t xStreamChannel = NULL;
+static SpscChannelHandle_t xIsrChannel = NULL;
+
+static volatile uint32_t ulStreamItemsReceived = 0;
+static volatile uint32_t ulIsrItemsReceived = 0;
+static volatile uint32_t ulErrors = 0;
+static volatile BaseType_t xReaderDone = pdFALSE;
+
+/* Only written by the timer callback. */
+static uint32_t ulIsrItemsSent = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    while( ulStreamItemsReceived < spscSTREAM_ITEMS )
+    {
+        if( xSpscChannelReceive( xStreamChannel, &ulValue, portMAX_DELAY ) != pdPASS )
+        {
+            ulErrors++;
+        }
+        else
+        {
+            if( ulValue != ulStreamItemsReceived )
+            {
+                ulErrors++;
+            }
+
+            ulStreamItemsReceived++;
+        }
+    }
+
+    while( ulIsrItemsReceived < spscISR_ITEMS )
+    {
+        if( xSpscChannelReceive( xIsrChannel, &ulValue, 100 ) != pdPASS )
+        {
+            ulErrors++;
+            break;
+        }
+
+        if( ulValue != ulIsrItemsReceived )
+        {
+            ulErrors++;
+        }
+
+        ulIsrItemsReceived++;
+    }
+
+    xReaderDone = pdTRUE;
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    int i;
+
+    ( void ) xTimer;
+
+    for( i = 0; ( i < spscISR_ITEMS_PER_TICK ) && ( ulIsrItemsSent < spscISR_ITEMS ); i++ )
+    {
+        if( xSpscChannelSendFromISR( xIsrChannel, &ulIsrItemsSent, &xHigherPriorityTaskWoken ) == pdPASS )
+        {
+            ulIsrItemsSent++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    static StaticSpscChannel_t xStaticChannel;
+    static uint8_t ucStaticStorage[ 2 * sizeof( uint64_t ) ];
+    SpscChannelHandle_t xChannel;
+    uint64_t ullSent = 0x1122334455667788ULL, ullReceived = 0;
+    uint32_t ul, ulValue = 0;
+    TickType_t xStart, xElapsed;
+    TimerHandle_t xTimer;
+
+    ( void ) pvParameters;
+
+    /* 1. Full, empty, timeout and wrap around. */
+    xChannel = xSpscChannelCreate( spscSHORT_LENGTH, sizeof( uint32_t ) );
+    testCHECK( xChannel != NULL );
+
+    for( ul = 0; ul < spscSHORT_LENGTH; ul++ )
+    {
+        testCHECK( xSpscChannelSend( xChannel, &ul ) == pdPASS );
+    }
+
+    testCHECK( xSpscChannelSend( xChannel, &ul ) == errQUEUE_FULL );
+    testCHECK( uxSpscChannelItemsWaiting( xChannel ) == spscSHORT_LENGTH );
+
+    for( ul = 0; ul < spscSHORT_LENGTH; ul++ )
+    {
+        testCHECK( xSpscChannelReceive( xChannel, &ulValue, 0 ) == pdPASS );
+        testCHECK( ulValue == ul );
+    }
+
+    testCHECK( xSpscChannelReceive( xChannel, &ulValue, 0 ) == errQUEUE_EMPTY );
+
+    xStart = xTaskGetTickCount();
+    testCHECK( xSpscChannelReceive( xChannel, &ulValue, spscTIMEOUT_TICKS ) == errQUEUE_EMPTY );
+    xElapsed = xTaskGetTickCount() - xStart;
+    testCHECK( ( xElapsed >= spscTIMEOUT_TICKS ) && ( xElapsed <= ( spscTIMEOUT_TICKS + spscTICKS_LATE ) ) );
+
+    for( ul = 0; ul < spscWRAP_ITEMS; ul++ )
+    {
+        testCHECK( xSpscChannelSend( xChannel, &ul ) == pdPASS );
+        testCHECK( xSpscChannelReceive( xChannel, &ulValue, 0 ) == pdPASS );
+        testCHECK( ulValue == ul );
+    }
+
+    vSpscChannelDelete( xChannel );
+
+    /* 2. Static allocation. */
+    xChannel = xSpscChannelCreateStatic( 2, sizeof( uint64_t ), ucStaticStorage, &xStaticChannel );
+    testCHECK( xChannel != NULL );
+    testCHECK( xSpscChannelSend( xChannel, &ullSent ) == pdPASS );
+    testCHECK( xSpscChannelReceive( xChannel, &ullReceived, 0 ) == pdPASS );
+    testCHECK( ullReceived == ullSent );
+    vSpscChannelDelete( xChannel );
+    testCHECK( sizeof( StaticSpscChannel_t ) == ( 3U * configSPSC_CHANNEL_CACHE_LINE_SIZE ) );
+
+    /* 3. Streaming to a reader that blocks when the channel is empty.  The
+     * writer never blocks, so it yields when the channel is full. */
+    ( void ) xTaskCreate( prvReaderTask, "reader", spscSTACK_SIZE, NULL, spscREADER_PRIORITY, NULL );
+
+    for( ul = 0; ul < spscSTREAM_ITEMS; )
+    {
+        if( xSpscChannelSend( xStreamChannel, &ul ) == pdPASS )
+        {
+            ul++;
+        }
+        else
+        {
+            taskYIELD();
+        }
+
+        if( ( ul % 9973U ) == 0U )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+
+    /* 4. Sending from a timer callback. */
+    xTimer = xTimerCreate( "sender", 1, pdTRUE, NULL, prvTimerCallback );
+    testCHECK( xTimer != NULL );
+    ( void ) xTimerStart( xTimer, 0 );
+
+    while( xReaderDone == pdFALSE )
+    {
+        vTaskDelay( 10 );
+    }
+
+    testCHECK( ulStreamItemsReceived == spscSTREAM_ITEMS );
+    testCHECK( ulIsrItemsReceived == spscISR_ITEMS );
+    testCHECK( ulErrors == 0U );
+
+    ( void ) printf( "%lu streamed items, %lu items from the timer, %lu errors\n",
+                     ( unsigned long ) ulStreamItemsReceived, ( unsigned long ) ulIsrItemsReceived,
+                     ( unsigned long ) ulErrors );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    xStreamChannel = xSpscChannelCreate( spscSTREAM_LENGTH, sizeof( uint32_t ) );
+    xIsrChannel = xSpscChannelCreate( spscISR_LENGTH, sizeof( uint32_t ) );
+
+    ( void ) xTaskCreate( prvControlTask, "control", spscSTACK_SIZE, NULL, spscCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,396 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Compares tasks created from a task pool, when configUSE_TASK_POOLS is 1,
+ * with tasks created on the heap by xTaskCreate().  Built with heap_4 so the
+ * effect on the heap can be seen.  A control task measures:
+ *
+ * 1. The time to create a task and delete it again.  On this port most of the
+ *    time goes to creating and destroying the thread for the task, which is
+ *    the same for both.
+ * 2. How many heap bytes a burst of tasks that delete themselves leaves in
+ *    use until the idle task runs.
+ * 3. The heap's fragmentation under a mixed load, in which short lived tasks
+ *    are created and deleted while the application allocates and frees
+ *    blocks of random size and lifetime.
+ *
+ * Usage: task_pool_benchmark [create and delete loops] [mixed load rounds] [seed]
+ *
+ * The program also checks the pool's statistics and that a full pool refuses
+ * to create a task, so serves as a test when run with few loops.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_support.h"
+
+#define poolSLOTS                ( ( UBaseType_t ) 8 )
+#define poolSTACK_DEPTH          configMINIMAL_STACK_SIZE
+#define poolAPPLICATION_BLOCKS   64
+#define poolCONTROL_PRIORITY     ( tskIDLE_PRIORITY + 3 )
+#define poolWORKER_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+#define poolBURST_PRIORITY       ( tskIDLE_PRIORITY + 4 )
+
+/*-----------------------------------------------------------*/
+
+static void prvSuspendedWorkerTask( void * pvParameters );
+static void prvSelfDeletingWorkerTask( void * pvParameters );
+static TaskHandle_t prvCreateWorker( BaseType_t xUsePool,
+                                     TaskFunction_t pxTaskCode,
+                                     UBaseType_t uxPriority );
+static void prvMeasureCreateAndDelete( BaseType_t xUsePool,
+                                       uint32_t ulLoops );
+static void prvMeasureSelfDeletingBurst( BaseType_t xUsePool );
+static void prvMeasureMixedLoad( BaseType_t xUsePool,
+                                 uint32_t ulRounds,
+                                 unsigned int uxSeed );
+static void prvCheckFullPool( void );
+static void prvControlTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static StackType_t xPoolStacks[ poolSLOTS * poolSTACK_DEPTH ];
+static StaticTask_t xPoolTCBs[ poolSLOTS ];
+static StaticTaskPool_t xPoolBuffer;
+static TaskPoolHandle_t xPool = NULL;
+
+static uint32_t ulCreateLoops = 20000;
+static uint32_t ulMixedLoadRounds = 20000;
+static unsigned int uxSeed = 1;
+
+/*-----------------------------------------------------------*/
+
+static void prvSuspendedWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelfDeletingWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vTaskDelete( NULL );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvCreateWorker( BaseType_t xUsePool,
+                                     TaskFunction_t pxTaskCode,
+                                     UBaseType_t uxPriority )
+{
+    TaskHandle_t xTask = NULL;
+
+    if( xUsePool != pdFALSE )
+    {
+        xTask = xTaskCreateFromPool( xPool, pxTaskCode, "worker", NULL, uxPriority );
+    }
+    else if( xTaskCreate( pxTaskCode, "worker", poolSTACK_DEPTH, NULL, uxPriority, &xTask ) != pdPASS )
+    {
+        xTask = NULL;
+    }
+
+    return xTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureCreateAndDelete( BaseType_t xUsePool,
+                                       uint32_t ulLoops )
+{
+    TaskHandle_t xTask;
+    uint32_t ulLoop, ulFailures = 0;
+    uint64_t ullStartNs;
+
+    ullStartNs = ullTestGetTimeNs();
+
+    for( ulLoop = 0; ulLoop < ulLoops; ulLoop++ )
+    {
+        /* The worker is below the control task's priority so it does not
+         * run, and so is deleted at once. */
+        xTask = prvCreateWorker( xUsePool, prvSuspendedWorkerTask, poolWORKER_PRIORITY );
+
+        if( xTask != NULL )
+        {
+            vTaskDelete( xTask );
+        }
+        else
+        {
+            ulFailures++;
+        }
+    }
+
+    ( void ) printf( "create and delete, %s: %.0f ns\n", ( xUsePool != pdFALSE ) ? "pool" : "heap",
+                     ( double ) ( ullTestGetTimeNs() - ullStartNs ) / ( double ) ulLoops );
+
+    testCHECK( ulFailures == 0U );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureSelfDeletingBurst( BaseType_t xUsePool )
+{
+    const size_t xFreeBefore = xPortGetFreeHeapSize();
+    size_t xHeldUntilIdle;
+    TaskPoolStats_t xStats;
+    UBaseType_t ux, uxFailures = 0;
+    int iBurst;
+
+    /* Each worker is above the control task's priority, so runs and deletes
+     * itself as soon as it is created.  From the pool, the second burst
+     * reuses the slots of the first before the idle task has run.  From the
+     * heap, the memory of every task is held until the idle task runs, so
+     * the heap can run out. */
+    for( iBurst = 0; iBurst < 2; iBurst++ )
+    {
+        for( ux = 0; ux < poolSLOTS; ux++ )
+        {
+            if( prvCreateWorker( xUsePool, prvSelfDeletingWorkerTask, poolBURST_PRIORITY ) == NULL )
+            {
+                uxFailures++;
+            }
+        }
+    }
+
+    xHeldUntilIdle = xFreeBefore - xPortGetFreeHeapSize();
+
+    /* Let the idle task clean up. */
+    vTaskDelay( 10 );
+
+    ( void ) printf( "burst of %lu tasks that delete themselves, %s: %lu not created, "
+                     "%lu heap bytes held until the idle task runs\n",
+                     ( unsigned long ) ( poolSLOTS * 2U ), ( xUsePool != pdFALSE ) ? "pool" : "heap",
+                     ( unsigned long ) uxFailures, ( unsigned long ) xHeldUntilIdle );
+
+    testCHECK( xPortGetFreeHeapSize() == xFreeBefore );
+
+    if( xUsePool != pdFALSE )
+    {
+        testCHECK( uxFailures == 0U );
+        testCHECK( xHeldUntilIdle == 0U );
+        vTaskPoolGetStats( xPool, &xStats );
+        testCHECK( xStats.uxFreeSlots == poolSLOTS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureMixedLoad( BaseType_t xUsePool,
+                                 uint32_t ulRounds,
+                                 unsigned int uxSeed )
+{
+    TaskHandle_t xWorkers[ poolSLOTS ] = { NULL };
+    uint32_t ulWorkerDeath[ poolSLOTS ] = { 0 };
+    void * pvBlocks[ poolAPPLICATION_BLOCKS ] = { NULL };
+    uint32_t ulBlockDeath[ poolAPPLICATION_BLOCKS ] = { 0 };
+    uint32_t ulRound, ulWorkerFailures = 0, ulBlockFailures = 0, ulTaskOperations = 0;
+    size_t xMinimumLargestBlock = ( size_t ) -1;
+    uint64_t ullTaskNs = 0, ullStartNs;
+    HeapStats_t xHeapStats;
+    UBaseType_t ux;
+
+    srand( uxSeed );
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        /* Up to poolSLOTS workers live for up to 8 rounds each. */
+        for( ux = 0; ux < poolSLOTS; ux++ )
+        {
+            if( ( xWorkers[ ux ] != NULL ) && ( ulWorkerDeath[ ux ] <= ulRound ) )
+            {
+                ullStartNs = ullTestGetTimeNs();
+                vTaskDelete( xWorkers[ ux ] );
+                ullTaskNs += ullTestGetTimeNs() - ullStartNs;
+                xWorkers[ ux ] = NULL;
+            }
+
+            if( ( xWorkers[ ux ] == NULL ) && ( ( rand() % 4 ) == 0 ) )
+            {
+                ullStartNs = ullTestGetTimeNs();
+                xWorkers[ ux ] = prvCreateWorker( xUsePool, prvSuspendedWorkerTask, poolWORKER_PRIORITY );
+                ullTaskNs += ullTestGetTimeNs() - ullStartNs;
+                ulTaskOperations++;
+
+                if( xWorkers[ ux ] == NULL )
+                {
+                    ulWorkerFailures++;
+                }
+
+                ulWorkerDeath[ ux ] = ulRound + 1U + ( uint32_t ) ( rand() % 8 );
+            }
+        }
+
+        /* Up to poolAPPLICATION_BLOCKS blocks of 32 to 1055 bytes live for up
+         * to 200 rounds each. */
+        for( ux = 0; ux < poolAPPLICATION_BLOCKS; ux++ )
+        {
+            if( ( pvBlocks[ ux ] != NULL ) && ( ulBlockDeath[ ux ] <= ulRound ) )
+            {
+                vPortFree( pvBlocks[ ux ] );
+                pvBlocks[ ux ] = NULL;
+            }
+
+            if( ( pvBlocks[ ux ] == NULL ) && ( ( rand() % 8 ) == 0 ) )
+            {
+                pvBlocks[ ux ] = pvPortMalloc( 32U + ( size_t ) ( rand() % 1024 ) );
+
+                if( pvBlocks[ ux ] == NULL )
+                {
+                    ulBlockFailures++;
+                }
+
+                ulBlockDeath[ ux ] = ulRound + 1U + ( uint32_t ) ( rand() % 200 );
+            }
+        }
+
+        vPortGetHeapStats( &xHeapStats );
+
+        if( xHeapStats.xSizeOfLargestFreeBlockInBytes < xMinimumLargestBlock )
+        {
+            xMinimumLargestBlock = xHeapStats.xSizeOfLargestFreeBlockInBytes;
+        }
+    }
+
+    vPortGetHeapStats( &xHeapStats );
+
+    ( void ) printf( "mixed load, %s: smallest largest free block %lu bytes, %lu free blocks at the end, "
+                     "%lu tasks and %lu blocks not allocated, %.0f ns per task create or delete\n",
+                     ( xUsePool != pdFALSE ) ? "pool" : "heap", ( unsigned long ) xMinimumLargestBlock,
+                     ( unsigned long ) xHeapStats.xNumberOfFreeBlocks, ( unsigned long ) ulWorkerFailures,
+                     ( unsigned long ) ulBlockFailures,
+                     ( ulTaskOperations != 0U ) ? ( double ) ullTaskNs / ( double ) ulTaskOperations : 0.0 );
+
+    if( xUsePool != pdFALSE )
+    {
+        testCHECK( ulWorkerFailures == 0U );
+    }
+
+    for( ux = 0; ux < poolSLOTS; ux++ )
+    {
+        if( xWorkers[ ux ] != NULL )
+        {
+            vTaskDelete( xWorkers[ ux ] );
+        }
+    }
+
+    for( ux = 0; ux < poolAPPLICATION_BLOCKS; ux++ )
+    {
+        vPortFree( pvBlocks[ ux ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckFullPool( void )
+{
+    TaskHandle_t xWorkers[ poolSLOTS ];
+    TaskPoolStats_t xBefore, xAfter;
+    UBaseType_t ux;
+
+    vTaskPoolGetStats( xPool, &xBefore );
+
+    for( ux = 0; ux < poolSLOTS; ux++ )
+    {
+        xWorkers[ ux ] = prvCreateWorker( pdTRUE, prvSuspendedWorkerTask, poolWORKER_PRIORITY );
+        testCHECK( xWorkers[ ux ] != NULL );
+    }
+
+    testCHECK( prvCreateWorker( pdTRUE, prvSuspendedWorkerTask, poolWORKER_PRIORITY ) == NULL );
+
+    vTaskPoolGetStats( xPool, &xAfter );
+    testCHECK( xAfter.uxSlots == poolSLOTS );
+    testCHECK( xAfter.uxFreeSlots == 0U );
+    testCHECK( xAfter.uxMinimumEverFreeSlots == 0U );
+    testCHECK( xAfter.ulAllocations == ( xBefore.ulAllocations + poolSLOTS ) );
+    testCHECK( xAfter.ulFailedAllocations == ( xBefore.ulFailedAllocations + 1U ) );
+
+    for( ux = 0; ux < poolSLOTS; ux++ )
+    {
+        vTaskDelete( xWorkers[ ux ] );
+    }
+
+    vTaskPoolGetStats( xPool, &xAfter );
+    testCHECK( xAfter.uxFreeSlots == poolSLOTS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvMeasureCreateAndDelete( pdFALSE, ulCreateLoops );
+    prvMeasureCreateAndDelete( pdTRUE, ulCreateLoops );
+    prvMeasureSelfDeletingBurst( pdFALSE );
+    prvMeasureSelfDeletingBurst( pdTRUE );
+    prvMeasureMixedLoad( pdFALSE, ulMixedLoadRounds, uxSeed );
+    prvMeasureMixedLoad( pdTRUE, ulMixedLoadRounds, uxSeed );
+    prvCheckFullPool();
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( argc > 1 )
+    {
+        ulCreateLoops = ( uint32_t ) strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    if( argc > 2 )
+    {
+        ulMixedLoadRounds = ( uint32_t ) strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    if( argc > 3 )
+    {
+        uxSeed = ( unsigned int ) strtoul( argv[ 3 ], NULL, 10 );
+    }
+
+    xPool = xTaskPoolCreateStatic( poolSLOTS, poolSTACK_DEPTH, xPoolStacks, xPoolTCBs, &xPoolBuffer );
+    configASSERT( xPool != NULL );
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE * 4, NULL, poolCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,109 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+#include "test_support.h"
+
+static volatile unsigned long ulFailures = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    ( void ) printf( "ASSERT %s:%lu\n", pcFile, ulLine );
+    ( void ) fflush( stdout );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+void vTestCheck( BaseType_t xPassed,
+                 const char * pcFile,
+                 int iLine,
+                 const char * pcExpression )
+{
+    if( xPassed == pdFALSE )
+    {
+        /* Checks can fail on more than one core at once in SMP builds. */
+        ( void ) __atomic_add_fetch( &ulFailures, 1UL, __ATOMIC_RELAXED );
+        ( void ) printf( "FAIL %s:%d %s\n", pcFile, iLine, pcExpression );
+        ( void ) fflush( stdout );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTestFinish( void )
+{
+    if( ulFailures == 0UL )
+    {
+        ( void ) printf( "PASS\n" );
+        ( void ) fflush( stdout );
+        exit( 0 );
+    }
+    else
+    {
+        ( void ) printf( "FAIL (%lu checks failed)\n", ulFailures );
+        ( void ) fflush( stdout );
+        exit( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullTestGetTimeNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vApplicationIdleHook( void )
+    {
+        ( void ) sched_yield();
+    }
+/*-----------------------------------------------------------*/
+
+    void vApplicationPassiveIdleHook( void )
+    {
+        ( void ) sched_yield();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
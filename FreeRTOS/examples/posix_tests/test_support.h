@@ -0,0 +1,57 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+/* Helpers shared by the programs in this directory. */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* Record a failure, with the file and line of the check, if x is false.  The
+ * program carries on so one run reports every check that fails. */
+#define testCHECK( x )    vTestCheck( ( ( x ) ? pdTRUE : pdFALSE ), __FILE__, __LINE__, #x )
+
+void vTestCheck( BaseType_t xPassed,
+                 const char * pcFile,
+                 int iLine,
+                 const char * pcExpression );
+
+/* Print whether every check passed and exit the process with status 0 if they
+ * did and 1 if not.  May be called from a task. */
+void vTestFinish( void ) __attribute__( ( noreturn ) );
+
+/* Return the time from a monotonic clock in nanoseconds, for programs that
+ * measure how long kernel operations take. */
+uint64_t ullTestGetTimeNs( void );
+
+#endif /* TEST_SUPPORT_H */
@@ -0,0 +1,219 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Checks that tasks blocked with a timeout are woken on time when
+ * configUSE_TIMING_WHEEL is 1.  Worker tasks repeatedly block for a
+ * pseudo-random number of ticks, chosen so that some timeouts fall in each
+ * level of the wheel and some are beyond it, either in vTaskDelay() or waiting
+ * for a queue that a control task writes to every few ticks.  A task that
+ * returns from vTaskDelay() before its delay has passed, or that times out on
+ * the queue early, fails the test.  The control task also aborts one delay and
+ * checks uxTaskGetSystemState() sees every task while the wheel is in use.
+ * The number of ticks by which tasks woke late is printed but not checked, as
+ * tasks of equal priority that wake on the same tick run one after another.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "test_support.h"
+
+#define wheelNUM_WORKERS         96
+#define wheelWAITS_PER_WORKER    4
+#define wheelWORKER_PRIORITY     ( tskIDLE_PRIORITY + 2 )
+#define wheelCONTROL_PRIORITY    ( tskIDLE_PRIORITY + 3 )
+#define wheelSEND_PERIOD         ( ( TickType_t ) 37 )
+
+/* The worker whose delay is aborted.  It is not checked for waking early. */
+#define wheelABORTED_WORKER      5
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters );
+static void prvControlTask( void * pvParameters );
+static TickType_t prvNextTimeout( uint32_t * pulSeed );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueue = NULL;
+static TaskHandle_t xWorkers[ wheelNUM_WORKERS ];
+static volatile UBaseType_t uxWorkersDone = 0U;
+static volatile TickType_t xMaxLateTicks = 0U;
+
+/*-----------------------------------------------------------*/
+
+static TickType_t prvNextTimeout( uint32_t * pulSeed )
+{
+    TickType_t xTimeout;
+    uint32_t ulRandom;
+
+    *pulSeed = ( *pulSeed * 1103515245UL ) + 12345UL;
+    ulRandom = *pulSeed >> 8;
+
+    /* Short, medium, long and very long timeouts in turn land in the lowest
+     * level of the wheel, the higher levels, and beyond the wheel when it is
+     * configured small. */
+    switch( ( *pulSeed >> 16 ) % 4U )
+    {
+        case 0:
+            xTimeout = 1U + ( ulRandom % 8U );
+            break;
+
+        case 1:
+            xTimeout = 1U + ( ulRandom % 70U );
+            break;
+
+        case 2:
+            xTimeout = 1U + ( ulRandom % 600U );
+            break;
+
+        default:
+            xTimeout = 1U + ( ulRandom % 1500U );
+            break;
+    }
+
+    return xTimeout;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    const UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvParameters;
+    uint32_t ulSeed = ( ( uint32_t ) uxIndex * 2654435761UL ) + 1UL;
+    TickType_t xTimeout, xStart, xElapsed;
+    uint32_t ulValue;
+    int i;
+
+    for( i = 0; i < wheelWAITS_PER_WORKER; i++ )
+    {
+        xTimeout = prvNextTimeout( &ulSeed );
+        xStart = xTaskGetTickCount();
+
+        if( ( uxIndex % 3U ) == 0U )
+        {
+            if( xQueueReceive( xQueue, &ulValue, xTimeout ) == pdPASS )
+            {
+                /* Received before the timeout, so there is nothing to check. */
+                continue;
+            }
+        }
+        else
+        {
+            vTaskDelay( xTimeout );
+        }
+
+        xElapsed = xTaskGetTickCount() - xStart;
+
+        if( uxIndex != wheelABORTED_WORKER )
+        {
+            testCHECK( xElapsed >= xTimeout );
+        }
+
+        if( ( xElapsed > xTimeout ) && ( ( xElapsed - xTimeout ) > xMaxLateTicks ) )
+        {
+            xMaxLateTicks = xElapsed - xTimeout;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uxWorkersDone++;
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    TaskStatus_t * pxStatus;
+    UBaseType_t uxReported;
+    BaseType_t xAborted = pdFALSE;
+    uint32_t ulValue = 0;
+    int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; uxWorkersDone < wheelNUM_WORKERS; i++ )
+    {
+        vTaskDelay( wheelSEND_PERIOD );
+        ( void ) xQueueSend( xQueue, &ulValue, 0 );
+
+        if( ( i % 10 ) == 0 )
+        {
+            pxStatus = pvPortMalloc( sizeof( TaskStatus_t ) * ( wheelNUM_WORKERS + 8 ) );
+            configASSERT( pxStatus != NULL );
+            uxReported = uxTaskGetSystemState( pxStatus, wheelNUM_WORKERS + 8, NULL );
+            testCHECK( uxReported == uxTaskGetNumberOfTasks() );
+            vPortFree( pxStatus );
+        }
+
+        if( ( xAborted == pdFALSE ) && ( eTaskGetState( xWorkers[ wheelABORTED_WORKER ] ) == eBlocked ) )
+        {
+            testCHECK( xTaskAbortDelay( xWorkers[ wheelABORTED_WORKER ] ) == pdPASS );
+            xAborted = pdTRUE;
+        }
+    }
+
+    testCHECK( xAborted != pdFALSE );
+
+    ( void ) printf( "timing wheel %d: %d workers, latest wake %lu ticks after its timeout\n",
+                     configUSE_TIMING_WHEEL, wheelNUM_WORKERS, ( unsigned long ) xMaxLateTicks );
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    char cName[ configMAX_TASK_NAME_LEN ];
+    UBaseType_t uxIndex;
+
+    xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+
+    for( uxIndex = 0U; uxIndex < wheelNUM_WORKERS; uxIndex++ )
+    {
+        ( void ) snprintf( cName, sizeof( cName ), "w%lu", ( unsigned long ) uxIndex );
+        ( void ) xTaskCreate( prvWorkerTask, cName, configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) uxIndex,
+                              wheelWORKER_PRIORITY, &( xWorkers[ uxIndex ] ) );
+    }
+
+    ( void ) xTaskCreate( prvControlTask, "control", configMINIMAL_STACK_SIZE, NULL, wheelCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
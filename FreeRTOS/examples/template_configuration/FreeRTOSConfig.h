@@ -99,6 +99,42 @@
  * if left undefined. */
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 
+/* When configUSE_PORT_OPTIMISED_TASK_SELECTION is 0, set
+ * configUSE_READY_PRIORITY_BITMAP to 1 to have the generic C algorithm track
+ * which priorities have Ready state tasks in a two level bitmap, so selecting
+ * the next task to run takes constant time for up to 1024 priorities.  Set to 0
+ * to search down from the highest priority used, which uses less RAM.  Only
+ * available when configNUMBER_OF_CORES is 1.  Defaults to 0 if left undefined. */
+#define configUSE_READY_PRIORITY_BITMAP            0
+
+/* Set configUSE_EVENT_LIST_BUCKETS to 1 to have each queue, semaphore and
+ * mutex remember the last task of each priority that is blocked on it, so a
+ * task can be added to the priority ordered list of blocked tasks without
+ * searching the list.  This makes blocking on an object take constant time
+ * however many tasks are already blocked on it.  The cost is an
+ * EventListBuckets_t for each of the object's two lists of blocked tasks, so
+ * every queue, semaphore and mutex grows by 2 * sizeof( EventListBuckets_t ),
+ * which is 2 * ( configMAX_PRIORITIES pointers + 4 * ( ( configMAX_PRIORITIES
+ * + 31 ) / 32 ) + 4 ) bytes - 272 bytes with 32 priorities and 32-bit
+ * pointers - and every task grows by a pointer and a UBaseType_t.  Only worth
+ * using if many tasks can be blocked on the same object at once.  Defaults to
+ * 0 if left undefined. */
+#define configUSE_EVENT_LIST_BUCKETS               0
+
+/* Set configUSE_EDF_SCHEDULING to 1 to schedule the Ready state tasks at
+ * configEDF_TASK_PRIORITY earliest deadline first instead of in turn.  Tasks
+ * are given deadlines using xTaskCreateDeadline() and vTaskSetDeadline(), and
+ * tasks at other priorities are scheduled as normal.  A task holding a mutex
+ * that a task with an earlier deadline waits for inherits that deadline.  Only
+ * available when configNUMBER_OF_CORES is 1.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_EDF_SCHEDULING                   0
+
+/* The priority at which tasks are scheduled earliest deadline first when
+ * configUSE_EDF_SCHEDULING is 1.  Defaults to (configMAX_PRIORITIES - 1) if
+ * left undefined. */
+#define configEDF_TASK_PRIORITY                    ( configMAX_PRIORITIES - 1 )
+
 /* Set configUSE_TICKLESS_IDLE to 1 to use the low power tickless mode.  Set to
  * 0 to keep the tick interrupt running at all times.  Not all FreeRTOS ports
  * support tickless mode. See
@@ -106,6 +142,22 @@
  * undefined. */
 #define configUSE_TICKLESS_IDLE                    0
 
+/* Set configUSE_TIMING_WHEEL to 1 to hold Blocked state tasks in a hierarchical
+ * timing wheel, which makes entering and leaving the Blocked state O(1)
+ * regardless of how many tasks are blocked with a timeout.  Set to 0 to hold
+ * them in a list sorted by wake time, which uses less RAM.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_TIMING_WHEEL                     0
+
+/* When configUSE_TIMING_WHEEL is 1, the wheel has configTIMING_WHEEL_LEVELS
+ * levels of 2^configTIMING_WHEEL_SLOT_BITS slots each, and each slot is a
+ * List_t.  Together they cover timeouts of up to
+ * 2^(configTIMING_WHEEL_SLOT_BITS * configTIMING_WHEEL_LEVELS) ticks - longer
+ * timeouts are held in one extra list that is re-examined each time that period
+ * elapses.  Default to 5 and 3 respectively if left undefined. */
+#define configTIMING_WHEEL_SLOT_BITS               5
+#define configTIMING_WHEEL_LEVELS                  3
+
 /* configMAX_PRIORITIES Sets the number of available task priorities.  Tasks can
  * be assigned priorities of 0 to (configMAX_PRIORITIES - 1).  Zero is the
  * lowest priority. */
@@ -283,6 +335,14 @@
  * https://www.freertos.org/Static_Vs_Dynamic_Memory_Allocation.html. */
 #define configSUPPORT_DYNAMIC_ALLOCATION             1
 
+/* Set configUSE_TASK_POOLS to 1 to include the xTaskPoolCreateStatic() and
+ * xTaskCreateFromPool() API functions, which create tasks in fixed size TCB and
+ * stack slots that are returned to their pool when the task is deleted rather
+ * than being allocated from and freed to the heap.  Requires
+ * configSUPPORT_STATIC_ALLOCATION to also be 1.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_TASK_POOLS                         0
+
 /* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
  * or heap_4.c are included in the build.  This value is defaulted to 4096 bytes
  * but it must be tailored to each application.  Note the heap will appear in
@@ -364,6 +424,14 @@
  * 0 if left undefined. */
 #define configCHECK_FOR_STACK_OVERFLOW        2
 
+/* Set configUSE_STACK_HIGH_WATER_MARK_CACHE to 1 to have each task remember
+ * its stack high water mark when it is measured, so measuring it again before
+ * the task has next run returns the remembered value instead of checking the
+ * stack again.  This speeds up polling the high water marks of tasks that run
+ * infrequently, at the cost of a few bytes per task and a single write on each
+ * context switch.  Defaults to 0 if left undefined. */
+#define configUSE_STACK_HIGH_WATER_MARK_CACHE 0
+
 /******************************************************************************/
 /* Run time and task stats gathering related definitions. *********************/
 /******************************************************************************/
@@ -375,6 +443,20 @@
  */
 #define configGENERATE_RUN_TIME_STATS           0
 
+/* Set configUSE_LATENCY_HISTOGRAMS to 1 to record, for each task and for all
+ * tasks together, a histogram of the time from a task becoming ready to it
+ * running.  Latencies are measured with portGET_LATENCY_TIMESTAMP() if the
+ * port defines it, otherwise with the run time counter, in which case
+ * configGENERATE_RUN_TIME_STATS must also be 1.  See
+ * xTaskGetLatencyHistogram().  Defaults to 0 if left undefined. */
+#define configUSE_LATENCY_HISTOGRAMS            0
+
+/* The number of buckets in each latency histogram when
+ * configUSE_LATENCY_HISTOGRAMS is 1.  Bucket n counts latencies from 2^n to
+ * 2^(n+1)-1 timestamp units, and the last bucket also counts all longer
+ * latencies.  Defaults to 16 if left undefined. */
+#define configLATENCY_HISTOGRAM_BUCKETS         16
+
 /* Set configUSE_TRACE_FACILITY to include additional task structure members
  * are used by trace and visualisation functions and tools.  Set to 0 to exclude
  * the additional information from the structures. Defaults to 0 if left
@@ -388,6 +470,28 @@
  * undefined. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* Set configUSE_TASK_SNAPSHOT to 1 to include the vTaskSnapshotBegin(),
+ * uxTaskSnapshotNext() and xTaskSnapshotEncode() functions, which collect the
+ * state of the tasks a few at a time rather than suspending the scheduler for
+ * the whole walk as uxTaskGetSystemState() does.  Requires
+ * configUSE_TRACE_FACILITY to also be 1.  Defaults to 0 if left undefined. */
+#define configUSE_TASK_SNAPSHOT                 0
+
+/* Set configUSE_TRACE_BUFFER to 1 to record scheduling and queue events into
+ * a ring buffer per core using the built in trace macros defined in
+ * trace_buffer.h.  The records are moved into a stream buffer by calling
+ * xTraceBufferDrain().  trace_buffer.c must be included in the project.
+ * Requires configUSE_TRACE_FACILITY and configUSE_STREAM_BUFFERS to also be 1,
+ * and the port to provide a timestamp.  Defaults to 0 if left undefined. */
+#define configUSE_TRACE_BUFFER                  0
+
+/* configTRACE_BUFFER_LENGTH sets the number of records held by the trace
+ * buffer of each core when configUSE_TRACE_BUFFER is 1.  Each record is 8
+ * bytes.  Up to configTRACE_BUFFER_LENGTH - 1 records can be waiting to be
+ * drained, as the slot after the newest record may be part way through being
+ * written.  Must be a power of 2.  Defaults to 256 if left undefined. */
+#define configTRACE_BUFFER_LENGTH               256
+
 /******************************************************************************/
 /* Co-routine related definitions. ********************************************/
 /******************************************************************************/
@@ -403,6 +507,14 @@
  * priority. Defaults to 0 if left undefined. */
 #define configMAX_CO_ROUTINE_PRIORITIES    1
 
+/* Set configUSE_ASYNC_COROUTINES to 1 to include the stackless async
+ * coroutines in the build.  Async coroutines are run by an executor hosted by
+ * an ordinary task, and can await queues, semaphores, stream buffers, event
+ * groups, delays and notifications.  async.c must be included in the project,
+ * and configUSE_TASK_NOTIFICATIONS must be 1.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_ASYNC_COROUTINES         0
+
 /******************************************************************************/
 /* Debugging assistance. ******************************************************/
 /******************************************************************************/
@@ -522,6 +634,19 @@
  * priority task may run on different cores at the same time. */
 #define configRUN_MULTIPLE_PRIORITIES             0
 
+/* When using SMP (i.e. configNUMBER_OF_CORES is greater than one), set
+ * configUSE_HOME_CORE_READY_LISTS to 1 to give each core its own set of ready
+ * lists, so tasks keep to a home core. A task that becomes ready is queued on
+ * its home core, which is the core it last ran on (or, if its core affinity no
+ * longer allows that, a core it can run on). New tasks are given home cores in
+ * turn, and each core searches its own lists before taking work from the lists
+ * of the other cores. This keeps tasks on the same core where possible and
+ * shortens the ready list search. It does not reduce contention for the
+ * kernel's TASK and ISR locks, which still protect every core's lists. Kernel
+ * aware debuggers that read pxReadyTasksLists will not see the lists of each
+ * core. Defaults to 0 if left undefined. */
+#define configUSE_HOME_CORE_READY_LISTS           0
+
 /* When using SMP (i.e. configNUMBER_OF_CORES is greater than one), set
  * configUSE_CORE_AFFINITY to 1 to enable core affinity feature. When core
  * affinity feature is enabled, the vTaskCoreAffinitySet and
@@ -558,6 +683,24 @@
  * tskNO_AFFINITY if left undefined. */
 #define configTIMER_SERVICE_TASK_CORE_AFFINITY    tskNO_AFFINITY
 
+/* When using SMP (i.e. configNUMBER_OF_CORES is greater than one), set
+ * configUSE_ADAPTIVE_MUTEXES to 1 to have a task that finds a mutex taken spin
+ * for a short time, rather than block straight away, while the mutex holder is
+ * running on another core.  Each mutex keeps an average of how long its waits
+ * spin for and limits the next spin to about twice that, and the task blocks
+ * as normal, with priority inheritance, if the holder stops running or the
+ * limit is reached.  Checking whether the holder is running takes the TASK and
+ * ISR locks, so leave this at 0 unless measurements on the target show that
+ * spinning helps.  Adds 4 bytes to each queue.  Requires configUSE_MUTEXES to
+ * also be 1.  Defaults to 0 if left undefined. */
+#define configUSE_ADAPTIVE_MUTEXES                0
+
+/* configADAPTIVE_MUTEX_MAX_SPINS sets the most times a task polls a mutex
+ * before it blocks when configUSE_ADAPTIVE_MUTEXES is 1.  Set it to about the
+ * number of polls that take as long as blocking and being unblocked again.
+ * Defaults to 1000 if left undefined. */
+#define configADAPTIVE_MUTEX_MAX_SPINS            1000
+
 /******************************************************************************/
 /* ARMv8-M secure side port related definitions. ******************************/
 /******************************************************************************/
@@ -642,6 +785,120 @@
 #define configUSE_QUEUE_SETS                   0
 #define configUSE_APPLICATION_TASK_TAG         0
 
+/* Set configUSE_SEMAPHORE_FAST_PATH to 1 to have xSemaphoreGive() and
+ * xSemaphoreTake() update the count of a binary or counting semaphore with a
+ * compare-and-swap, rather than inside a critical section, when no task is
+ * waiting for the semaphore.  The compare-and-swap is a single instruction
+ * where GCC provides one and otherwise masks interrupts.  Mutexes always take
+ * the full path.  traceQUEUE_SEND() and traceQUEUE_RECEIVE() are called after
+ * the count changes rather than before.  If configUSE_TRACE_FACILITY is 1 the
+ * interrupt mask is always used, so the trace macros are called with
+ * interrupts masked as they are on the full path.  Not supported in SMP
+ * FreeRTOS.  Defaults to 0 if left undefined. */
+#define configUSE_SEMAPHORE_FAST_PATH          0
+
+/* Set configUSE_TRANSITIVE_PRIORITY_INHERITANCE to 1 to have priority
+ * inheritance follow chains of mutexes.  When a task blocks on a mutex whose
+ * holder is itself blocked on a second mutex, the holder of the second mutex
+ * inherits the priority too, and so on along the chain.  Priorities passed along
+ * a chain are withdrawn again when the waiting task times out.  Adds a pointer
+ * to each TCB.  Requires configUSE_MUTEXES to be 1.  Not supported when
+ * portUSING_GRANULAR_LOCKS is 1.  Defaults to 0 if left undefined. */
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 0
+
+/* configMAX_PRIORITY_INHERITANCE_DEPTH sets the most tasks, including the
+ * holder of the mutex being waited for, whose priority is changed each time a
+ * task blocks on a mutex or times out waiting for one, which bounds the time
+ * spent in the critical section that makes the changes.  Defaults to 4 if left
+ * undefined. */
+#define configMAX_PRIORITY_INHERITANCE_DEPTH   4
+
+/* Set configUSE_PRIORITY_CEILING_MUTEXES to 1 to include
+ * xSemaphoreCreateCeilingMutex() and xSemaphoreCreateCeilingMutexStatic(),
+ * which create mutexes that raise the task taking them to a fixed ceiling
+ * priority until they are given back, instead of using priority inheritance.
+ * Adds two UBaseType_t members to each queue.  Requires configUSE_MUTEXES to
+ * be 1.  Defaults to 0 if left undefined. */
+#define configUSE_PRIORITY_CEILING_MUTEXES     0
+
+/* Set configUSE_QUEUE_LOANS to 1 to include xQueueAcquireSendSlot(),
+ * xQueueCommitSendSlot(), vQueueCancelSendSlot(), xQueueBorrowItem() and
+ * vQueueReleaseItem(), which let a task build or process a queue item in the
+ * queue's own storage instead of copying it in and out.  Adds one byte to each
+ * queue.  Defaults to 0 if left undefined. */
+#define configUSE_QUEUE_LOANS                  0
+
+/* Set configUSE_QUEUE_WORD_COPY to 1 to have queues that hold 4, 8 or 16 byte
+ * items copy them in and out with a memcpy() of constant size, which the
+ * compiler can expand inline, rather than with a memcpy() of the item size
+ * read at run time.  Adds one byte to each queue.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_QUEUE_WORD_COPY              0
+
+/* Set configUSE_QUEUE_SET_READY_LISTS to 1 to have each queue set keep a list
+ * of its members that hold data, rather than a queue of member handles with
+ * one entry per item posted.  A queue set then needs no storage area, however
+ * long its members are, and xQueueSelectFromSet() returns each member holding
+ * data in turn.  uxQueueMessagesWaiting() on a queue set returns the number
+ * of members holding data, which can exceed the length the set was created
+ * with.  Adds one pointer to each queue.  Requires configUSE_QUEUE_SETS to also
+ * be 1.  Defaults to 0 if left undefined. */
+#define configUSE_QUEUE_SET_READY_LISTS        0
+
+/* Set configUSE_PRIORITY_QUEUES to 1 to include xQueueCreatePriorityQueue(),
+ * which creates queues that return the highest priority message first and
+ * messages of equal priority in the order they were sent.  Adds a pointer and
+ * a 32-bit counter to each queue.  Defaults to 0 if left undefined. */
+#define configUSE_PRIORITY_QUEUES              0
+
+/* Set configUSE_QUEUE_STATS to 1 to have each queue, semaphore and mutex count
+ * its peak occupancy, blocked and failed sends and receives, the ticks spent
+ * blocked, and deferred events while locked.  The counts are read with
+ * vQueueGetStats(), or for every registered queue at once with
+ * uxQueueGetRegistryStats().  Adds 32 bytes to each queue.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_QUEUE_STATS                  0
+
+/* Set configUSE_SPSC_CHANNELS to 1 to include the single producer, single
+ * consumer channels declared in spsc_channel.h, which pass items from one task
+ * or interrupt to one task without entering a critical section.
+ * spsc_channel.c must be included in the project.  Requires
+ * configUSE_TASK_NOTIFICATIONS to also be 1.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_SPSC_CHANNELS                0
+
+/* configSPSC_CHANNEL_CACHE_LINE_SIZE sets the size, in bytes, each group of
+ * channel fields is padded to, so the writer and reader indices are never on
+ * the same cache line.  Must be a power of 2 and at least 32.  Defaults to 32
+ * if left undefined. */
+#define configSPSC_CHANNEL_CACHE_LINE_SIZE     32
+
+/* configSPSC_CHANNEL_NOTIFICATION_INDEX sets the task notification index a
+ * reader task waits on while a channel is empty.  The reader task must not use
+ * that index for anything else.  Defaults to 0 if left undefined. */
+#define configSPSC_CHANNEL_NOTIFICATION_INDEX  0
+
+/* Set configUSE_MPMC_QUEUES to 1 to include the multiple producer, multiple
+ * consumer queues declared in mpmc_queue.h, which are written and read without
+ * entering the kernel critical section unless a task has to block or be
+ * unblocked.  mpmc_queue.c must be included in the project.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_MPMC_QUEUES                  0
+
+/* configMPMC_QUEUE_CACHE_LINE_SIZE sets the size, in bytes, the write and
+ * read positions of an MPMC queue are each padded to, so writers and readers
+ * on different cores do not contend for the same cache line.  Must be a power
+ * of 2 and at least 32.  Defaults to 32 if left undefined. */
+#define configMPMC_QUEUE_CACHE_LINE_SIZE       32
+
+/* Set configUSE_RW_LOCKS to 1 to include the reader-writer locks declared in
+ * rwlock.h, which many tasks can hold for reading at once or one task can
+ * hold for writing.  Waiting writers are preferred over new readers, and the
+ * writer inherits the priority of higher priority tasks that block on the
+ * lock.  Requires configUSE_MUTEXES to be 1.  rwlock.c must be included in the
+ * project.  Defaults to 0 if left undefined. */
+#define configUSE_RW_LOCKS                     0
+
 /* USE_POSIX_ERRNO enables the task global FreeRTOS_errno variable which will
  * contain the most recent error for that task. */
 #define configUSE_POSIX_ERRNO                  0
@@ -658,6 +915,7 @@
 #define INCLUDE_xTaskGetSchedulerState         1
 #define INCLUDE_xTaskGetCurrentTaskHandle      1
 #define INCLUDE_uxTaskGetStackHighWaterMark    0
+#define INCLUDE_uxTaskGetAllStackHighWaterMarks 0
 #define INCLUDE_xTaskGetIdleTaskHandle         0
 #define INCLUDE_eTaskGetState                  0
 #define INCLUDE_xTimerPendFunctionCall         0
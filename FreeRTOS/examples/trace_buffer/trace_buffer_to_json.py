@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+#
+# FreeRTOS Kernel <DEVELOPMENT BRANCH>
+# Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# SPDX-License-Identifier: MIT
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+# https://www.FreeRTOS.org
+# https://github.com/FreeRTOS
+#
+
+"""Convert records written by xTraceBufferDrain() into Chrome trace event JSON.
+
+The input is the raw bytes read from the stream buffer passed to
+xTraceBufferDrain(), as a sequence of 8 byte TraceBufferRecord_t structures.
+The output can be opened in the Perfetto UI (https://ui.perfetto.dev) or in
+chrome://tracing.  Each core is shown as a thread, with a slice for each period
+a task was running on it, and the other kernel events shown as instant events.
+
+Example:
+    trace_buffer_to_json.py --frequency 1000000 trace.bin trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# Must match the tbEVENT_ values in include/trace_buffer.h.
+EVENT_TASK_SWITCHED_IN = 1
+EVENT_TASK_READY = 2
+EVENT_TASK_CREATE = 3
+EVENT_TASK_NAME = 4
+EVENT_TASK_DELETE = 5
+EVENT_TASK_DELAY = 6
+EVENT_TASK_SUSPEND = 7
+EVENT_TASK_RESUME = 8
+EVENT_QUEUE_SEND = 9
+EVENT_QUEUE_SEND_FROM_ISR = 10
+EVENT_QUEUE_RECEIVE = 11
+EVENT_QUEUE_RECEIVE_FROM_ISR = 12
+EVENT_BLOCKING_ON_QUEUE_SEND = 13
+EVENT_BLOCKING_ON_QUEUE_RECEIVE = 14
+EVENT_RECORDS_LOST = 127
+EVENT_FIRST_APPLICATION_EVENT = 128
+
+TASK_EVENT_NAMES = {
+    EVENT_TASK_READY: "Ready",
+    EVENT_TASK_CREATE: "Create",
+    EVENT_TASK_DELETE: "Delete",
+    EVENT_TASK_DELAY: "Delay",
+    EVENT_TASK_SUSPEND: "Suspend",
+    EVENT_TASK_RESUME: "Resume",
+}
+
+QUEUE_EVENT_NAMES = {
+    EVENT_QUEUE_SEND: "QueueSend",
+    EVENT_QUEUE_SEND_FROM_ISR: "QueueSendFromISR",
+    EVENT_QUEUE_RECEIVE: "QueueReceive",
+    EVENT_QUEUE_RECEIVE_FROM_ISR: "QueueReceiveFromISR",
+    EVENT_BLOCKING_ON_QUEUE_SEND: "BlockingOnQueueSend",
+    EVENT_BLOCKING_ON_QUEUE_RECEIVE: "BlockingOnQueueReceive",
+}
+
+RECORD_LENGTH = 8
+PROCESS_ID = 1
+
+
+def read_records(data, byte_order):
+    """Yield (timestamp, object, event, core) for each complete record."""
+    record = struct.Struct(byte_order + "IHBB")
+    for offset in range(0, len(data) - (len(data) % RECORD_LENGTH), RECORD_LENGTH):
+        yield record.unpack_from(data, offset)
+
+
+def convert(data, byte_order, frequency):
+    events = []
+    task_names = {}
+    last_raw = {}
+    wrap_offset = {}
+    running = {}
+    naming = {}
+    lost = 0
+    microseconds_per_tick = 1000000.0 / frequency
+
+    def task_name(number):
+        return task_names.get(number, "Task %d" % number)
+
+    def end_slice(core, timestamp):
+        if core in running:
+            number, start = running.pop(core)
+            events.append({
+                "name": task_name(number),
+                "ph": "X",
+                "pid": PROCESS_ID,
+                "tid": core,
+                "ts": start,
+                "dur": timestamp - start,
+                "args": {"task": number},
+            })
+
+    for raw, obj, event, core in read_records(data, byte_order):
+        if event == EVENT_TASK_NAME:
+            # The timestamp field holds four more characters of the name.  The
+            # name is only used if the create record that starts it was seen.
+            if naming.get(core) == obj:
+                characters = struct.pack("<I", raw).split(b"\0", 1)[0]
+                task_names[obj] += characters.decode("ascii", "replace")
+                if len(characters) < 4:
+                    del naming[core]
+            continue
+
+        if event == EVENT_RECORDS_LOST:
+            # The timestamp field holds the number of records lost.  Anything
+            # running on the core can no longer be trusted to still be running.
+            lost += raw
+            running.pop(core, None)
+            naming.pop(core, None)
+            continue
+
+        # Timestamps are 32 bits, so extend them across each wrap.  Records
+        # from a single core are always in time order.
+        if core in last_raw and raw < last_raw[core]:
+            wrap_offset[core] = wrap_offset.get(core, 0) + (1 << 32)
+        last_raw[core] = raw
+        timestamp = (raw + wrap_offset.get(core, 0)) * microseconds_per_tick
+
+        if event == EVENT_TASK_SWITCHED_IN:
+            end_slice(core, timestamp)
+            running[core] = (obj, timestamp)
+        else:
+            if event == EVENT_TASK_CREATE:
+                task_names[obj] = ""
+                naming[core] = obj
+
+            if event in TASK_EVENT_NAMES:
+                name = TASK_EVENT_NAMES[event]
+                args = {"task": obj}
+            elif event in QUEUE_EVENT_NAMES:
+                name = QUEUE_EVENT_NAMES[event]
+                args = {"queue": obj}
+            elif event >= EVENT_FIRST_APPLICATION_EVENT:
+                name = "Application %d" % event
+                args = {"object": obj}
+            else:
+                name = "Unknown %d" % event
+                args = {"object": obj}
+
+            events.append({
+                "name": name,
+                "ph": "i",
+                "s": "t",
+                "pid": PROCESS_ID,
+                "tid": core,
+                "ts": timestamp,
+                "args": args,
+            })
+
+    # Close the slices of the tasks still running at the end of the trace.
+    for core in list(running):
+        end_slice(core, (last_raw[core] + wrap_offset.get(core, 0)) * microseconds_per_tick)
+
+    # A task can run before the records that name it are seen, for example if
+    # they were lost, so name the slices once all the names are known.
+    for event in events:
+        if event["ph"] == "X":
+            event["name"] = task_name(event["args"]["task"])
+
+    metadata = [{"name": "process_name", "ph": "M", "pid": PROCESS_ID, "args": {"name": "FreeRTOS"}}]
+    for core in sorted(set(last_raw)):
+        metadata.append({"name": "thread_name", "ph": "M", "pid": PROCESS_ID, "tid": core,
+                         "args": {"name": "Core %d" % core}})
+
+    return {"traceEvents": metadata + events, "otherData": {"recordsLost": lost}}, lost
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert FreeRTOS trace buffer records into Chrome trace event JSON.")
+    parser.add_argument("input", help="file holding the bytes written by xTraceBufferDrain()")
+    parser.add_argument("output", nargs="?", help="JSON file to write, standard output if omitted")
+    parser.add_argument("--frequency", type=float, default=1000000.0,
+                        help="frequency of the trace timestamp in Hz (default 1000000)")
+    parser.add_argument("--big-endian", action="store_true",
+                        help="the records were written by a big endian target")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    if len(data) % RECORD_LENGTH != 0:
+        print("warning: ignoring %d trailing bytes" % (len(data) % RECORD_LENGTH), file=sys.stderr)
+
+    trace, lost = convert(data, ">" if args.big_endian else "<", args.frequency)
+
+    if lost > 0:
+        print("warning: %d records were lost" % lost, file=sys.stderr)
+
+    if args.output is None:
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -289,6 +289,10 @@
     #define INCLUDE_uxTaskGetStackHighWaterMark2    0
 #endif
 
+#ifndef INCLUDE_uxTaskGetAllStackHighWaterMarks
+    #define INCLUDE_uxTaskGetAllStackHighWaterMarks    0
+#endif
+
 #ifndef INCLUDE_eTaskGetState
     #define INCLUDE_eTaskGetState    0
 #endif
@@ -315,6 +319,10 @@
     #endif
 #endif
 
+#ifndef configUSE_ASYNC_COROUTINES
+    #define configUSE_ASYNC_COROUTINES    0
+#endif
+
 #ifndef configUSE_APPLICATION_TASK_TAG
     #define configUSE_APPLICATION_TASK_TAG    0
 #endif
@@ -416,6 +424,14 @@
     #define configRUN_MULTIPLE_PRIORITIES    0
 #endif
 
+#ifndef configUSE_HOME_CORE_READY_LISTS
+    #define configUSE_HOME_CORE_READY_LISTS    0
+#endif
+
+#if ( ( configUSE_HOME_CORE_READY_LISTS == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_HOME_CORE_READY_LISTS can only be set to 1 when configNUMBER_OF_CORES is greater than 1.
+#endif
+
 #ifndef portGET_CORE_ID
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -492,6 +508,34 @@
 
 #endif /* portGET_ISR_LOCK */
 
+#ifndef portUSING_GRANULAR_LOCKS
+    #define portUSING_GRANULAR_LOCKS    0
+#endif
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        #error portUSING_GRANULAR_LOCKS is only supported in SMP
+    #endif
+
+    #ifndef portSPINLOCK_TYPE
+        #error portSPINLOCK_TYPE is required when portUSING_GRANULAR_LOCKS is 1
+    #endif
+
+    #ifndef portINIT_SPINLOCK
+        #error portINIT_SPINLOCK is required when portUSING_GRANULAR_LOCKS is 1
+    #endif
+
+    #ifndef portGET_SPINLOCK
+        #error portGET_SPINLOCK is required when portUSING_GRANULAR_LOCKS is 1
+    #endif
+
+    #ifndef portRELEASE_SPINLOCK
+        #error portRELEASE_SPINLOCK is required when portUSING_GRANULAR_LOCKS is 1
+    #endif
+
+#endif /* portUSING_GRANULAR_LOCKS */
+
 #ifndef portENTER_CRITICAL_FROM_ISR
 
     #if ( configNUMBER_OF_CORES > 1 )
@@ -609,6 +653,28 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+#ifndef configUSE_TRACE_BUFFER
+    #define configUSE_TRACE_BUFFER    0
+#endif
+
+#if ( configUSE_TRACE_BUFFER == 1 )
+    #ifndef configTRACE_BUFFER_LENGTH
+        #define configTRACE_BUFFER_LENGTH    256
+    #endif
+
+    #if ( configUSE_TRACE_FACILITY != 1 )
+        #error configUSE_TRACE_FACILITY must be set to 1 when configUSE_TRACE_BUFFER is 1.
+    #endif
+
+    #if ( ( configTRACE_BUFFER_LENGTH < 2 ) || ( ( configTRACE_BUFFER_LENGTH & ( configTRACE_BUFFER_LENGTH - 1 ) ) != 0 ) )
+        #error configTRACE_BUFFER_LENGTH must be a power of 2.
+    #endif
+
+    /* The trace buffer defines the trace macros it records before the unused
+     * trace macros are removed below. */
+    #include "trace_buffer.h"
+#endif /* configUSE_TRACE_BUFFER */
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -681,6 +747,23 @@
     #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )
 #endif
 
+#ifndef traceTASK_PRIORITY_RAISED_TO_CEILING
+
+/* Called when a task takes a priority ceiling mutex and its priority is raised
+ * to the mutex's ceiling.  pxTCBOfMutexHolder is a pointer to the TCB of the
+ * task that took the mutex.  uxCeilingPriority is the mutex's ceiling. */
+    #define traceTASK_PRIORITY_RAISED_TO_CEILING( pxTCBOfMutexHolder, uxCeilingPriority )
+#endif
+
+#ifndef traceTASK_PRIORITY_RESTORED_AFTER_CEILING
+
+/* Called when a task gives the last mutex it holds, that mutex is a priority
+ * ceiling mutex, and the task's priority is lowered again.  pxTCBOfMutexHolder
+ * is a pointer to the TCB of the task that gave the mutex.  uxRestoredPriority
+ * is the task's new (base) priority. */
+    #define traceTASK_PRIORITY_RESTORED_AFTER_CEILING( pxTCBOfMutexHolder, uxRestoredPriority )
+#endif
+
 #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
 
 /* Task is about to block because it cannot read from a
@@ -712,6 +795,10 @@
     #define configCHECK_FOR_STACK_OVERFLOW    0
 #endif
 
+#ifndef configUSE_STACK_HIGH_WATER_MARK_CACHE
+    #define configUSE_STACK_HIGH_WATER_MARK_CACHE    0
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
@@ -854,6 +941,10 @@
     #define traceTASK_DELAY()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceTASK_PRIORITY_SET
     #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )
 #endif
@@ -1174,6 +1265,14 @@
     #define traceRETURN_vEventGroupSetNumber()
 #endif
 
+#ifndef traceENTER_pxEventGroupGetAsyncWaitList
+    #define traceENTER_pxEventGroupGetAsyncWaitList( xEventGroup )
+#endif
+
+#ifndef traceRETURN_pxEventGroupGetAsyncWaitList
+    #define traceRETURN_pxEventGroupGetAsyncWaitList( pxWaitList )
+#endif
+
 #ifndef traceENTER_xQueueGenericReset
     #define traceENTER_xQueueGenericReset( xQueue, xNewQueue )
 #endif
@@ -1222,6 +1321,22 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateCeilingMutex
+    #define traceENTER_xQueueCreateCeilingMutex( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_xQueueCreateCeilingMutex
+    #define traceRETURN_xQueueCreateCeilingMutex( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateCeilingMutexStatic
+    #define traceENTER_xQueueCreateCeilingMutexStatic( uxCeilingPriority, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateCeilingMutexStatic
+    #define traceRETURN_xQueueCreateCeilingMutexStatic( xNewQueue )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1406,6 +1521,126 @@
     #define traceRETURN_uxQueueGetQueueLength( uxLength )
 #endif
 
+#ifndef traceENTER_pxQueueGetAsyncWaitList
+    #define traceENTER_pxQueueGetAsyncWaitList( xQueue, xWaitingToSend )
+#endif
+
+#ifndef traceRETURN_pxQueueGetAsyncWaitList
+    #define traceRETURN_pxQueueGetAsyncWaitList( pxWaitList )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultiple
+    #define traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultiple
+    #define traceRETURN_uxQueueSendMultiple( uxItemsSent )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultipleFromISR
+    #define traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultipleFromISR
+    #define traceRETURN_uxQueueSendMultipleFromISR( uxItemsSent )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultiple
+    #define traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultiple
+    #define traceRETURN_uxQueueReceiveMultiple( uxItemsReceived )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultipleFromISR
+    #define traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultipleFromISR
+    #define traceRETURN_uxQueueReceiveMultipleFromISR( uxItemsReceived )
+#endif
+
+#ifndef traceENTER_xQueueAcquireSendSlot
+    #define traceENTER_xQueueAcquireSendSlot( xQueue, ppvSlot, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueAcquireSendSlot
+    #define traceRETURN_xQueueAcquireSendSlot( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueCommitSendSlot
+    #define traceENTER_xQueueCommitSendSlot( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCommitSendSlot
+    #define traceRETURN_xQueueCommitSendSlot( xReturn )
+#endif
+
+#ifndef traceENTER_vQueueCancelSendSlot
+    #define traceENTER_vQueueCancelSendSlot( xQueue )
+#endif
+
+#ifndef traceRETURN_vQueueCancelSendSlot
+    #define traceRETURN_vQueueCancelSendSlot()
+#endif
+
+#ifndef traceENTER_xQueueBorrowItem
+    #define traceENTER_xQueueBorrowItem( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueBorrowItem
+    #define traceRETURN_xQueueBorrowItem( xReturn )
+#endif
+
+#ifndef traceENTER_vQueueReleaseItem
+    #define traceENTER_vQueueReleaseItem( xQueue )
+#endif
+
+#ifndef traceRETURN_vQueueReleaseItem
+    #define traceRETURN_vQueueReleaseItem()
+#endif
+
+#ifndef traceENTER_xQueueCreatePriorityQueue
+    #define traceENTER_xQueueCreatePriorityQueue( uxQueueLength, uxItemSize )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePriorityQueue
+    #define traceRETURN_xQueueCreatePriorityQueue( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreatePriorityQueueStatic
+    #define traceENTER_xQueueCreatePriorityQueueStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxNodeStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePriorityQueueStatic
+    #define traceRETURN_xQueueCreatePriorityQueueStatic( pxNewQueue )
+#endif
+
+#ifndef traceENTER_vQueueGetStats
+    #define traceENTER_vQueueGetStats( xQueue, pxStats )
+#endif
+
+#ifndef traceRETURN_vQueueGetStats
+    #define traceRETURN_vQueueGetStats()
+#endif
+
+#ifndef traceENTER_vQueueResetStats
+    #define traceENTER_vQueueResetStats( xQueue )
+#endif
+
+#ifndef traceRETURN_vQueueResetStats
+    #define traceRETURN_vQueueResetStats()
+#endif
+
+#ifndef traceENTER_uxQueueGetRegistryStats
+    #define traceENTER_uxQueueGetRegistryStats( pxQueueStatusArray, uxArraySize )
+#endif
+
+#ifndef traceRETURN_uxQueueGetRegistryStats
+    #define traceRETURN_uxQueueGetRegistryStats( uxCount )
+#endif
+
 #ifndef traceENTER_xQueueIsQueueEmptyFromISR
     #define traceENTER_xQueueIsQueueEmptyFromISR( xQueue )
 #endif
@@ -1702,6 +1937,30 @@
     #define traceRETURN_xTaskCreateStatic( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskPoolCreateStatic
+    #define traceENTER_xTaskPoolCreateStatic( uxSlots, uxStackDepth, puxStackBuffers, pxTaskBuffers, pxTaskPoolBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskPoolCreateStatic
+    #define traceRETURN_xTaskPoolCreateStatic( pxPool )
+#endif
+
+#ifndef traceENTER_xTaskCreateFromPool
+    #define traceENTER_xTaskCreateFromPool( xTaskPool, pxTaskCode, pcName, pvParameters, uxPriority )
+#endif
+
+#ifndef traceRETURN_xTaskCreateFromPool
+    #define traceRETURN_xTaskCreateFromPool( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskPoolGetStats
+    #define traceENTER_vTaskPoolGetStats( xTaskPool, pxTaskPoolStats )
+#endif
+
+#ifndef traceRETURN_vTaskPoolGetStats
+    #define traceRETURN_vTaskPoolGetStats()
+#endif
+
 #ifndef traceENTER_xTaskCreateStaticAffinitySet
     #define traceENTER_xTaskCreateStaticAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, uxCoreAffinityMask )
 #endif
@@ -1758,6 +2017,22 @@
     #define traceRETURN_xTaskCreateAffinitySet( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreateDeadline
+    #define traceENTER_xTaskCreateDeadline( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreateDeadline
+    #define traceRETURN_xTaskCreateDeadline( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetDeadline
+    #define traceENTER_vTaskSetDeadline( xTask, xRelativeDeadline )
+#endif
+
+#ifndef traceRETURN_vTaskSetDeadline
+    #define traceRETURN_vTaskSetDeadline()
+#endif
+
 #ifndef traceENTER_vTaskDelete
     #define traceENTER_vTaskDelete( xTaskToDelete )
 #endif
@@ -1974,6 +2249,30 @@
     #define traceRETURN_uxTaskGetSystemState( uxTask )
 #endif
 
+#ifndef traceENTER_vTaskSnapshotBegin
+    #define traceENTER_vTaskSnapshotBegin( pxSnapshot )
+#endif
+
+#ifndef traceRETURN_vTaskSnapshotBegin
+    #define traceRETURN_vTaskSnapshotBegin()
+#endif
+
+#ifndef traceENTER_uxTaskSnapshotNext
+    #define traceENTER_uxTaskSnapshotNext( pxSnapshot, pxTaskStatusArray, uxArraySize, xGetFreeStackSpace )
+#endif
+
+#ifndef traceRETURN_uxTaskSnapshotNext
+    #define traceRETURN_uxTaskSnapshotNext( uxTask )
+#endif
+
+#ifndef traceENTER_xTaskSnapshotEncode
+    #define traceENTER_xTaskSnapshotEncode( pxTaskStatusArray, uxArraySize, pucBuffer, xBufferLength )
+#endif
+
+#ifndef traceRETURN_xTaskSnapshotEncode
+    #define traceRETURN_xTaskSnapshotEncode( xBytesWritten )
+#endif
+
 #if ( configNUMBER_OF_CORES == 1 )
     #ifndef traceENTER_xTaskGetIdleTaskHandle
         #define traceENTER_xTaskGetIdleTaskHandle()
@@ -2074,6 +2373,14 @@
     #define traceRETURN_vTaskPlaceOnEventList()
 #endif
 
+#ifndef traceENTER_vTaskPlaceOnBucketedEventList
+    #define traceENTER_vTaskPlaceOnBucketedEventList( pxEventList, pxBuckets, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_vTaskPlaceOnBucketedEventList
+    #define traceRETURN_vTaskPlaceOnBucketedEventList()
+#endif
+
 #ifndef traceENTER_vTaskPlaceOnUnorderedEventList
     #define traceENTER_vTaskPlaceOnUnorderedEventList( pxEventList, xItemValue, xTicksToWait )
 #endif
@@ -2210,6 +2517,14 @@
     #define traceRETURN_uxTaskGetStackHighWaterMark( uxReturn )
 #endif
 
+#ifndef traceENTER_uxTaskGetAllStackHighWaterMarks
+    #define traceENTER_uxTaskGetAllStackHighWaterMarks( pxHighWaterMarkArray, uxArraySize )
+#endif
+
+#ifndef traceRETURN_uxTaskGetAllStackHighWaterMarks
+    #define traceRETURN_uxTaskGetAllStackHighWaterMarks( uxTask )
+#endif
+
 #ifndef traceENTER_xTaskGetCurrentTaskHandle
     #define traceENTER_xTaskGetCurrentTaskHandle()
 #endif
@@ -2258,6 +2573,38 @@
     #define traceRETURN_vTaskPriorityDisinheritAfterTimeout()
 #endif
 
+#ifndef traceENTER_vTaskSetBlockingMutexHolder
+    #define traceENTER_vTaskSetBlockingMutexHolder( pxMutexHolder )
+#endif
+
+#ifndef traceRETURN_vTaskSetBlockingMutexHolder
+    #define traceRETURN_vTaskSetBlockingMutexHolder()
+#endif
+
+#ifndef traceENTER_vTaskPriorityRaiseToCeiling
+    #define traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_vTaskPriorityRaiseToCeiling
+    #define traceRETURN_vTaskPriorityRaiseToCeiling()
+#endif
+
+#ifndef traceENTER_xTaskPriorityRestoreAfterCeiling
+    #define traceENTER_xTaskPriorityRestoreAfterCeiling( pxMutexHolder )
+#endif
+
+#ifndef traceRETURN_xTaskPriorityRestoreAfterCeiling
+    #define traceRETURN_xTaskPriorityRestoreAfterCeiling( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskIsRunningOnOtherCore
+    #define traceENTER_xTaskIsRunningOnOtherCore( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskIsRunningOnOtherCore
+    #define traceRETURN_xTaskIsRunningOnOtherCore( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskYieldWithinAPI
     #define traceENTER_vTaskYieldWithinAPI()
 #endif
@@ -2298,6 +2645,54 @@
     #define traceRETURN_vTaskExitCriticalFromISR()
 #endif
 
+#ifndef traceENTER_vTaskDataGroupEnterCritical
+    #define traceENTER_vTaskDataGroupEnterCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupEnterCritical
+    #define traceRETURN_vTaskDataGroupEnterCritical()
+#endif
+
+#ifndef traceENTER_uxTaskDataGroupEnterCriticalFromISR
+    #define traceENTER_uxTaskDataGroupEnterCriticalFromISR( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_uxTaskDataGroupEnterCriticalFromISR
+    #define traceRETURN_uxTaskDataGroupEnterCriticalFromISR( uxSavedInterruptStatus )
+#endif
+
+#ifndef traceENTER_vTaskDataGroupExitCritical
+    #define traceENTER_vTaskDataGroupExitCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupExitCritical
+    #define traceRETURN_vTaskDataGroupExitCritical()
+#endif
+
+#ifndef traceENTER_vTaskDataGroupExitCriticalFromISR
+    #define traceENTER_vTaskDataGroupExitCriticalFromISR( uxSavedInterruptStatus, pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupExitCriticalFromISR
+    #define traceRETURN_vTaskDataGroupExitCriticalFromISR()
+#endif
+
+#ifndef traceENTER_vTaskDataGroupLockKernel
+    #define traceENTER_vTaskDataGroupLockKernel()
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupLockKernel
+    #define traceRETURN_vTaskDataGroupLockKernel()
+#endif
+
+#ifndef traceENTER_vTaskDataGroupUnlockKernel
+    #define traceENTER_vTaskDataGroupUnlockKernel()
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupUnlockKernel
+    #define traceRETURN_vTaskDataGroupUnlockKernel()
+#endif
+
 #ifndef traceENTER_vTaskListTasks
     #define traceENTER_vTaskListTasks( pcWriteBuffer, uxBufferLength )
 #endif
@@ -2418,6 +2813,30 @@
     #define traceRETURN_ulTaskGetIdleRunTimePercent( ulReturn )
 #endif
 
+#ifndef traceENTER_xTaskGetLatencyHistogram
+    #define traceENTER_xTaskGetLatencyHistogram( xTask, pulHistogram, uxHistogramLength )
+#endif
+
+#ifndef traceRETURN_xTaskGetLatencyHistogram
+    #define traceRETURN_xTaskGetLatencyHistogram( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskGetGlobalLatencyHistogram
+    #define traceENTER_xTaskGetGlobalLatencyHistogram( pulHistogram, uxHistogramLength )
+#endif
+
+#ifndef traceRETURN_xTaskGetGlobalLatencyHistogram
+    #define traceRETURN_xTaskGetGlobalLatencyHistogram( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskResetLatencyHistograms
+    #define traceENTER_vTaskResetLatencyHistograms()
+#endif
+
+#ifndef traceRETURN_vTaskResetLatencyHistograms
+    #define traceRETURN_vTaskResetLatencyHistograms()
+#endif
+
 #ifndef traceENTER_xTaskGetMPUSettings
     #define traceENTER_xTaskGetMPUSettings( xTask )
 #endif
@@ -2610,6 +3029,14 @@
     #define traceRETURN_ucStreamBufferGetStreamBufferType( ucStreamBufferType )
 #endif
 
+#ifndef traceENTER_pxStreamBufferGetAsyncWaitList
+    #define traceENTER_pxStreamBufferGetAsyncWaitList( xStreamBuffer, xWaitingToSend )
+#endif
+
+#ifndef traceRETURN_pxStreamBufferGetAsyncWaitList
+    #define traceRETURN_pxStreamBufferGetAsyncWaitList( pxWaitList )
+#endif
+
 #ifndef traceENTER_vListInitialise
     #define traceENTER_vListInitialise( pxList )
 #endif
@@ -2682,82 +3109,332 @@
     #define traceRETURN_xCoRoutineRemoveFromEventList( xReturn )
 #endif
 
-#ifndef configGENERATE_RUN_TIME_STATS
-    #define configGENERATE_RUN_TIME_STATS    0
+#ifndef traceENTER_vAsyncExecutorInitialise
+    #define traceENTER_vAsyncExecutorInitialise( pxExecutor )
 #endif
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#ifndef traceRETURN_vAsyncExecutorInitialise
+    #define traceRETURN_vAsyncExecutorInitialise()
+#endif
 
-    #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
-        #error If configGENERATE_RUN_TIME_STATS is defined then portCONFIGURE_TIMER_FOR_RUN_TIME_STATS must also be defined.  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS should call a port layer function to setup a peripheral timer/counter that can then be used as the run time counter time base.
-    #endif /* portCONFIGURE_TIMER_FOR_RUN_TIME_STATS */
+#ifndef traceENTER_vAsyncExecutorRun
+    #define traceENTER_vAsyncExecutorRun( pxExecutor )
+#endif
 
-    #ifndef portGET_RUN_TIME_COUNTER_VALUE
-        #ifndef portALT_GET_RUN_TIME_COUNTER_VALUE
-            #error If configGENERATE_RUN_TIME_STATS is defined then either portGET_RUN_TIME_COUNTER_VALUE or portALT_GET_RUN_TIME_COUNTER_VALUE must also be defined.  See the examples provided and the FreeRTOS web site for more information.
-        #endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
-    #endif /* portGET_RUN_TIME_COUNTER_VALUE */
+#ifndef traceENTER_vAsyncCoroutineStart
+    #define traceENTER_vAsyncCoroutineStart( pxExecutor, pxCoroutine, pxFunction, pvParameters )
+#endif
 
-#endif /* configGENERATE_RUN_TIME_STATS */
+#ifndef traceRETURN_vAsyncCoroutineStart
+    #define traceRETURN_vAsyncCoroutineStart()
+#endif
 
-#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
-    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#ifndef traceENTER_xAsyncNotifyGive
+    #define traceENTER_xAsyncNotifyGive( pxCoroutine )
 #endif
 
-#ifndef portPRIVILEGE_BIT
-    #define portPRIVILEGE_BIT    ( ( UBaseType_t ) 0x00 )
+#ifndef traceRETURN_xAsyncNotifyGive
+    #define traceRETURN_xAsyncNotifyGive( xReturn )
 #endif
 
-#ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+#ifndef traceENTER_vAsyncNotifyGiveFromISR
+    #define traceENTER_vAsyncNotifyGiveFromISR( pxCoroutine, pxHigherPriorityTaskWoken )
 #endif
 
-#ifndef portSUPPRESS_TICKS_AND_SLEEP
-    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#ifndef traceRETURN_vAsyncNotifyGiveFromISR
+    #define traceRETURN_vAsyncNotifyGiveFromISR()
 #endif
 
-#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
-    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#ifndef traceENTER_xSpscChannelCreate
+    #define traceENTER_xSpscChannelCreate( uxLength, uxItemSize )
 #endif
 
-#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
-    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#ifndef traceRETURN_xSpscChannelCreate
+    #define traceRETURN_xSpscChannelCreate( pxChannel )
 #endif
 
-#ifndef configUSE_TICKLESS_IDLE
-    #define configUSE_TICKLESS_IDLE    0
+#ifndef traceENTER_xSpscChannelCreateStatic
+    #define traceENTER_xSpscChannelCreateStatic( uxLength, uxItemSize, pucChannelStorage, pxStaticChannel )
 #endif
 
-#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
-    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+#ifndef traceRETURN_xSpscChannelCreateStatic
+    #define traceRETURN_xSpscChannelCreateStatic( xReturn )
 #endif
 
-#ifndef configPRE_SLEEP_PROCESSING
-    #define configPRE_SLEEP_PROCESSING( x )
+#ifndef traceENTER_vSpscChannelDelete
+    #define traceENTER_vSpscChannelDelete( xChannel )
 #endif
 
-#ifndef configPOST_SLEEP_PROCESSING
-    #define configPOST_SLEEP_PROCESSING( x )
+#ifndef traceRETURN_vSpscChannelDelete
+    #define traceRETURN_vSpscChannelDelete()
 #endif
 
-#ifndef configUSE_QUEUE_SETS
-    #define configUSE_QUEUE_SETS    0
+#ifndef traceENTER_xSpscChannelSend
+    #define traceENTER_xSpscChannelSend( xChannel, pvItemToSend )
 #endif
 
-#ifndef portTASK_USES_FLOATING_POINT
-    #define portTASK_USES_FLOATING_POINT()
+#ifndef traceRETURN_xSpscChannelSend
+    #define traceRETURN_xSpscChannelSend( xReturn )
 #endif
 
-#ifndef portALLOCATE_SECURE_CONTEXT
-    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+#ifndef traceENTER_xSpscChannelSendFromISR
+    #define traceENTER_xSpscChannelSendFromISR( xChannel, pvItemToSend, pxHigherPriorityTaskWoken )
 #endif
 
-#ifndef portDONT_DISCARD
-    #define portDONT_DISCARD
+#ifndef traceRETURN_xSpscChannelSendFromISR
+    #define traceRETURN_xSpscChannelSendFromISR( xReturn )
 #endif
 
-#ifndef configUSE_TIME_SLICING
-    #define configUSE_TIME_SLICING    1
+#ifndef traceENTER_xSpscChannelReceive
+    #define traceENTER_xSpscChannelReceive( xChannel, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xSpscChannelReceive
+    #define traceRETURN_xSpscChannelReceive( xReturn )
+#endif
+
+#ifndef traceENTER_uxSpscChannelItemsWaiting
+    #define traceENTER_uxSpscChannelItemsWaiting( xChannel )
+#endif
+
+#ifndef traceRETURN_uxSpscChannelItemsWaiting
+    #define traceRETURN_uxSpscChannelItemsWaiting( uxReturn )
+#endif
+
+#ifndef traceENTER_xMpmcQueueCreate
+    #define traceENTER_xMpmcQueueCreate( uxQueueLength, uxItemSize )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueCreate
+    #define traceRETURN_xMpmcQueueCreate( pxQueue )
+#endif
+
+#ifndef traceENTER_xMpmcQueueCreateStatic
+    #define traceENTER_xMpmcQueueCreateStatic( uxQueueLength, uxItemSize, pulQueueStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueCreateStatic
+    #define traceRETURN_xMpmcQueueCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vMpmcQueueDelete
+    #define traceENTER_vMpmcQueueDelete( xQueue )
+#endif
+
+#ifndef traceRETURN_vMpmcQueueDelete
+    #define traceRETURN_vMpmcQueueDelete()
+#endif
+
+#ifndef traceENTER_xMpmcQueueSend
+    #define traceENTER_xMpmcQueueSend( xQueue, pvItemToQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueSend
+    #define traceRETURN_xMpmcQueueSend( xReturn )
+#endif
+
+#ifndef traceENTER_xMpmcQueueSendFromISR
+    #define traceENTER_xMpmcQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueSendFromISR
+    #define traceRETURN_xMpmcQueueSendFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xMpmcQueueReceive
+    #define traceENTER_xMpmcQueueReceive( xQueue, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueReceive
+    #define traceRETURN_xMpmcQueueReceive( xReturn )
+#endif
+
+#ifndef traceENTER_xMpmcQueueReceiveFromISR
+    #define traceENTER_xMpmcQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueReceiveFromISR
+    #define traceRETURN_xMpmcQueueReceiveFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_uxMpmcQueueMessagesWaiting
+    #define traceENTER_uxMpmcQueueMessagesWaiting( xQueue )
+#endif
+
+#ifndef traceRETURN_uxMpmcQueueMessagesWaiting
+    #define traceRETURN_uxMpmcQueueMessagesWaiting( uxReturn )
+#endif
+
+#ifndef traceENTER_xRwLockCreate
+    #define traceENTER_xRwLockCreate()
+#endif
+
+#ifndef traceRETURN_xRwLockCreate
+    #define traceRETURN_xRwLockCreate( pxLock )
+#endif
+
+#ifndef traceENTER_xRwLockCreateStatic
+    #define traceENTER_xRwLockCreateStatic( pxStaticLock )
+#endif
+
+#ifndef traceRETURN_xRwLockCreateStatic
+    #define traceRETURN_xRwLockCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vRwLockDelete
+    #define traceENTER_vRwLockDelete( xLock )
+#endif
+
+#ifndef traceRETURN_vRwLockDelete
+    #define traceRETURN_vRwLockDelete()
+#endif
+
+#ifndef traceENTER_xRwLockTakeRead
+    #define traceENTER_xRwLockTakeRead( xLock, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xRwLockTakeRead
+    #define traceRETURN_xRwLockTakeRead( xReturn )
+#endif
+
+#ifndef traceENTER_xRwLockGiveRead
+    #define traceENTER_xRwLockGiveRead( xLock )
+#endif
+
+#ifndef traceRETURN_xRwLockGiveRead
+    #define traceRETURN_xRwLockGiveRead( xReturn )
+#endif
+
+#ifndef traceENTER_xRwLockTakeWrite
+    #define traceENTER_xRwLockTakeWrite( xLock, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xRwLockTakeWrite
+    #define traceRETURN_xRwLockTakeWrite( xReturn )
+#endif
+
+#ifndef traceENTER_xRwLockGiveWrite
+    #define traceENTER_xRwLockGiveWrite( xLock )
+#endif
+
+#ifndef traceRETURN_xRwLockGiveWrite
+    #define traceRETURN_xRwLockGiveWrite( xReturn )
+#endif
+
+#ifndef traceENTER_uxRwLockGetReaderCount
+    #define traceENTER_uxRwLockGetReaderCount( xLock )
+#endif
+
+#ifndef traceRETURN_uxRwLockGetReaderCount
+    #define traceRETURN_uxRwLockGetReaderCount( uxReturn )
+#endif
+
+#ifndef traceENTER_xRwLockGetWriter
+    #define traceENTER_xRwLockGetWriter( xLock )
+#endif
+
+#ifndef traceRETURN_xRwLockGetWriter
+    #define traceRETURN_xRwLockGetWriter( xReturn )
+#endif
+
+#ifndef configGENERATE_RUN_TIME_STATS
+    #define configGENERATE_RUN_TIME_STATS    0
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+        #error If configGENERATE_RUN_TIME_STATS is defined then portCONFIGURE_TIMER_FOR_RUN_TIME_STATS must also be defined.  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS should call a port layer function to setup a peripheral timer/counter that can then be used as the run time counter time base.
+    #endif /* portCONFIGURE_TIMER_FOR_RUN_TIME_STATS */
+
+    #ifndef portGET_RUN_TIME_COUNTER_VALUE
+        #ifndef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #error If configGENERATE_RUN_TIME_STATS is defined then either portGET_RUN_TIME_COUNTER_VALUE or portALT_GET_RUN_TIME_COUNTER_VALUE must also be defined.  See the examples provided and the FreeRTOS web site for more information.
+        #endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
+    #endif /* portGET_RUN_TIME_COUNTER_VALUE */
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+#ifndef configUSE_LATENCY_HISTOGRAMS
+    #define configUSE_LATENCY_HISTOGRAMS    0
+#endif
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    /* Latencies are timed with portGET_LATENCY_TIMESTAMP() if the port
+     * defines it, otherwise with the run time counter. */
+    #if ( !defined( portGET_LATENCY_TIMESTAMP ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+        #error configUSE_LATENCY_HISTOGRAMS can only be set to 1 when either portGET_LATENCY_TIMESTAMP is defined or configGENERATE_RUN_TIME_STATS is 1.
+    #endif
+
+    #ifndef configLATENCY_HISTOGRAM_BUCKETS
+        #define configLATENCY_HISTOGRAM_BUCKETS    16
+    #endif
+
+    #if ( ( configLATENCY_HISTOGRAM_BUCKETS < 2 ) || ( configLATENCY_HISTOGRAM_BUCKETS > 64 ) )
+        #error configLATENCY_HISTOGRAM_BUCKETS must be between 2 and 64.
+    #endif
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#endif
+
+#ifndef portPRIVILEGE_BIT
+    #define portPRIVILEGE_BIT    ( ( UBaseType_t ) 0x00 )
+#endif
+
+#ifndef portYIELD_WITHIN_API
+    #define portYIELD_WITHIN_API    portYIELD
+#endif
+
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+    #define configUSE_TICKLESS_IDLE    0
+#endif
+
+#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
+    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+    #define configPRE_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+    #define configPOST_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+    #define configUSE_QUEUE_SETS    0
+#endif
+
+#ifndef portTASK_USES_FLOATING_POINT
+    #define portTASK_USES_FLOATING_POINT()
+#endif
+
+#ifndef portALLOCATE_SECURE_CONTEXT
+    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+#endif
+
+#ifndef portDONT_DISCARD
+    #define portDONT_DISCARD
+#endif
+
+#ifndef configUSE_TIME_SLICING
+    #define configUSE_TIME_SLICING    1
 #endif
 
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
@@ -2792,6 +3469,144 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #define configUSE_READY_PRIORITY_BITMAP    0
+#endif
+
+#if ( ( configUSE_READY_PRIORITY_BITMAP == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) )
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_READY_PRIORITY_BITMAP is not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configMAX_PRIORITIES must not exceed 1024 when configUSE_READY_PRIORITY_BITMAP is 1.
+    #endif
+
+#endif
+
+#ifndef configUSE_QUEUE_LOANS
+    #define configUSE_QUEUE_LOANS    0
+#endif
+
+#ifndef configUSE_QUEUE_WORD_COPY
+    #define configUSE_QUEUE_WORD_COPY    0
+#endif
+
+#ifndef configUSE_QUEUE_SET_READY_LISTS
+    #define configUSE_QUEUE_SET_READY_LISTS    0
+#endif
+
+#if ( ( configUSE_QUEUE_SET_READY_LISTS == 1 ) && ( configUSE_QUEUE_SETS != 1 ) )
+    #error configUSE_QUEUE_SETS must be set to 1 when configUSE_QUEUE_SET_READY_LISTS is 1.
+#endif
+
+#ifndef configUSE_PRIORITY_QUEUES
+    #define configUSE_PRIORITY_QUEUES    0
+#endif
+
+#ifndef configUSE_QUEUE_STATS
+    #define configUSE_QUEUE_STATS    0
+#endif
+
+#ifndef configUSE_SPSC_CHANNELS
+    #define configUSE_SPSC_CHANNELS    0
+#endif
+
+#ifndef configSPSC_CHANNEL_CACHE_LINE_SIZE
+    #define configSPSC_CHANNEL_CACHE_LINE_SIZE    32
+#endif
+
+#ifndef configSPSC_CHANNEL_NOTIFICATION_INDEX
+    #define configSPSC_CHANNEL_NOTIFICATION_INDEX    0
+#endif
+
+#if ( configUSE_SPSC_CHANNELS == 1 )
+
+    #if ( ( configSPSC_CHANNEL_CACHE_LINE_SIZE < 32 ) || ( ( configSPSC_CHANNEL_CACHE_LINE_SIZE & ( configSPSC_CHANNEL_CACHE_LINE_SIZE - 1 ) ) != 0 ) )
+        #error configSPSC_CHANNEL_CACHE_LINE_SIZE must be a power of 2 and at least 32.
+    #endif
+
+#endif
+
+#ifndef configUSE_MPMC_QUEUES
+    #define configUSE_MPMC_QUEUES    0
+#endif
+
+#ifndef configMPMC_QUEUE_CACHE_LINE_SIZE
+    #define configMPMC_QUEUE_CACHE_LINE_SIZE    32
+#endif
+
+#if ( configUSE_MPMC_QUEUES == 1 )
+
+    #if ( ( configMPMC_QUEUE_CACHE_LINE_SIZE < 32 ) || ( ( configMPMC_QUEUE_CACHE_LINE_SIZE & ( configMPMC_QUEUE_CACHE_LINE_SIZE - 1 ) ) != 0 ) )
+        #error configMPMC_QUEUE_CACHE_LINE_SIZE must be a power of 2 and at least 32.
+    #endif
+
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) ) )
+    #error configUSE_MUTEXES and INCLUDE_xTaskGetCurrentTaskHandle must both be set to 1 to use reader-writer locks
+#endif
+
+#ifndef configUSE_EVENT_LIST_BUCKETS
+    #define configUSE_EVENT_LIST_BUCKETS    0
+#endif
+
+#if ( ( configUSE_EVENT_LIST_BUCKETS == 1 ) && ( configMAX_PRIORITIES > 1024 ) )
+    #error configMAX_PRIORITIES must not exceed 1024 when configUSE_EVENT_LIST_BUCKETS is 1.
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    #ifndef configEDF_TASK_PRIORITY
+        #define configEDF_TASK_PRIORITY    ( configMAX_PRIORITIES - 1 )
+    #endif
+
+    #if ( ( configEDF_TASK_PRIORITY < 1 ) || ( configEDF_TASK_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_TASK_PRIORITY must be above the idle priority and less than configMAX_PRIORITIES.
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_EDF_SCHEDULING is not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#ifndef configUSE_TIMING_WHEEL
+    #define configUSE_TIMING_WHEEL    0
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+    #ifndef configTIMING_WHEEL_SLOT_BITS
+        #define configTIMING_WHEEL_SLOT_BITS    5
+    #endif
+
+    #ifndef configTIMING_WHEEL_LEVELS
+        #define configTIMING_WHEEL_LEVELS    3
+    #endif
+
+    #if ( ( configTIMING_WHEEL_SLOT_BITS < 1 ) || ( configTIMING_WHEEL_LEVELS < 1 ) )
+        #error configTIMING_WHEEL_SLOT_BITS and configTIMING_WHEEL_LEVELS must both be at least 1.
+    #endif
+
+    #if ( ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( ( configTIMING_WHEEL_SLOT_BITS * configTIMING_WHEEL_LEVELS ) >= 16 ) ) || \
+    ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ) && ( ( configTIMING_WHEEL_SLOT_BITS * configTIMING_WHEEL_LEVELS ) >= 32 ) ) ||       \
+    ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS ) && ( ( configTIMING_WHEEL_SLOT_BITS * configTIMING_WHEEL_LEVELS ) >= 64 ) ) )
+        #error configTIMING_WHEEL_SLOT_BITS * configTIMING_WHEEL_LEVELS must be less than the number of bits in TickType_t.
+    #endif
+
+#endif /* configUSE_TIMING_WHEEL */
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -2854,6 +3669,14 @@
     #define configSTATS_BUFFER_MAX_LENGTH    0xFFFF
 #endif
 
+#ifndef configUSE_TASK_SNAPSHOT
+    #define configUSE_TASK_SNAPSHOT    0
+#endif
+
+#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_TASK_SNAPSHOT can only be set to 1 when configUSE_TRACE_FACILITY is 1, as the snapshot is returned in TaskStatus_t structures.
+#endif
+
 #ifndef configSTACK_DEPTH_TYPE
 
 /* Defaults to StackType_t for backward compatibility, but can be overridden
@@ -2882,10 +3705,74 @@
     #error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#ifndef configUSE_TASK_POOLS
+    #define configUSE_TASK_POOLS    0
+#endif
+
+#if ( ( configUSE_TASK_POOLS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION != 1 ) )
+    #error configUSE_TASK_POOLS can only be set to 1 when configSUPPORT_STATIC_ALLOCATION is 1, as the slots of a task pool are statically allocated.
+#endif
+
 #if ( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#ifndef configUSE_ADAPTIVE_MUTEXES
+    #define configUSE_ADAPTIVE_MUTEXES    0
+#endif
+
+#ifndef configADAPTIVE_MUTEX_MAX_SPINS
+    #define configADAPTIVE_MUTEX_MAX_SPINS    1000
+#endif
+
+#if ( ( configUSE_ADAPTIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use adaptive mutexes
+#endif
+
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_ADAPTIVE_MUTEXES != 0 ) )
+    #error configUSE_ADAPTIVE_MUTEXES is not supported in single core FreeRTOS
+#endif
+
+#if ( configADAPTIVE_MUTEX_MAX_SPINS > 0x7FFFFFFF )
+    #error configADAPTIVE_MUTEX_MAX_SPINS must not be more than 0x7FFFFFFF
+#endif
+
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+    #define configUSE_TRANSITIVE_PRIORITY_INHERITANCE    0
+#endif
+
+#ifndef configMAX_PRIORITY_INHERITANCE_DEPTH
+    #define configMAX_PRIORITY_INHERITANCE_DEPTH    4
+#endif
+
+#if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) && ( portUSING_GRANULAR_LOCKS == 1 ) )
+    #error configUSE_TRANSITIVE_PRIORITY_INHERITANCE is not supported when portUSING_GRANULAR_LOCKS is 1
+#endif
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH < 1 )
+    #error configMAX_PRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
+#ifndef configUSE_PRIORITY_CEILING_MUTEXES
+    #define configUSE_PRIORITY_CEILING_MUTEXES    0
+#endif
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#ifndef configUSE_SEMAPHORE_FAST_PATH
+    #define configUSE_SEMAPHORE_FAST_PATH    0
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_SEMAPHORE_FAST_PATH != 0 ) )
+    #error configUSE_SEMAPHORE_FAST_PATH is not supported in SMP FreeRTOS
+#endif
+
 #if ( ( configRUN_MULTIPLE_PRIORITIES == 0 ) && ( configUSE_TASK_PREEMPTION_DISABLE != 0 ) )
     #error configRUN_MULTIPLE_PRIORITIES must be set to 1 to use task preemption disable
 #endif
@@ -3176,6 +4063,9 @@ typedef struct xSTATIC_TCB
     #if ( configNUMBER_OF_CORES > 1 )
         BaseType_t xDummy23;
         UBaseType_t uxDummy24;
+        #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+            BaseType_t xDummy29;
+        #endif
     #endif
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
     #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
@@ -3219,8 +4109,62 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy27[ 3 ];
+        UBaseType_t uxDummy28;
+        void * pvDummy41[ 3 ];
+        uint32_t ulDummy42;
+        uint8_t ucDummy43[ 2 ];
+    #endif
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy30;
+        BaseType_t xDummy31;
+        UBaseType_t uxDummy32;
+        uint32_t ulDummy33[ configLATENCY_HISTOGRAM_BUCKETS ];
+    #endif
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        StaticListItem_t xDummy34;
+    #endif
+    #if ( configUSE_TASK_POOLS == 1 )
+        void * pvDummy35;
+    #endif
+    #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+        void * pvDummy36;
+        UBaseType_t uxDummy37;
+    #endif
+    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        configSTACK_DEPTH_TYPE uxDummy38;
+        uint8_t ucDummy39;
+    #endif
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        void * pvDummy40;
+    #endif
 } StaticTask_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the task pool structure used
+ * internally by FreeRTOS is not accessible to application code.  However, the
+ * memory used to hold a task pool is always provided by the application, so
+ * the size of the task pool object needs to be known.  The StaticTaskPool_t
+ * structure below is provided for this purpose.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure, no
+ * matter which architecture is being used, and no matter how the values in
+ * FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+#if ( configUSE_TASK_POOLS == 1 )
+    typedef struct xSTATIC_TASK_POOL
+    {
+        StaticList_t xDummy1;
+        configSTACK_DEPTH_TYPE uxDummy2;
+        UBaseType_t uxDummy3[ 2 ];
+        uint32_t ulDummy4[ 2 ];
+    } StaticTaskPool_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3255,15 +4199,78 @@ typedef struct xSTATIC_QUEUE
 
     #if ( configUSE_QUEUE_SETS == 1 )
         void * pvDummy7;
+
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+            void * pvDummy16;
+        #endif
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummySpinlock;
+    #endif
+
+    #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+        struct
+        {
+            void * pvDummy10[ configMAX_PRIORITIES ];
+            uint32_t ulDummy11[ ( ( configMAX_PRIORITIES + 31U ) / 32U ) + 1U ];
+        } xDummy12[ 2 ];
+    #endif
+
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        void * pvDummy13[ 2 ];
+    #endif
+
+    #if ( configUSE_QUEUE_LOANS == 1 )
+        uint8_t ucDummy14;
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        void * pvDummy17;
+        uint32_t ulDummy18;
+    #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        struct
+        {
+            UBaseType_t uxDummy1;
+            uint32_t ulDummy2[ 7 ];
+        } xDummy19;
+    #endif
+
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        uint32_t ulDummy20;
+    #endif
+
+    #if ( configUSE_QUEUE_WORD_COPY == 1 )
+        uint8_t ucDummy15;
+    #endif
+
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxDummy21;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
+/*
+ * The node storage of a statically allocated priority queue is an array of
+ * StaticPriorityQueueNode_t, one for each space in the queue.  See the
+ * StaticQueue_t definition above for the reasoning behind the opaque type.
+ */
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    typedef struct xSTATIC_PRIORITY_QUEUE_NODE
+    {
+        uint32_t ulDummy1;
+        UBaseType_t uxDummy2;
+        uint8_t ucDummy3;
+    } StaticPriorityQueueNode_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3290,6 +4297,14 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummySpinlock;
+    #endif
+
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        void * pvDummy5;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -3345,11 +4360,96 @@ typedef struct xSTATIC_STREAM_BUFFER
         void * pvDummy5[ 2 ];
     #endif
     UBaseType_t uxDummy6;
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummySpinlock;
+    #endif
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        void * pvDummy7[ 2 ];
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real channel structure is not accessible to
+ * application code.  The StaticSpscChannel_t structure below is provided so the
+ * application writer can statically allocate the memory required to create a
+ * channel.  Its size and alignment requirements are guaranteed to match those
+ * of the genuine structure.
+ */
+typedef struct xSTATIC_SPSC_CHANNEL
+{
+    union
+    {
+        struct
+        {
+            void * pvDummy1;
+            size_t uxDummy2;
+            UBaseType_t uxDummy3;
+            uint8_t ucDummy4;
+        } xDummy5;
+        uint8_t ucDummy6[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } xDummy7;
+    union
+    {
+        UBaseType_t uxDummy8;
+        uint8_t ucDummy9[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } xDummy10;
+    union
+    {
+        struct
+        {
+            UBaseType_t uxDummy11;
+            void * pvDummy12;
+        } xDummy13;
+        uint8_t ucDummy14[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } xDummy15;
+} StaticSpscChannel_t;
+
+/*
+ * The StaticMpmcQueue_t structure below is provided so the application writer
+ * can statically allocate the memory required to create an MPMC queue.  Its
+ * size and alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_MPMC_QUEUE
+{
+    union
+    {
+        struct
+        {
+            void * pvDummy1;
+            size_t uxDummy2[ 2 ];
+            uint32_t ulDummy3;
+            uint8_t ucDummy4;
+        } xDummy5;
+        uint8_t ucDummy6[ configMPMC_QUEUE_CACHE_LINE_SIZE ];
+    } xDummy7;
+    union
+    {
+        uint32_t ulDummy8;
+        uint8_t ucDummy9[ configMPMC_QUEUE_CACHE_LINE_SIZE ];
+    } xDummy10[ 2 ];
+    StaticList_t xDummy11[ 2 ];
+    UBaseType_t uxDummy12[ 2 ];
+} StaticMpmcQueue_t;
+
+/*
+ * The StaticRwLock_t structure below is provided so the application writer
+ * can statically allocate the memory required to create a reader-writer lock.
+ * Its size and alignment requirements are guaranteed to match those of the
+ * genuine structure.
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+    StaticList_t xDummy1[ 2 ];
+    void * pvDummy2[ 2 ];
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticRwLock_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
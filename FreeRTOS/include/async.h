@@ -0,0 +1,611 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include async.h"
+#endif
+
+#include "list.h"
+#include "task.h"
+#include "queue.h"
+
+#if ( configUSE_STREAM_BUFFERS == 1 )
+    #include "stream_buffer.h"
+#endif
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+    #include "event_groups.h"
+#endif
+
+/*
+ * Async coroutines.  An async coroutine is a stackless function that can wait
+ * for queues, semaphores, stream buffers, event bits, notifications and
+ * delays without blocking the task that runs it.  Any number of coroutines are
+ * run by an executor, which is hosted by a single task, so thousands of
+ * concurrent flows need only the stack of that one task plus a few tens of
+ * bytes of RAM each.
+ *
+ * Unlike the co-routines in croutine.h, async coroutines wait for the same
+ * kernel objects that tasks use, so a queue can be written by a task or an
+ * interrupt and read by a coroutine, and are scheduled by the executor in
+ * first in first out order rather than by a separate set of priorities.  The
+ * executor runs at the priority of its host task.
+ *
+ * As with croutine.h co-routines, a coroutine returns to the executor each
+ * time it waits, so local variables do not keep their values across a wait.
+ * State that must be kept should be placed in the structure passed as the
+ * coroutine's pvParameters value.  The asyncAWAIT_ macros cannot be used from
+ * within a switch statement, and no two may be used on the same line.
+ */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+struct AsyncCoroutine;
+
+/* The list of coroutines waiting for a kernel object.  Each queue, stream
+ * buffer and event group holds the lists it needs, and each coroutine holds
+ * one for its own notification. */
+typedef struct AsyncCoroutine * AsyncWaitList_t;
+
+/* Defines the prototype to which coroutine functions must conform. */
+typedef void (* AsyncFunction_t)( struct AsyncCoroutine * pxCoroutine,
+                                  void * pvParameters );
+
+/*
+ * The executor that runs a set of coroutines.  The structure is only
+ * included in the header so it can be allocated by the application - its
+ * members must not be accessed directly.
+ */
+typedef struct AsyncExecutor
+{
+    List_t xReadyList;                 /**< Coroutines that are ready to run, in the order in which they became ready. */
+    List_t xDelayedList1;              /**< Coroutines waiting with a timeout. */
+    List_t xDelayedList2;              /**< Coroutines waiting with a timeout that expires after the tick count has overflowed. */
+    List_t * pxDelayedList;            /**< Points to the delayed list currently being used. */
+    List_t * pxOverflowDelayedList;    /**< Points to the delayed list used for timeouts that have overflowed the current tick count. */
+    AsyncWaitList_t xPendingReadyList; /**< Coroutines made ready by tasks or interrupts, which are moved to xReadyList by the executor. */
+    TickType_t xTickCount;             /**< The tick count when the executor last checked for timeouts. */
+    TaskHandle_t xHostTask;            /**< The task running the executor, or NULL if vAsyncExecutorRun() has not been called. */
+} AsyncExecutor_t;
+
+/*
+ * A coroutine.  The structure is only included in the header so it can be
+ * allocated by the application, and because the asyncAWAIT_ macros access
+ * ulResumePoint - its other members must not be accessed directly.
+ */
+typedef struct AsyncCoroutine
+{
+    ListItem_t xStateListItem;                /**< Used to place the coroutine in its executor's ready and delayed lists. */
+    struct AsyncCoroutine * pxNextWaiter;     /**< The next coroutine in the wait list that holds this coroutine. */
+    struct AsyncCoroutine * pxPreviousWaiter; /**< The previous coroutine in the wait list that holds this coroutine. */
+    AsyncWaitList_t * pxWaitList;             /**< The wait list that holds this coroutine, or NULL if the coroutine is not in a wait list. */
+    AsyncExecutor_t * pxExecutor;             /**< The executor that runs this coroutine, or NULL if the coroutine is not running. */
+    AsyncFunction_t pxFunction;               /**< The coroutine function. */
+    void * pvParameters;                      /**< Passed to the coroutine function each time it is called. */
+    AsyncWaitList_t xNotificationWaitList;    /**< Holds this coroutine while it waits for a notification. */
+    uint32_t ulNotifiedValue;                 /**< The notification count. */
+    uint32_t ulResumePoint;                   /**< The line of the asyncAWAIT_ macro from which the coroutine function continues, or 0 to start from the beginning. */
+    uint8_t ucAwaitState;                     /**< Used internally by the await functions. */
+} AsyncCoroutine_t;
+
+/*
+ * These macros are intended for internal use by the coroutine implementation
+ * only.  The macros should not be used directly by application writers.
+ */
+#define asyncAWAIT( pxCoroutine, xOperation )                           \
+    do {                                                                \
+        if( ( xOperation ) == errQUEUE_BLOCKED )                        \
+        {                                                               \
+            ( pxCoroutine )->ulResumePoint = ( uint32_t ) ( __LINE__ ); \
+            return;                                                     \
+            case ( __LINE__ ):                                          \
+                if( ( xOperation ) == errQUEUE_BLOCKED )                \
+                {                                                       \
+                    return;                                             \
+                }                                                       \
+        }                                                               \
+    } while( 0 )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncBEGIN( AsyncCoroutine_t *pxCoroutine );
+ * @endcode
+ *
+ * This macro MUST always be called at the start of a coroutine function.
+ *
+ * Example usage:
+ * @code{c}
+ * // Per flow state, as local variables do not keep their values across a
+ * // wait.
+ * typedef struct
+ * {
+ *     QueueHandle_t xQueue;
+ *     uint32_t ulCount;
+ * } Flow_t;
+ *
+ * void vFlowCoroutine( AsyncCoroutine_t * pxCoroutine, void * pvParameters )
+ * {
+ * Flow_t * pxFlow = ( Flow_t * ) pvParameters;
+ * BaseType_t xResult;
+ * uint32_t ulValue;
+ *
+ *   // Must start every coroutine with a call to asyncBEGIN();
+ *   asyncBEGIN( pxCoroutine );
+ *
+ *   for( ;; )
+ *   {
+ *       // Wait up to 100 ticks for a value to arrive on the flow's queue.
+ *       // The host task continues to run other coroutines in the meantime.
+ *       asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, pxFlow->xQueue, &ulValue, 100, &xResult );
+ *
+ *       if( xResult == pdPASS )
+ *       {
+ *           pxFlow->ulCount += ulValue;
+ *       }
+ *   }
+ *
+ *   // Must end every coroutine with a call to asyncEND();
+ *   asyncEND();
+ * }
+ * @endcode
+ * \defgroup asyncBEGIN asyncBEGIN
+ * \ingroup Async
+ */
+#define asyncBEGIN( pxCoroutine )                  \
+    switch( ( pxCoroutine )->ulResumePoint ) { \
+        case 0U:
+
+/**
+ * async.h
+ * @code{c}
+ * asyncEND();
+ * @endcode
+ *
+ * This macro MUST always be called at the end of a coroutine function.  A
+ * coroutine that returns, or reaches asyncEND(), has finished, and its
+ * AsyncCoroutine_t structure can be passed to vAsyncCoroutineStart() again.
+ * \defgroup asyncEND asyncEND
+ * \ingroup Async
+ */
+/* *INDENT-OFF* */
+#define asyncEND()    }
+/* *INDENT-ON* */
+
+/**
+ * async.h
+ * @code{c}
+ * asyncDELAY( AsyncCoroutine_t *pxCoroutine, TickType_t xTicksToDelay );
+ * @endcode
+ *
+ * Wait for a fixed number of ticks.  A delay of 0 moves the coroutine to the
+ * back of the executor's ready list, allowing other ready coroutines to run.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xTicksToDelay The number of ticks to wait.
+ * \defgroup asyncDELAY asyncDELAY
+ * \ingroup Async
+ */
+#define asyncDELAY( pxCoroutine, xTicksToDelay ) \
+    asyncAWAIT( ( pxCoroutine ), xAsyncDelay( ( pxCoroutine ), ( xTicksToDelay ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_QUEUE_SEND( AsyncCoroutine_t *pxCoroutine,
+ *                        QueueHandle_t xQueue,
+ *                        const void *pvItemToQueue,
+ *                        TickType_t xTicksToWait,
+ *                        BaseType_t *pxResult );
+ * @endcode
+ *
+ * The coroutine equivalent of xQueueSend().  Waits for space on the queue if
+ * it is full, without blocking the task that runs the coroutine.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xQueue The queue to which the item is to be posted.  The queue can
+ * also be written and read by tasks and interrupts.
+ *
+ * @param pvItemToQueue A pointer to the item to be copied to the queue.  The
+ * item must remain valid until the macro completes, so must not be a local
+ * variable.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space, or
+ * portMAX_DELAY to wait without a timeout.
+ *
+ * @param pxResult Set to pdPASS if the item was posted, otherwise
+ * errQUEUE_FULL.
+ * \defgroup asyncAWAIT_QUEUE_SEND asyncAWAIT_QUEUE_SEND
+ * \ingroup Async
+ */
+#define asyncAWAIT_QUEUE_SEND( pxCoroutine, xQueue, pvItemToQueue, xTicksToWait, pxResult ) \
+    asyncAWAIT( ( pxCoroutine ), ( *( pxResult ) = xAsyncQueueSend( ( pxCoroutine ), ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ) ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_QUEUE_RECEIVE( AsyncCoroutine_t *pxCoroutine,
+ *                           QueueHandle_t xQueue,
+ *                           void *pvBuffer,
+ *                           TickType_t xTicksToWait,
+ *                           BaseType_t *pxResult );
+ * @endcode
+ *
+ * The coroutine equivalent of xQueueReceive().  Also takes binary and counting
+ * semaphores when pvBuffer is NULL.  Must not be used with mutexes, as it is
+ * the host task, not the coroutine, that would hold the mutex.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xQueue The queue from which the item is to be received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the received item is
+ * copied.  As the item is copied when the macro completes, the buffer can be a
+ * local variable.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item, or
+ * portMAX_DELAY to wait without a timeout.
+ *
+ * @param pxResult Set to pdPASS if an item was received, otherwise
+ * errQUEUE_EMPTY.
+ * \defgroup asyncAWAIT_QUEUE_RECEIVE asyncAWAIT_QUEUE_RECEIVE
+ * \ingroup Async
+ */
+#define asyncAWAIT_QUEUE_RECEIVE( pxCoroutine, xQueue, pvBuffer, xTicksToWait, pxResult ) \
+    asyncAWAIT( ( pxCoroutine ), ( *( pxResult ) = xAsyncQueueReceive( ( pxCoroutine ), ( xQueue ), ( pvBuffer ), ( xTicksToWait ) ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_STREAM_BUFFER_SEND( AsyncCoroutine_t *pxCoroutine,
+ *                                StreamBufferHandle_t xStreamBuffer,
+ *                                const void *pvTxData,
+ *                                size_t xDataLengthBytes,
+ *                                TickType_t xTicksToWait,
+ *                                size_t *pxBytesSent );
+ * @endcode
+ *
+ * The coroutine equivalent of xStreamBufferSend() and xMessageBufferSend().
+ * Completes as soon as any data can be written, so fewer than
+ * xDataLengthBytes bytes may be written to a stream buffer.  Only available
+ * when configUSE_STREAM_BUFFERS is 1.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xStreamBuffer The stream or message buffer to write to.
+ *
+ * @param pvTxData A pointer to the data to write, which must remain valid
+ * until the macro completes.
+ *
+ * @param xDataLengthBytes The number of bytes to write.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space.
+ *
+ * @param pxBytesSent Set to the number of bytes written, which is 0 if the
+ * wait timed out.
+ * \defgroup asyncAWAIT_STREAM_BUFFER_SEND asyncAWAIT_STREAM_BUFFER_SEND
+ * \ingroup Async
+ */
+#define asyncAWAIT_STREAM_BUFFER_SEND( pxCoroutine, xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait, pxBytesSent ) \
+    asyncAWAIT( ( pxCoroutine ), xAsyncStreamBufferSend( ( pxCoroutine ), ( xStreamBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ), ( pxBytesSent ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_STREAM_BUFFER_RECEIVE( AsyncCoroutine_t *pxCoroutine,
+ *                                   StreamBufferHandle_t xStreamBuffer,
+ *                                   void *pvRxData,
+ *                                   size_t xBufferLengthBytes,
+ *                                   TickType_t xTicksToWait,
+ *                                   size_t *pxReceivedBytes );
+ * @endcode
+ *
+ * The coroutine equivalent of xStreamBufferReceive() and
+ * xMessageBufferReceive().  The coroutine is woken when the number of bytes in
+ * the buffer reaches its trigger level.  Only available when
+ * configUSE_STREAM_BUFFERS is 1.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xStreamBuffer The stream or message buffer to read from.
+ *
+ * @param pvRxData A pointer to the buffer into which the data is copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for data.
+ *
+ * @param pxReceivedBytes Set to the number of bytes read, which is 0 if the
+ * wait timed out.
+ * \defgroup asyncAWAIT_STREAM_BUFFER_RECEIVE asyncAWAIT_STREAM_BUFFER_RECEIVE
+ * \ingroup Async
+ */
+#define asyncAWAIT_STREAM_BUFFER_RECEIVE( pxCoroutine, xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait, pxReceivedBytes ) \
+    asyncAWAIT( ( pxCoroutine ), xAsyncStreamBufferReceive( ( pxCoroutine ), ( xStreamBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ), ( pxReceivedBytes ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_EVENT_BITS( AsyncCoroutine_t *pxCoroutine,
+ *                        EventGroupHandle_t xEventGroup,
+ *                        EventBits_t uxBitsToWaitFor,
+ *                        BaseType_t xClearOnExit,
+ *                        BaseType_t xWaitForAllBits,
+ *                        TickType_t xTicksToWait,
+ *                        EventBits_t *puxBits );
+ * @endcode
+ *
+ * The coroutine equivalent of xEventGroupWaitBits().  Only available when
+ * configUSE_EVENT_GROUPS is 1.
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits,
+ * xTicksToWait As the parameters of xEventGroupWaitBits().
+ *
+ * @param puxBits Set to the value of the event bits when the wait condition
+ * was met or the wait timed out, before any bits were cleared.
+ * \defgroup asyncAWAIT_EVENT_BITS asyncAWAIT_EVENT_BITS
+ * \ingroup Async
+ */
+#define asyncAWAIT_EVENT_BITS( pxCoroutine, xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait, puxBits ) \
+    asyncAWAIT( ( pxCoroutine ), xAsyncEventGroupWaitBits( ( pxCoroutine ), ( xEventGroup ), ( uxBitsToWaitFor ), ( xClearOnExit ), ( xWaitForAllBits ), ( xTicksToWait ), ( puxBits ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * asyncAWAIT_NOTIFY_TAKE( AsyncCoroutine_t *pxCoroutine,
+ *                         BaseType_t xClearCountOnExit,
+ *                         TickType_t xTicksToWait,
+ *                         uint32_t *pulValue );
+ * @endcode
+ *
+ * The coroutine equivalent of ulTaskNotifyTake().  Waits for the coroutine's
+ * notification count to be non-zero, then either clears it or decrements it.
+ * Notifications are sent to a coroutine by calling xAsyncNotifyGive() or
+ * vAsyncNotifyGiveFromISR().
+ *
+ * @param pxCoroutine The coroutine being run.
+ *
+ * @param xClearCountOnExit pdTRUE to clear the count to 0, or pdFALSE to
+ * decrement it.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait.
+ *
+ * @param pulValue Set to the notification count before it was cleared or
+ * decremented, which is 0 if the wait timed out.
+ * \defgroup asyncAWAIT_NOTIFY_TAKE asyncAWAIT_NOTIFY_TAKE
+ * \ingroup Async
+ */
+#define asyncAWAIT_NOTIFY_TAKE( pxCoroutine, xClearCountOnExit, xTicksToWait, pulValue ) \
+    asyncAWAIT( ( pxCoroutine ), xAsyncNotifyTake( ( pxCoroutine ), ( xClearCountOnExit ), ( xTicksToWait ), ( pulValue ) ) )
+
+/**
+ * async.h
+ * @code{c}
+ * void vAsyncExecutorInitialise( AsyncExecutor_t *pxExecutor );
+ * @endcode
+ *
+ * Initialise an executor.  Must be called before the executor is passed to any
+ * other function.
+ *
+ * @param pxExecutor The executor to initialise.
+ * \defgroup vAsyncExecutorInitialise vAsyncExecutorInitialise
+ * \ingroup Async
+ */
+void vAsyncExecutorInitialise( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/**
+ * async.h
+ * @code{c}
+ * void vAsyncExecutorRun( AsyncExecutor_t *pxExecutor );
+ * @endcode
+ *
+ * Run the executor's coroutines.  Called from the task that hosts the
+ * executor, and never returns.  While no coroutine is ready to run the host
+ * task blocks on its task notification, so the host task must not use its
+ * direct to task notification at index tskDEFAULT_INDEX_TO_NOTIFY for any
+ * other purpose.
+ *
+ * Example usage:
+ * @code{c}
+ * static AsyncExecutor_t xExecutor;
+ * static AsyncCoroutine_t xCoroutines[ 1000 ];
+ * static Flow_t xFlows[ 1000 ];
+ *
+ * void vHostTask( void * pvParameters )
+ * {
+ *     vAsyncExecutorRun( &xExecutor );
+ * }
+ *
+ * void vStartFlows( void )
+ * {
+ * size_t x;
+ *
+ *     vAsyncExecutorInitialise( &xExecutor );
+ *
+ *     for( x = 0; x < 1000; x++ )
+ *     {
+ *         xFlows[ x ].xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+ *         vAsyncCoroutineStart( &xExecutor, &( xCoroutines[ x ] ), vFlowCoroutine, &( xFlows[ x ] ) );
+ *     }
+ *
+ *     xTaskCreate( vHostTask, "Flows", configMINIMAL_STACK_SIZE * 2, NULL, 2, NULL );
+ * }
+ * @endcode
+ * \defgroup vAsyncExecutorRun vAsyncExecutorRun
+ * \ingroup Async
+ */
+void vAsyncExecutorRun( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/**
+ * async.h
+ * @code{c}
+ * void vAsyncCoroutineStart( AsyncExecutor_t *pxExecutor,
+ *                            AsyncCoroutine_t *pxCoroutine,
+ *                            AsyncFunction_t pxFunction,
+ *                            void *pvParameters );
+ * @endcode
+ *
+ * Start a coroutine.  The coroutine runs from the start of pxFunction the
+ * next time the executor runs.  Can be called from a task, or from a coroutine,
+ * before or after the executor's host task has started.
+ *
+ * @param pxExecutor The executor that is to run the coroutine.
+ *
+ * @param pxCoroutine The coroutine's structure, which must remain valid until
+ * the coroutine has finished.  Must not be the structure of a coroutine that
+ * has not yet finished.
+ *
+ * @param pxFunction The coroutine function.
+ *
+ * @param pvParameters Passed to the coroutine function each time it is called.
+ * \defgroup vAsyncCoroutineStart vAsyncCoroutineStart
+ * \ingroup Async
+ */
+void vAsyncCoroutineStart( AsyncExecutor_t * pxExecutor,
+                           AsyncCoroutine_t * pxCoroutine,
+                           AsyncFunction_t pxFunction,
+                           void * pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * async.h
+ * @code{c}
+ * BaseType_t xAsyncNotifyGive( AsyncCoroutine_t *pxCoroutine );
+ * void vAsyncNotifyGiveFromISR( AsyncCoroutine_t *pxCoroutine,
+ *                               BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Increment a coroutine's notification count, waking the coroutine if it is
+ * waiting in asyncAWAIT_NOTIFY_TAKE().  xAsyncNotifyGive() can be called from
+ * a task or a coroutine, and vAsyncNotifyGiveFromISR() from an interrupt.
+ *
+ * @param pxCoroutine The coroutine to notify.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if waking the coroutine
+ * unblocked the executor's host task, and the host task has a priority above
+ * that of the interrupted task.
+ *
+ * @return xAsyncNotifyGive() always returns pdPASS.
+ * \defgroup xAsyncNotifyGive xAsyncNotifyGive
+ * \ingroup Async
+ */
+BaseType_t xAsyncNotifyGive( AsyncCoroutine_t * pxCoroutine ) PRIVILEGED_FUNCTION;
+void vAsyncNotifyGiveFromISR( AsyncCoroutine_t * pxCoroutine,
+                              BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FUNCTIONS BELOW MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE
+ * INTERFACES FOR THE EXCLUSIVE USE OF THE ASYNC MACROS AND THE KERNEL.
+ *
+ * The await functions return errQUEUE_BLOCKED when the coroutine must return
+ * to the executor to wait, and are called again when the coroutine resumes.
+ */
+BaseType_t xAsyncDelay( AsyncCoroutine_t * pxCoroutine,
+                        TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncQueueSend( AsyncCoroutine_t * pxCoroutine,
+                            QueueHandle_t xQueue,
+                            const void * pvItemToQueue,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncQueueReceive( AsyncCoroutine_t * pxCoroutine,
+                               QueueHandle_t xQueue,
+                               void * pvBuffer,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncNotifyTake( AsyncCoroutine_t * pxCoroutine,
+                             BaseType_t xClearCountOnExit,
+                             TickType_t xTicksToWait,
+                             uint32_t * pulValue ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_STREAM_BUFFERS == 1 )
+    BaseType_t xAsyncStreamBufferSend( AsyncCoroutine_t * pxCoroutine,
+                                       StreamBufferHandle_t xStreamBuffer,
+                                       const void * pvTxData,
+                                       size_t xDataLengthBytes,
+                                       TickType_t xTicksToWait,
+                                       size_t * pxBytesSent ) PRIVILEGED_FUNCTION;
+    BaseType_t xAsyncStreamBufferReceive( AsyncCoroutine_t * pxCoroutine,
+                                          StreamBufferHandle_t xStreamBuffer,
+                                          void * pvRxData,
+                                          size_t xBufferLengthBytes,
+                                          TickType_t xTicksToWait,
+                                          size_t * pxReceivedBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+    BaseType_t xAsyncEventGroupWaitBits( AsyncCoroutine_t * pxCoroutine,
+                                         EventGroupHandle_t xEventGroup,
+                                         EventBits_t uxBitsToWaitFor,
+                                         BaseType_t xClearOnExit,
+                                         BaseType_t xWaitForAllBits,
+                                         TickType_t xTicksToWait,
+                                         EventBits_t * puxBits ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called by a kernel object after its state has changed, to wake the first
+ * coroutine in pxWaitList, or all of the coroutines if xWakeAll is pdTRUE.
+ * The caller must not be in a critical section.
+ */
+void vAsyncWakeWaiters( AsyncWaitList_t * pxWaitList,
+                        BaseType_t xWakeAll ) PRIVILEGED_FUNCTION;
+void vAsyncWakeWaitersFromISR( AsyncWaitList_t * pxWaitList,
+                               BaseType_t xWakeAll,
+                               BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the wait lists held by kernel objects.  Implemented by queue.c,
+ * stream_buffer.c and event_groups.c respectively.
+ */
+AsyncWaitList_t * pxQueueGetAsyncWaitList( QueueHandle_t xQueue,
+                                           BaseType_t xWaitingToSend ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_STREAM_BUFFERS == 1 )
+    AsyncWaitList_t * pxStreamBufferGetAsyncWaitList( StreamBufferHandle_t xStreamBuffer,
+                                                      BaseType_t xWaitingToSend ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+    AsyncWaitList_t * pxEventGroupGetAsyncWaitList( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* ASYNC_H */
@@ -470,6 +470,10 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * Setting bits in an event group will automatically unblock tasks that are
  * blocked waiting for the bits.
  *
+ * In SMP FreeRTOS xEventGroupSetBits() suspends the scheduler while it searches
+ * the tasks waiting for bits, so it takes the kernel's TASK lock even when
+ * portUSING_GRANULAR_LOCKS is set to 1.
+ *
  * The configUSE_EVENT_GROUPS configuration constant must be set to 1 for xEventGroupSetBits()
  * to be available.
  *
@@ -384,6 +384,43 @@ typedef struct xLIST
         ( ( pxList )->uxNumberOfItems ) = ( UBaseType_t ) ( ( ( pxList )->uxNumberOfItems ) + 1U ); \
     } while( 0 )
 
+/*
+ * Insert a list item into a list immediately after an item that is already in
+ * the list, without regard to the item values.  Passing the list's end marker
+ * as pxPosition inserts the item at the head of the list.  Used by the kernel
+ * to keep a list sorted when it already knows where the new item belongs.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxPosition The item after which the new item is inserted.
+ *
+ * @param pxNewListItem The list item to be inserted into the list.
+ *
+ * \page listINSERT_AFTER listINSERT_AFTER
+ * \ingroup LinkedList
+ */
+#define listINSERT_AFTER( pxList, pxPosition, pxNewListItem )                                       \
+    do {                                                                                            \
+        ListItem_t * const pxAfter = ( pxPosition );                                                \
+                                                                                                    \
+        /* Only effective when configASSERT() is also defined, these tests may catch                \
+         * the list data structures being overwritten in memory.  They will not catch               \
+         * data errors caused by incorrect configuration or use of FreeRTOS. */                     \
+        listTEST_LIST_INTEGRITY( ( pxList ) );                                                      \
+        listTEST_LIST_ITEM_INTEGRITY( ( pxNewListItem ) );                                          \
+                                                                                                    \
+        ( pxNewListItem )->pxNext = pxAfter->pxNext;                                                \
+        ( pxNewListItem )->pxPrevious = pxAfter;                                                    \
+                                                                                                    \
+        pxAfter->pxNext->pxPrevious = ( pxNewListItem );                                            \
+        pxAfter->pxNext = ( pxNewListItem );                                                        \
+                                                                                                    \
+        /* Remember which list the item is in. */                                                   \
+        ( pxNewListItem )->pxContainer = ( pxList );                                                \
+                                                                                                    \
+        ( ( pxList )->uxNumberOfItems ) = ( UBaseType_t ) ( ( ( pxList )->uxNumberOfItems ) + 1U ); \
+    } while( 0 )
+
 /*
  * Access function to obtain the owner of the first entry in a list.  Lists
  * are normally sorted in ascending item value order.
@@ -0,0 +1,289 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Multiple producer, multiple consumer queues.  An MPMC queue holds a fixed
+ * number of fixed size items, like a queue created by xQueueCreate(), but an
+ * item is written or read without entering the kernel critical section.  Each
+ * slot holds a sequence number that tells writers and readers whether the slot
+ * is free or holds an item, and writers and readers claim slots with a compare
+ * and swap on the queue's write and read positions.  The kernel critical
+ * section is only entered when a task has to block, or when a task is blocked
+ * waiting for the item that was written or the space that was freed.
+ *
+ * On multicore builds this lets tasks on different cores send to and receive
+ * from the same queue at the same time.  On single core builds the compare and
+ * swap masks interrupts for a few instructions, as the functions in atomic.h
+ * do.
+ *
+ * Unlike a queue created by xQueueCreate(), an MPMC queue cannot be used as a
+ * semaphore or mutex, added to a queue set, or written to the front, and the
+ * order in which blocked tasks receive items is only best effort.
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h and mpmc_queue.c
+ * must be included in the build for the functions in this file to be
+ * available.
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mpmc_queue.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which MPMC queues are referenced.  For example, a call to
+ * xMpmcQueueCreate() returns an MpmcQueueHandle_t variable that can then be
+ * used as a parameter to xMpmcQueueSend(), xMpmcQueueReceive(), etc.
+ */
+struct MpmcQueueDef_t;
+typedef struct MpmcQueueDef_t * MpmcQueueHandle_t;
+
+/**
+ * The number of 32-bit words of storage needed by an MPMC queue that holds
+ * uxQueueLength items of uxItemSize bytes.  Each item is stored with a 32-bit
+ * sequence number and padded to a multiple of 4 bytes.  Use to declare the
+ * storage area passed to xMpmcQueueCreateStatic().
+ */
+#define mpmcQUEUE_STORAGE_WORDS( uxQueueLength, uxItemSize ) \
+    ( ( size_t ) ( uxQueueLength ) * ( ( size_t ) 1U + ( ( ( size_t ) ( uxItemSize ) + ( size_t ) 3U ) / ( size_t ) 4U ) ) )
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * MpmcQueueHandle_t xMpmcQueueCreate( UBaseType_t uxQueueLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new MPMC queue and returns a handle by which it can be referenced.
+ * The structure and the storage area are allocated with a single call to
+ * pvPortMalloc().
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.  Must be
+ * a power of 2, and no more than 2^30.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the created queue, or NULL if there was insufficient
+ * heap memory available.
+ * \defgroup xMpmcQueueCreate xMpmcQueueCreate
+ * \ingroup MpmcQueue
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MpmcQueueHandle_t xMpmcQueueCreate( UBaseType_t uxQueueLength,
+                                        UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * MpmcQueueHandle_t xMpmcQueueCreateStatic( UBaseType_t uxQueueLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           uint32_t *pulQueueStorage,
+ *                                           StaticMpmcQueue_t *pxStaticQueue );
+ * @endcode
+ *
+ * Creates a new MPMC queue using memory provided by the application.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.  Must be
+ * a power of 2, and no more than 2^30.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pulQueueStorage Must point to an array of at least
+ * mpmcQUEUE_STORAGE_WORDS( uxQueueLength, uxItemSize ) 32-bit words.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticMpmcQueue_t,
+ * which is used to hold the queue's data structure.
+ *
+ * @return The handle of the created queue, or NULL if either pointer was NULL.
+ * \defgroup xMpmcQueueCreateStatic xMpmcQueueCreateStatic
+ * \ingroup MpmcQueue
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MpmcQueueHandle_t xMpmcQueueCreateStatic( UBaseType_t uxQueueLength,
+                                              UBaseType_t uxItemSize,
+                                              uint32_t * pulQueueStorage,
+                                              StaticMpmcQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * void vMpmcQueueDelete( MpmcQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes an MPMC queue.  The queue must not be deleted while tasks are
+ * blocked on it or might still use it.
+ *
+ * @param xQueue The handle of the queue to delete.
+ * \defgroup vMpmcQueueDelete vMpmcQueueDelete
+ * \ingroup MpmcQueue
+ */
+void vMpmcQueueDelete( MpmcQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * BaseType_t xMpmcQueueSend( MpmcQueueHandle_t xQueue,
+ *                            const void *pvItemToQueue,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item to the back of an MPMC queue.  The equivalent of
+ * xQueueSend().
+ *
+ * @param xQueue The handle of the queue to post the item to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space if the
+ * queue is full, or portMAX_DELAY to wait without a timeout.
+ *
+ * @return pdPASS if the item was posted, otherwise errQUEUE_FULL.
+ * \defgroup xMpmcQueueSend xMpmcQueueSend
+ * \ingroup MpmcQueue
+ */
+BaseType_t xMpmcQueueSend( MpmcQueueHandle_t xQueue,
+                           const void * const pvItemToQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * BaseType_t xMpmcQueueSendFromISR( MpmcQueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xMpmcQueueSend() that can be called from an interrupt service
+ * routine.  The equivalent of xQueueSendFromISR().
+ *
+ * @param xQueue The handle of the queue to post the item to.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the item unblocked
+ * a task that has a priority above the currently running task.  If it is set
+ * to pdTRUE then a context switch should be requested before the interrupt is
+ * exited.  Can be NULL.
+ *
+ * @return pdPASS if the item was posted, otherwise errQUEUE_FULL.
+ * \defgroup xMpmcQueueSendFromISR xMpmcQueueSendFromISR
+ * \ingroup MpmcQueue
+ */
+BaseType_t xMpmcQueueSendFromISR( MpmcQueueHandle_t xQueue,
+                                  const void * const pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * BaseType_t xMpmcQueueReceive( MpmcQueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item out of an MPMC queue and removes it.  The equivalent
+ * of xQueueReceive().
+ *
+ * @param xQueue The handle of the queue to receive from.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item if the
+ * queue is empty, or portMAX_DELAY to wait without a timeout.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ * \defgroup xMpmcQueueReceive xMpmcQueueReceive
+ * \ingroup MpmcQueue
+ */
+BaseType_t xMpmcQueueReceive( MpmcQueueHandle_t xQueue,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * BaseType_t xMpmcQueueReceiveFromISR( MpmcQueueHandle_t xQueue,
+ *                                      void *pvBuffer,
+ *                                      BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xMpmcQueueReceive() that can be called from an interrupt
+ * service routine.  The equivalent of xQueueReceiveFromISR().
+ *
+ * @param xQueue The handle of the queue to receive from.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if removing the item
+ * unblocked a task that has a priority above the currently running task.  If
+ * it is set to pdTRUE then a context switch should be requested before the
+ * interrupt is exited.  Can be NULL.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ * \defgroup xMpmcQueueReceiveFromISR xMpmcQueueReceiveFromISR
+ * \ingroup MpmcQueue
+ */
+BaseType_t xMpmcQueueReceiveFromISR( MpmcQueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mpmc_queue.h
+ * @code{c}
+ * UBaseType_t uxMpmcQueueMessagesWaiting( MpmcQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of items in an MPMC queue.  Items that are being written
+ * or read at the time of the call may or may not be counted.
+ *
+ * @param xQueue The handle of the queue being queried.
+ *
+ * @return The number of items in the queue.
+ * \defgroup uxMpmcQueueMessagesWaiting uxMpmcQueueMessagesWaiting
+ * \ingroup MpmcQueue
+ */
+UBaseType_t uxMpmcQueueMessagesWaiting( MpmcQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( MPMC_QUEUE_H ) */
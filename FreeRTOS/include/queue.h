@@ -64,10 +64,41 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/* Used with the vQueueGetStats() function to return the usage statistics kept
+ * for a queue when configUSE_QUEUE_STATS is 1.  Semaphores and mutexes record
+ * gives as sends and takes as receives. */
+typedef struct xQUEUE_STATS
+{
+    UBaseType_t uxMessagesWaitingHighWaterMark; /* The most items the queue has held at once. */
+    uint32_t ulSendsBlocked;                    /* The number of sends that had to wait for space because the queue was full. */
+    uint32_t ulReceivesBlocked;                 /* The number of receives and peeks that had to wait for data because the queue was empty. */
+    uint32_t ulTicksBlockedSending;             /* The total number of ticks tasks have spent waiting to send. */
+    uint32_t ulTicksBlockedReceiving;           /* The total number of ticks tasks have spent waiting to receive or peek. */
+    uint32_t ulSendsFailedFull;                 /* The number of sends that failed, without or after waiting, because the queue was full. */
+    uint32_t ulTxLockEvents;                    /* The number of sends that found the queue locked, so had their unblocking of a waiting task deferred until the queue was unlocked. */
+    uint32_t ulRxLockEvents;                    /* The number of receives that found the queue locked, so had their unblocking of a waiting task deferred until the queue was unlocked. */
+} QueueStats_t;
+
+/* Used with the uxQueueGetRegistryStats() function to return the statistics
+ * of each queue in the queue registry. */
+typedef struct xQUEUE_REGISTRY_STATUS
+{
+    QueueHandle_t xHandle;         /* The handle of the queue to which the rest of the information in the structure relates. */
+    const char * pcQueueName;      /* The name the queue was registered with. */
+    UBaseType_t uxMessagesWaiting; /* The number of items in the queue when the structure was populated. */
+    UBaseType_t uxLength;          /* The maximum number of items the queue can hold. */
+    QueueStats_t xStats;           /* The statistics of the queue when the structure was populated. */
+} QueueRegistryStatus_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
+#define queueSEND_WITH_PRIORITY( uxPriority )    ( ( BaseType_t ) ( ( UBaseType_t ) 3U + ( uxPriority ) ) )
+
+/* The highest priority that can be given to a message sent to a priority
+ * queue. */
+#define queueMAX_MESSAGE_PRIORITY    ( ( UBaseType_t ) 31U )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
@@ -76,6 +107,8 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
 #define queueQUEUE_TYPE_SET                   ( ( uint8_t ) 5U )
+#define queueQUEUE_TYPE_PRIORITY              ( ( uint8_t ) 6U )
+#define queueQUEUE_TYPE_CEILING_MUTEX         ( ( uint8_t ) 7U )
 
 /**
  * queue. h
@@ -264,6 +297,194 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueGetStaticBuffers( xQueue, ppucQueueStorage, ppxStaticQueue )    xQueueGenericGetStaticBuffers( ( xQueue ), ( ppucQueueStorage ), ( ppxStaticQueue ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityQueue(
+ *                                        UBaseType_t uxQueueLength,
+ *                                        UBaseType_t uxItemSize
+ *                                        );
+ * @endcode
+ *
+ * Creates a priority queue, and returns a handle by which the new queue can be
+ * referenced.  Each message posted to a priority queue carries a priority
+ * between 0 and queueMAX_MESSAGE_PRIORITY.  Receiving from the queue returns
+ * the message with the highest priority, and messages that have the same
+ * priority are received in the order in which they were sent.  Messages are
+ * kept in a binary heap, so sending and receiving take a time proportional to
+ * the logarithm of the number of messages in the queue.
+ *
+ * A priority queue is used with the same functions as any other queue, and can
+ * be added to a queue set.  Messages are sent with xQueueSendWithPriority() or
+ * xQueueSendWithPriorityFromISR().  xQueueSend() and xQueueSendToBack() send
+ * with priority 0.  xQueueSendToFront(), xQueueOverwrite(), the multiple item
+ * functions and queue loans cannot be used with a priority queue.
+ *
+ * configUSE_PRIORITY_QUEUES must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  The queue requires an extra
+ * sizeof( StaticPriorityQueueNode_t ) bytes of RAM for each space in the queue.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * void vATask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue;
+ * uint32_t ulEvent;
+ *
+ *  // Create a priority queue capable of containing 10 uint32_t values.
+ *  xQueue = xQueueCreatePriorityQueue( 10, sizeof( uint32_t ) );
+ *
+ *  if( xQueue != NULL )
+ *  {
+ *      ulEvent = 0x55;
+ *      xQueueSendWithPriority( xQueue, &ulEvent, 2, 0 );
+ *
+ *      ulEvent = 0xAA;
+ *      xQueueSendWithPriority( xQueue, &ulEvent, 7, 0 );
+ *
+ *      // ulEvent is set to 0xAA, as it was sent with the higher priority.
+ *      xQueueReceive( xQueue, &ulEvent, 0 );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueCreatePriorityQueue xQueueCreatePriorityQueue
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreatePriorityQueue( const UBaseType_t uxQueueLength,
+                                             const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityQueueStatic(
+ *                                              UBaseType_t uxQueueLength,
+ *                                              UBaseType_t uxItemSize,
+ *                                              uint8_t *pucQueueStorage,
+ *                                              StaticPriorityQueueNode_t *pxNodeStorage,
+ *                                              StaticQueue_t *pxQueueBuffer
+ *                                              );
+ * @endcode
+ *
+ * Creates a priority queue using memory provided by the application writer.
+ * See xQueueCreatePriorityQueue() for a description of priority queues.
+ *
+ * configUSE_PRIORITY_QUEUES must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * ( uxQueueLength * uxItemSize ) bytes long.
+ *
+ * @param pxNodeStorage Must point to an array of uxQueueLength variables of
+ * type StaticPriorityQueueNode_t, which will be used to order the messages.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pxQueueBuffer is NULL then NULL is returned.
+ *
+ * \defgroup xQueueCreatePriorityQueueStatic xQueueCreatePriorityQueueStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreatePriorityQueueStatic( const UBaseType_t uxQueueLength,
+                                                   const UBaseType_t uxItemSize,
+                                                   uint8_t * pucQueueStorage,
+                                                   StaticPriorityQueueNode_t * pxNodeStorage,
+                                                   StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriority(
+ *                                   QueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   UBaseType_t uxPriority,
+ *                                   TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Post an item to a queue created by xQueueCreatePriorityQueue() or
+ * xQueueCreatePriorityQueueStatic().  The item is received before every item
+ * in the queue that has a lower priority, and after every item in the queue
+ * that has the same or a higher priority.  It is implemented as a macro that
+ * calls xQueueGenericSend().
+ *
+ * @param xQueue The handle to the priority queue on which the item is to be
+ * posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The priority of the item, from 0 (the lowest) to
+ * queueMAX_MESSAGE_PRIORITY (the highest).
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriority( xQueue, pvItemToQueue, uxPriority, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_WITH_PRIORITY( uxPriority ) )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriorityFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          const void *pvItemToQueue,
+ *                                          UBaseType_t uxPriority,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken
+ *                                        );
+ * @endcode
+ *
+ * A version of xQueueSendWithPriority() that can be called from an interrupt
+ * service routine.  It is implemented as a macro that calls
+ * xQueueGenericSendFromISR().
+ *
+ * @param xQueue The handle to the priority queue on which the item is to be
+ * posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The priority of the item, from 0 (the lowest) to
+ * queueMAX_MESSAGE_PRIORITY (the highest).
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendWithPriorityFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xQueueSendWithPriorityFromISR xQueueSendWithPriorityFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, uxPriority, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_WITH_PRIORITY( uxPriority ) )
+
 /**
  * queue. h
  * @code{c}
@@ -914,6 +1135,266 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void * const pvItemsToQueue,
+ *                                  const UBaseType_t uxItemCount,
+ *                                  TickType_t xTicksToWait
+ *                                );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in a single operation.
+ * The items are copied in using one critical section, the tasks waiting for
+ * data are unblocked together, and the calling task yields at most once, so
+ * the cost per item is lower than calling xQueueSend() for each item.
+ *
+ * As many items as there is space for are posted.  The call only blocks,
+ * for up to xTicksToWait, if the queue is full, and returns as soon as at
+ * least one item has been posted.  Must not be used on semaphores or mutexes,
+ * or called from an interrupt service routine.  See
+ * uxQueueSendMultipleFromISR() for an alternative which may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size the queue was created to hold.
+ *
+ * @param uxItemCount The number of items in the array.  Must be at least 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return The number of items posted, which is 0 if the queue remained full
+ * for xTicksToWait ticks.  The items from that position on were not posted.
+ *
+ * Example usage:
+ * @code{c}
+ * uint32_t ulSamples[ 32 ];
+ * UBaseType_t uxSent = 0;
+ *
+ *  while( uxSent < 32 )
+ *  {
+ *      uxSent += uxQueueSendMultiple( xQueue, &( ulSamples[ uxSent ] ), 32 - uxSent, portMAX_DELAY );
+ *  }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void * const pvBuffer,
+ *                                     const UBaseType_t uxMaxItems,
+ *                                     TickType_t xTicksToWait
+ *                                   );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from the front of a queue in a single
+ * operation.  The items are copied out using one critical section, the tasks
+ * waiting for space are unblocked together, and the calling task yields at
+ * most once.
+ *
+ * As many items as are available are received.  The call only blocks, for up
+ * to xTicksToWait, if the queue is empty, and returns as soon as at least one
+ * item has been received.  Must not be used on semaphores or mutexes, or
+ * called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to an array of at least uxMaxItems items into which
+ * the received items will be copied, oldest first.
+ *
+ * @param uxMaxItems The maximum number of items to receive.  Must be at least
+ * 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return The number of items received, which is 0 if the queue remained
+ * empty for xTicksToWait ticks.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquireSendSlot(
+ *                                   QueueHandle_t xQueue,
+ *                                   void **ppvSlot,
+ *                                   TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Lend the caller the next free slot in the queue's own storage so an item
+ * can be built in place, rather than built in a local buffer and then copied
+ * into the queue by xQueueSend().  The item is posted to the back of the queue
+ * by xQueueCommitSendSlot(), or the slot returned unused by
+ * vQueueCancelSendSlot().
+ *
+ * Only one send slot can be on loan at a time.  While it is on loan the queue
+ * appears full to every other writer, so the loan should be short.
+ *
+ * configUSE_QUEUE_LOANS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  Loans cannot be used on semaphores or mutexes, or on a
+ * queue that is also written with xQueueSendToFront() or xQueueOverwrite().  A
+ * queue must not be reset or deleted while any loan is outstanding.  Must not
+ * be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param ppvSlot Set to the address of the slot, which is uxItemSize bytes
+ * long, if the call passes.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot, should the queue be full or its slot already on loan.
+ *
+ * @return pdTRUE if a slot was lent, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage *pxMessage;
+ *
+ *  if( xQueueAcquireSendSlot( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdTRUE )
+ *  {
+ *      pxMessage->ucMessageID = 0x12;
+ *      vFillPayload( pxMessage->ucData );
+ *      xQueueCommitSendSlot( xQueue );
+ *  }
+ * @endcode
+ * \defgroup xQueueAcquireSendSlot xQueueAcquireSendSlot
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    BaseType_t xQueueAcquireSendSlot( QueueHandle_t xQueue,
+                                      void ** ppvSlot,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitSendSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Post the item built in the slot lent by xQueueAcquireSendSlot() to the back
+ * of the queue.  Tasks and queue sets waiting for data are notified as if the
+ * item had been sent with xQueueSend().  The slot must not be accessed after
+ * it has been committed.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @return pdPASS if the item was posted, or pdFAIL if no send slot was on loan.
+ *
+ * \defgroup xQueueCommitSendSlot xQueueCommitSendSlot
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    BaseType_t xQueueCommitSendSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueCancelSendSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Return the slot lent by xQueueAcquireSendSlot() without posting an item.
+ *
+ * @param xQueue The handle to the queue the slot was lent from.
+ *
+ * \defgroup vQueueCancelSendSlot vQueueCancelSendSlot
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    void vQueueCancelSendSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueBorrowItem(
+ *                              QueueHandle_t xQueue,
+ *                              void **ppvItem,
+ *                              TickType_t xTicksToWait
+ *                            );
+ * @endcode
+ *
+ * Lend the caller the item at the front of the queue so it can be processed
+ * where it is stored, rather than copied out by xQueueReceive().  The item is
+ * removed from the queue by vQueueReleaseItem().
+ *
+ * Only one item can be on loan at a time.  While it is on loan the queue
+ * appears empty to every other reader, so the loan should be short.  The
+ * restrictions listed for xQueueAcquireSendSlot() also apply.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * borrowed.
+ *
+ * @param ppvItem Set to the address of the item, which is uxItemSize bytes
+ * long, if the call passes.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, should the queue be empty or its front item already on
+ * loan.
+ *
+ * @return pdTRUE if an item was lent, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage *pxMessage;
+ *
+ *  if( xQueueBorrowItem( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdTRUE )
+ *  {
+ *      vProcessMessage( pxMessage );
+ *      vQueueReleaseItem( xQueue );
+ *  }
+ * @endcode
+ * \defgroup xQueueBorrowItem xQueueBorrowItem
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    BaseType_t xQueueBorrowItem( QueueHandle_t xQueue,
+                                 void ** ppvItem,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueReleaseItem( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Remove the item lent by xQueueBorrowItem() from the queue, freeing its slot
+ * for senders.  The item must not be accessed after it has been released.
+ *
+ * @param xQueue The handle to the queue the item was borrowed from.
+ *
+ * \defgroup vQueueReleaseItem vQueueReleaseItem
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    void vQueueReleaseItem( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1456,6 +1937,82 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                         QueueHandle_t xQueue,
+ *                                         const void * const pvItemsToQueue,
+ *                                         const UBaseType_t uxItemCount,
+ *                                         BaseType_t * const pxHigherPriorityTaskWoken
+ *                                       );
+ * @endcode
+ *
+ * A version of uxQueueSendMultiple() that can be called from an interrupt
+ * service routine.  As many of the items as there is space for are posted,
+ * and the call never blocks.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.
+ *
+ * @param uxItemCount The number of items in the array.  Must be at least 1.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If uxQueueSendMultipleFromISR() sets this value to pdTRUE then
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                            QueueHandle_t xQueue,
+ *                                            void * const pvBuffer,
+ *                                            const UBaseType_t uxMaxItems,
+ *                                            BaseType_t * const pxHigherPriorityTaskWoken
+ *                                          );
+ * @endcode
+ *
+ * A version of uxQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.  As many items as are available, up to uxMaxItems, are
+ * received, and the call never blocks.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to an array of at least uxMaxItems items into which
+ * the received items will be copied, oldest first.
+ *
+ * @param uxMaxItems The maximum number of items to receive.  Must be at least
+ * 1.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if receiving the items caused a task
+ * waiting for space to unblock, and the unblocked task has a priority higher
+ * than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxMaxItems,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1502,6 +2059,20 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                            StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Use xSemaphoreCreateCeilingMutex() or
+ * xSemaphoreCreateCeilingMutexStatic() instead of calling these functions
+ * directly.
+ */
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_COUNTING_SEMAPHORES == 1 )
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
@@ -1595,6 +2166,82 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Copy the usage statistics of a queue, semaphore or mutex into *pxStats.
+ * The statistics are recorded from when the queue is created, or from the
+ * last call to vQueueResetStats().  Resetting the queue with xQueueReset()
+ * does not clear them.
+ *
+ * configUSE_QUEUE_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle of the queue the statistics of which are returned.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Clear the usage statistics of a queue, semaphore or mutex.  The high water
+ * mark is set to the number of items the queue holds now.
+ *
+ * configUSE_QUEUE_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle of the queue the statistics of which are cleared.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueResetStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Populate a QueueRegistryStatus_t structure for each queue, semaphore and
+ * mutex in the queue registry, so a monitoring task can report the usage of
+ * every registered queue with one call.  The scheduler is suspended while the
+ * registry is read, and each queue's statistics are copied within that queue's
+ * critical section.
+ *
+ * configUSE_QUEUE_STATS must be set to 1, and configQUEUE_REGISTRY_SIZE must
+ * be greater than 0, in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param pxQueueStatusArray An array of QueueRegistryStatus_t structures.
+ *
+ * @param uxArraySize The number of structures in pxQueueStatusArray.  Entries
+ * beyond this number are not returned, so configQUEUE_REGISTRY_SIZE entries
+ * guarantees every registered queue is returned.
+ *
+ * @return The number of QueueRegistryStatus_t structures that were populated.
+ *
+ * Example usage:
+ * @code{c}
+ * void vDumpQueueStats( void )
+ * {
+ * static QueueRegistryStatus_t xStatus[ configQUEUE_REGISTRY_SIZE ];
+ * UBaseType_t ux, uxCount;
+ *
+ *  uxCount = uxQueueGetRegistryStats( xStatus, configQUEUE_REGISTRY_SIZE );
+ *
+ *  for( ux = 0; ux < uxCount; ux++ )
+ *  {
+ *      printf( "%s %u/%u peak %u blocked %lu full %lu\r\n",
+ *              xStatus[ ux ].pcQueueName,
+ *              ( unsigned ) xStatus[ ux ].uxMessagesWaiting,
+ *              ( unsigned ) xStatus[ ux ].uxLength,
+ *              ( unsigned ) xStatus[ ux ].xStats.uxMessagesWaitingHighWaterMark,
+ *              ( unsigned long ) xStatus[ ux ].xStats.ulSendsBlocked,
+ *              ( unsigned long ) xStatus[ ux ].xStats.ulSendsFailedFull );
+ *  }
+ * }
+ * @endcode
+ */
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStatus_t * const pxQueueStatusArray,
+                                         const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1676,6 +2323,9 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *    5, and a counting semaphore that has a maximum count of 3, then
  *    uxEventQueueLength should be set to (5 + 3), or 8.
  *
+ * When configUSE_QUEUE_SET_READY_LISTS is 1 the queue set does not store
+ * events, so uxEventQueueLength is not used.
+ *
  * @return If the queue set is created successfully then a handle to the created
  * queue set is returned.  Otherwise NULL is returned.
  */
@@ -1728,8 +2378,12 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *    5, and a counting semaphore that has a maximum count of 3, then
  *    uxEventQueueLength should be set to (5 + 3), or 8.
  *
+ * When configUSE_QUEUE_SET_READY_LISTS is 1 the queue set does not store
+ * events, so uxEventQueueLength is not used.
+ *
  * @param pucQueueStorage pucQueueStorage must point to a uint8_t array that is
- * at least large enough to hold uxEventQueueLength events.
+ * at least large enough to hold uxEventQueueLength events.  Not used, and can
+ * be NULL, when configUSE_QUEUE_SET_READY_LISTS is 1.
  *
  * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
  * will be used to hold the queue's data structure.
@@ -1813,6 +2467,12 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * semaphore) operation must not be performed on a member of a queue set unless
  * a call to xQueueSelectFromSet() has first returned a handle to that set member.
  *
+ * Note 4:  When configUSE_QUEUE_SET_READY_LISTS is 1 a member is returned by
+ * every call while it holds data, in turn with the other members that hold
+ * data, rather than once per item posted to it.  If more than one task selects
+ * from the same set, a member returned to one task may be emptied by another
+ * before it is read.
+ *
  * @param xQueueSet The queue set on which the task will (potentially) block.
  *
  * @param xTicksToWait The maximum time, in ticks, that the calling task will
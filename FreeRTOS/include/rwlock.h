@@ -0,0 +1,263 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Reader-writer locks.  Any number of tasks can hold a reader-writer lock for
+ * reading at the same time, or one task can hold it for writing.  Tasks that
+ * cannot take the lock block on priority ordered event lists in the same way
+ * as tasks that cannot take a mutex.
+ *
+ * Writers are preferred.  Once a writer is waiting for the lock, tasks that
+ * want to read block until every waiting writer has had the lock, so a steady
+ * stream of readers cannot starve a writer.  When the lock is released by a
+ * writer, or by the last reader, the highest priority waiting writer is given
+ * the next turn.  If no writer is waiting, all the waiting readers are
+ * unblocked together.
+ *
+ * A writer that is given the next turn keeps it until it runs again and takes
+ * the lock, and no other task can take the lock in the meantime.  If that
+ * writer is suspended before it runs, the lock stays unavailable until it is
+ * resumed.  If it is deleted before it runs, the lock is never available
+ * again, in the same way that a mutex is never available again if its holder
+ * is deleted, so a task must not be deleted while it is waiting to take a
+ * reader-writer lock for writing.
+ *
+ * The task holding the lock for writing inherits the priority of any higher
+ * priority task that blocks waiting for the lock, in the same way as the
+ * holder of a mutex.  Tasks holding the lock for reading are not tracked
+ * individually, so do not inherit priorities.
+ *
+ * The lock is not recursive.  A task that already holds the lock must not try
+ * to take it again, for either reading or writing, and a task holding the lock
+ * for reading cannot upgrade to writing.  Reader-writer locks cannot be used
+ * from interrupts.
+ *
+ * configUSE_RW_LOCKS must be set to 1 in FreeRTOSConfig.h and rwlock.c must be
+ * included in the build for the functions in this file to be available.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include rwlock.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRwLockCreate() returns an RwLockHandle_t variable that can then be used as
+ * a parameter to xRwLockTakeRead(), xRwLockTakeWrite(), etc.
+ */
+struct RwLockDef_t;
+typedef struct RwLockDef_t * RwLockHandle_t;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RwLockHandle_t xRwLockCreate( void );
+ * @endcode
+ *
+ * Creates a new reader-writer lock and returns a handle by which it can be
+ * referenced.  The lock is created free.
+ *
+ * @return The handle of the created lock, or NULL if there was insufficient
+ * heap memory available.
+ * \defgroup xRwLockCreate xRwLockCreate
+ * \ingroup RwLock
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RwLockHandle_t xRwLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RwLockHandle_t xRwLockCreateStatic( StaticRwLock_t *pxStaticLock );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using memory provided by the application.
+ *
+ * @param pxStaticLock Must point to a variable of type StaticRwLock_t, which
+ * is used to hold the lock's data structure.
+ *
+ * @return The handle of the created lock, or NULL if pxStaticLock was NULL.
+ * \defgroup xRwLockCreateStatic xRwLockCreateStatic
+ * \ingroup RwLock
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RwLockHandle_t xRwLockCreateStatic( StaticRwLock_t * pxStaticLock ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * void vRwLockDelete( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Deletes a reader-writer lock.  The lock must not be held, and no tasks may
+ * be blocked on it.
+ *
+ * @param xLock The handle of the lock to delete.
+ * \defgroup vRwLockDelete vRwLockDelete
+ * \ingroup RwLock
+ */
+void vRwLockDelete( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRwLockTakeRead( RwLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for reading.  The lock is available for reading
+ * if no task holds it for writing and no writer is waiting for it.
+ *
+ * @param xLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for the lock to
+ * become available, or portMAX_DELAY to wait without a timeout.
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ * \defgroup xRwLockTakeRead xRwLockTakeRead
+ * \ingroup RwLock
+ */
+BaseType_t xRwLockTakeRead( RwLockHandle_t xLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRwLockGiveRead( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Releases a reader-writer lock that was taken for reading by
+ * xRwLockTakeRead().  If the calling task was the last reader, the highest
+ * priority task waiting to write is unblocked.
+ *
+ * @param xLock The handle of the lock to release.
+ *
+ * @return pdPASS if the lock was released, or pdFAIL if the lock was not held
+ * for reading.
+ * \defgroup xRwLockGiveRead xRwLockGiveRead
+ * \ingroup RwLock
+ */
+BaseType_t xRwLockGiveRead( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for writing.  The lock is available for writing
+ * if no task holds it for either reading or writing.  While the calling task
+ * is waiting, tasks that try to take the lock for reading block.
+ *
+ * If the lock is held for writing by a task with a lower priority than the
+ * calling task, that task inherits the calling task's priority while the
+ * calling task waits.
+ *
+ * The calling task must not be deleted while it is waiting for the lock.  See
+ * the description at the top of this file.
+ *
+ * @param xLock The handle of the lock to take.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for the lock to
+ * become available, or portMAX_DELAY to wait without a timeout.
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ * \defgroup xRwLockTakeWrite xRwLockTakeWrite
+ * \ingroup RwLock
+ */
+BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * Releases a reader-writer lock that was taken for writing by
+ * xRwLockTakeWrite().  Must be called by the task that took the lock.  Any
+ * priority the task inherited while holding the lock is disinherited, as
+ * when a mutex is given.
+ *
+ * @param xLock The handle of the lock to release.
+ *
+ * @return pdPASS if the lock was released, or pdFAIL if the calling task did
+ * not hold the lock for writing.
+ * \defgroup xRwLockGiveWrite xRwLockGiveWrite
+ * \ingroup RwLock
+ */
+BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * @param xLock The handle of the lock being queried.
+ *
+ * @return The number of tasks holding the lock for reading.
+ * \defgroup uxRwLockGetReaderCount uxRwLockGetReaderCount
+ * \ingroup RwLock
+ */
+UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock );
+ * @endcode
+ *
+ * @param xLock The handle of the lock being queried.
+ *
+ * @return The handle of the task holding the lock for writing, or NULL if the
+ * lock is not held for writing.
+ * \defgroup xRwLockGetWriter xRwLockGetWriter
+ * \ingroup RwLock
+ */
+TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( RWLOCK_H ) */
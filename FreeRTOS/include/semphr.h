@@ -798,6 +798,112 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutex( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a new mutex type semaphore that uses the immediate priority ceiling
+ * protocol instead of priority inheritance, and returns a handle by which the
+ * new mutex can be referenced.
+ *
+ * A task that takes the mutex has its priority raised to uxCeilingPriority
+ * straight away.  As with priority inheritance mutexes, the raised priority is
+ * kept until the task has given back every mutex it holds, whatever order the
+ * mutexes are given in, and then returns to the task's base priority.  A task
+ * that holds several mutexes therefore runs at the highest priority that any of
+ * them raised it to until it gives the last of them.  uxCeilingPriority
+ * must be at least the priority of every task that uses the mutex, so no task
+ * that wants the mutex can preempt the task holding it, and there is no
+ * priority inheritance to do or undo.  Tasks whose priority equals the ceiling
+ * can still share the processor with the holder when configUSE_TIME_SLICING is
+ * 1, and then block on the mutex, so setting the ceiling one above the highest
+ * priority task that uses the mutex means that, on a single core, a task never
+ * finds the mutex held unless the holder blocked while holding it.  The cost is
+ * that the holder also delays unrelated tasks with priorities up to the
+ * ceiling while it holds the mutex, even if no other task wants the mutex.
+ *
+ * Tasks that do block on the mutex do not raise the priority of the holder.
+ * Taking the mutex from a task whose priority is above the ceiling will
+ * trigger configASSERT().
+ *
+ * Mutexes created using this function can be accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros.  Mutex type semaphores cannot be used from
+ * within interrupt service routines.
+ *
+ * configUSE_PRIORITY_CEILING_MUTEXES must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * @param uxCeilingPriority The priority a task runs at while it holds the mutex.
+ * Must be less than configMAX_PRIORITIES.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * semaphore is returned.  If there was not enough heap to allocate the mutex
+ * data structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // The mutex is used by tasks of priority 3 and below.
+ *  xSemaphore = xSemaphoreCreateCeilingMutex( 3 );
+ *
+ *  if( xSemaphore != NULL )
+ *  {
+ *      // The semaphore was created successfully.
+ *      // The semaphore can now be used.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateCeilingMutex xSemaphoreCreateCeilingMutex
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutex( uxCeilingPriority )    xQueueCreateCeilingMutex( ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutexStatic( UBaseType_t uxCeilingPriority,
+ *                                                       StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a new priority ceiling mutex, as xSemaphoreCreateCeilingMutex(), but
+ * using memory provided by the application writer instead of dynamically
+ * allocated memory.
+ *
+ * @param uxCeilingPriority The priority a task runs at while it holds the mutex.
+ * Must be less than configMAX_PRIORITIES.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ * StaticSemaphore_t xMutexBuffer;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // The mutex is used by tasks of priority 3 and below.
+ *  xSemaphore = xSemaphoreCreateCeilingMutexStatic( 3, &xMutexBuffer );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateCeilingMutexStatic xSemaphoreCreateCeilingMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutexStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateCeilingMutexStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
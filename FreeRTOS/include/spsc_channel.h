@@ -0,0 +1,251 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Single producer, single consumer channels.  A channel passes fixed size
+ * items from exactly one writer, which can be a task or an interrupt, to
+ * exactly one reader task.  Neither side enters a critical section: the writer
+ * only ever updates the head index and the reader only ever updates the tail
+ * index, so a send or receive costs an item copy and a few memory accesses.
+ * The two indices are kept on separate cache lines so the writer and the
+ * reader do not contend for the same line when running on different cores.
+ *
+ * The reader blocks, using a direct to task notification, only when the
+ * channel is empty.  The writer never blocks - it returns errQUEUE_FULL if
+ * there is no space.
+ *
+ * ***NOTE***:  As with stream buffers, it is not safe to have more than one
+ * writer or more than one reader.  If there are to be multiple writers or
+ * readers then use a queue instead.  A task blocked on a channel waits on the
+ * task notification index set by configSPSC_CHANNEL_NOTIFICATION_INDEX, so the
+ * reader task must not use that index for anything else.
+ *
+ * configUSE_SPSC_CHANNELS must be set to 1 in FreeRTOSConfig.h and
+ * spsc_channel.c must be included in the build for the functions in this file
+ * to be available.
+ */
+
+#ifndef SPSC_CHANNEL_H
+#define SPSC_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_channel.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which channels are referenced.  For example, a call to
+ * xSpscChannelCreate() returns an SpscChannelHandle_t variable that can then be
+ * used as a parameter to xSpscChannelSend(), xSpscChannelReceive(), etc.
+ */
+struct SpscChannelDef_t;
+typedef struct SpscChannelDef_t * SpscChannelHandle_t;
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxLength, size_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new channel and returns a handle by which it can be referenced.
+ * The structure and the storage area are allocated with a single call to
+ * pvPortMalloc().
+ *
+ * @param uxLength The maximum number of items the channel can hold.  Must be a
+ * power of 2, and no larger than half the range of a UBaseType_t plus one.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Must not be 0.
+ *
+ * @return The handle of the created channel, or NULL if there was
+ * insufficient heap memory available.
+ * \defgroup xSpscChannelCreate xSpscChannelCreate
+ * \ingroup SpscChannel
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxLength,
+                                            size_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxLength,
+ *                                               size_t uxItemSize,
+ *                                               uint8_t *pucChannelStorage,
+ *                                               StaticSpscChannel_t *pxStaticChannel );
+ * @endcode
+ *
+ * Creates a new channel using memory provided by the application.
+ *
+ * @param uxLength The maximum number of items the channel can hold.  Must be a
+ * power of 2, and no larger than half the range of a UBaseType_t plus one.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Must not be 0.
+ *
+ * @param pucChannelStorage Must point to an array of at least
+ * ( uxLength * uxItemSize ) bytes, into which items are copied.
+ *
+ * @param pxStaticChannel Must point to a variable of type StaticSpscChannel_t,
+ * which is used to hold the channel's data structure.
+ *
+ * @return The handle of the created channel, or NULL if either pointer was
+ * NULL.
+ * \defgroup xSpscChannelCreateStatic xSpscChannelCreateStatic
+ * \ingroup SpscChannel
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxLength,
+                                                  size_t uxItemSize,
+                                                  uint8_t * pucChannelStorage,
+                                                  StaticSpscChannel_t * pxStaticChannel ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * void vSpscChannelDelete( SpscChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Deletes a channel.  The channel must not be deleted while the reader task is
+ * blocked on it or while the writer might still use it.
+ *
+ * @param xChannel The handle of the channel to delete.
+ * \defgroup vSpscChannelDelete vSpscChannelDelete
+ * \ingroup SpscChannel
+ */
+void vSpscChannelDelete( SpscChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel, const void *pvItemToSend );
+ * @endcode
+ *
+ * Copies an item into the channel from a task.  Never blocks.  If the reader
+ * task is waiting for an item it is sent a notification, which can cause a
+ * context switch.
+ *
+ * @param xChannel The handle of the channel to write to.
+ *
+ * @param pvItemToSend A pointer to the item to copy into the channel.
+ *
+ * @return pdPASS if the item was written, or errQUEUE_FULL if the channel was
+ * full.
+ * \defgroup xSpscChannelSend xSpscChannelSend
+ * \ingroup SpscChannel
+ */
+BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel,
+                             const void * pvItemToSend ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+ *                                     const void *pvItemToSend,
+ *                                     BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSpscChannelSend() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xChannel The handle of the channel to write to.
+ *
+ * @param pvItemToSend A pointer to the item to copy into the channel.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the item unblocked
+ * a reader task that has a priority above the currently running task.  If it
+ * is set to pdTRUE then a context switch should be requested before the
+ * interrupt is exited.  Can be NULL.
+ *
+ * @return pdPASS if the item was written, or errQUEUE_FULL if the channel was
+ * full.
+ * \defgroup xSpscChannelSendFromISR xSpscChannelSendFromISR
+ * \ingroup SpscChannel
+ */
+BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+                                    const void * pvItemToSend,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+ *                                 void *pvBuffer,
+ *                                 TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item out of the channel.  Must only be called from the one
+ * reader task.
+ *
+ * @param xChannel The handle of the channel to read from.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item if the
+ * channel is empty, or portMAX_DELAY to wait without a timeout.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ * \defgroup xSpscChannelReceive xSpscChannelReceive
+ * \ingroup SpscChannel
+ */
+BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_channel.h
+ * @code{c}
+ * UBaseType_t uxSpscChannelItemsWaiting( SpscChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Returns the number of items in the channel.  Can be called from the writer,
+ * the reader or an interrupt, but the value may be out of date by the time it
+ * is used if the other side is active.
+ *
+ * @param xChannel The handle of the channel being queried.
+ *
+ * @return The number of items in the channel.
+ * \defgroup uxSpscChannelItemsWaiting uxSpscChannelItemsWaiting
+ * \ingroup SpscChannel
+ */
+UBaseType_t uxSpscChannelItemsWaiting( SpscChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_CHANNEL_H ) */
@@ -95,6 +95,13 @@ struct tskTaskControlBlock; /* The old naming convention is used to prevent brea
 typedef struct tskTaskControlBlock         * TaskHandle_t;
 typedef const struct tskTaskControlBlock   * ConstTaskHandle_t;
 
+/*
+ * Type by which task pools are referenced.  xTaskPoolCreateStatic() returns a
+ * TaskPoolHandle_t that can then be passed to xTaskCreateFromPool().
+ */
+struct tskTaskPool;
+typedef struct tskTaskPool * TaskPoolHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -131,6 +138,24 @@ typedef struct xTIME_OUT
     TickType_t xTimeOnEntering;
 } TimeOut_t;
 
+/*
+ * Used internally only.  Records the last item of each priority in an event
+ * list that is kept in priority order, so an item can be inserted without
+ * searching the list.  Bit ( n % 32 ) of ulOccupied[ n / 32 ] is set while
+ * pxLastItem[ n ] is valid, and bit m of ulOccupiedGroups is set while
+ * ulOccupied[ m ] is not zero.  Entry n relates to priority
+ * ( configMAX_PRIORITIES - 1 - n ), so lower entries are nearer the head of
+ * the list.
+ */
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    typedef struct xEVENT_LIST_BUCKETS
+    {
+        ListItem_t * pxLastItem[ configMAX_PRIORITIES ];
+        uint32_t ulOccupied[ ( configMAX_PRIORITIES + 31U ) / 32U ];
+        uint32_t ulOccupiedGroups;
+    } EventListBuckets_t;
+#endif
+
 /*
  * Defines the memory ranges allocated to the task when an MPU is used.
  */
@@ -178,8 +203,52 @@ typedef struct xTASK_STATUS
     #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
         UBaseType_t uxCoreAffinityMask;           /* The core affinity mask for the task */
     #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDeadline;                     /* The absolute deadline of the task's current job.  Only valid if xRelativeDeadline is not 0. */
+        TickType_t xRelativeDeadline;             /* The deadline of each of the task's jobs relative to the job's release time, or 0 if the task does not have a deadline. */
+        UBaseType_t uxDeadlineMisses;             /* The number of the task's jobs that missed their deadline. */
+    #endif
 } TaskStatus_t;
 
+/* Used with the uxTaskGetAllStackHighWaterMarks() function. */
+typedef struct xTASK_STACK_HIGH_WATER_MARK
+{
+    TaskHandle_t xHandle;                        /* The handle of the task to which the rest of the information in the structure relates. */
+    configSTACK_DEPTH_TYPE uxStackHighWaterMark; /* The minimum amount of stack space, in words, that has remained for the task since the task was created. */
+} TaskStackHighWaterMark_t;
+
+/* Used with the vTaskSnapshotBegin() and uxTaskSnapshotNext() functions to
+ * hold the position reached in a snapshot between calls.  Used internally
+ * only. */
+typedef struct xTASK_SNAPSHOT
+{
+    void * pvLastItem;
+    UBaseType_t uxLastTaskNumber;
+    UBaseType_t uxGeneration;
+} TaskSnapshot_t;
+
+/* The number of bytes xTaskSnapshotEncode() writes for each task.  Each record
+ * holds, in order and with multi-byte values stored little endian:
+ * - the task number (4 bytes).
+ * - the run time counter (8 bytes).
+ * - the stack high water mark, in words (4 bytes).
+ * - the current priority (2 bytes).
+ * - the base priority (2 bytes).
+ * - the state, as an eTaskState value (1 byte).
+ * - the task name, padded with zeros to configMAX_TASK_NAME_LEN bytes. */
+#define tskSNAPSHOT_RECORD_LENGTH    ( ( size_t ) 21U + ( size_t ) configMAX_TASK_NAME_LEN )
+
+/* Used with the vTaskPoolGetStats() function to return the usage of a task
+ * pool. */
+typedef struct xTASK_POOL_STATS
+{
+    UBaseType_t uxSlots;                /* The number of TCB and stack slots in the pool. */
+    UBaseType_t uxFreeSlots;            /* The number of slots not in use when vTaskPoolGetStats() was called. */
+    UBaseType_t uxMinimumEverFreeSlots; /* The lowest number of slots there have been free since the pool was created. */
+    uint32_t ulAllocations;             /* The number of tasks created in the pool. */
+    uint32_t ulFailedAllocations;       /* The number of calls to xTaskCreateFromPool() that failed because every slot was in use. */
+} TaskPoolStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -253,6 +322,27 @@ typedef enum
     #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
 #endif
 
+/*
+ * Macros to enter and exit a critical section that protects a single kernel
+ * object (a data group) with its own spinlock rather than with the kernel
+ * locks.  Only available when portUSING_GRANULAR_LOCKS is set to 1.  Kernel
+ * functions that access task lists must only be called from within a data
+ * group critical section after calling taskDATA_GROUP_LOCK_KERNEL().  Data
+ * group critical sections only cover operations that do not block.  A task
+ * blocking on any queue, semaphore, stream buffer or event group, and
+ * xEventGroupSetBits(), still suspend the scheduler and so take the TASK lock,
+ * and adding or removing a task from the kernel lists takes the ISR lock.  For
+ * internal use only.
+ */
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+    #define taskDATA_GROUP_ENTER_CRITICAL( pxSpinlock )               vTaskDataGroupEnterCritical( pxSpinlock )
+    #define taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( pxSpinlock )      uxTaskDataGroupEnterCriticalFromISR( pxSpinlock )
+    #define taskDATA_GROUP_EXIT_CRITICAL( pxSpinlock )                vTaskDataGroupExitCritical( pxSpinlock )
+    #define taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( x, pxSpinlock )    vTaskDataGroupExitCriticalFromISR( ( x ), ( pxSpinlock ) )
+    #define taskDATA_GROUP_LOCK_KERNEL()                              vTaskDataGroupLockKernel()
+    #define taskDATA_GROUP_UNLOCK_KERNEL()                            vTaskDataGroupUnlockKernel()
+#endif
+
 /**
  * task. h
  *
@@ -400,6 +490,68 @@ typedef enum
                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                 void * const pvParameters,
+ *                                 TickType_t xRelativeDeadline,
+ *                                 TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Create a new task that is scheduled earliest deadline first, and add it to
+ * the list of tasks that are ready to run.  The parameters are the same as
+ * for xTaskCreate(), except the task is always created at
+ * configEDF_TASK_PRIORITY and is given a relative deadline in place of a
+ * priority.
+ *
+ * Ready state tasks at configEDF_TASK_PRIORITY run in order of their absolute
+ * deadline rather than in turn, and a task whose deadline is earlier than
+ * that of the running task preempts it.  Tasks at configEDF_TASK_PRIORITY that
+ * do not have a deadline only run when no task with a deadline is ready.
+ * Tasks at higher priorities preempt all deadline scheduled tasks, and tasks at
+ * lower priorities only run when no deadline scheduled task is ready.
+ *
+ * A task at configEDF_TASK_PRIORITY that holds a mutex, or a reader-writer lock
+ * for writing, that a task with an earlier deadline blocks on inherits that
+ * deadline, as a lower priority holder inherits the blocked task's priority.
+ * This includes holders that have no deadline of their own.  The holder keeps
+ * the inherited deadline until it holds no mutexes, even if the blocked task
+ * times out first.  Deadlines are not passed along chains of mutexes when
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1.
+ *
+ * The first job of the task is released when the task is created, so its
+ * deadline is xRelativeDeadline ticks after that.  A periodic task ends each
+ * job by calling xTaskDelayUntil(), which releases the next job at the wake
+ * time with a deadline xRelativeDeadline ticks after it, and counts the job as
+ * a deadline miss if it completed after its deadline.  A job is also counted as
+ * a deadline miss if the task blocks in any other way, or is given a new job by
+ * vTaskSetDeadline(), after the job's deadline.  Each job is counted at most
+ * once.
+ *
+ * @param xRelativeDeadline The number of ticks after the release of each job
+ * by which the job must complete.  Must not be 0.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file projdefs.h
+ *
+ * \defgroup xTaskCreateDeadline xTaskCreateDeadline
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xRelativeDeadline,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -529,6 +681,139 @@ typedef enum
                                                UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * TaskPoolHandle_t xTaskPoolCreateStatic( UBaseType_t uxSlots,
+ *                                         configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                         StackType_t *puxStackBuffers,
+ *                                         StaticTask_t *pxTaskBuffers,
+ *                                         StaticTaskPool_t *pxTaskPoolBuffer );
+ * @endcode
+ *
+ * Only available when configUSE_TASK_POOLS is set to 1.
+ *
+ * Creates a pool of uxSlots task slots, each of which is made up of a TCB and
+ * a stack of uxStackDepth words.  Tasks created in the pool with
+ * xTaskCreateFromPool() take a free slot, and the slot is returned to the pool
+ * when the task is deleted, so creating and deleting short lived tasks neither
+ * calls pvPortMalloc() nor fragments the heap.  The memory of every slot stays
+ * reserved for the pool while the slot is free, so the pool should be sized
+ * for the number of such tasks expected to exist at once, not more.
+ *
+ * @param uxSlots The number of slots in the pool.
+ *
+ * @param uxStackDepth The size of the stack of each slot, specified as the
+ * number of words the stack can hold, not the number of bytes.
+ *
+ * @param puxStackBuffers Must point to an array of at least
+ * ( uxSlots * uxStackDepth ) StackType_t variables, which holds the stacks of
+ * the slots.
+ *
+ * @param pxTaskBuffers Must point to an array of at least uxSlots
+ * StaticTask_t variables, which holds the TCBs of the slots.
+ *
+ * @param pxTaskPoolBuffer Must point to a StaticTaskPool_t variable, which is
+ * then used to hold the pool's data structures.
+ *
+ * @return The handle of the pool, or NULL if any of the buffers are NULL.
+ *
+ * Example usage:
+ * @code{c}
+ *
+ *  #define WORKER_SLOTS        8
+ *  #define WORKER_STACK_SIZE   200
+ *
+ *  StackType_t xWorkerStacks[ WORKER_SLOTS * WORKER_STACK_SIZE ];
+ *  StaticTask_t xWorkerTCBs[ WORKER_SLOTS ];
+ *  StaticTaskPool_t xWorkerPoolBuffer;
+ *  TaskPoolHandle_t xWorkerPool;
+ *
+ *  void vWorker( void * pvParameters )
+ *  {
+ *      vProcessRequest( pvParameters );
+ *
+ *      // The task's slot is returned to the pool.
+ *      vTaskDelete( NULL );
+ *  }
+ *
+ *  void vDispatcher( void * pvParameters )
+ *  {
+ *      xWorkerPool = xTaskPoolCreateStatic( WORKER_SLOTS, WORKER_STACK_SIZE, xWorkerStacks, xWorkerTCBs, &xWorkerPoolBuffer );
+ *
+ *      for( ;; )
+ *      {
+ *          xTaskCreateFromPool( xWorkerPool, vWorker, "Worker", pvGetNextRequest(), tskIDLE_PRIORITY + 1 );
+ *      }
+ *  }
+ * @endcode
+ * \defgroup xTaskPoolCreateStatic xTaskPoolCreateStatic
+ * \ingroup Tasks
+ */
+#if ( configUSE_TASK_POOLS == 1 )
+    TaskPoolHandle_t xTaskPoolCreateStatic( UBaseType_t uxSlots,
+                                            configSTACK_DEPTH_TYPE uxStackDepth,
+                                            StackType_t * const puxStackBuffers,
+                                            StaticTask_t * const pxTaskBuffers,
+                                            StaticTaskPool_t * const pxTaskPoolBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+ *                                   TaskFunction_t pxTaskCode,
+ *                                   const char * const pcName,
+ *                                   void *pvParameters,
+ *                                   UBaseType_t uxPriority );
+ * @endcode
+ *
+ * Only available when configUSE_TASK_POOLS is set to 1.
+ *
+ * Create a new task in a free slot of a task pool and add it to the list of
+ * tasks that are ready to run.  The parameters are as for xTaskCreateStatic(),
+ * except the stack depth and buffers come from the pool.
+ *
+ * A task that deletes itself cannot return its slot until it is no longer
+ * running, which is normally done by the idle task.  If the pool has no free
+ * slot, any such tasks are cleaned up by xTaskCreateFromPool() itself before
+ * it gives up, so the slot can be reused without waiting for the idle task to
+ * run.
+ *
+ * @return The handle of the created task, or NULL if every slot of the pool
+ * is in use.
+ *
+ * \defgroup xTaskCreateFromPool xTaskCreateFromPool
+ * \ingroup Tasks
+ */
+#if ( configUSE_TASK_POOLS == 1 )
+    TaskHandle_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+                                      TaskFunction_t pxTaskCode,
+                                      const char * const pcName,
+                                      void * const pvParameters,
+                                      UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskPoolGetStats( TaskPoolHandle_t xTaskPool, TaskPoolStats_t *pxTaskPoolStats );
+ * @endcode
+ *
+ * Only available when configUSE_TASK_POOLS is set to 1.
+ *
+ * Populates *pxTaskPoolStats with the current and lowest ever number of free
+ * slots in the pool, and with the number of successful and failed attempts to
+ * create a task in the pool.  See the definition of TaskPoolStats_t.
+ *
+ * \defgroup vTaskPoolGetStats vTaskPoolGetStats
+ * \ingroup Tasks
+ */
+#if ( configUSE_TASK_POOLS == 1 )
+    void vTaskPoolGetStats( TaskPoolHandle_t xTaskPool,
+                            TaskPoolStats_t * pxTaskPoolStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1190,6 +1475,38 @@ UBaseType_t uxTaskBasePriorityGetFromISR( const TaskHandle_t xTask ) PRIVILEGED_
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Set the relative deadline of a task and release a new job of the task now,
+ * so the task's absolute deadline becomes xRelativeDeadline ticks from now.
+ * The deadline is only used to schedule the task while it is running at
+ * configEDF_TASK_PRIORITY - see xTaskCreateDeadline().  Aperiodic tasks can
+ * call this function each time they start a new job.
+ *
+ * A context switch will occur before the function returns if the change means
+ * another task now has the earliest deadline.
+ *
+ * @param xTask Handle to the task for which the deadline is being set.
+ * Passing a NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xRelativeDeadline The number of ticks after the release of each job
+ * by which the job must complete.  Passing 0 removes the task's deadline.
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1863,6 +2180,46 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task.h
+ * @code{c}
+ * UBaseType_t uxTaskGetAllStackHighWaterMarks( TaskStackHighWaterMark_t * const pxHighWaterMarkArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * INCLUDE_uxTaskGetAllStackHighWaterMarks must be set to 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * Populates a TaskStackHighWaterMark_t structure with the handle and stack
+ * high water mark of each task in the system, in a single pass with the
+ * scheduler suspended.  This is much cheaper than calling
+ * uxTaskGetStackHighWaterMark2() for each task, or calling
+ * uxTaskGetSystemState() when only the stack high water marks are needed.
+ *
+ * NOTE: This function is intended for debugging and health monitoring use
+ * only, as its use results in the scheduler remaining suspended for an
+ * extended period.
+ *
+ * @param pxHighWaterMarkArray A pointer to an array of TaskStackHighWaterMark_t
+ * structures.  The array must contain at least one structure for each task
+ * that is under the control of the RTOS.  The number of tasks under the
+ * control of the RTOS can be determined using the uxTaskGetNumberOfTasks() API
+ * function.
+ *
+ * @param uxArraySize The size of the array pointed to by the
+ * pxHighWaterMarkArray parameter.  The size is specified as the number of
+ * indexes in the array, or the number of TaskStackHighWaterMark_t structures
+ * contained in the array, not by the number of bytes in the array.
+ *
+ * @return The number of TaskStackHighWaterMark_t structures that were
+ * populated by uxTaskGetAllStackHighWaterMarks().  This should equal the
+ * number returned by the uxTaskGetNumberOfTasks() API function, but will be
+ * zero if the value passed in the uxArraySize parameter was too small.
+ */
+#if ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 )
+    UBaseType_t uxTaskGetAllStackHighWaterMarks( TaskStackHighWaterMark_t * const pxHighWaterMarkArray,
+                                                 const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
  * so the following two prototypes will cause a compilation error.  This can be
@@ -2183,6 +2540,108 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot );
+ * UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot, TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, const BaseType_t xGetFreeStackSpace );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * An alternative to uxTaskGetSystemState() that collects the TaskStatus_t
+ * structures in chunks.  The scheduler is only suspended while each chunk is
+ * collected, so the time for which the scheduler is suspended is bounded by
+ * the chunk size rather than by the number of tasks in the system.
+ *
+ * vTaskSnapshotBegin() starts a snapshot.  Each call to uxTaskSnapshotNext()
+ * then populates up to uxArraySize TaskStatus_t structures, continuing from
+ * the task after the last one returned by the previous call.  Tasks are
+ * returned in the order in which they were created.  A task that is created
+ * during a snapshot is included in it, and a task that is deleted during a
+ * snapshot is not returned after it has been deleted.  As the scheduler runs
+ * between chunks, different chunks may reflect the system at different times.
+ *
+ * The snapshot resumes where it left off in constant time, unless a task was
+ * deleted since the previous call, in which case the position is found again
+ * by searching for the task number following the last one returned.
+ *
+ * @param pxSnapshot The snapshot being taken.  The structure must not be
+ * modified by the application.
+ *
+ * @param pxTaskStatusArray A pointer to an array of TaskStatus_t structures.
+ *
+ * @param uxArraySize The number of TaskStatus_t structures in the array
+ * pointed to by pxTaskStatusArray, and therefore the maximum number of tasks
+ * returned by the call.
+ *
+ * @param xGetFreeStackSpace Set to pdFALSE to skip the time consuming stack
+ * high water mark calculation, in which case usStackHighWaterMark is set to 0.
+ *
+ * @return The number of TaskStatus_t structures populated.  0 is returned
+ * once every task has been returned.
+ *
+ * Example usage:
+ * @code{c}
+ *  void vReportTasks( void )
+ *  {
+ *  TaskSnapshot_t xSnapshot;
+ *  TaskStatus_t xStatus[ 8 ];
+ *  uint8_t ucRecords[ 8 * tskSNAPSHOT_RECORD_LENGTH ];
+ *  UBaseType_t uxCount;
+ *  size_t xLength;
+ *
+ *      vTaskSnapshotBegin( &xSnapshot );
+ *
+ *      while( ( uxCount = uxTaskSnapshotNext( &xSnapshot, xStatus, 8, pdTRUE ) ) > 0 )
+ *      {
+ *          xLength = xTaskSnapshotEncode( xStatus, uxCount, ucRecords, sizeof( ucRecords ) );
+ *          vSendToHost( ucRecords, xLength );
+ *      }
+ *  }
+ * @endcode
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot,
+                                    TaskStatus_t * const pxTaskStatusArray,
+                                    const UBaseType_t uxArraySize,
+                                    const BaseType_t xGetFreeStackSpace ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * size_t xTaskSnapshotEncode( const TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint8_t * const pucBuffer, const size_t xBufferLength );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Encodes TaskStatus_t structures, as populated by uxTaskSnapshotNext() or
+ * uxTaskGetSystemState(), into fixed length binary records that are smaller
+ * and faster to produce than the tables written by vTaskListTasks().  The
+ * layout of each record is described with tskSNAPSHOT_RECORD_LENGTH.
+ *
+ * @param pxTaskStatusArray The TaskStatus_t structures to encode.
+ *
+ * @param uxArraySize The number of structures in pxTaskStatusArray.
+ *
+ * @param pucBuffer The buffer into which the records are written.
+ *
+ * @param xBufferLength The length of pucBuffer in bytes.  Only as many whole
+ * records as fit in the buffer are written.
+ *
+ * @return The number of bytes written to pucBuffer.
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    size_t xTaskSnapshotEncode( const TaskStatus_t * const pxTaskStatusArray,
+                                const UBaseType_t uxArraySize,
+                                uint8_t * const pucBuffer,
+                                const size_t xBufferLength ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2514,6 +2973,72 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskGetLatencyHistogram( TaskHandle_t xTask, uint32_t * pulHistogram, UBaseType_t uxHistogramLength );
+ * BaseType_t xTaskGetGlobalLatencyHistogram( uint32_t * pulHistogram, UBaseType_t uxHistogramLength );
+ * @endcode
+ *
+ * configUSE_LATENCY_HISTOGRAMS must be defined as 1 for these functions to be
+ * available.  Latencies are measured in the units of the port's
+ * portGET_LATENCY_TIMESTAMP() macro if it is defined, otherwise in the units of
+ * the run time counter, in which case configGENERATE_RUN_TIME_STATS must also
+ * be 1.
+ *
+ * The scheduling latency of a task is the time from the task entering the
+ * Ready state to the task next entering the Running state.  Each latency is
+ * counted in the histogram bucket given by its base 2 logarithm, so bucket 0
+ * counts latencies of 0 or 1, bucket 1 counts latencies of 2 to 3, bucket 2
+ * latencies of 4 to 7, and so on.  The last bucket also counts all longer
+ * latencies.  There are configLATENCY_HISTOGRAM_BUCKETS buckets.
+ *
+ * xTaskGetLatencyHistogram() obtains the histogram of a single task, and
+ * xTaskGetGlobalLatencyHistogram() the histogram of all the tasks together.
+ *
+ * @param xTask The handle of the task whose histogram is obtained.  Passing
+ * NULL obtains the histogram of the calling task.
+ *
+ * @param pulHistogram The array into which the histogram is written.
+ *
+ * @param uxHistogramLength The number of entries in the pulHistogram array.
+ * Must be at least configLATENCY_HISTOGRAM_BUCKETS.
+ *
+ * @return pdPASS if the histogram was written to pulHistogram, or pdFAIL if
+ * uxHistogramLength is too small.
+ *
+ * \defgroup xTaskGetLatencyHistogram xTaskGetLatencyHistogram
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    BaseType_t xTaskGetLatencyHistogram( TaskHandle_t xTask,
+                                         uint32_t * pulHistogram,
+                                         UBaseType_t uxHistogramLength ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskGetGlobalLatencyHistogram( uint32_t * pulHistogram,
+                                               UBaseType_t uxHistogramLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskResetLatencyHistograms( void );
+ * @endcode
+ *
+ * configUSE_LATENCY_HISTOGRAMS must be defined as 1 for this function to be
+ * available.
+ *
+ * Requests that the scheduling latency histograms of all the tasks, and the
+ * global histogram, are cleared.  The histograms are cleared the next time the
+ * idle task runs, so the reset never adds to the execution time of other
+ * tasks.  Can be called from an interrupt.
+ *
+ * \defgroup vTaskResetLatencyHistograms vTaskResetLatencyHistograms
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    void vTaskResetLatencyHistograms( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3537,6 +4062,24 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
                                      const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * Performs the same function as vTaskPlaceOnEventList(), but uses pxBuckets
+ * to find the calling task's position in the priority ordered event list in
+ * constant time rather than by searching the list.  pxBuckets must be
+ * initialised to all zeros when pxEventList is initialised, and must only be
+ * used with pxEventList.
+ */
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    void vTaskPlaceOnBucketedEventList( List_t * const pxEventList,
+                                        EventListBuckets_t * const pxBuckets,
+                                        const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3645,6 +4188,49 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Records that the calling task is about to block on
+ * the mutex whose holder is stored in the variable pointed to by pxMutexHolder,
+ * so xTaskPriorityInherit() and vTaskPriorityDisinheritAfterTimeout() can pass
+ * priority changes on to that holder.  Must be called with NULL once the
+ * calling task stops waiting for the mutex.
+ */
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+    void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Raises the priority of the calling task to
+ * uxCeilingPriority when it takes a priority ceiling mutex, unless its priority
+ * is already at least that high.
+ */
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Called when the holder of a priority ceiling mutex
+ * gives the mutex.  As with xTaskPriorityDisinherit(), the holder's priority is
+ * only returned to its base priority once it holds no other mutexes, as any
+ * mutex still held may have a ceiling, or an inherited priority, at least as
+ * high as the holder's current priority.  Returns pdTRUE if the priority was
+ * lowered, in which case a context switch may be required.
+ */
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+    BaseType_t xTaskPriorityRestoreAfterCeiling( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Returns pdTRUE if xTask is running on a core other
+ * than the calling core, otherwise pdFALSE.  Used by adaptive mutexes to decide
+ * whether to spin while the mutex holder runs.  Must be called from a kernel
+ * critical section, so that the TASK and ISR locks stop xTask switching in or
+ * out, or being deleted, while its state is read.
+ */
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+    BaseType_t xTaskIsRunningOnOtherCore( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3755,6 +4341,34 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNC
     void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
 #endif
 
+/*
+ * For internal use only.  Enter and exit a data group critical section.  The
+ * interrupts are masked and the data group's spinlock is held, but the kernel
+ * locks are not taken, so a data group critical section on one core does not
+ * block kernel critical sections or other data groups on the other cores.
+ * Data group critical sections must not be entered from within a kernel
+ * critical section.
+ */
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+    void vTaskDataGroupEnterCritical( portSPINLOCK_TYPE * pxSpinlock );
+    UBaseType_t uxTaskDataGroupEnterCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock );
+    void vTaskDataGroupExitCritical( portSPINLOCK_TYPE * pxSpinlock );
+    void vTaskDataGroupExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus,
+                                            portSPINLOCK_TYPE * pxSpinlock );
+#endif
+
+/*
+ * For internal use only.  Take and release the kernel ISR lock from within a
+ * data group critical section so the caller can add tasks to, and remove
+ * tasks from, the ready, delayed and event lists.  The task lock is never
+ * taken while a data group spinlock is held, so the lock order is always the
+ * task lock, then data group spinlocks, then the ISR lock.
+ */
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+    void vTaskDataGroupLockKernel( void );
+    void vTaskDataGroupUnlockKernel( void );
+#endif
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 /*
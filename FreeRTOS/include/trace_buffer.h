@@ -0,0 +1,216 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include trace_buffer.h"
+#endif
+
+/*
+ * The built in trace buffer.  When configUSE_TRACE_BUFFER is set to 1 in
+ * FreeRTOSConfig.h this header is included by FreeRTOS.h, and defines the
+ * trace macros listed below so each traced kernel event writes a fixed size
+ * TraceBufferRecord_t into a ring buffer belonging to the core on which the
+ * event occurred.  Writing a record never blocks and never takes a lock -
+ * interrupts are masked on the writing core only for the few instructions
+ * needed to claim a slot and fill it in.  If the rings are not drained
+ * quickly enough the oldest records are overwritten.
+ *
+ * A task calls xTraceBufferDrain() to move the records into a stream buffer,
+ * from where they can be sent to a host using any transport.  The
+ * trace_buffer_to_json.py script in the examples/trace_buffer directory
+ * converts the records into the Chrome trace event JSON format, which can be
+ * viewed in the Perfetto UI or in chrome://tracing.
+ *
+ * Any of the trace macros can still be defined in FreeRTOSConfig.h, in which
+ * case that definition is used in place of the one below.
+ */
+
+/* The values that can be held in the ucEvent member of TraceBufferRecord_t. */
+#define tbEVENT_TASK_SWITCHED_IN            ( ( uint8_t ) 1U )  /* usObject is the task number of the task that was selected to run. */
+#define tbEVENT_TASK_READY                  ( ( uint8_t ) 2U )  /* usObject is the task number of the task that entered the Ready state. */
+#define tbEVENT_TASK_CREATE                 ( ( uint8_t ) 3U )  /* usObject is the task number of the new task. */
+#define tbEVENT_TASK_NAME                   ( ( uint8_t ) 4U )  /* Follows tbEVENT_TASK_CREATE.  ulTimestamp holds the next four characters of the task's name, the first in the least significant byte. */
+#define tbEVENT_TASK_DELETE                 ( ( uint8_t ) 5U )  /* usObject is the task number of the deleted task. */
+#define tbEVENT_TASK_DELAY                  ( ( uint8_t ) 6U )  /* usObject is the task number of the task that called vTaskDelay() or xTaskDelayUntil(). */
+#define tbEVENT_TASK_SUSPEND                ( ( uint8_t ) 7U )  /* usObject is the task number of the suspended task. */
+#define tbEVENT_TASK_RESUME                 ( ( uint8_t ) 8U )  /* usObject is the task number of the resumed task. */
+#define tbEVENT_QUEUE_SEND                  ( ( uint8_t ) 9U )  /* usObject is the queue number of the queue, semaphore or mutex. */
+#define tbEVENT_QUEUE_SEND_FROM_ISR         ( ( uint8_t ) 10U ) /* As tbEVENT_QUEUE_SEND. */
+#define tbEVENT_QUEUE_RECEIVE               ( ( uint8_t ) 11U ) /* As tbEVENT_QUEUE_SEND. */
+#define tbEVENT_QUEUE_RECEIVE_FROM_ISR      ( ( uint8_t ) 12U ) /* As tbEVENT_QUEUE_SEND. */
+#define tbEVENT_BLOCKING_ON_QUEUE_SEND      ( ( uint8_t ) 13U ) /* As tbEVENT_QUEUE_SEND. */
+#define tbEVENT_BLOCKING_ON_QUEUE_RECEIVE   ( ( uint8_t ) 14U ) /* As tbEVENT_QUEUE_SEND. */
+#define tbEVENT_RECORDS_LOST                ( ( uint8_t ) 127U ) /* Written by xTraceBufferDrain().  ulTimestamp holds the number of records from the core that were overwritten before they could be drained. */
+#define tbEVENT_FIRST_APPLICATION_EVENT     ( ( uint8_t ) 128U ) /* Values from this value up can be passed to vTraceBufferRecord() by the application. */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* This header is included by FreeRTOS.h, so cannot include stream_buffer.h to
+ * obtain the StreamBufferHandle_t type. */
+struct StreamBufferDef_t;
+
+/*
+ * The record written for each traced event.  Records are stored, and copied
+ * to the stream buffer by xTraceBufferDrain(), in the byte order of the
+ * target.
+ */
+typedef struct xTRACE_BUFFER_RECORD
+{
+    uint32_t ulTimestamp; /* The value of the trace timestamp when the event occurred, unless the description of ucEvent says otherwise. */
+    uint16_t usObject;    /* The number of the task or queue the event relates to, as returned by uxTaskGetTaskNumber() or uxQueueGetQueueNumber(). */
+    uint8_t ucEvent;      /* One of the tbEVENT_ values. */
+    uint8_t ucCoreID;     /* The core on which the event occurred. */
+} TraceBufferRecord_t;
+
+/**
+ * trace_buffer.h
+ * @code{c}
+ * void vTraceBufferRecord( uint8_t ucEvent, UBaseType_t uxObject );
+ * @endcode
+ *
+ * Writes a record to the trace buffer of the calling core.  Used by the trace
+ * macros, and can also be called by the application, from a task or an
+ * interrupt, to record its own events.
+ *
+ * @param ucEvent The event to record.  Application events must use values of
+ * tbEVENT_FIRST_APPLICATION_EVENT or above.
+ *
+ * @param uxObject Stored in the usObject member of the record.
+ */
+void vTraceBufferRecord( uint8_t ucEvent,
+                         UBaseType_t uxObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_buffer.h
+ * @code{c}
+ * size_t xTraceBufferDrain( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Moves as many records as will fit from the trace buffers of all the cores
+ * into a stream buffer, oldest first for each core.  Each record is written as
+ * sizeof( TraceBufferRecord_t ) bytes.  If any records were overwritten before
+ * they could be drained then a tbEVENT_RECORDS_LOST record is written in their
+ * place.
+ *
+ * Must only be called from a task, and by only one task.  Does not block.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write the records to.
+ * The stream buffer must not be a message buffer.
+ *
+ * @return The number of bytes written to the stream buffer.
+ */
+size_t xTraceBufferDrain( struct StreamBufferDef_t * xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE KERNEL.
+ *
+ * Writes a tbEVENT_TASK_CREATE record followed by the tbEVENT_TASK_NAME
+ * records that hold the name of the task.
+ */
+void vTraceBufferRecordTaskCreate( UBaseType_t uxTaskNumber,
+                                   const char * pcName ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+/* The trace macros that write to the trace buffer.  The task macros are only
+ * used within tasks.c, and the queue macros within queue.c, so can access the
+ * task and queue numbers directly.  configUSE_TRACE_FACILITY must be 1 for
+ * those numbers to exist. */
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()    vTraceBufferRecord( tbEVENT_TASK_SWITCHED_IN, pxCurrentTCB->uxTCBNumber )
+#endif
+
+#ifndef traceMOVED_TASK_TO_READY_STATE
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceBufferRecord( tbEVENT_TASK_READY, ( pxTCB )->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_CREATE
+    #define traceTASK_CREATE( pxNewTCB )    vTraceBufferRecordTaskCreate( ( pxNewTCB )->uxTCBNumber, ( pxNewTCB )->pcTaskName )
+#endif
+
+#ifndef traceTASK_DELETE
+    #define traceTASK_DELETE( pxTaskToDelete )    vTraceBufferRecord( tbEVENT_TASK_DELETE, ( pxTaskToDelete )->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_DELAY
+    #define traceTASK_DELAY()    vTraceBufferRecord( tbEVENT_TASK_DELAY, pxCurrentTCB->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+    #define traceTASK_DELAY_UNTIL( x )    vTraceBufferRecord( tbEVENT_TASK_DELAY, pxCurrentTCB->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_SUSPEND
+    #define traceTASK_SUSPEND( pxTaskToSuspend )    vTraceBufferRecord( tbEVENT_TASK_SUSPEND, ( pxTaskToSuspend )->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_RESUME
+    #define traceTASK_RESUME( pxTaskToResume )    vTraceBufferRecord( tbEVENT_TASK_RESUME, ( pxTaskToResume )->uxTCBNumber )
+#endif
+
+#ifndef traceTASK_RESUME_FROM_ISR
+    #define traceTASK_RESUME_FROM_ISR( pxTaskToResume )    vTraceBufferRecord( tbEVENT_TASK_RESUME, ( pxTaskToResume )->uxTCBNumber )
+#endif
+
+#ifndef traceQUEUE_SEND
+    #define traceQUEUE_SEND( pxQueue )    vTraceBufferRecord( tbEVENT_QUEUE_SEND, ( pxQueue )->uxQueueNumber )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR
+    #define traceQUEUE_SEND_FROM_ISR( pxQueue )    vTraceBufferRecord( tbEVENT_QUEUE_SEND_FROM_ISR, ( pxQueue )->uxQueueNumber )
+#endif
+
+#ifndef traceQUEUE_RECEIVE
+    #define traceQUEUE_RECEIVE( pxQueue )    vTraceBufferRecord( tbEVENT_QUEUE_RECEIVE, ( pxQueue )->uxQueueNumber )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+    #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    vTraceBufferRecord( tbEVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue )->uxQueueNumber )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    vTraceBufferRecord( tbEVENT_BLOCKING_ON_QUEUE_SEND, ( pxQueue )->uxQueueNumber )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    vTraceBufferRecord( tbEVENT_BLOCKING_ON_QUEUE_RECEIVE, ( pxQueue )->uxQueueNumber )
+#endif
+
+#endif /* TRACE_BUFFER_H */
@@ -0,0 +1,992 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpmc_queue.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include MPMC queues.  This #if is closed at the very bottom of this file.
+ * If you want to include MPMC queues then ensure configUSE_MPMC_QUEUES is set
+ * to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_MPMC_QUEUES == 1 )
+
+/* Access to the positions and sequence numbers.  When there is more than one
+ * core the compiler's atomic built-ins are used, so a compare and swap does not
+ * need a lock and the processor does not reorder an item copy past the
+ * sequence number that publishes it.  The sequence number is stored, and the
+ * count of waiting tasks loaded, with sequential consistency, so the store is
+ * also ordered before the check for tasks to wake without a separate fence.
+ * On a single core the writers and readers only ever interleave by being
+ * interrupted or preempted, so masking interrupts for the few instructions of
+ * a compare and swap is enough, and stopping the compiler reordering accesses
+ * orders them for the processor too. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #if !defined( __GNUC__ )
+            #error mpmc_queue.c requires a GCC compatible compiler when configNUMBER_OF_CORES is greater than 1.
+        #endif
+
+        #define mpmcLOAD_ACQUIRE( pulSource )          __atomic_load_n( ( pulSource ), __ATOMIC_ACQUIRE )
+        #define mpmcACQUIRE_BARRIER()
+        #define mpmcPUBLISH( pulDestination, ulValue )  __atomic_store_n( ( pulDestination ), ( ulValue ), __ATOMIC_SEQ_CST )
+        #define mpmcLOAD_WAITING( puxSource )           __atomic_load_n( ( puxSource ), __ATOMIC_SEQ_CST )
+        #define mpmcMEMORY_FENCE()                      __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #else
+        #define mpmcLOAD_ACQUIRE( pulSource )    ( *( ( volatile const uint32_t * ) ( pulSource ) ) )
+        #define mpmcACQUIRE_BARRIER()            portMEMORY_BARRIER()
+        #define mpmcPUBLISH( pulDestination, ulValue )                    \
+    do {                                                                  \
+        portMEMORY_BARRIER();                                             \
+        *( ( volatile uint32_t * ) ( pulDestination ) ) = ( ulValue );    \
+        portMEMORY_BARRIER();                                             \
+    } while( 0 )
+        #define mpmcLOAD_WAITING( puxSource )    ( *( puxSource ) )
+        #define mpmcMEMORY_FENCE()               portMEMORY_BARRIER()
+    #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define mpmcYIELD_IF_USING_PREEMPTION()
+    #else
+        #define mpmcYIELD_IF_USING_PREEMPTION()    taskYIELD_WITHIN_API()
+    #endif
+
+/* Bits used in ucFlags. */
+    #define mpmcFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1U )
+
+/*
+ * The MPMC queue.  The storage area is an array of cells.  Each cell is a
+ * 32-bit sequence number followed by space for one item.  A cell whose
+ * sequence number equals a write position is free to be written at that
+ * position, and a cell whose sequence number is one more than a read position
+ * holds the item to be read at that position.  ulWritePosition and
+ * ulReadPosition are the number of items ever claimed for writing and reading,
+ * so they are allowed to wrap.
+ *
+ * The fields that are not changed after the queue is created, the write
+ * position and the read position are each padded to
+ * configMPMC_QUEUE_CACHE_LINE_SIZE bytes, so writers on one core and readers
+ * on another do not contend for the same cache line.  The event lists and
+ * waiting task counts are only written by tasks that block.
+ */
+    typedef union MpmcQueueConfig
+    {
+        struct
+        {
+            uint8_t * pucStorage;   /**< The array of cells. */
+            size_t uxItemSize;      /**< The size of each item in bytes. */
+            size_t uxCellSize;      /**< The size of each cell in bytes, which is a multiple of 4. */
+            uint32_t ulLengthMask;  /**< The length of the queue minus one.  The length is a power of 2. */
+            uint8_t ucFlags;        /**< A bit map of mpmcFLAGS_* values. */
+        } xFields;
+        uint8_t ucPadding[ configMPMC_QUEUE_CACHE_LINE_SIZE ];
+    } MpmcQueueConfig_t;
+
+    typedef union MpmcQueuePosition
+    {
+        volatile uint32_t ulPosition;
+        uint8_t ucPadding[ configMPMC_QUEUE_CACHE_LINE_SIZE ];
+    } MpmcQueuePosition_t;
+
+    typedef struct MpmcQueueDef_t
+    {
+        MpmcQueueConfig_t xConfig;
+        MpmcQueuePosition_t xWrite;                 /**< Holds ulPosition, the next position to be written. */
+        MpmcQueuePosition_t xRead;                  /**< Holds ulPosition, the next position to be read. */
+        List_t xTasksWaitingToSend;                 /**< List of tasks that are blocked waiting for space.  Stored in priority order. */
+        List_t xTasksWaitingToReceive;              /**< List of tasks that are blocked waiting for an item.  Stored in priority order. */
+        volatile UBaseType_t uxTasksWaitingToSend;  /**< The number of tasks that are about to block, or are blocked, waiting for space. */
+        volatile UBaseType_t uxTasksWaitingToReceive; /**< The number of tasks that are about to block, or are blocked, waiting for an item. */
+    } MpmcQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xMpmcQueueCreate() and xMpmcQueueCreateStatic() to
+ * initialise the members of a newly created queue.
+ */
+    static void prvInitialiseNewMpmcQueue( MpmcQueue_t * const pxQueue,
+                                           UBaseType_t uxQueueLength,
+                                           UBaseType_t uxItemSize,
+                                           uint8_t * const pucStorage,
+                                           uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a pointer to the sequence number of the cell used by ulPosition.
+ * The item follows the sequence number.
+ */
+    static uint32_t * prvGetCell( const MpmcQueue_t * const pxQueue,
+                                  uint32_t ulPosition ) PRIVILEGED_FUNCTION;
+
+/*
+ * Atomically sets *pulDestination to ulExchange if it equals ulComparand.
+ * Returns pdTRUE if the value was set.
+ */
+    static BaseType_t prvCompareAndSwap( uint32_t volatile * pulDestination,
+                                         uint32_t ulComparand,
+                                         uint32_t ulExchange,
+                                         BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the queue if there is space, or out of the queue if
+ * there is an item.  Never blocks.  Returns pdTRUE if an item was copied.
+ */
+    static BaseType_t prvTrySend( MpmcQueue_t * const pxQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvTryReceive( MpmcQueue_t * const pxQueue,
+                                     void * pvBuffer,
+                                     BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the queue has space (xWaitingToSend is pdTRUE) or holds
+ * an item (xWaitingToSend is pdFALSE).
+ */
+    static BaseType_t prvIsReady( const MpmcQueue_t * const pxQueue,
+                                  BaseType_t xWaitingToSend ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on pxEventList for up to xTicksToWait ticks, unless
+ * the queue became ready after the task last tried to send or receive.
+ * *puxTasksWaiting is incremented before the queue is checked again, so a
+ * writer or reader that changes the queue after the check sees there is a
+ * task to wake.
+ */
+    static void prvBlock( MpmcQueue_t * const pxQueue,
+                          List_t * const pxEventList,
+                          volatile UBaseType_t * const puxTasksWaiting,
+                          BaseType_t xWaitingToSend,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the highest priority task on pxEventList, if any tasks are
+ * waiting.  Returns pdTRUE if the task that was unblocked has a priority above
+ * the calling task.
+ */
+    static BaseType_t prvWakeWaitingTask( List_t * const pxEventList,
+                                          volatile UBaseType_t * const puxTasksWaiting,
+                                          BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewMpmcQueue( MpmcQueue_t * const pxQueue,
+                                           UBaseType_t uxQueueLength,
+                                           UBaseType_t uxItemSize,
+                                           uint8_t * const pucStorage,
+                                           uint8_t ucFlags )
+    {
+        uint32_t ulPosition;
+
+        ( void ) memset( ( void * ) pxQueue, 0x00, sizeof( MpmcQueue_t ) );
+
+        pxQueue->xConfig.xFields.pucStorage = pucStorage;
+        pxQueue->xConfig.xFields.uxItemSize = ( size_t ) uxItemSize;
+        pxQueue->xConfig.xFields.uxCellSize = ( mpmcQUEUE_STORAGE_WORDS( 1U, uxItemSize ) * sizeof( uint32_t ) );
+        pxQueue->xConfig.xFields.ulLengthMask = ( uint32_t ) uxQueueLength - 1U;
+        pxQueue->xConfig.xFields.ucFlags = ucFlags;
+
+        vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+        vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+        /* Each cell starts free to be written at its own position. */
+        for( ulPosition = 0U; ulPosition < ( uint32_t ) uxQueueLength; ulPosition++ )
+        {
+            *( prvGetCell( pxQueue, ulPosition ) ) = ulPosition;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        MpmcQueueHandle_t xMpmcQueueCreate( UBaseType_t uxQueueLength,
+                                            UBaseType_t uxItemSize )
+        {
+            void * pvAllocatedMemory = NULL;
+            size_t xStorageWords;
+
+            traceENTER_xMpmcQueueCreate( uxQueueLength, uxItemSize );
+
+            /* The length must be a power of 2 so a position can be converted to
+             * a cell with a mask, and no more than 2^30 so the signed difference
+             * between a sequence number and a position is meaningful. */
+            configASSERT( uxQueueLength > ( UBaseType_t ) 0U );
+            configASSERT( ( uxQueueLength & ( UBaseType_t ) ( uxQueueLength - ( UBaseType_t ) 1U ) ) == ( UBaseType_t ) 0U );
+            configASSERT( ( uxQueueLength >> 30 ) <= ( UBaseType_t ) 1U );
+
+            /* The queue structure and the storage area are allocated in a
+             * single call to pvPortMalloc(), with the storage area placed
+             * immediately after the structure.  Check the size calculation does
+             * not overflow. */
+            xStorageWords = mpmcQUEUE_STORAGE_WORDS( 1U, uxItemSize );
+
+            if( ( ( SIZE_MAX - sizeof( MpmcQueue_t ) ) / ( xStorageWords * sizeof( uint32_t ) ) ) >= ( size_t ) uxQueueLength )
+            {
+                xStorageWords *= ( size_t ) uxQueueLength;
+                pvAllocatedMemory = pvPortMalloc( sizeof( MpmcQueue_t ) + ( xStorageWords * sizeof( uint32_t ) ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pvAllocatedMemory != NULL )
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                prvInitialiseNewMpmcQueue( ( MpmcQueue_t * ) pvAllocatedMemory,
+                                           uxQueueLength,
+                                           uxItemSize,
+                                           ( ( uint8_t * ) pvAllocatedMemory ) + sizeof( MpmcQueue_t ),
+                                           ( uint8_t ) 0U );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xMpmcQueueCreate( pvAllocatedMemory );
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            return ( MpmcQueueHandle_t ) pvAllocatedMemory;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        MpmcQueueHandle_t xMpmcQueueCreateStatic( UBaseType_t uxQueueLength,
+                                                  UBaseType_t uxItemSize,
+                                                  uint32_t * pulQueueStorage,
+                                                  StaticMpmcQueue_t * pxStaticQueue )
+        {
+            MpmcQueueHandle_t xReturn = NULL;
+
+            traceENTER_xMpmcQueueCreateStatic( uxQueueLength, uxItemSize, pulQueueStorage, pxStaticQueue );
+
+            configASSERT( uxQueueLength > ( UBaseType_t ) 0U );
+            configASSERT( ( uxQueueLength & ( UBaseType_t ) ( uxQueueLength - ( UBaseType_t ) 1U ) ) == ( UBaseType_t ) 0U );
+            configASSERT( ( uxQueueLength >> 30 ) <= ( UBaseType_t ) 1U );
+            configASSERT( pulQueueStorage );
+            configASSERT( pxStaticQueue );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMpmcQueue_t equals the size of the real
+                 * queue structure. */
+                volatile size_t xSize = sizeof( StaticMpmcQueue_t );
+                configASSERT( xSize == sizeof( MpmcQueue_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pulQueueStorage != NULL ) && ( pxStaticQueue != NULL ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                prvInitialiseNewMpmcQueue( ( MpmcQueue_t * ) pxStaticQueue,
+                                           uxQueueLength,
+                                           uxItemSize,
+                                           ( uint8_t * ) pulQueueStorage,
+                                           mpmcFLAGS_IS_STATICALLY_ALLOCATED );
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                xReturn = ( MpmcQueueHandle_t ) pxStaticQueue;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xMpmcQueueCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vMpmcQueueDelete( MpmcQueueHandle_t xQueue )
+    {
+        MpmcQueue_t * const pxQueue = xQueue;
+
+        traceENTER_vMpmcQueueDelete( xQueue );
+
+        configASSERT( pxQueue );
+        configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE );
+        configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE );
+
+        if( ( pxQueue->xConfig.xFields.ucFlags & mpmcFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0U )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* Both the structure and the storage area were allocated using
+                 * a single call to pvPortMalloc(), hence only one call to
+                 * vPortFree() is required. */
+                vPortFree( ( void * ) pxQueue );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xQueue == ( MpmcQueueHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure and storage area were statically allocated, so
+             * there is nothing to free. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vMpmcQueueDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t * prvGetCell( const MpmcQueue_t * const pxQueue,
+                                  uint32_t ulPosition )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        return ( uint32_t * ) &( pxQueue->xConfig.xFields.pucStorage[ ( size_t ) ( ulPosition & pxQueue->xConfig.xFields.ulLengthMask ) * pxQueue->xConfig.xFields.uxCellSize ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCompareAndSwap( uint32_t volatile * pulDestination,
+                                         uint32_t ulComparand,
+                                         uint32_t ulExchange,
+                                         BaseType_t xFromISR )
+    {
+        BaseType_t xReturn;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            ( void ) xFromISR;
+
+            if( __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else
+        {
+            UBaseType_t uxSavedInterruptStatus = 0U;
+
+            /* Mask interrupts around the compare, as atomic.h does.  A port
+             * that does not support nested interrupts cannot mask them from an
+             * interrupt, but nothing can interrupt the interrupt either. */
+            #if ( portHAS_NESTED_INTERRUPTS == 1 )
+            {
+                ( void ) xFromISR;
+                uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+            }
+            #else
+            {
+                if( xFromISR == pdFALSE )
+                {
+                    portENTER_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+            {
+                if( *pulDestination == ulComparand )
+                {
+                    *pulDestination = ulExchange;
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    xReturn = pdFALSE;
+                }
+            }
+            #if ( portHAS_NESTED_INTERRUPTS == 1 )
+            {
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            }
+            #else
+            {
+                ( void ) uxSavedInterruptStatus;
+
+                if( xFromISR == pdFALSE )
+                {
+                    portEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+        #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTrySend( MpmcQueue_t * const pxQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t xFromISR )
+    {
+        uint32_t ulPosition = pxQueue->xWrite.ulPosition;
+        uint32_t * pulCell;
+        int32_t lDifference;
+        BaseType_t xReturn = pdFALSE;
+
+        for( ; ; )
+        {
+            pulCell = prvGetCell( pxQueue, ulPosition );
+            lDifference = ( int32_t ) ( mpmcLOAD_ACQUIRE( pulCell ) - ulPosition );
+
+            if( lDifference == 0 )
+            {
+                /* The cell is free.  Try to claim it by moving the write
+                 * position on. */
+                if( prvCompareAndSwap( &( pxQueue->xWrite.ulPosition ), ulPosition, ulPosition + 1U, xFromISR ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( lDifference < 0 )
+            {
+                /* The cell still holds the item written a lap ago, so the
+                 * queue is full. */
+                break;
+            }
+            else
+            {
+                /* Another writer claimed the cell first. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ulPosition = pxQueue->xWrite.ulPosition;
+        }
+
+        if( xReturn != pdFALSE )
+        {
+            /* The cell must not be accessed before it is claimed. */
+            mpmcACQUIRE_BARRIER();
+
+            ( void ) memcpy( ( void * ) &( pulCell[ 1 ] ), pvItemToQueue, pxQueue->xConfig.xFields.uxItemSize );
+
+            /* Publish the item to readers. */
+            mpmcPUBLISH( pulCell, ulPosition + 1U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTryReceive( MpmcQueue_t * const pxQueue,
+                                     void * pvBuffer,
+                                     BaseType_t xFromISR )
+    {
+        uint32_t ulPosition = pxQueue->xRead.ulPosition;
+        uint32_t * pulCell;
+        int32_t lDifference;
+        BaseType_t xReturn = pdFALSE;
+
+        for( ; ; )
+        {
+            pulCell = prvGetCell( pxQueue, ulPosition );
+            lDifference = ( int32_t ) ( mpmcLOAD_ACQUIRE( pulCell ) - ( ulPosition + 1U ) );
+
+            if( lDifference == 0 )
+            {
+                /* The cell holds an item.  Try to claim it by moving the read
+                 * position on. */
+                if( prvCompareAndSwap( &( pxQueue->xRead.ulPosition ), ulPosition, ulPosition + 1U, xFromISR ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( lDifference < 0 )
+            {
+                /* The item for this position has not been written, so the
+                 * queue is empty. */
+                break;
+            }
+            else
+            {
+                /* Another reader claimed the cell first. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ulPosition = pxQueue->xRead.ulPosition;
+        }
+
+        if( xReturn != pdFALSE )
+        {
+            /* The cell must not be accessed before it is claimed. */
+            mpmcACQUIRE_BARRIER();
+
+            ( void ) memcpy( pvBuffer, ( const void * ) &( pulCell[ 1 ] ), pxQueue->xConfig.xFields.uxItemSize );
+
+            /* Free the cell for the writer one lap ahead. */
+            mpmcPUBLISH( pulCell, ulPosition + pxQueue->xConfig.xFields.ulLengthMask + 1U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvIsReady( const MpmcQueue_t * const pxQueue,
+                                  BaseType_t xWaitingToSend )
+    {
+        uint32_t ulPosition;
+        BaseType_t xReturn;
+
+        if( xWaitingToSend != pdFALSE )
+        {
+            ulPosition = pxQueue->xWrite.ulPosition;
+            xReturn = ( mpmcLOAD_ACQUIRE( prvGetCell( pxQueue, ulPosition ) ) == ulPosition ) ? pdTRUE : pdFALSE;
+        }
+        else
+        {
+            ulPosition = pxQueue->xRead.ulPosition;
+            xReturn = ( mpmcLOAD_ACQUIRE( prvGetCell( pxQueue, ulPosition ) ) == ( ulPosition + 1U ) ) ? pdTRUE : pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBlock( MpmcQueue_t * const pxQueue,
+                          List_t * const pxEventList,
+                          volatile UBaseType_t * const puxTasksWaiting,
+                          BaseType_t xWaitingToSend,
+                          TickType_t xTicksToWait )
+    {
+        BaseType_t xBlocked = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            /* The kernel critical section stops a writer or reader waking a
+             * task from this event list until the calling task is either on
+             * the list or has decided not to block. */
+            taskENTER_CRITICAL();
+            {
+                ( *puxTasksWaiting )++;
+                mpmcMEMORY_FENCE();
+
+                if( prvIsReady( pxQueue, xWaitingToSend ) == pdFALSE )
+                {
+                    vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    ( *puxTasksWaiting )--;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( xTaskResumeAll() == pdFALSE )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocked != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( *puxTasksWaiting )--;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWakeWaitingTask( List_t * const pxEventList,
+                                          volatile UBaseType_t * const puxTasksWaiting,
+                                          BaseType_t xFromISR )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* The caller published its change to the queue with mpmcPUBLISH(),
+         * which, with this load and the fence in prvBlock(), ensures either
+         * the blocking task sees the change or the caller sees the task. */
+        if( mpmcLOAD_WAITING( puxTasksWaiting ) != ( UBaseType_t ) 0U )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+                    {
+                        xReturn = xTaskRemoveFromEventList( pxEventList );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+                    {
+                        xReturn = xTaskRemoveFromEventList( pxEventList );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMpmcQueueSend( MpmcQueueHandle_t xQueue,
+                               const void * const pvItemToQueue,
+                               TickType_t xTicksToWait )
+    {
+        MpmcQueue_t * const pxQueue = xQueue;
+        BaseType_t xEntryTimeSet = pdFALSE, xReturn;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xMpmcQueueSend( xQueue, pvItemToQueue, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->xConfig.xFields.uxItemSize != ( size_t ) 0U ) ) );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            if( prvTrySend( pxQueue, pvItemToQueue, pdFALSE ) != pdFALSE )
+            {
+                if( prvWakeWaitingTask( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->uxTasksWaitingToReceive ), pdFALSE ) != pdFALSE )
+                {
+                    mpmcYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xReturn = errQUEUE_FULL;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xReturn = errQUEUE_FULL;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvBlock( pxQueue, &( pxQueue->xTasksWaitingToSend ), &( pxQueue->uxTasksWaitingToSend ), pdTRUE, xTicksToWait );
+        }
+
+        traceRETURN_xMpmcQueueSend( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMpmcQueueSendFromISR( MpmcQueueHandle_t xQueue,
+                                      const void * const pvItemToQueue,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        MpmcQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        traceENTER_xMpmcQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->xConfig.xFields.uxItemSize != ( size_t ) 0U ) ) );
+
+        if( prvTrySend( pxQueue, pvItemToQueue, pdTRUE ) != pdFALSE )
+        {
+            if( prvWakeWaitingTask( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->uxTasksWaitingToReceive ), pdTRUE ) != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errQUEUE_FULL;
+        }
+
+        traceRETURN_xMpmcQueueSendFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMpmcQueueReceive( MpmcQueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait )
+    {
+        MpmcQueue_t * const pxQueue = xQueue;
+        BaseType_t xEntryTimeSet = pdFALSE, xReturn;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xMpmcQueueReceive( xQueue, pvBuffer, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->xConfig.xFields.uxItemSize != ( size_t ) 0U ) ) );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            if( prvTryReceive( pxQueue, pvBuffer, pdFALSE ) != pdFALSE )
+            {
+                if( prvWakeWaitingTask( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->uxTasksWaitingToSend ), pdFALSE ) != pdFALSE )
+                {
+                    mpmcYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvBlock( pxQueue, &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->uxTasksWaitingToReceive ), pdFALSE, xTicksToWait );
+        }
+
+        traceRETURN_xMpmcQueueReceive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xMpmcQueueReceiveFromISR( MpmcQueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        MpmcQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        traceENTER_xMpmcQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->xConfig.xFields.uxItemSize != ( size_t ) 0U ) ) );
+
+        if( prvTryReceive( pxQueue, pvBuffer, pdTRUE ) != pdFALSE )
+        {
+            if( prvWakeWaitingTask( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->uxTasksWaitingToSend ), pdTRUE ) != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errQUEUE_EMPTY;
+        }
+
+        traceRETURN_xMpmcQueueReceiveFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMpmcQueueMessagesWaiting( MpmcQueueHandle_t xQueue )
+    {
+        const MpmcQueue_t * const pxQueue = xQueue;
+        uint32_t ulReadPosition, ulCount;
+
+        traceENTER_uxMpmcQueueMessagesWaiting( xQueue );
+
+        configASSERT( pxQueue );
+
+        /* Read the read position first, so a reader that moves it on between
+         * the two reads cannot make the count appear negative. */
+        ulReadPosition = pxQueue->xRead.ulPosition;
+        mpmcMEMORY_FENCE();
+        ulCount = pxQueue->xWrite.ulPosition - ulReadPosition;
+
+        if( ulCount > ( pxQueue->xConfig.xFields.ulLengthMask + 1U ) )
+        {
+            /* Items were read and written between the two reads. */
+            ulCount = pxQueue->xConfig.xFields.ulLengthMask + 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxMpmcQueueMessagesWaiting( ( UBaseType_t ) ulCount );
+
+        return ( UBaseType_t ) ulCount;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include MPMC queues.  This #if is closed at the very bottom of this file.
+ * If you want to include MPMC queues then ensure configUSE_MPMC_QUEUES is set
+ * to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MPMC_QUEUES == 1 */
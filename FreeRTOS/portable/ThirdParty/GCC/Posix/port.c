@@ -677,3 +677,9 @@ uint32_t ulPortGetRunTime( void )
     return ( uint32_t ) xTimes.tms_utime;
 }
 /*-----------------------------------------------------------*/
+
+uint32_t ulPortGetLatencyTimestamp( void )
+{
+    return ( uint32_t ) ( prvGetTimeNs() / ( uint64_t ) 1000U );
+}
+/*-----------------------------------------------------------*/
@@ -144,6 +144,12 @@ extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
 
+/* The run time counter is in units of process CPU time, which is too coarse
+ * to measure scheduling latency, so latencies are measured in microseconds of
+ * the host's monotonic clock instead. */
+extern uint32_t ulPortGetLatencyTimestamp( void );
+#define portGET_LATENCY_TIMESTAMP()                 ulPortGetLatencyTimestamp()
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -137,6 +137,25 @@ extern void vPortYield( void );
  * it should be released as many times as it is locked. */
     #define portRELEASE_ISR_LOCK( xCoreID )  do {} while( 0 )
 
+/* The following are only required if portUSING_GRANULAR_LOCKS is set to 1, in
+ * which case queues, stream buffers and event groups are each protected by
+ * their own spinlock rather than by the TASK and ISR locks.  Blocking on an
+ * object, and xEventGroupSetBits(), still suspend the scheduler and so take
+ * the TASK lock, and unblocking a task still takes the ISR lock. */
+
+/* The type of a spinlock. */
+    #define portSPINLOCK_TYPE                              BaseType_t
+
+/* Initialise the spinlock pointed to by pxSpinlock to the unlocked state. */
+    #define portINIT_SPINLOCK( pxSpinlock )                ( *( pxSpinlock ) = 0 )
+
+/* Acquire the spinlock pointed to by pxSpinlock. Spinlocks need not be
+ * recursive. */
+    #define portGET_SPINLOCK( xCoreID, pxSpinlock )        do { ( void ) ( xCoreID ); ( void ) ( pxSpinlock ); } while( 0 )
+
+/* Release the spinlock pointed to by pxSpinlock. */
+    #define portRELEASE_SPINLOCK( xCoreID, pxSpinlock )    do { ( void ) ( xCoreID ); ( void ) ( pxSpinlock ); } while( 0 )
+
 #endif /* if ( configNUMBER_OF_CORES > 1 ) */
 
 #endif /* PORTMACRO_H */
@@ -42,6 +42,10 @@
     #include "croutine.h"
 #endif
 
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+    #include "async.h"
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -77,11 +81,35 @@ typedef struct SemaphoreData
     UBaseType_t uxRecursiveCallCount; /**< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
 } SemaphoreData_t;
 
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    typedef struct QueuePriorityNode
+    {
+        uint32_t ulSequence; /**< Orders messages of equal priority by the time they were sent. */
+        UBaseType_t uxSlot;  /**< The storage slot holding the message, or a free slot for nodes past the end of the heap. */
+        uint8_t ucPriority;  /**< The priority the message was sent with. */
+    } QueuePriorityNode_t;
+#endif
+
+#if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+    typedef struct QueueSetReadyList
+    {
+        struct QueueDefinition * pxHead; /**< The first member of the set in the ready list, or NULL if the ready list is empty. */
+        struct QueueDefinition * pxTail; /**< The last member of the set in the ready list.  Only valid when pxHead is not NULL. */
+    } QueueSetReadyList_t;
+#endif
+
 /* Semaphores do not actually store or copy data, so have an item size of
  * zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+/* The uxCeilingPriority of a mutex that uses priority inheritance rather than a
+ * priority ceiling, and of a queue that is not a mutex. */
+    #define queueNO_CEILING_PRIORITY    ( ( UBaseType_t ) configMAX_PRIORITIES )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -95,6 +123,54 @@ typedef struct SemaphoreData
     #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 #endif
 
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+/* A task waiting for a mutex spins at most twice the mutex's average spin
+ * count plus queueMUTEX_MIN_SPINS times, and never more than
+ * configADAPTIVE_MUTEX_MAX_SPINS times.  Checking the mutex holder is still
+ * running needs a kernel critical section, so is only done every
+ * queueMUTEX_HOLDER_CHECK_INTERVAL spins, which must be a power of 2. */
+    #define queueMUTEX_MIN_SPINS                ( ( uint32_t ) 16U )
+    #define queueMUTEX_HOLDER_CHECK_INTERVAL    ( ( uint32_t ) 16U )
+#endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+/* The semaphore fast path uses the compiler's compare-and-swap if it is lock
+ * free for every integer type UBaseType_t might be, and otherwise masks
+ * interrupts around the compare as atomic.h does.  Every other call to
+ * traceQUEUE_SEND() and traceQUEUE_RECEIVE() is made from inside a critical
+ * section, so when the trace facility is in use the interrupt mask is used
+ * even if a compare-and-swap instruction is available and the trace macros are
+ * called with interrupts still masked. */
+    #if defined( __GNUC__ ) && defined( __GCC_ATOMIC_LONG_LOCK_FREE ) && ( __GCC_ATOMIC_CHAR_LOCK_FREE == 2 ) && ( __GCC_ATOMIC_SHORT_LOCK_FREE == 2 ) && ( __GCC_ATOMIC_INT_LOCK_FREE == 2 ) && ( __GCC_ATOMIC_LONG_LOCK_FREE == 2 ) && ( configUSE_TRACE_FACILITY != 1 )
+        #define queueUSE_NATIVE_COMPARE_AND_SWAP    1
+    #else
+        #define queueUSE_NATIVE_COMPARE_AND_SWAP    0
+    #endif
+
+/* Calls the trace macro for a successful fast give or take. */
+    #define queueTRACE_SEMAPHORE_FAST_PATH( pxQueue, xGive ) \
+    do {                                                     \
+        if( ( xGive ) != pdFALSE )                           \
+        {                                                    \
+            traceQUEUE_SEND( ( pxQueue ) );                  \
+        }                                                    \
+        else                                                 \
+        {                                                    \
+            traceQUEUE_RECEIVE( ( pxQueue ) );               \
+        }                                                    \
+    } while( 0 )
+
+/* Whether the queue is a member of a queue set, which must be notified each
+ * time the queue is given to. */
+    #if ( configUSE_QUEUE_SETS == 1 )
+        #define queueIS_QUEUE_SET_MEMBER( pxQueue )    ( ( pxQueue )->pxQueueSetContainer != NULL )
+    #else
+        #define queueIS_QUEUE_SET_MEMBER( pxQueue )    ( 0 )
+    #endif
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -109,6 +185,9 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     {
         QueuePointers_t xQueue;     /**< Data required exclusively when this structure is used as a queue. */
         SemaphoreData_t xSemaphore; /**< Data required exclusively when this structure is used as a semaphore. */
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+            QueueSetReadyList_t xSet; /**< Data required exclusively when this structure is used as a queue set. */
+        #endif
     } u;
 
     List_t xTasksWaitingToSend;             /**< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
@@ -127,18 +206,268 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 
     #if ( configUSE_QUEUE_SETS == 1 )
         struct QueueDefinition * pxQueueSetContainer;
+
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+            struct QueueDefinition * pxNextReadyMember; /**< The next member in the ready list of the containing set, the set itself if this is the last member in the list, or NULL if this queue is not in the list. */
+        #endif
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xQueueSpinlock; /**< Protects the queue when it is not a mutex. */
+    #endif
+
+    #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+        EventListBuckets_t xTasksWaitingToSendBuckets;    /**< The last task of each priority in xTasksWaitingToSend. */
+        EventListBuckets_t xTasksWaitingToReceiveBuckets; /**< The last task of each priority in xTasksWaitingToReceive. */
+    #endif
+
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        AsyncWaitList_t xAsyncWaitingToSend;    /**< Async coroutines waiting to post onto this queue.  Stored in FIFO order. */
+        AsyncWaitList_t xAsyncWaitingToReceive; /**< Async coroutines waiting to read from this queue.  Stored in FIFO order. */
+    #endif
+
+    #if ( configUSE_QUEUE_LOANS == 1 )
+        uint8_t ucLoans; /**< Records whether the send slot and/or the item at the head of the queue are on loan to a task. */
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        QueuePriorityNode_t * pxPriorityHeap; /**< The heap that orders the messages of a priority queue, or NULL if the queue is FIFO. */
+        uint32_t ulNextSequence;              /**< The sequence number given to the next message sent to a priority queue. */
+    #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        QueueStats_t xStats; /**< Usage statistics, only updated from within the queue's critical section. */
+    #endif
+
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        uint32_t ulSpinEstimate; /**< A running average of the number of times a task spun waiting for the mutex, used to size the next spin. */
+    #endif
+
+    #if ( configUSE_QUEUE_WORD_COPY == 1 )
+        uint8_t ucItemCopy; /**< The item size in 32-bit words if prvCopyItem() has a constant size copy for it, or queueCOPY_GENERIC.  Set when the queue is created. */
+    #endif
+
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPriority; /**< The priority a task holding the mutex runs at, or queueNO_CEILING_PRIORITY if the mutex uses priority inheritance. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+/*
+ * Single items are copied in and out of the queue storage area by
+ * queueCOPY_ITEM().  When configUSE_QUEUE_WORD_COPY is 1, queues holding 4, 8
+ * or 16 byte items copy them with a memcpy() of constant size, which compilers
+ * expand inline, instead of calling memcpy() with a size only known at run
+ * time.  The storage area of a dynamically allocated queue starts on the first
+ * word boundary after the Queue_t structure so the expanded copies can use word
+ * accesses on the queue's side whenever the heap is aligned.
+ */
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
+    #define queueCOPY_GENERIC             ( ( uint8_t ) 0U )
+    #define queueSTORAGE_OFFSET           ( ( sizeof( Queue_t ) + ( sizeof( uint32_t ) - 1U ) ) & ~( sizeof( uint32_t ) - 1U ) )
+    #define queueCOPY_ITEM( pxQueue, pvDestination, pvSource )    prvCopyItem( ( pxQueue ), ( pvDestination ), ( pvSource ) )
+#else
+    #define queueSTORAGE_OFFSET           sizeof( Queue_t )
+    #define queueCOPY_ITEM( pxQueue, pvDestination, pvSource )    ( void ) memcpy( ( pvDestination ), ( pvSource ), ( size_t ) ( pxQueue )->uxItemSize )
+#endif
+
+/*
+ * Macros to enter and exit a critical section that protects a queue.  When
+ * portUSING_GRANULAR_LOCKS is 1 each queue is protected by its own spinlock,
+ * so queues used by tasks running on different cores do not contend with
+ * each other.  Mutexes are still protected by the kernel critical section as
+ * giving and taking a mutex can change the priority of the mutex holder.
+ *
+ * Within a queue spinlock critical section the kernel is only locked as it
+ * would be from an ISR, so queueREMOVE_FROM_EVENT_LIST() must be used in place
+ * of xTaskRemoveFromEventList(), and the queue's event lists must not be
+ * updated while another core holds the queue locked by prvLockQueue().
+ */
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+    #define queueSPINLOCK( pxQueue )    ( ( portSPINLOCK_TYPE * ) &( ( pxQueue )->xQueueSpinlock ) )
+
+    #define queueENTER_CRITICAL( pxQueue )                             \
+    do {                                                               \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )          \
+        {                                                              \
+            taskENTER_CRITICAL();                                      \
+        }                                                              \
+        else                                                           \
+        {                                                              \
+            taskDATA_GROUP_ENTER_CRITICAL( queueSPINLOCK( pxQueue ) ); \
+        }                                                              \
+    } while( 0 )
+
+    #define queueEXIT_CRITICAL( pxQueue )                             \
+    do {                                                              \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )         \
+        {                                                             \
+            taskEXIT_CRITICAL();                                      \
+        }                                                             \
+        else                                                          \
+        {                                                             \
+            taskDATA_GROUP_EXIT_CRITICAL( queueSPINLOCK( pxQueue ) ); \
+        }                                                             \
+    } while( 0 )
+
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                        \
+    ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) ?                \
+      taskENTER_CRITICAL_FROM_ISR() :                                      \
+      taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( queueSPINLOCK( pxQueue ) ) )
+
+    #define queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue )                                 \
+    do {                                                                                                   \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )                                              \
+        {                                                                                                  \
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                          \
+        }                                                                                                  \
+        else                                                                                               \
+        {                                                                                                  \
+            taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( ( uxSavedInterruptStatus ), queueSPINLOCK( pxQueue ) ); \
+        }                                                                                                  \
+    } while( 0 )
+
+    #define queueREMOVE_FROM_EVENT_LIST( pxEventList )    prvRemoveFromEventList( pxEventList )
+
+    #define queueSET_TIME_OUT_STATE( pxTimeOut )   \
+    do {                                           \
+        taskDATA_GROUP_LOCK_KERNEL();              \
+        vTaskInternalSetTimeOutState( pxTimeOut ); \
+        taskDATA_GROUP_UNLOCK_KERNEL();            \
+    } while( 0 )
+#else /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+    #define queueENTER_CRITICAL( pxQueue )                                    taskENTER_CRITICAL()
+    #define queueEXIT_CRITICAL( pxQueue )                                     taskEXIT_CRITICAL()
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                           taskENTER_CRITICAL_FROM_ISR()
+    #define queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+    #define queueREMOVE_FROM_EVENT_LIST( pxEventList )                        xTaskRemoveFromEventList( pxEventList )
+    #define queueSET_TIME_OUT_STATE( pxTimeOut )                              vTaskInternalSetTimeOutState( pxTimeOut )
+#endif /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+
+/*
+ * Macros to block the calling task on one of the queue's event lists.  When
+ * configUSE_EVENT_LIST_BUCKETS is 1 the position of the task within the
+ * priority ordered list is found in constant time.
+ */
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    #define queuePLACE_ON_SEND_EVENT_LIST( pxQueue, xTicksToWait )       vTaskPlaceOnBucketedEventList( &( ( pxQueue )->xTasksWaitingToSend ), &( ( pxQueue )->xTasksWaitingToSendBuckets ), ( xTicksToWait ) )
+    #define queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait )    vTaskPlaceOnBucketedEventList( &( ( pxQueue )->xTasksWaitingToReceive ), &( ( pxQueue )->xTasksWaitingToReceiveBuckets ), ( xTicksToWait ) )
+#else
+    #define queuePLACE_ON_SEND_EVENT_LIST( pxQueue, xTicksToWait )       vTaskPlaceOnEventList( &( ( pxQueue )->xTasksWaitingToSend ), ( xTicksToWait ) )
+    #define queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait )    vTaskPlaceOnEventList( &( ( pxQueue )->xTasksWaitingToReceive ), ( xTicksToWait ) )
+#endif
+
+/*
+ * Macros to wake the async coroutines waiting for space or data in the queue.
+ * Async wait lists are protected by the kernel critical section, so these are
+ * used after the queue's own critical section has been exited.
+ */
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+    #define queueWAKE_ASYNC_WAITERS( pxWaitList, xWakeAll )    \
+    do {                                                       \
+        if( *( pxWaitList ) != NULL )                          \
+        {                                                      \
+            vAsyncWakeWaiters( ( pxWaitList ), ( xWakeAll ) ); \
+        }                                                      \
+    } while( 0 )
+
+    #define queueWAKE_ASYNC_WAITERS_FROM_ISR( pxWaitList, xWakeAll, pxHigherPriorityTaskWoken )      \
+    do {                                                                                             \
+        if( *( pxWaitList ) != NULL )                                                                \
+        {                                                                                            \
+            vAsyncWakeWaitersFromISR( ( pxWaitList ), ( xWakeAll ), ( pxHigherPriorityTaskWoken ) ); \
+        }                                                                                            \
+    } while( 0 )
+#else
+    #define queueWAKE_ASYNC_WAITERS( pxWaitList, xWakeAll )
+    #define queueWAKE_ASYNC_WAITERS_FROM_ISR( pxWaitList, xWakeAll, pxHigherPriorityTaskWoken )
+#endif
+
+/*
+ * Bits used in ucLoans.  While the send slot is on loan the queue is full to
+ * every other writer, and while the head item is on loan the queue is empty to
+ * every other reader, so the storage being used in place is never touched by
+ * a copy.
+ */
+#if ( configUSE_QUEUE_LOANS == 1 )
+    #define queueLOANED_SEND_SLOT                ( ( uint8_t ) 0x01U )
+    #define queueLOANED_ITEM                     ( ( uint8_t ) 0x02U )
+    #define queueSEND_SLOT_ON_LOAN( pxQueue )    ( ( ( pxQueue )->ucLoans & queueLOANED_SEND_SLOT ) != 0U )
+    #define queueITEM_ON_LOAN( pxQueue )         ( ( ( pxQueue )->ucLoans & queueLOANED_ITEM ) != 0U )
+#else
+    #define queueSEND_SLOT_ON_LOAN( pxQueue )    ( 0 )
+    #define queueITEM_ON_LOAN( pxQueue )         ( 0 )
+#endif
+
+/*
+ * A priority queue stores its messages in the same slots as any other queue,
+ * but orders them with a binary heap of QueuePriorityNode_t rather than by
+ * their position in the storage area.  The heap holds one node per message,
+ * ordered by priority then sequence number.  The nodes past the end of the
+ * heap hold the indexes of the free slots, so no separate free list is
+ * needed.  Operations that rely on the storage area being a FIFO ring, such
+ * as batches and loans, cannot be used on priority queues.
+ */
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+    #define queueIS_PRIORITY_QUEUE( pxQueue )    ( ( pxQueue )->pxPriorityHeap != NULL )
+#else
+    #define queueIS_PRIORITY_QUEUE( pxQueue )    ( 0 )
+#endif
+
+/*
+ * Macros that update the statistics kept when configUSE_QUEUE_STATS is 1.  All
+ * but queueSTATS_SEND_TIMED_OUT() and queueSTATS_RECEIVE_TIMED_OUT() must be
+ * called from within the queue's critical section.  A send or receive that has
+ * to wait records the tick at which it started waiting in xWaitStartTick, and
+ * adds the ticks waited to the statistics when it completes or times out.
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    #define queueSTATS_INCREMENT( pxQueue, ulCounter )    ( ( pxQueue )->xStats.ulCounter )++
+
+    #define queueSTATS_HIGH_WATER_MARK_EXCEEDED( pxQueue )    ( ( pxQueue )->uxMessagesWaiting > ( pxQueue )->xStats.uxMessagesWaitingHighWaterMark )
+
+    #define queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue )                                         \
+    do {                                                                                         \
+        if( queueSTATS_HIGH_WATER_MARK_EXCEEDED( pxQueue ) )                                     \
+        {                                                                                        \
+            ( pxQueue )->xStats.uxMessagesWaitingHighWaterMark = ( pxQueue )->uxMessagesWaiting; \
+        }                                                                                        \
+    } while( 0 )
+
+    #define queueSTATS_WAIT_STARTED( pxQueue, ulCounter, xWaitStartTick ) \
+    do {                                                                  \
+        ( ( pxQueue )->xStats.ulCounter )++;                              \
+        ( xWaitStartTick ) = xTaskGetTickCount();                         \
+    } while( 0 )
+
+    #define queueSTATS_WAIT_ENDED( pxQueue, ulCounter, xEntryTimeSet, xWaitStartTick )                                 \
+    do {                                                                                                               \
+        if( ( xEntryTimeSet ) != pdFALSE )                                                                             \
+        {                                                                                                              \
+            ( pxQueue )->xStats.ulCounter += ( uint32_t ) ( TickType_t ) ( xTaskGetTickCount() - ( xWaitStartTick ) ); \
+        }                                                                                                              \
+    } while( 0 )
+
+    #define queueSTATS_SEND_TIMED_OUT( pxQueue, xWaitStartTick )       prvRecordTimeOut( ( pxQueue ), pdTRUE, ( xWaitStartTick ) )
+    #define queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick )    prvRecordTimeOut( ( pxQueue ), pdFALSE, ( xWaitStartTick ) )
+#else
+    #define queueSTATS_INCREMENT( pxQueue, ulCounter )
+    #define queueSTATS_HIGH_WATER_MARK_EXCEEDED( pxQueue )    ( 0 )
+    #define queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue )
+    #define queueSTATS_WAIT_STARTED( pxQueue, ulCounter, xWaitStartTick )
+    #define queueSTATS_WAIT_ENDED( pxQueue, ulCounter, xEntryTimeSet, xWaitStartTick )
+    #define queueSTATS_SEND_TIMED_OUT( pxQueue, xWaitStartTick )
+    #define queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -210,13 +539,144 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies a number of consecutive items into the back of a queue, or out of the
+ * front of a queue, using at most two copies to handle the storage area
+ * wrapping around.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const void * pvItems,
+                                 const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
+
+/*
+ * Copies one item between a slot in the queue storage area and a caller's
+ * buffer, in either direction, using the copy selected when the queue was
+ * created.
+ */
+    static void prvCopyItem( const Queue_t * const pxQueue,
+                             void * const pvDestination,
+                             const void * const pvSource ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/*
+ * Functions that maintain the heap of a priority queue.  prvPushPriorityItem()
+ * and prvPopPriorityItem() copy a message in or out and restore the heap
+ * order, and must be called before uxMessagesWaiting is updated.
+ * prvResetPriorityHeap() marks every slot as free.
+ */
+    static void prvPushPriorityItem( Queue_t * const pxQueue,
+                                     const void * pvItemToQueue,
+                                     const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+    static void prvPopPriorityItem( Queue_t * const pxQueue,
+                                    void * const pvBuffer ) PRIVILEGED_FUNCTION;
+    static void prvPeekPriorityItem( const Queue_t * const pxQueue,
+                                     void * const pvBuffer ) PRIVILEGED_FUNCTION;
+    static void prvResetPriorityHeap( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the message described by pxA must be received before the
+ * message described by pxB, otherwise pdFALSE.
+ */
+    static BaseType_t prvPriorityNodeIsBefore( const QueuePriorityNode_t * const pxA,
+                                               const QueuePriorityNode_t * const pxB ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/*
+ * Adds the ticks a send or receive waited before timing out to the queue's
+ * statistics, and counts a timed out send as failed.  Called outside of the
+ * queue's critical section, which it enters itself.
+ */
+    static void prvRecordTimeOut( Queue_t * const pxQueue,
+                                  const BaseType_t xIsSend,
+                                  const TickType_t xWaitStartTick ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+/*
+ * Called when a task has to wait for a mutex.  Spins, outside of any critical
+ * section, while the mutex holder is running on another core, until the mutex
+ * is given back or the spin limit derived from the mutex's ulSpinEstimate is
+ * reached.  The estimate is then updated from the number of spins.
+ *
+ * @return pdTRUE if the mutex was seen to be available, otherwise pdFALSE, in
+ * which case the caller should block as it would have done without spinning.
+ */
+    static BaseType_t prvSpinWhileMutexHolderRuns( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+/*
+ * Sets the count of a semaphore to uxExchange if it is still uxComparand, in a
+ * single step that neither an interrupt nor a context switch can split, and
+ * calls traceQUEUE_SEND() if xGive is pdTRUE or traceQUEUE_RECEIVE() if not
+ * when the count is set.  Returns pdTRUE if the count was set.
+ */
+    static BaseType_t prvSemaphoreCompareAndSwap( Queue_t * const pxQueue,
+                                                  UBaseType_t uxComparand,
+                                                  const UBaseType_t uxExchange,
+                                                  const BaseType_t xGive ) PRIVILEGED_FUNCTION;
+
+/*
+ * The uncontended paths of xQueueGenericSend() and xQueueSemaphoreTake() for
+ * binary and counting semaphores.  They change the count with
+ * prvSemaphoreCompareAndSwap() and only enter a critical section if, once the
+ * count has changed, there is a task to unblock or a queue set to notify.
+ * They return pdFALSE without changing the count if the semaphore is full
+ * (give) or empty (take), if the semaphore is a mutex, or if a task is already
+ * waiting, in which case the caller continues along its full path.
+ */
+    static BaseType_t prvSemaphoreFastGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSemaphoreFastTake( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
  * Checks to see if a queue is a member of a queue set, and if so, notifies
  * the queue set that the queue contains data.
  */
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+
+/*
+ * Returns the member at the head of a queue set's ready list, after moving it
+ * to the back of the list so ready members are selected in turn, or NULL if
+ * no member holds data.  Members that were emptied since they were added to
+ * the ready list are dropped from it on the way.  Must be called from within
+ * the queue set's critical section.
+ */
+    static Queue_t * prvTakeReadyMember( Queue_t * const pxQueueSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlinks a member from its queue set's ready list.  Must be called with both
+ * the member and the queue set locked.
+ */
+    static void prvRemoveFromReadyList( Queue_t * const pxQueueSet,
+                                        Queue_t * const pxMember ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+/*
+ * Removes the highest priority task from pxEventList, with the kernel locked,
+ * if the list is not empty.  The list may have emptied since the caller last
+ * checked it as the kernel may time out a waiting task at any time.  Returns
+ * the value returned by xTaskRemoveFromEventList().
+ */
+    static BaseType_t prvRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -249,6 +709,21 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetHighestPriorityOfWaitToReceiveList( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+/*
+ * Unblock up to uxCount of the highest priority tasks waiting to send to, or
+ * receive from, the queue after space or data has been made available other
+ * than by a single xQueueSend() or xQueueReceive().  If another core has the
+ * queue locked the event is recorded in the lock count instead.  Must be
+ * called from within the queue's critical section.
+ *
+ * @return pdTRUE if an unblocked task has a priority higher than the calling
+ * task, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockWaitingSenders( Queue_t * const pxQueue,
+                                            UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockWaitingReceivers( Queue_t * const pxQueue,
+                                              UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
 /*-----------------------------------------------------------*/
 
 /*
@@ -256,7 +731,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  * accessing the queue event lists.
  */
 #define prvLockQueue( pxQueue )                            \
-    taskENTER_CRITICAL();                                  \
+    queueENTER_CRITICAL( pxQueue );                        \
     {                                                      \
         if( ( pxQueue )->cRxLock == queueUNLOCKED )        \
         {                                                  \
@@ -267,7 +742,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             ( pxQueue )->cTxLock = queueLOCKED_UNMODIFIED; \
         }                                                  \
     }                                                      \
-    taskEXIT_CRITICAL()
+    queueEXIT_CRITICAL( pxQueue )
 
 /*
  * Macro to increment cTxLock member of the queue data structure. It is
@@ -277,6 +752,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #define prvIncrementQueueTxLock( pxQueue, cTxLock )                           \
     do {                                                                      \
         const UBaseType_t uxNumberOfTasks = uxTaskGetNumberOfTasks();         \
+        queueSTATS_INCREMENT( ( pxQueue ), ulTxLockEvents );                  \
         if( ( UBaseType_t ) ( cTxLock ) < uxNumberOfTasks )                   \
         {                                                                     \
             configASSERT( ( cTxLock ) != queueINT8_MAX );                     \
@@ -292,6 +768,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #define prvIncrementQueueRxLock( pxQueue, cRxLock )                           \
     do {                                                                      \
         const UBaseType_t uxNumberOfTasks = uxTaskGetNumberOfTasks();         \
+        queueSTATS_INCREMENT( ( pxQueue ), ulRxLockEvents );                  \
         if( ( UBaseType_t ) ( cRxLock ) < uxNumberOfTasks )                   \
         {                                                                     \
             configASSERT( ( cRxLock ) != queueINT8_MAX );                     \
@@ -315,25 +792,70 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         /* Check for multiplication overflow. */
         ( ( SIZE_MAX / pxQueue->uxLength ) >= pxQueue->uxItemSize ) )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
             pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize );
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
             pxQueue->pcWriteTo = pxQueue->pcHead;
             pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize );
-            pxQueue->cRxLock = queueUNLOCKED;
-            pxQueue->cTxLock = queueUNLOCKED;
+
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+            {
+                if( pxQueue->pxPriorityHeap != NULL )
+                {
+                    prvResetPriorityHeap( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            #if ( portUSING_GRANULAR_LOCKS == 1 )
+            {
+                /* Another core may be holding an existing queue locked. */
+                if( xNewQueue != pdFALSE )
+                {
+                    pxQueue->cRxLock = queueUNLOCKED;
+                    pxQueue->cTxLock = queueUNLOCKED;
+                }
+            }
+            #else
+            {
+                pxQueue->cRxLock = queueUNLOCKED;
+                pxQueue->cTxLock = queueUNLOCKED;
+            }
+            #endif
 
             if( xNewQueue == pdFALSE )
             {
+                #if ( configUSE_QUEUE_LOANS == 1 )
+                {
+                    /* Resetting would free storage a task is still using. */
+                    configASSERT( pxQueue->ucLoans == 0U );
+                }
+                #endif
+
                 /* If there are tasks blocked waiting to read from the queue, then
                  * the tasks will remain blocked as after this function exits the queue
                  * will still be empty.  If there are tasks blocked waiting to write to
                  * the queue, then one should be unblocked as after this function exits
                  * it will be possible to write to it. */
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                    if( pxQueue->cRxLock != queueUNLOCKED )
+                    {
+                        const int8_t cRxLock = pxQueue->cRxLock;
+
+                        /* The core holding the queue locked will unblock the
+                         * task when it unlocks the queue. */
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                    else
+                #endif
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -352,9 +874,33 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                 /* Ensure the event queues start in the correct state. */
                 vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
                 vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+                #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+                {
+                    ( void ) memset( &( pxQueue->xTasksWaitingToSendBuckets ), 0x00, sizeof( EventListBuckets_t ) );
+                    ( void ) memset( &( pxQueue->xTasksWaitingToReceiveBuckets ), 0x00, sizeof( EventListBuckets_t ) );
+                }
+                #endif
+
+                #if ( configUSE_QUEUE_LOANS == 1 )
+                {
+                    pxQueue->ucLoans = 0U;
+                }
+                #endif
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
+
+        if( xNewQueue == pdFALSE )
+        {
+            /* The queue is now empty, so every async coroutine waiting to
+             * write to it can continue. */
+            queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdTRUE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
@@ -516,7 +1062,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 14.3.1 [Configuration dependent invariant] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-143. */
             /* coverity[misra_c_2012_rule_14_3_violation] */
-            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( size_t ) ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize ) ) )
+            ( ( SIZE_MAX - queueSTORAGE_OFFSET ) >= ( size_t ) ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize ) ) )
         {
             /* Allocate enough space to hold the maximum number of items that
              * can be in the queue at any time.  It is valid for uxItemSize to be
@@ -526,14 +1072,14 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            pxNewQueue = ( Queue_t * ) pvPortMalloc( queueSTORAGE_OFFSET + xQueueSizeInBytes );
 
             if( pxNewQueue != NULL )
             {
                 /* Jump past the queue structure to find the location of the queue
                  * storage area. */
                 pucQueueStorage = ( uint8_t * ) pxNewQueue;
-                pucQueueStorage += sizeof( Queue_t );
+                pucQueueStorage += queueSTORAGE_OFFSET;
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -566,67 +1112,264 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
-                                   const UBaseType_t uxItemSize,
-                                   uint8_t * pucQueueStorage,
-                                   const uint8_t ucQueueType,
-                                   Queue_t * pxNewQueue )
-{
-    /* Remove compiler warnings about unused parameters should
-     * configUSE_TRACE_FACILITY not be set to 1. */
-    ( void ) ucQueueType;
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    if( uxItemSize == ( UBaseType_t ) 0 )
-    {
-        /* No RAM was allocated for the queue storage area, but PC head cannot
-         * be set to NULL because NULL is used as a key to say the queue is used as
-         * a mutex.  Therefore just set pcHead to point to the queue as a benign
-         * value that is known to be within the memory map. */
-        pxNewQueue->pcHead = ( int8_t * ) pxNewQueue;
-    }
-    else
+    QueueHandle_t xQueueCreatePriorityQueue( const UBaseType_t uxQueueLength,
+                                             const UBaseType_t uxItemSize )
     {
-        /* Set the head to the start of the queue storage area. */
-        pxNewQueue->pcHead = ( int8_t * ) pucQueueStorage;
-    }
+        Queue_t * pxNewQueue = NULL;
+        size_t xNodesSizeInBytes;
+        size_t xQueueSizeInBytes;
+        uint8_t * pucQueueStorage;
 
-    /* Initialise the queue members as described where the queue type is
-     * defined. */
-    pxNewQueue->uxLength = uxQueueLength;
-    pxNewQueue->uxItemSize = uxItemSize;
-    ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+        traceENTER_xQueueCreatePriorityQueue( uxQueueLength, uxItemSize );
 
-    #if ( configUSE_TRACE_FACILITY == 1 )
-    {
-        pxNewQueue->ucQueueType = ucQueueType;
-    }
-    #endif /* configUSE_TRACE_FACILITY */
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            /* Check for multiplication overflow. */
+            ( ( SIZE_MAX / uxQueueLength ) >= ( ( size_t ) uxItemSize + sizeof( QueuePriorityNode_t ) ) ) &&
+            /* Check for addition overflow. */
+            ( ( SIZE_MAX - queueSTORAGE_OFFSET ) >= ( ( size_t ) uxQueueLength * ( ( size_t ) uxItemSize + sizeof( QueuePriorityNode_t ) ) ) ) )
+        {
+            /* The heap nodes are placed directly after the queue structure, and
+             * the items after the heap nodes.  The size of a node is a multiple
+             * of its alignment, so the items keep the alignment of the
+             * storage offset. */
+            xNodesSizeInBytes = ( size_t ) uxQueueLength * sizeof( QueuePriorityNode_t );
+            xQueueSizeInBytes = ( size_t ) uxQueueLength * ( size_t ) uxItemSize;
 
-    #if ( configUSE_QUEUE_SETS == 1 )
-    {
-        pxNewQueue->pxQueueSetContainer = NULL;
-    }
-    #endif /* configUSE_QUEUE_SETS */
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewQueue = ( Queue_t * ) pvPortMalloc( queueSTORAGE_OFFSET + xNodesSizeInBytes + xQueueSizeInBytes );
 
-    traceQUEUE_CREATE( pxNewQueue );
-}
-/*-----------------------------------------------------------*/
+            if( pxNewQueue != NULL )
+            {
+                pucQueueStorage = ( uint8_t * ) pxNewQueue;
+                pucQueueStorage += queueSTORAGE_OFFSET;
 
-#if ( configUSE_MUTEXES == 1 )
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* Queues can be created either statically or dynamically, so
+                     * note this queue was created dynamically in case it is later
+                     * deleted. */
+                    pxNewQueue->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-    static void prvInitialiseMutex( Queue_t * pxNewQueue )
-    {
-        if( pxNewQueue != NULL )
-        {
-            /* The queue create function will set all the queue structure members
-            * correctly for a generic queue, but this function is creating a
-            * mutex.  Overwrite those members that need to be set differently -
-            * in particular the information required for priority inheritance. */
-            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
-            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+                prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage + xNodesSizeInBytes, queueQUEUE_TYPE_PRIORITY, pxNewQueue );
 
-            /* In case this is a recursive mutex. */
-            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+                /* The queue is not visible to any other task yet, so the heap
+                 * can be attached without a critical section. */
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxNewQueue->pxPriorityHeap = ( QueuePriorityNode_t * ) pucQueueStorage;
+                prvResetPriorityHeap( pxNewQueue );
+            }
+            else
+            {
+                traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_PRIORITY );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreatePriorityQueue( pxNewQueue );
+
+        return pxNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreatePriorityQueueStatic( const UBaseType_t uxQueueLength,
+                                                   const UBaseType_t uxItemSize,
+                                                   uint8_t * pucQueueStorage,
+                                                   StaticPriorityQueueNode_t * pxNodeStorage,
+                                                   StaticQueue_t * pxStaticQueue )
+    {
+        Queue_t * pxNewQueue = NULL;
+
+        traceENTER_xQueueCreatePriorityQueueStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxNodeStorage, pxStaticQueue );
+
+        configASSERT( pxNodeStorage );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare the
+             * node storage equals the size of the real heap node. */
+            volatile size_t xSize = sizeof( StaticPriorityQueueNode_t );
+
+            /* This assertion cannot be branch covered in unit tests */
+            configASSERT( xSize == sizeof( QueuePriorityNode_t ) ); /* LCOV_EXCL_BR_LINE */
+            ( void ) xSize;                                         /* Prevent unused variable warning when configASSERT() is not defined. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxNodeStorage != NULL ) && ( uxItemSize > ( UBaseType_t ) 0 ) )
+        {
+            pxNewQueue = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_PRIORITY );
+
+            if( pxNewQueue != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxNewQueue->pxPriorityHeap = ( QueuePriorityNode_t * ) pxNodeStorage;
+                prvResetPriorityHeap( pxNewQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreatePriorityQueueStatic( pxNewQueue );
+
+        return pxNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
+                                   const UBaseType_t uxItemSize,
+                                   uint8_t * pucQueueStorage,
+                                   const uint8_t ucQueueType,
+                                   Queue_t * pxNewQueue )
+{
+    /* Remove compiler warnings about unused parameters should
+     * configUSE_TRACE_FACILITY not be set to 1. */
+    ( void ) ucQueueType;
+
+    if( uxItemSize == ( UBaseType_t ) 0 )
+    {
+        /* No RAM was allocated for the queue storage area, but PC head cannot
+         * be set to NULL because NULL is used as a key to say the queue is used as
+         * a mutex.  Therefore just set pcHead to point to the queue as a benign
+         * value that is known to be within the memory map. */
+        pxNewQueue->pcHead = ( int8_t * ) pxNewQueue;
+    }
+    else
+    {
+        /* Set the head to the start of the queue storage area. */
+        pxNewQueue->pcHead = ( int8_t * ) pucQueueStorage;
+    }
+
+    /* Initialise the queue members as described where the queue type is
+     * defined. */
+    pxNewQueue->uxLength = uxQueueLength;
+    pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+    {
+        portINIT_SPINLOCK( &( pxNewQueue->xQueueSpinlock ) );
+    }
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        /* Must be valid before the queue is reset.  The priority queue create
+         * functions attach the heap after this function returns. */
+        pxNewQueue->pxPriorityHeap = NULL;
+    }
+    #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+    {
+        ( void ) memset( &( pxNewQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+    }
+    #endif
+
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+    {
+        /* The priority ceiling mutex create functions set the ceiling after
+         * this function returns. */
+        pxNewQueue->uxCeilingPriority = queueNO_CEILING_PRIORITY;
+    }
+    #endif
+
+    ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+    {
+        pxNewQueue->ucQueueType = ucQueueType;
+    }
+    #endif /* configUSE_TRACE_FACILITY */
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        pxNewQueue->pxQueueSetContainer = NULL;
+
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+        {
+            pxNewQueue->pxNextReadyMember = NULL;
+        }
+        #endif
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+    {
+        pxNewQueue->xAsyncWaitingToSend = NULL;
+        pxNewQueue->xAsyncWaitingToReceive = NULL;
+    }
+    #endif /* configUSE_ASYNC_COROUTINES */
+
+    #if ( configUSE_QUEUE_WORD_COPY == 1 )
+    {
+        /* Only the item sizes prvCopyItem() has a constant size copy for
+         * are marked.  The copies are correct at any alignment. */
+        if( ( uxItemSize == ( UBaseType_t ) 4U ) ||
+            ( uxItemSize == ( UBaseType_t ) 8U ) ||
+            ( uxItemSize == ( UBaseType_t ) 16U ) )
+        {
+            pxNewQueue->ucItemCopy = ( uint8_t ) ( uxItemSize / ( UBaseType_t ) sizeof( uint32_t ) );
+        }
+        else
+        {
+            pxNewQueue->ucItemCopy = queueCOPY_GENERIC;
+        }
+    }
+    #endif /* configUSE_QUEUE_WORD_COPY */
+
+    traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static void prvInitialiseMutex( Queue_t * pxNewQueue )
+    {
+        if( pxNewQueue != NULL )
+        {
+            /* The queue create function will set all the queue structure members
+            * correctly for a generic queue, but this function is creating a
+            * mutex.  Overwrite those members that need to be set differently -
+            * in particular the information required for priority inheritance. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+            /* In case this is a recursive mutex. */
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+
+            #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+            {
+                pxNewQueue->ulSpinEstimate = 0U;
+            }
+            #endif
 
             traceCREATE_MUTEX( pxNewQueue );
 
@@ -687,6 +1430,69 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateCeilingMutex( uxCeilingPriority );
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, queueQUEUE_TYPE_CEILING_MUTEX );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCeilingMutex( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateCeilingMutexStatic( uxCeilingPriority, pxStaticQueue );
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, queueQUEUE_TYPE_CEILING_MUTEX );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCeilingMutexStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -885,6 +1691,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             if( xHandle != NULL )
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+                queueSTATS_UPDATE_HIGH_WATER_MARK( ( Queue_t * ) xHandle );
 
                 traceCREATE_COUNTING_SEMAPHORE();
             }
@@ -924,6 +1731,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             if( xHandle != NULL )
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+                queueSTATS_UPDATE_HIGH_WATER_MARK( ( Queue_t * ) xHandle );
 
                 traceCREATE_COUNTING_SEMAPHORE();
             }
@@ -955,6 +1763,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
     traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
 
     configASSERT( pxQueue );
@@ -966,15 +1778,39 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    {
+        /* Give a binary or counting semaphore that no task is waiting for
+         * without entering a critical section. */
+        if( ( pxQueue->uxItemSize == ( UBaseType_t ) 0 ) && ( xCopyPosition == queueSEND_TO_BACK ) )
+        {
+            if( prvSemaphoreFastGive( pxQueue ) != pdFALSE )
+            {
+                traceRETURN_xQueueGenericSend( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
+
     for( ; ; )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
             /* Is there room on the queue now?  The running task must be the
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE ) ) || ( xCopyPosition == queueOVERWRITE ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -984,6 +1820,18 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
+                    #if ( portUSING_GRANULAR_LOCKS == 1 )
+                        if( pxQueue->cTxLock != queueUNLOCKED )
+                        {
+                            const int8_t cTxLock = pxQueue->cTxLock;
+
+                            /* Another core has the queue locked, so record that
+                             * data was posted as an ISR would.  The event is
+                             * processed when the queue is unlocked. */
+                            prvIncrementQueueTxLock( pxQueue, cTxLock );
+                        }
+                        else
+                    #endif
                     if( pxQueue->pxQueueSetContainer != NULL )
                     {
                         if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
@@ -1011,7 +1859,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                          * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
                                  * our own so yield immediately.  Yes it is ok to
@@ -1044,9 +1892,21 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     /* If there was a task waiting for data to arrive on the
                      * queue then unblock it now. */
+                    #if ( portUSING_GRANULAR_LOCKS == 1 )
+                        if( pxQueue->cTxLock != queueUNLOCKED )
+                        {
+                            const int8_t cTxLock = pxQueue->cTxLock;
+
+                            /* Another core has the queue locked, so record that
+                             * data was posted as an ISR would.  The event is
+                             * processed when the queue is unlocked. */
+                            prvIncrementQueueTxLock( pxQueue, cTxLock );
+                        }
+                        else
+                    #endif
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
                              * our own so yield immediately.  Yes it is ok to do
@@ -1074,7 +1934,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
 
-                taskEXIT_CRITICAL();
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedSending, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE );
 
                 traceRETURN_xQueueGenericSend( pdPASS );
 
@@ -1086,7 +1949,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 {
                     /* The queue was full and no block time is specified (or
                      * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+                    queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
+                    queueEXIT_CRITICAL( pxQueue );
 
                     /* Return to the original privilege level before exiting
                      * the function. */
@@ -1099,8 +1963,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 {
                     /* The queue was full and a block time was specified so
                      * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulSendsBlocked, xWaitStartTick );
                 }
                 else
                 {
@@ -1109,7 +1974,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
         /* Interrupts and other tasks can send to and receive from the queue
          * now the critical section has been exited. */
@@ -1123,7 +1988,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                queuePLACE_ON_SEND_EVENT_LIST( pxQueue, xTicksToWait );
 
                 /* Unlocking the queue means queue events can effect the
                  * event list. It is possible that interrupts occurring now
@@ -1155,6 +2020,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
+            queueSTATS_SEND_TIMED_OUT( pxQueue, xWaitStartTick );
             traceQUEUE_SEND_FAILED( pxQueue );
             traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
@@ -1202,9 +2068,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE ) ) || ( xCopyPosition == queueOVERWRITE ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1256,7 +2122,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1284,7 +2150,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 {
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1324,10 +2190,20 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
         else
         {
             traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
             xReturn = errQUEUE_FULL;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    if( xReturn == pdPASS )
+    {
+        queueWAKE_ASYNC_WAITERS_FROM_ISR( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
     traceRETURN_xQueueGenericSendFromISR( xReturn );
 
@@ -1378,7 +2254,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1398,6 +2274,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * priority disinheritance is needed.  Simply increase the count of
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+            queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue );
 
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
@@ -1430,7 +2307,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1458,7 +2335,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 {
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1495,10 +2372,20 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
         else
         {
             traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
             xReturn = errQUEUE_FULL;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    if( xReturn == pdPASS )
+    {
+        queueWAKE_ASYNC_WAITERS_FROM_ISR( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
     traceRETURN_xQueueGiveFromISR( xReturn );
 
@@ -1514,6 +2401,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
     traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
     /* Check the pointer is not NULL. */
@@ -1532,13 +2423,13 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
     for( ; ; )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueITEM_ON_LOAN( pxQueue ) == pdFALSE ) )
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
@@ -1548,9 +2439,21 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
                  * task. */
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                    if( pxQueue->cRxLock != queueUNLOCKED )
+                    {
+                        const int8_t cRxLock = pxQueue->cRxLock;
+
+                        /* Another core has the queue locked, so record that
+                         * data was removed as an ISR would.  The event is
+                         * processed when the queue is unlocked. */
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                    else
+                #endif
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1564,7 +2467,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                taskEXIT_CRITICAL();
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedReceiving, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
 
                 traceRETURN_xQueueReceive( pdPASS );
 
@@ -1576,7 +2482,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 {
                     /* The queue was empty and no block time is specified (or
                      * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+                    queueEXIT_CRITICAL( pxQueue );
 
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
                     traceRETURN_xQueueReceive( errQUEUE_EMPTY );
@@ -1587,8 +2493,9 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 {
                     /* The queue was empty and a block time was specified so
                      * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulReceivesBlocked, xWaitStartTick );
                 }
                 else
                 {
@@ -1597,7 +2504,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
         /* Interrupts and other tasks can send to and receive from the queue
          * now the critical section has been exited. */
@@ -1613,7 +2520,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1642,6 +2549,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick );
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
@@ -1663,10 +2571,18 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
     #if ( configUSE_MUTEXES == 1 )
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        BaseType_t xHasSpun = pdFALSE;
+    #endif
+
     traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
 
     /* Check the queue pointer is not NULL. */
@@ -1683,11 +2599,28 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     }
     #endif
 
-    for( ; ; )
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
     {
-        taskENTER_CRITICAL();
+        /* Take a binary or counting semaphore that is available without
+         * entering a critical section. */
+        if( prvSemaphoreFastTake( pxQueue ) != pdFALSE )
         {
-            /* Semaphores are queues with an item size of 0, and where the
+            traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Semaphores are queues with an item size of 0, and where the
              * number of messages in the queue is the semaphore's count value. */
             const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
 
@@ -1708,6 +2641,21 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                        {
+                            /* A priority ceiling mutex raises its holder to the
+                             * ceiling straight away instead. */
+                            if( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
                     }
                     else
                     {
@@ -1718,9 +2666,21 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 /* Check to see if other tasks are blocked waiting to give the
                  * semaphore, and if so, unblock the highest priority such task. */
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                    if( pxQueue->cRxLock != queueUNLOCKED )
+                    {
+                        const int8_t cRxLock = pxQueue->cRxLock;
+
+                        /* Another core has the queue locked, so record that
+                         * data was removed as an ISR would.  The event is
+                         * processed when the queue is unlocked. */
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                    else
+                #endif
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         queueYIELD_IF_USING_PREEMPTION();
                     }
@@ -1734,7 +2694,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                taskEXIT_CRITICAL();
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedReceiving, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
 
                 traceRETURN_xQueueSemaphoreTake( pdPASS );
 
@@ -1746,7 +2709,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     /* The semaphore count was 0 and no block time is specified
                      * (or the block time has expired) so exit now. */
-                    taskEXIT_CRITICAL();
+                    queueEXIT_CRITICAL( pxQueue );
 
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
                     traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
@@ -1757,8 +2720,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     /* The semaphore count was 0 and a block time was specified
                      * so configure the timeout structure ready to block. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulReceivesBlocked, xWaitStartTick );
                 }
                 else
                 {
@@ -1767,7 +2731,34 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
+
+        #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        {
+            /* If the mutex holder is running on another core it may give the
+             * mutex back sooner than this task could block and be unblocked
+             * again, so spin for a while first.  Only spin once per call so
+             * the block time is still honoured. */
+            if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xHasSpun == pdFALSE ) )
+            {
+                xHasSpun = pdTRUE;
+
+                if( prvSpinWhileMutexHolderRuns( pxQueue ) != pdFALSE )
+                {
+                    /* The mutex was given back, so try to take it again. */
+                    continue;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_ADAPTIVE_MUTEXES */
 
         /* Interrupts and other tasks can give to and take from the semaphore
          * now the critical section has been exited. */
@@ -1788,11 +2779,32 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
+                    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                        if( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY )
+                        {
+                            /* The holder of a priority ceiling mutex already
+                             * runs at the ceiling, so there is nothing to
+                             * inherit.  Transitive priority inheritance stops
+                             * here too, as lowering a holder's priority along a
+                             * chain could take it below the ceiling. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else
+                    #endif
                     if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
                     {
                         taskENTER_CRITICAL();
                         {
                             xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+                            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                            {
+                                /* Let tasks that later block on a mutex this
+                                 * task holds pass their priority on to the
+                                 * holder of this mutex too. */
+                                vTaskSetBlockingMutexHolder( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+                            }
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1803,7 +2815,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1814,6 +2826,19 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        vTaskSetBlockingMutexHolder( NULL );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
             }
             else
             {
@@ -1867,6 +2892,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_MUTEXES */
 
+                queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick );
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
 
@@ -1890,6 +2916,10 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
     int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
     traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
 
     /* The buffer into which data is received can only be NULL if the data size
@@ -1905,7 +2935,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
     for( ; ; )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1913,22 +2943,45 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                #if ( configUSE_PRIORITY_QUEUES == 1 )
+                    if( pxQueue->pxPriorityHeap != NULL )
+                    {
+                        prvPeekPriorityItem( pxQueue, pvBuffer );
+                    }
+                    else
+                #endif
+                {
+                    /* Remember the read position so it can be reset after the
+                     * data is read from the queue as this function is only
+                     * peeking the data, not removing it. */
+                    pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
 
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
+                    prvCopyDataFromQueue( pxQueue, pvBuffer );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                    /* The data is not being removed, so reset the read
+                     * pointer. */
+                    pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                }
+
+                traceQUEUE_PEEK( pxQueue );
 
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
+                #if ( portUSING_GRANULAR_LOCKS == 1 )
+                    if( pxQueue->cTxLock != queueUNLOCKED )
+                    {
+                        const int8_t cTxLock = pxQueue->cTxLock;
+
+                        /* Another core has the queue locked, so record that
+                         * data is available as an ISR would.  The event is
+                         * processed when the queue is unlocked. */
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    }
+                    else
+                #endif
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than this task. */
                         queueYIELD_IF_USING_PREEMPTION();
@@ -1943,7 +2996,8 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                taskEXIT_CRITICAL();
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedReceiving, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
 
                 traceRETURN_xQueuePeek( pdPASS );
 
@@ -1955,7 +3009,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                 {
                     /* The queue was empty and no block time is specified (or
                      * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+                    queueEXIT_CRITICAL( pxQueue );
 
                     traceQUEUE_PEEK_FAILED( pxQueue );
                     traceRETURN_xQueuePeek( errQUEUE_EMPTY );
@@ -1967,8 +3021,9 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                     /* The queue was empty and a block time was specified so
                      * configure the timeout structure ready to enter the blocked
                      * state. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulReceivesBlocked, xWaitStartTick );
                 }
                 else
                 {
@@ -1977,7 +3032,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
         /* Interrupts and other tasks can send to and receive from the queue
          * now that the critical section has been exited. */
@@ -1993,7 +3048,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -2022,6 +3077,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick );
                 traceQUEUE_PEEK_FAILED( pxQueue );
                 traceRETURN_xQueuePeek( errQUEUE_EMPTY );
 
@@ -2068,12 +3124,12 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueITEM_ON_LOAN( pxQueue ) == pdFALSE ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2090,7 +3146,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             {
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than us so
                          * force a context switch. */
@@ -2128,7 +3184,16 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    if( xReturn == pdPASS )
+    {
+        queueWAKE_ASYNC_WAITERS_FROM_ISR( &( pxQueue->xAsyncWaitingToSend ), pdFALSE, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
     traceRETURN_xQueueReceiveFromISR( xReturn );
 
@@ -2168,18 +3233,27 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
         /* Cannot block in an ISR, so check there is data available. */
         if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
         {
             traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+                if( pxQueue->pxPriorityHeap != NULL )
+                {
+                    prvPeekPriorityItem( pxQueue, pvBuffer );
+                }
+                else
+            #endif
+            {
+                /* Remember the read position so it can be reset as nothing is
+                 * actually being removed from the queue. */
+                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            }
 
             xReturn = pdPASS;
         }
@@ -2189,7 +3263,7 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
             traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
 
     traceRETURN_xQueuePeekFromISR( xReturn );
 
@@ -2197,264 +3271,2052 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    traceENTER_uxQueueMessagesWaiting( xQueue );
-
-    configASSERT( xQueue );
+#if ( configUSE_QUEUE_LOANS == 1 )
 
-    portBASE_TYPE_ENTER_CRITICAL();
+    BaseType_t xQueueAcquireSendSlot( QueueHandle_t xQueue,
+                                      void ** ppvSlot,
+                                      TickType_t xTicksToWait )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    portBASE_TYPE_EXIT_CRITICAL();
-
-    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+        #if ( configUSE_QUEUE_STATS == 1 )
+            TickType_t xWaitStartTick = 0;
+        #endif
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        traceENTER_xQueueAcquireSendSlot( xQueue, ppvSlot, xTicksToWait );
 
-    traceENTER_uxQueueSpacesAvailable( xQueue );
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
 
-    configASSERT( pxQueue );
+        /* Semaphores and mutexes have no storage to lend. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    portBASE_TYPE_ENTER_CRITICAL();
-    {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
-    }
-    portBASE_TYPE_EXIT_CRITICAL();
+        /* The storage of a priority queue is not used in FIFO order. */
+        configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
 
-    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* Is there a free slot that is not already on loan?  Only one
+                 * send slot can be on loan at a time as the next slot is not
+                 * known until the current one has been committed. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE ) )
+                {
+                    pxQueue->ucLoans |= queueLOANED_SEND_SLOT;
+                    *ppvSlot = ( void * ) pxQueue->pcWriteTo;
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+                    queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedSending, xEntryTimeSet, xWaitStartTick );
+                    queueEXIT_CRITICAL( pxQueue );
 
-    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+                    traceRETURN_xQueueAcquireSendSlot( pdPASS );
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
+                        queueEXIT_CRITICAL( pxQueue );
 
-    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueAcquireSendSlot( errQUEUE_FULL );
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        queueSET_TIME_OUT_STATE( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                        queueSTATS_WAIT_STARTED( pxQueue, ulSendsBlocked, xWaitStartTick );
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
 
-    traceENTER_vQueueDelete( xQueue );
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    queuePLACE_ON_SEND_EVENT_LIST( pxQueue, xTicksToWait );
+                    prvUnlockQueue( pxQueue );
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+                queueSTATS_SEND_TIMED_OUT( pxQueue, xWaitStartTick );
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueAcquireSendSlot( errQUEUE_FULL );
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-        {
-            vPortFree( pxQueue );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+                return errQUEUE_FULL;
+            }
         }
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-
-    traceRETURN_vQueueDelete();
-}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    BaseType_t xQueueCommitSendSlot( QueueHandle_t xQueue )
     {
-        traceENTER_uxQueueGetQueueNumber( xQueue );
+        BaseType_t xReturn, xYieldRequired;
+        BaseType_t xSpaceRemains = pdFALSE;
+        Queue_t * const pxQueue = xQueue;
 
-        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+        traceENTER_xQueueCommitSendSlot( xQueue );
 
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+        configASSERT( pxQueue );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( queueSEND_SLOT_ON_LOAN( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_SEND( pxQueue );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                /* The item is already in place, so posting it is just a
+                 * matter of moving the write position past it. */
+                pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
-    {
-        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+                if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+                {
+                    pxQueue->pcWriteTo = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue );
+                pxQueue->ucLoans = ( uint8_t ) ( pxQueue->ucLoans & ~queueLOANED_SEND_SLOT );
 
-        traceRETURN_vQueueSetQueueNumber();
-    }
+                xYieldRequired = prvUnblockWaitingReceivers( pxQueue, ( UBaseType_t ) 1 );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+                /* Other senders saw the queue as full while the slot was on
+                 * loan, so let one of them try again if there is still space. */
+                if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+                {
+                    xSpaceRemains = pdTRUE;
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                    if( prvUnblockWaitingSenders( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-    {
-        traceENTER_ucQueueGetQueueType( xQueue );
+                if( xYieldRequired != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        if( xReturn == pdPASS )
+        {
+            queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE );
+
+            if( xSpaceRemains != pdFALSE )
+            {
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCommitSendSlot( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueCancelSendSlot( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueCancelSendSlot( xQueue );
+
+        configASSERT( pxQueue );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            configASSERT( queueSEND_SLOT_ON_LOAN( pxQueue ) != pdFALSE );
+
+            /* Nothing was posted, but the slot is free for another sender. */
+            pxQueue->ucLoans = ( uint8_t ) ( pxQueue->ucLoans & ~queueLOANED_SEND_SLOT );
+
+            if( prvUnblockWaitingSenders( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
+
+        traceRETURN_vQueueCancelSendSlot();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueBorrowItem( QueueHandle_t xQueue,
+                                 void ** ppvItem,
+                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        #if ( configUSE_QUEUE_STATS == 1 )
+            TickType_t xWaitStartTick = 0;
+        #endif
+
+        traceENTER_xQueueBorrowItem( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+
+        /* Semaphores and mutexes have no storage to lend. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* The storage of a priority queue is not used in FIFO order. */
+        configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* Is there an item that is not already on loan?  The item
+                 * stays in the queue until it is released, so other readers
+                 * see the queue as empty until then. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueITEM_ON_LOAN( pxQueue ) == pdFALSE ) )
+                {
+                    int8_t * pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail )
+                    {
+                        pcItem = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxQueue->ucLoans |= queueLOANED_ITEM;
+                    *ppvItem = ( void * ) pcItem;
+
+                    queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedReceiving, xEntryTimeSet, xWaitStartTick );
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueueBorrowItem( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueBorrowItem( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        queueSET_TIME_OUT_STATE( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                        queueSTATS_WAIT_STARTED( pxQueue, ulReceivesBlocked, xWaitStartTick );
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is still no item to borrow exit,
+                 * otherwise loop back and attempt to borrow it. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueBorrowItem( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueReleaseItem( QueueHandle_t xQueue )
+    {
+        UBaseType_t uxMessagesWaiting;
+        BaseType_t xYieldRequired;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueReleaseItem( xQueue );
+
+        configASSERT( pxQueue );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            configASSERT( queueITEM_ON_LOAN( pxQueue ) != pdFALSE );
+
+            /* The item was read in place, so receiving it is just a matter of
+             * moving the read position onto it. */
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceQUEUE_RECEIVE( pxQueue );
+            uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting;
+            pxQueue->ucLoans = ( uint8_t ) ( pxQueue->ucLoans & ~queueLOANED_ITEM );
+
+            xYieldRequired = prvUnblockWaitingSenders( pxQueue, ( UBaseType_t ) 1 );
+
+            /* Other readers saw the queue as empty while the item was on
+             * loan, so let one of them try again if items remain.  A queue set
+             * was already notified of those items when they were sent. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                    if( pxQueue->pxQueueSetContainer == NULL )
+                #endif
+                {
+                    if( prvUnblockWaitingReceivers( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
+
+        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vQueueReleaseItem();
+    }
+
+#endif /* configUSE_QUEUE_LOANS */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingSenders( Queue_t * const pxQueue,
+                                            UBaseType_t uxCount )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        if( pxQueue->cRxLock != queueUNLOCKED )
+        {
+            /* Another core has the queue locked, so record that space became
+             * available as an ISR would.  The event is processed when the
+             * queue is unlocked. */
+            while( uxCount > ( UBaseType_t ) 0 )
+            {
+                const int8_t cRxLock = pxQueue->cRxLock;
+
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+                uxCount--;
+            }
+        }
+        else
+    #endif
+    {
+        while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+        {
+            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxCount--;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingReceivers( Queue_t * const pxQueue,
+                                              UBaseType_t uxCount )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        if( pxQueue->cTxLock != queueUNLOCKED )
+        {
+            /* Another core has the queue locked, so record that data became
+             * available as an ISR would.  The event is processed when the
+             * queue is unlocked. */
+            while( uxCount > ( UBaseType_t ) 0 )
+            {
+                const int8_t cTxLock = pxQueue->cTxLock;
+
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                uxCount--;
+            }
+        }
+        else
+    #endif
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if( pxQueue->pxQueueSetContainer != NULL )
+        {
+            /* The queue set holds one entry per item in the queue. */
+            while( uxCount > ( UBaseType_t ) 0 )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxCount--;
+            }
+        }
+        else
+    #endif
+    {
+        while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxCount--;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSpaces, uxItemsSent;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
+    traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+
+    /* Semaphores and mutexes must be given one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* The messages of a priority queue are not stored in FIFO order. */
+    configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE )
+            {
+                uxSpaces = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+            }
+            else
+            {
+                uxSpaces = ( UBaseType_t ) 0U;
+            }
+
+            /* Is there room for at least one item?  As many items as will fit
+             * are posted together, and the waiting tasks are then unblocked
+             * with a single decision on whether to yield. */
+            if( uxSpaces > ( UBaseType_t ) 0U )
+            {
+                uxItemsSent = ( uxItemCount < uxSpaces ) ? uxItemCount : uxSpaces;
+
+                prvCopyItemsToQueue( pxQueue, pvItemsToQueue, uxItemsSent );
+                traceQUEUE_SEND( pxQueue );
+
+                if( prvUnblockWaitingReceivers( pxQueue, uxItemsSent ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedSending, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToReceive ), ( uxItemsSent > ( UBaseType_t ) 1U ) ? pdTRUE : pdFALSE );
+
+                traceRETURN_uxQueueSendMultiple( uxItemsSent );
+
+                return uxItemsSent;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    traceRETURN_uxQueueSendMultiple( 0 );
+
+                    return ( UBaseType_t ) 0U;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulSendsBlocked, xWaitStartTick );
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                queuePLACE_ON_SEND_EVENT_LIST( pxQueue, xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            queueSTATS_SEND_TIMED_OUT( pxQueue, xWaitStartTick );
+            traceQUEUE_SEND_FAILED( pxQueue );
+            traceRETURN_uxQueueSendMultiple( 0 );
+
+            return ( UBaseType_t ) 0U;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSpaces, uxItemsSent;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* The messages of a priority queue are not stored in FIFO order. */
+    configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        if( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE )
+        {
+            uxSpaces = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+        }
+        else
+        {
+            uxSpaces = ( UBaseType_t ) 0U;
+        }
+
+        if( uxSpaces > ( UBaseType_t ) 0U )
+        {
+            uxItemsSent = ( uxItemCount < uxSpaces ) ? uxItemCount : uxSpaces;
+
+            prvCopyItemsToQueue( pxQueue, pvItemsToQueue, uxItemsSent );
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( pxQueue->cTxLock == queueUNLOCKED )
+            {
+                if( prvUnblockWaitingReceivers( pxQueue, uxItemsSent ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxCount;
+
+                /* Increment the lock count once per item so the task that
+                 * unlocks the queue knows how many tasks to unblock. */
+                for( uxCount = ( UBaseType_t ) 0U; uxCount < uxItemsSent; uxCount++ )
+                {
+                    const int8_t cTxLock = pxQueue->cTxLock;
+
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueSTATS_INCREMENT( pxQueue, ulSendsFailedFull );
+            uxItemsSent = ( UBaseType_t ) 0U;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    if( uxItemsSent > ( UBaseType_t ) 0U )
+    {
+        queueWAKE_ASYNC_WAITERS_FROM_ISR( &( pxQueue->xAsyncWaitingToReceive ), ( uxItemsSent > ( UBaseType_t ) 1U ) ? pdTRUE : pdFALSE, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_uxQueueSendMultipleFromISR( uxItemsSent );
+
+    return uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxAvailable, uxItemsReceived;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xWaitStartTick = 0;
+    #endif
+
+    traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0U );
+
+    /* Semaphores and mutexes must be taken one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* The messages of a priority queue are not stored in FIFO order. */
+    configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( queueITEM_ON_LOAN( pxQueue ) == pdFALSE )
+            {
+                uxAvailable = pxQueue->uxMessagesWaiting;
+            }
+            else
+            {
+                uxAvailable = ( UBaseType_t ) 0U;
+            }
+
+            /* Is there at least one item in the queue?  As many items as are
+             * available are removed together, and the waiting tasks are then
+             * unblocked with a single decision on whether to yield. */
+            if( uxAvailable > ( UBaseType_t ) 0U )
+            {
+                uxItemsReceived = ( uxMaxItems < uxAvailable ) ? uxMaxItems : uxAvailable;
+
+                prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemsReceived );
+                traceQUEUE_RECEIVE( pxQueue );
+
+                if( prvUnblockWaitingSenders( pxQueue, uxItemsReceived ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueSTATS_WAIT_ENDED( pxQueue, ulTicksBlockedReceiving, xEntryTimeSet, xWaitStartTick );
+                queueEXIT_CRITICAL( pxQueue );
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), ( uxItemsReceived > ( UBaseType_t ) 1U ) ? pdTRUE : pdFALSE );
+
+                traceRETURN_uxQueueReceiveMultiple( uxItemsReceived );
+
+                return uxItemsReceived;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_uxQueueReceiveMultiple( 0 );
+
+                    return ( UBaseType_t ) 0U;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    queueSET_TIME_OUT_STATE( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                    queueSTATS_WAIT_STARTED( pxQueue, ulReceivesBlocked, xWaitStartTick );
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueue, xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read
+                 * the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise
+             * loop back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                queueSTATS_RECEIVE_TIMED_OUT( pxQueue, xWaitStartTick );
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_uxQueueReceiveMultiple( 0 );
+
+                return ( UBaseType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxMaxItems,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxAvailable, uxItemsReceived;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* The messages of a priority queue are not stored in FIFO order. */
+    configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        if( queueITEM_ON_LOAN( pxQueue ) == pdFALSE )
+        {
+            uxAvailable = pxQueue->uxMessagesWaiting;
+        }
+        else
+        {
+            uxAvailable = ( UBaseType_t ) 0U;
+        }
+
+        if( uxAvailable > ( UBaseType_t ) 0U )
+        {
+            uxItemsReceived = ( uxMaxItems < uxAvailable ) ? uxMaxItems : uxAvailable;
+
+            prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemsReceived );
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that ISRs have removed data while the queue was
+             * locked. */
+            if( pxQueue->cRxLock == queueUNLOCKED )
+            {
+                if( prvUnblockWaitingSenders( pxQueue, uxItemsReceived ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxCount;
+
+                for( uxCount = ( UBaseType_t ) 0U; uxCount < uxItemsReceived; uxCount++ )
+                {
+                    const int8_t cRxLock = pxQueue->cRxLock;
+
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            uxItemsReceived = ( UBaseType_t ) 0U;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    if( uxItemsReceived > ( UBaseType_t ) 0U )
+    {
+        queueWAKE_ASYNC_WAITERS_FROM_ISR( &( pxQueue->xAsyncWaitingToSend ), ( uxItemsReceived > ( UBaseType_t ) 1U ) ? pdTRUE : pdFALSE, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_uxQueueReceiveMultipleFromISR( uxItemsReceived );
+
+    return uxItemsReceived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    traceENTER_uxQueueMessagesWaiting( xQueue );
+
+    configASSERT( xQueue );
+
+    portBASE_TYPE_ENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    portBASE_TYPE_EXIT_CRITICAL();
+
+    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueSpacesAvailable( xQueue );
+
+    configASSERT( pxQueue );
+
+    portBASE_TYPE_ENTER_CRITICAL();
+    {
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+        {
+            /* The message count of a queue set is the number of members in
+             * its ready list, which can exceed the set's length of one.
+             * Nothing can be sent to a set in any case. */
+            if( pxQueue->uxMessagesWaiting > pxQueue->uxLength )
+            {
+                uxReturn = ( UBaseType_t ) 0;
+            }
+            else
+            {
+                uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+            }
+        }
+        #else
+        {
+            uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+        }
+        #endif
+
+        #if ( configUSE_QUEUE_LOANS == 1 )
+        {
+            /* A send slot on loan is not available to other senders. */
+            if( queueSEND_SLOT_ON_LOAN( pxQueue ) != pdFALSE )
+            {
+                uxReturn--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+    }
+    portBASE_TYPE_EXIT_CRITICAL();
+
+    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_vQueueDelete( xQueue );
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+    traceRETURN_vQueueDelete();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        traceENTER_uxQueueGetQueueNumber( xQueue );
+
+        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+
+        traceRETURN_vQueueSetQueueNumber();
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        traceENTER_ucQueueGetQueueType( xQueue );
+
+        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueItemSize( xQueue );
+
+    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+
+    return ( ( Queue_t * ) xQueue )->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueLength( xQueue );
+
+    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+
+    return ( ( Queue_t * ) xQueue )->uxLength;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+
+    AsyncWaitList_t * pxQueueGetAsyncWaitList( QueueHandle_t xQueue,
+                                               BaseType_t xWaitingToSend ) /* PRIVILEGED_FUNCTION */
+    {
+        Queue_t * const pxQueue = xQueue;
+        AsyncWaitList_t * pxReturn;
+
+        traceENTER_pxQueueGetAsyncWaitList( xQueue, xWaitingToSend );
+
+        configASSERT( pxQueue );
+
+        if( xWaitingToSend != pdFALSE )
+        {
+            pxReturn = &( pxQueue->xAsyncWaitingToSend );
+        }
+        else
+        {
+            pxReturn = &( pxQueue->xAsyncWaitingToReceive );
+        }
+
+        traceRETURN_pxQueueGetAsyncWaitList( pxReturn );
+
+        return pxReturn;
+    }
+
+#endif /* configUSE_ASYNC_COROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetHighestPriorityOfWaitToReceiveList( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
+
+    /* This function is called from a critical section. */
+
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held. */
+                #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                    if( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY )
+                    {
+                        xReturn = xTaskPriorityRestoreAfterCeiling( pxQueue->u.xSemaphore.xMutexHolder );
+                    }
+                    else
+                #endif
+                {
+                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                }
+
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( pxQueue->pxPriorityHeap != NULL )
+        {
+            prvPushPriorityItem( pxQueue, pvItemToQueue, xPosition );
+        }
+    #endif
+    else if( xPosition == queueSEND_TO_BACK )
+    {
+        queueCOPY_ITEM( pxQueue, ( void * ) pxQueue->pcWriteTo, pvItemToQueue );
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        #if ( configUSE_QUEUE_LOANS == 1 )
+        {
+            /* Writing to the front of the queue would move the item on loan
+             * and could overwrite the send slot on loan. */
+            configASSERT( pxQueue->ucLoans == 0U );
+        }
+        #endif
+
+        /* Only priority queues accept a message priority. */
+        configASSERT( xPosition <= queueOVERWRITE );
+
+        queueCOPY_ITEM( pxQueue, ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue );
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+    queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( pxQueue->pxPriorityHeap != NULL )
+        {
+            prvPopPriorityItem( pxQueue, pvBuffer );
+        }
+    #endif
+    else
+    {
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        queueCOPY_ITEM( pxQueue, ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const void * pvItems,
+                                 const UBaseType_t uxItemCount )
+{
+    const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    const size_t xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    /* This function is called from a critical section. */
+
+    if( xBytes < xBytesToTail )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xBytes );
+        pxQueue->pcWriteTo += xBytes;
+    }
+    else
+    {
+        /* The items reach the end of the storage area, so the remainder go
+         * at the start. */
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xBytesToTail );
+        ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( ( ( const uint8_t * ) pvItems )[ xBytesToTail ] ), xBytes - xBytesToTail );
+        pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToTail );
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxItemCount );
+    queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxItemCount )
+{
+    const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+    size_t xBytesToTail;
+
+    /* This function is called from a critical section.  pcReadFrom points to
+     * the last item read, so the first item to copy is the one after it. */
+
+    if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+    {
+        pcReadFrom = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+    if( xBytes <= xBytesToTail )
+    {
+        ( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xBytes );
+        pcReadFrom += xBytes;
+    }
+    else
+    {
+        /* The items wrap past the end of the storage area. */
+        ( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xBytesToTail );
+        ( void ) memcpy( ( void * ) &( ( ( uint8_t * ) pvBuffer )[ xBytesToTail ] ), ( void * ) pxQueue->pcHead, xBytes - xBytesToTail );
+        pcReadFrom = pxQueue->pcHead + ( xBytes - xBytesToTail );
+    }
+
+    pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxItemCount );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
+
+    static void prvCopyItem( const Queue_t * const pxQueue,
+                             void * const pvDestination,
+                             const void * const pvSource )
+    {
+        /* Each case passes memcpy() a constant size so the compiler can
+         * replace the call with inline loads and stores that suit the
+         * alignment the target allows, without accessing the caller's buffer
+         * through a pointer of a different type. */
+        if( pxQueue->ucItemCopy == ( uint8_t ) 1U )
+        {
+            ( void ) memcpy( pvDestination, pvSource, 4U );
+        }
+        else if( pxQueue->ucItemCopy == ( uint8_t ) 2U )
+        {
+            ( void ) memcpy( pvDestination, pvSource, 8U );
+        }
+        else if( pxQueue->ucItemCopy == ( uint8_t ) 4U )
+        {
+            ( void ) memcpy( pvDestination, pvSource, 16U );
+        }
+        else
+        {
+            ( void ) memcpy( pvDestination, pvSource, ( size_t ) pxQueue->uxItemSize );
+        }
+    }
+
+#endif /* configUSE_QUEUE_WORD_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static BaseType_t prvPriorityNodeIsBefore( const QueuePriorityNode_t * const pxA,
+                                               const QueuePriorityNode_t * const pxB )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxA->ucPriority > pxB->ucPriority )
+        {
+            xReturn = pdTRUE;
+        }
+        else if( pxA->ucPriority == pxB->ucPriority )
+        {
+            /* Sequence numbers are compared as a signed difference so the
+             * order remains correct after ulNextSequence wraps. */
+            if( ( int32_t ) ( pxA->ulSequence - pxB->ulSequence ) < 0 )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPushPriorityItem( Queue_t * const pxQueue,
+                                     const void * pvItemToQueue,
+                                     const BaseType_t xPosition )
+    {
+        QueuePriorityNode_t * const pxHeap = pxQueue->pxPriorityHeap;
+        QueuePriorityNode_t xNewNode;
+        size_t xHole = ( size_t ) pxQueue->uxMessagesWaiting;
+        size_t xParent;
+
+        /* This function is called from a critical section.  Sending to the
+         * front of a priority queue, or overwriting it, is not supported. */
+        configASSERT( ( xPosition == queueSEND_TO_BACK ) || ( xPosition >= queueSEND_WITH_PRIORITY( 0U ) ) );
+        configASSERT( xPosition <= queueSEND_WITH_PRIORITY( queueMAX_MESSAGE_PRIORITY ) );
+
+        if( xPosition == queueSEND_TO_BACK )
+        {
+            xNewNode.ucPriority = 0U;
+        }
+        else
+        {
+            xNewNode.ucPriority = ( uint8_t ) ( xPosition - queueSEND_WITH_PRIORITY( 0U ) );
+        }
+
+        /* The nodes past the end of the heap hold the free storage slots, so
+         * the slot recorded in the first unused node is free. */
+        xNewNode.uxSlot = pxHeap[ xHole ].uxSlot;
+        xNewNode.ulSequence = pxQueue->ulNextSequence;
+        pxQueue->ulNextSequence++;
+
+        queueCOPY_ITEM( pxQueue, ( void * ) ( pxQueue->pcHead + ( ( size_t ) xNewNode.uxSlot * ( size_t ) pxQueue->uxItemSize ) ), pvItemToQueue );
+
+        /* Move the hole up until its parent is received before the new
+         * message.  As the new message has the highest sequence number it
+         * never moves above a message of the same priority. */
+        while( xHole > ( size_t ) 0 )
+        {
+            xParent = ( xHole - ( size_t ) 1 ) / ( size_t ) 2;
+
+            if( prvPriorityNodeIsBefore( &xNewNode, &( pxHeap[ xParent ] ) ) == pdFALSE )
+            {
+                break;
+            }
+
+            pxHeap[ xHole ] = pxHeap[ xParent ];
+            xHole = xParent;
+        }
+
+        pxHeap[ xHole ] = xNewNode;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPopPriorityItem( Queue_t * const pxQueue,
+                                    void * const pvBuffer )
+    {
+        QueuePriorityNode_t * const pxHeap = pxQueue->pxPriorityHeap;
+        const size_t xLast = ( size_t ) pxQueue->uxMessagesWaiting - ( size_t ) 1;
+        const UBaseType_t uxFreedSlot = pxHeap[ 0 ].uxSlot;
+        const QueuePriorityNode_t xLastNode = pxHeap[ xLast ];
+        size_t xHole = 0;
+        size_t xChild;
+
+        /* This function is called from a critical section, and only when the
+         * queue is not empty. */
+        queueCOPY_ITEM( pxQueue, pvBuffer, ( void * ) ( pxQueue->pcHead + ( ( size_t ) uxFreedSlot * ( size_t ) pxQueue->uxItemSize ) ) );
+
+        /* Move the hole left by the received message down until the last
+         * node can be placed in it without breaking the heap order. */
+        for( ; ; )
+        {
+            xChild = ( xHole * ( size_t ) 2 ) + ( size_t ) 1;
+
+            if( xChild >= xLast )
+            {
+                break;
+            }
+
+            if( ( ( xChild + ( size_t ) 1 ) < xLast ) && ( prvPriorityNodeIsBefore( &( pxHeap[ xChild + ( size_t ) 1 ] ), &( pxHeap[ xChild ] ) ) != pdFALSE ) )
+            {
+                xChild++;
+            }
+
+            if( prvPriorityNodeIsBefore( &( pxHeap[ xChild ] ), &xLastNode ) == pdFALSE )
+            {
+                break;
+            }
+
+            pxHeap[ xHole ] = pxHeap[ xChild ];
+            xHole = xChild;
+        }
+
+        pxHeap[ xHole ] = xLastNode;
+
+        /* The node that was last is now unused, so it records the freed
+         * slot. */
+        pxHeap[ xLast ].uxSlot = uxFreedSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPeekPriorityItem( const Queue_t * const pxQueue,
+                                     void * const pvBuffer )
+    {
+        const UBaseType_t uxSlot = pxQueue->pxPriorityHeap[ 0 ].uxSlot;
+
+        queueCOPY_ITEM( pxQueue, pvBuffer, ( void * ) ( pxQueue->pcHead + ( ( size_t ) uxSlot * ( size_t ) pxQueue->uxItemSize ) ) );
+    }
+/*-----------------------------------------------------------*/
 
-        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+    static void prvResetPriorityHeap( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxSlot;
 
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        for( uxSlot = ( UBaseType_t ) 0; uxSlot < pxQueue->uxLength; uxSlot++ )
+        {
+            pxQueue->pxPriorityHeap[ uxSlot ].uxSlot = uxSlot;
+        }
+
+        pxQueue->ulNextSequence = 0U;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_PRIORITY_QUEUES */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueItemSize( xQueue );
+#if ( configUSE_QUEUE_STATS == 1 )
 
-    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+    static void prvRecordTimeOut( Queue_t * const pxQueue,
+                                  const BaseType_t xIsSend,
+                                  const TickType_t xWaitStartTick )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            const uint32_t ulTicksWaited = ( uint32_t ) ( TickType_t ) ( xTaskGetTickCount() - xWaitStartTick );
 
-    return ( ( Queue_t * ) xQueue )->uxItemSize;
-}
+            if( xIsSend != pdFALSE )
+            {
+                pxQueue->xStats.ulTicksBlockedSending += ulTicksWaited;
+                pxQueue->xStats.ulSendsFailedFull++;
+            }
+            else
+            {
+                pxQueue->xStats.ulTicksBlockedReceiving += ulTicksWaited;
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+    }
+
+#endif /* configUSE_QUEUE_STATS */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueLength( xQueue );
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
 
-    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+    static BaseType_t prvSpinWhileMutexHolderRuns( Queue_t * const pxQueue )
+    {
+        BaseType_t xMutexAvailable = pdFALSE;
+        BaseType_t xHolderRunning = pdTRUE;
+        uint32_t ulSpinCount = 0U;
+        const uint32_t ulSpinEstimate = pxQueue->ulSpinEstimate;
+        uint32_t ulSpinLimit = ( ulSpinEstimate * 2U ) + queueMUTEX_MIN_SPINS;
 
-    return ( ( Queue_t * ) xQueue )->uxLength;
-}
-/*-----------------------------------------------------------*/
+        if( ulSpinLimit > ( uint32_t ) configADAPTIVE_MUTEX_MAX_SPINS )
+        {
+            ulSpinLimit = ( uint32_t ) configADAPTIVE_MUTEX_MAX_SPINS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-#if ( configUSE_MUTEXES == 1 )
+        while( ulSpinCount < ulSpinLimit )
+        {
+            if( ( ulSpinCount & ( queueMUTEX_HOLDER_CHECK_INTERVAL - 1U ) ) == 0U )
+            {
+                /* The holder's TCB belongs to another core, so is only read
+                 * with the TASK and ISR locks held.  The holder cannot then
+                 * switch in or out, give the mutex, or be deleted while its
+                 * state is read.  A kernel critical section is used even
+                 * when portUSING_GRANULAR_LOCKS is 1, as a data group
+                 * critical section would not take either lock.  A mutex
+                 * given back since the count was last read has no holder, so
+                 * the count is checked first so that the give is not taken
+                 * for the holder stopping. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                    {
+                        xMutexAvailable = pdTRUE;
+                    }
+                    else
+                    {
+                        xHolderRunning = xTaskIsRunningOnOtherCore( pxQueue->u.xSemaphore.xMutexHolder );
+                    }
+                }
+                taskEXIT_CRITICAL();
 
-    static UBaseType_t prvGetHighestPriorityOfWaitToReceiveList( const Queue_t * const pxQueue )
-    {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+                if( xMutexAvailable != pdFALSE )
+                {
+                    break;
+                }
+                else if( xHolderRunning == pdFALSE )
+                {
+                    /* The holder has been preempted or has blocked, so is
+                     * unlikely to give the mutex soon.  Stop spinning so the
+                     * caller blocks and the holder inherits its priority. */
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+            /* The count is read outside of the critical section so is only a
+             * hint.  The caller takes the mutex from within the critical
+             * section. */
+            if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                xMutexAvailable = pdTRUE;
+                break;
+            }
+            else
+            {
+                ulSpinCount++;
+            }
+        }
+
+        if( xHolderRunning != pdFALSE )
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+            /* Move the estimate an eighth of the way towards the number of
+             * spins this wait took, or towards the limit if the limit was
+             * reached.  A wait cut short because the holder stopped running
+             * says nothing about how long the mutex is held for, so is not
+             * counted.  Two cores updating the estimate at once can lose an
+             * update, which does no harm as the estimate is only a hint. */
+            pxQueue->ulSpinEstimate = ( ulSpinEstimate - ( ulSpinEstimate / 8U ) ) + ( ulSpinCount / 8U );
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxHighestPriorityOfWaitingTasks;
+        return xMutexAvailable;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_ADAPTIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
-
-    /* This function is called from a critical section. */
-
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    static BaseType_t prvSemaphoreCompareAndSwap( Queue_t * const pxQueue,
+                                                  UBaseType_t uxComparand,
+                                                  const UBaseType_t uxExchange,
+                                                  const BaseType_t xGive )
     {
-        #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( queueUSE_NATIVE_COMPARE_AND_SWAP == 1 )
         {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            /* Only used when configUSE_TRACE_FACILITY is not 1. */
+            if( __atomic_compare_exchange_n( &( pxQueue->uxMessagesWaiting ), &uxComparand, uxExchange, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) )
             {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                xReturn = pdTRUE;
+                queueTRACE_SEMAPHORE_FAST_PATH( pxQueue, xGive );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_MUTEXES */
+        #else /* if ( queueUSE_NATIVE_COMPARE_AND_SWAP == 1 ) */
+        {
+            #if ( portHAS_NESTED_INTERRUPTS == 1 )
+                UBaseType_t uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+            #else
+                portENTER_CRITICAL();
+            #endif
+            {
+                if( pxQueue->uxMessagesWaiting == uxComparand )
+                {
+                    pxQueue->uxMessagesWaiting = uxExchange;
+                    xReturn = pdTRUE;
+                    queueTRACE_SEMAPHORE_FAST_PATH( pxQueue, xGive );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #if ( portHAS_NESTED_INTERRUPTS == 1 )
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            #else
+                portEXIT_CRITICAL();
+            #endif
+        }
+        #endif /* if ( queueUSE_NATIVE_COMPARE_AND_SWAP == 1 ) */
+
+        return xReturn;
     }
-    else if( xPosition == queueSEND_TO_BACK )
-    {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;
+/*-----------------------------------------------------------*/
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+    static BaseType_t prvSemaphoreFastGive( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxCount;
+
+        /* A mutex has to record its holder, and a semaphore that a task is
+         * waiting for, or that is in a queue set, has to unblock the task or
+         * notify the set, so all of these take the full path. */
+        if( ( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) &&
+            ( queueIS_QUEUE_SET_MEMBER( pxQueue ) == pdFALSE ) )
         {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
+            uxCount = pxQueue->uxMessagesWaiting;
+
+            while( ( uxCount < pxQueue->uxLength ) && ( xReturn == pdFALSE ) )
+            {
+                if( prvSemaphoreCompareAndSwap( pxQueue, uxCount, ( UBaseType_t ) ( uxCount + ( UBaseType_t ) 1 ), pdTRUE ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    /* An interrupt or another task changed the count. */
+                    uxCount = pxQueue->uxMessagesWaiting;
+                }
+            }
+
+            if( xReturn != pdFALSE )
+            {
+                /* This task could have been preempted between the checks
+                 * above and the count changing by a task that then blocked on
+                 * the empty semaphore or added it to a queue set.  Neither can
+                 * happen once the count is no longer zero, so checking again
+                 * now catches both. */
+                if( ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) ||
+                    ( queueIS_QUEUE_SET_MEMBER( pxQueue ) != pdFALSE ) ||
+                    ( queueSTATS_HIGH_WATER_MARK_EXCEEDED( pxQueue ) != pdFALSE ) )
+                {
+                    queueENTER_CRITICAL( pxQueue );
+                    {
+                        queueSTATS_UPDATE_HIGH_WATER_MARK( pxQueue );
+
+                        #if ( configUSE_QUEUE_SETS == 1 )
+                            if( pxQueue->pxQueueSetContainer != NULL )
+                            {
+                                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                                {
+                                    queueYIELD_IF_USING_PREEMPTION();
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                        #endif /* configUSE_QUEUE_SETS */
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    queueEXIT_CRITICAL( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToReceive ), pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xReturn;
     }
-    else
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSemaphoreFastTake( Queue_t * const pxQueue )
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxCount;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
-        {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
-        }
-        else
+        if( ( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
         {
-            mtCOVERAGE_TEST_MARKER();
-        }
+            uxCount = pxQueue->uxMessagesWaiting;
 
-        if( xPosition == queueOVERWRITE )
-        {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            while( ( uxCount > ( UBaseType_t ) 0 ) && ( xReturn == pdFALSE ) )
             {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
+                if( prvSemaphoreCompareAndSwap( pxQueue, uxCount, ( UBaseType_t ) ( uxCount - ( UBaseType_t ) 1 ), pdFALSE ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    /* An interrupt or another task changed the count. */
+                    uxCount = pxQueue->uxMessagesWaiting;
+                }
+            }
+
+            if( xReturn != pdFALSE )
+            {
+                /* As in prvSemaphoreFastGive(), a task could have blocked
+                 * giving to the full semaphore before the count changed. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    queueENTER_CRITICAL( pxQueue );
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    queueEXIT_CRITICAL( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueWAKE_ASYNC_WAITERS( &( pxQueue->xAsyncWaitingToSend ), pdFALSE );
             }
             else
             {
@@ -2465,33 +5327,36 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+        return xReturn;
+    }
 
-    return xReturn;
-}
+#endif /* configUSE_SEMAPHORE_FAST_PATH */
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
-{
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    static BaseType_t prvRemoveFromEventList( const List_t * const pxEventList )
     {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+        BaseType_t xReturn = pdFALSE;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
-        {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-        }
-        else
+        taskDATA_GROUP_LOCK_KERNEL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+            {
+                xReturn = xTaskRemoveFromEventList( pxEventList );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+        taskDATA_GROUP_UNLOCK_KERNEL();
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+        return xReturn;
     }
-}
+
+#endif /* portUSING_GRANULAR_LOCKS */
 /*-----------------------------------------------------------*/
 
 static void prvUnlockQueue( Queue_t * const pxQueue )
@@ -2502,7 +5367,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
      * removed from the queue while the queue was locked.  When a queue is
      * locked items can be added or removed, but the event lists cannot be
      * updated. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cTxLock = pxQueue->cTxLock;
 
@@ -2534,7 +5399,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                      * suspended. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -2557,7 +5422,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                  * the pending ready list as the scheduler is still suspended. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority so record that
                          * a context switch is required. */
@@ -2580,10 +5445,10 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cTxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     /* Do the same for the Rx lock. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2591,7 +5456,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
         {
             if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
             {
-                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                if( queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                 {
                     vTaskMissedYield();
                 }
@@ -2610,7 +5475,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cRxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 }
 /*-----------------------------------------------------------*/
 
@@ -2618,9 +5483,9 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueITEM_ON_LOAN( pxQueue ) != pdFALSE ) )
         {
             xReturn = pdTRUE;
         }
@@ -2629,7 +5494,7 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     return xReturn;
 }
@@ -2644,7 +5509,7 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueITEM_ON_LOAN( pxQueue ) != pdFALSE ) )
     {
         xReturn = pdTRUE;
     }
@@ -2663,9 +5528,9 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( queueSEND_SLOT_ON_LOAN( pxQueue ) != pdFALSE ) )
         {
             xReturn = pdTRUE;
         }
@@ -2674,7 +5539,7 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     return xReturn;
 }
@@ -2689,7 +5554,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( queueSEND_SLOT_ON_LOAN( pxQueue ) != pdFALSE ) )
     {
         xReturn = pdTRUE;
     }
@@ -2743,7 +5608,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         portDISABLE_INTERRUPTS();
         {
-            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE ) )
             {
                 /* There is room in the queue, copy the data into the queue. */
                 prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
@@ -2798,12 +5663,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueCRReceive( xQueue, pvBuffer, xTicksToWait );
 
+        /* Co-routines read the queue storage directly, so cannot be used with
+         * a priority queue. */
+        configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
         /* If the queue is already empty we may have to block.  A critical section
          * is required to prevent an interrupt adding something to the queue
          * between the check to see if the queue is empty and blocking on the queue. */
         portDISABLE_INTERRUPTS();
         {
-            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+            if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueITEM_ON_LOAN( pxQueue ) != pdFALSE ) )
             {
                 /* There are no messages in the queue, do we want to block or just
                  * leave with nothing? */
@@ -2830,7 +5699,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         portDISABLE_INTERRUPTS();
         {
-            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueITEM_ON_LOAN( pxQueue ) == pdFALSE ) )
             {
                 /* Data is available from the queue. */
                 pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
@@ -2845,7 +5714,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
 
                 --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+                queueCOPY_ITEM( pxQueue, ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom );
 
                 xReturn = pdPASS;
 
@@ -2897,7 +5766,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         /* Cannot block within an ISR so if there is no space on the queue then
          * exit without doing anything. */
-        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_SLOT_ON_LOAN( pxQueue ) == pdFALSE ) )
         {
             prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
 
@@ -2950,9 +5819,13 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueCRReceiveFromISR( xQueue, pvBuffer, pxCoRoutineWoken );
 
+        /* Co-routines read the queue storage directly, so cannot be used with
+         * a priority queue. */
+        configASSERT( queueIS_PRIORITY_QUEUE( pxQueue ) == pdFALSE );
+
         /* We cannot block from an ISR, so check there is data available. If
          * not then just leave without doing anything. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueITEM_ON_LOAN( pxQueue ) == pdFALSE ) )
         {
             /* Copy the data from the queue. */
             pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
@@ -2967,7 +5840,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
 
             --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+            queueCOPY_ITEM( pxQueue, ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom );
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
@@ -3130,6 +6003,107 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxStats )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueGetStats( xQueue, pxStats );
+
+        configASSERT( pxQueue );
+        configASSERT( pxStats );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            *pxStats = pxQueue->xStats;
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_vQueueGetStats();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    void vQueueResetStats( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_vQueueResetStats( xQueue );
+
+        configASSERT( pxQueue );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( QueueStats_t ) );
+            pxQueue->xStats.uxMessagesWaitingHighWaterMark = pxQueue->uxMessagesWaiting;
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_vQueueResetStats();
+    }
+
+#endif /* configUSE_QUEUE_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+    UBaseType_t uxQueueGetRegistryStats( QueueRegistryStatus_t * const pxQueueStatusArray,
+                                         const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux;
+        UBaseType_t uxCount = ( UBaseType_t ) 0U;
+        Queue_t * pxQueue;
+
+        traceENTER_uxQueueGetRegistryStats( pxQueueStatusArray, uxArraySize );
+
+        configASSERT( pxQueueStatusArray );
+
+        /* Suspending the scheduler prevents another task deleting a queue
+         * between it being found in the registry and its statistics being
+         * read.  Queues are not added to or removed from the registry by
+         * interrupts. */
+        vTaskSuspendAll();
+        {
+            for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCount < uxArraySize ); ux++ )
+            {
+                if( xQueueRegistry[ ux ].pcQueueName != NULL )
+                {
+                    pxQueue = xQueueRegistry[ ux ].xHandle;
+
+                    pxQueueStatusArray[ uxCount ].xHandle = pxQueue;
+                    pxQueueStatusArray[ uxCount ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                    pxQueueStatusArray[ uxCount ].uxLength = pxQueue->uxLength;
+
+                    queueENTER_CRITICAL( pxQueue );
+                    {
+                        pxQueueStatusArray[ uxCount ].uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+                        pxQueueStatusArray[ uxCount ].xStats = pxQueue->xStats;
+                    }
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxQueueGetRegistryStats( uxCount );
+
+        return uxCount;
+    }
+
+#endif /* ( ( configUSE_QUEUE_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
     void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
@@ -3182,7 +6156,29 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueCreateSet( uxEventQueueLength );
 
-        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+        {
+            /* The set holds no events, only the head and tail of its ready
+             * list, so needs no storage area whatever the length requested. */
+            ( void ) uxEventQueueLength;
+
+            pxQueue = xQueueGenericCreate( ( UBaseType_t ) 1, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_SET );
+
+            if( pxQueue != NULL )
+            {
+                pxQueue->u.xSet.pxHead = NULL;
+                pxQueue->u.xSet.pxTail = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configUSE_QUEUE_SET_READY_LISTS */
+        {
+            pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LISTS */
 
         traceRETURN_xQueueCreateSet( pxQueue );
 
@@ -3202,7 +6198,30 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueCreateSetStatic( uxEventQueueLength );
 
-        pxQueue = xQueueGenericCreateStatic( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_SET );
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+        {
+            /* The set holds no events so any storage area passed in is not
+             * used. */
+            ( void ) uxEventQueueLength;
+            ( void ) pucQueueStorage;
+
+            pxQueue = xQueueGenericCreateStatic( ( UBaseType_t ) 1, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_SET );
+
+            if( pxQueue != NULL )
+            {
+                pxQueue->u.xSet.pxHead = NULL;
+                pxQueue->u.xSet.pxTail = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configUSE_QUEUE_SET_READY_LISTS */
+        {
+            pxQueue = xQueueGenericCreateStatic( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_SET );
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LISTS */
 
         traceRETURN_xQueueCreateSetStatic( pxQueue );
 
@@ -3221,7 +6240,15 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
 
-        taskENTER_CRITICAL();
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
+        {
+            /* A mutex is protected by the kernel critical section, within
+             * which the queue set's spinlock cannot be taken. */
+            configASSERT( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType != queueQUEUE_IS_MUTEX );
+        }
+        #endif
+
+        queueENTER_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
         {
             if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
             {
@@ -3240,7 +6267,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 xReturn = pdPASS;
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
 
         traceRETURN_xQueueAddToSet( xReturn );
 
@@ -3274,12 +6301,39 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         }
         else
         {
-            taskENTER_CRITICAL();
+            queueENTER_CRITICAL( pxQueueOrSemaphore );
             {
+                #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+                {
+                    /* The queue may still be in the set's ready list if it was
+                     * emptied without the set being selected from since. */
+                    if( pxQueueOrSemaphore->pxNextReadyMember != NULL )
+                    {
+                        #if ( portUSING_GRANULAR_LOCKS == 1 )
+                        {
+                            portGET_SPINLOCK( ( BaseType_t ) portGET_CORE_ID(), queueSPINLOCK( pxQueueOrSemaphore->pxQueueSetContainer ) );
+                        }
+                        #endif
+
+                        prvRemoveFromReadyList( pxQueueOrSemaphore->pxQueueSetContainer, pxQueueOrSemaphore );
+
+                        #if ( portUSING_GRANULAR_LOCKS == 1 )
+                        {
+                            portRELEASE_SPINLOCK( ( BaseType_t ) portGET_CORE_ID(), queueSPINLOCK( pxQueueOrSemaphore->pxQueueSetContainer ) );
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SET_READY_LISTS */
+
                 /* The queue is no longer contained in the set. */
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
             }
-            taskEXIT_CRITICAL();
+            queueEXIT_CRITICAL( pxQueueOrSemaphore );
             xReturn = pdPASS;
         }
 
@@ -3291,7 +6345,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SET_READY_LISTS == 0 ) )
 
     QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
                                                 TickType_t const xTicksToWait )
@@ -3307,7 +6361,118 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         return xReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* ( ( configUSE_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SET_READY_LISTS == 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+
+    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                TickType_t const xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        TickType_t xTicksRemaining = xTicksToWait;
+        Queue_t * const pxQueueSet = xQueueSet;
+        Queue_t * pxMember;
+
+        traceENTER_xQueueSelectFromSet( xQueueSet, xTicksToWait );
+
+        configASSERT( pxQueueSet );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueueSet );
+            {
+                pxMember = prvTakeReadyMember( pxQueueSet );
+
+                if( pxMember != NULL )
+                {
+                    /* The member stays in the ready list, so nothing has been
+                     * removed from the set and no task can be waiting to post
+                     * to it. */
+                    traceQUEUE_RECEIVE( pxQueueSet );
+                    queueEXIT_CRITICAL( pxQueueSet );
+
+                    traceRETURN_xQueueSelectFromSet( pxMember );
+
+                    return pxMember;
+                }
+                else
+                {
+                    if( xTicksRemaining == ( TickType_t ) 0 )
+                    {
+                        /* No member holds data and no block time is specified
+                         * (or the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueueSet );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+                        traceRETURN_xQueueSelectFromSet( NULL );
+
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        queueSET_TIME_OUT_STATE( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueueSet );
+
+            /* Interrupts and other tasks can post to the members of the set
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueueSet );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksRemaining ) == pdFALSE )
+            {
+                /* The ready list was emptied above, so it is only non-empty now
+                 * if a member was posted to since. */
+                if( prvIsQueueEmpty( pxQueueSet ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueueSet );
+                    queuePLACE_ON_RECEIVE_EVENT_LIST( pxQueueSet, xTicksRemaining );
+                    prvUnlockQueue( pxQueueSet );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueueSet );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out, so xTicksRemaining is now 0.  Loop back once more
+                 * to take any member that is ready before returning NULL. */
+                prvUnlockQueue( pxQueueSet );
+                ( void ) xTaskResumeAll();
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_SET_READY_LISTS */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_QUEUE_SETS == 1 )
@@ -3318,7 +6483,29 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueSelectFromSetFromISR( xQueueSet );
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            Queue_t * const pxQueueSet = xQueueSet;
+
+            configASSERT( pxQueueSet );
+
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueueSet );
+            {
+                xReturn = prvTakeReadyMember( pxQueueSet );
+            }
+            queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueueSet );
+        }
+        #else /* configUSE_QUEUE_SET_READY_LISTS */
+        {
+            ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LISTS */
 
         traceRETURN_xQueueSelectFromSetFromISR( xReturn );
 
@@ -3330,7 +6517,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
 #if ( configUSE_QUEUE_SETS == 1 )
 
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue )
     {
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
@@ -3341,22 +6528,69 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
+        {
+            /* The critical section the caller is in only protects the member
+             * queue, so the set must also be locked.  Interrupts are already
+             * disabled, and the lock order is always member then set. */
+            portGET_SPINLOCK( ( BaseType_t ) portGET_CORE_ID(), queueSPINLOCK( pxQueueSetContainer ) );
+        }
+        #endif
+
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 0 )
+            configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+
+            if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #endif
         {
             const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
             traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            #if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+            {
+                /* Add the queue to the back of the set's ready list, unless it
+                 * is already in the list, in place of posting its handle.  The
+                 * set's message count is the length of the ready list, so is
+                 * bounded by the number of members rather than by the set's
+                 * uxLength, which is always one, and exceeds uxLength whenever
+                 * two or more members hold data.  Nothing is ever copied into
+                 * a set so the count is never compared with uxLength, other
+                 * than by uxQueueSpacesAvailable(), which allows for it. */
+                if( pxQueue->pxNextReadyMember == NULL )
+                {
+                    pxQueue->pxNextReadyMember = pxQueueSetContainer;
+
+                    if( pxQueueSetContainer->u.xSet.pxHead == NULL )
+                    {
+                        pxQueueSetContainer->u.xSet.pxHead = pxQueue;
+                    }
+                    else
+                    {
+                        pxQueueSetContainer->u.xSet.pxTail->pxNextReadyMember = pxQueue;
+                    }
+
+                    pxQueueSetContainer->u.xSet.pxTail = pxQueue;
+                    pxQueueSetContainer->uxMessagesWaiting = ( UBaseType_t ) ( pxQueueSetContainer->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* configUSE_QUEUE_SET_READY_LISTS */
+            {
+                /* The data copied is the handle of the queue that contains data. */
+                xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            }
+            #endif /* configUSE_QUEUE_SET_READY_LISTS */
 
             if( cTxLock == queueUNLOCKED )
             {
                 if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( queueREMOVE_FROM_EVENT_LIST( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority. */
                         xReturn = pdTRUE;
@@ -3376,12 +6610,130 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
             }
         }
-        else
+        #if ( configUSE_QUEUE_SET_READY_LISTS == 0 )
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        #endif
+
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
         {
-            mtCOVERAGE_TEST_MARKER();
+            portRELEASE_SPINLOCK( ( BaseType_t ) portGET_CORE_ID(), queueSPINLOCK( pxQueueSetContainer ) );
         }
+        #endif
 
         return xReturn;
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+
+    static Queue_t * prvTakeReadyMember( Queue_t * const pxQueueSet )
+    {
+        Queue_t * pxMember = pxQueueSet->u.xSet.pxHead;
+        Queue_t * pxNext;
+
+        while( pxMember != NULL )
+        {
+            pxNext = pxMember->pxNextReadyMember;
+
+            if( pxMember->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                /* The member is returned but, as it still holds data, remains
+                 * in the ready list.  Move it to the back so the other ready
+                 * members are returned before it is again. */
+                if( pxNext != pxQueueSet )
+                {
+                    pxQueueSet->u.xSet.pxHead = pxNext;
+                    pxMember->pxNextReadyMember = pxQueueSet;
+                    pxQueueSet->u.xSet.pxTail->pxNextReadyMember = pxMember;
+                    pxQueueSet->u.xSet.pxTail = pxMember;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+            }
+            else
+            {
+                /* The member was emptied after it was added to the ready list,
+                 * so drop it.  It is added again when next posted to.  This is
+                 * the only place a member leaves the ready list other than
+                 * xQueueRemoveFromSet(), which keeps the receive paths free of
+                 * any queue set handling. */
+                pxMember->pxNextReadyMember = NULL;
+                pxQueueSet->uxMessagesWaiting = ( UBaseType_t ) ( pxQueueSet->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                if( pxNext == pxQueueSet )
+                {
+                    pxQueueSet->u.xSet.pxHead = NULL;
+                    pxMember = NULL;
+                }
+                else
+                {
+                    pxQueueSet->u.xSet.pxHead = pxNext;
+                    pxMember = pxNext;
+                }
+            }
+        }
+
+        return pxMember;
+    }
+
+#endif /* configUSE_QUEUE_SET_READY_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_READY_LISTS == 1 )
+
+    static void prvRemoveFromReadyList( Queue_t * const pxQueueSet,
+                                        Queue_t * const pxMember )
+    {
+        Queue_t * pxPrevious = NULL;
+        Queue_t * pxCurrent = pxQueueSet->u.xSet.pxHead;
+
+        /* The list is singly linked to keep the per queue overhead to one
+         * pointer, so find the member's predecessor.  Removing a member from a
+         * set is not expected to be time critical. */
+        while( ( pxCurrent != pxMember ) && ( pxCurrent != pxQueueSet ) )
+        {
+            pxPrevious = pxCurrent;
+            pxCurrent = pxCurrent->pxNextReadyMember;
+        }
+
+        configASSERT( pxCurrent == pxMember );
+
+        if( pxCurrent == pxMember )
+        {
+            if( pxPrevious == NULL )
+            {
+                pxQueueSet->u.xSet.pxHead = ( pxMember->pxNextReadyMember == pxQueueSet ) ? NULL : pxMember->pxNextReadyMember;
+            }
+            else
+            {
+                pxPrevious->pxNextReadyMember = pxMember->pxNextReadyMember;
+
+                if( pxQueueSet->u.xSet.pxTail == pxMember )
+                {
+                    pxQueueSet->u.xSet.pxTail = pxPrevious;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            pxMember->pxNextReadyMember = NULL;
+            pxQueueSet->uxMessagesWaiting = ( UBaseType_t ) ( pxQueueSet->uxMessagesWaiting - ( UBaseType_t ) 1 );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_QUEUE_SET_READY_LISTS */
@@ -0,0 +1,789 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer locks.  This #if is closed at the very bottom of
+ * this file.  If you want to include reader-writer locks then ensure
+ * configUSE_RW_LOCKS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_RW_LOCKS == 1 )
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define rwlockYIELD_IF_USING_PREEMPTION()
+    #else
+        #define rwlockYIELD_IF_USING_PREEMPTION()    taskYIELD_WITHIN_API()
+    #endif
+
+/*
+ * The reader-writer lock.  All the members are protected by the kernel
+ * critical section.
+ *
+ * xWokenWriter is set when the lock becomes free and the highest priority
+ * waiting writer is unblocked to take it.  Until that writer has run and
+ * taken the lock, readers and other writers treat the lock as taken, so the
+ * turn cannot be lost to a task that runs first.  It is only cleared by that
+ * writer, so stays set while the writer is suspended and forever if the writer
+ * is deleted first, as documented in rwlock.h.
+ */
+    typedef struct RwLockDef_t
+    {
+        List_t xTasksWaitingToRead;  /**< List of tasks that are blocked waiting to take the lock for reading.  Stored in priority order. */
+        List_t xTasksWaitingToWrite; /**< List of tasks that are blocked waiting to take the lock for writing.  Stored in priority order. */
+        TaskHandle_t xWriter;        /**< The task holding the lock for writing, or NULL. */
+        TaskHandle_t xWokenWriter;   /**< The writer that was unblocked to take the lock next, or NULL. */
+        UBaseType_t uxReaders;       /**< The number of tasks holding the lock for reading. */
+        uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the lock was statically allocated, so no attempt is made to free it. */
+    } RwLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xRwLockCreate() and xRwLockCreateStatic() to initialise the
+ * members of a newly created lock.
+ */
+    static void prvInitialiseNewRwLock( RwLock_t * const pxLock,
+                                        uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task can take the lock for writing
+ * (xWriting is pdTRUE) or reading (xWriting is pdFALSE) now.  Must be called
+ * from within a critical section.
+ */
+    static BaseType_t prvIsAvailable( const RwLock_t * const pxLock,
+                                      BaseType_t xWriting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task for up to xTicksToWait ticks, unless the lock became
+ * available after the task last tried to take it.  If the lock is held for
+ * writing by a lower priority task, that task inherits the calling task's
+ * priority and *pxInheritanceOccurred is set to pdTRUE.
+ */
+    static void prvBlock( RwLock_t * const pxLock,
+                          BaseType_t xWriting,
+                          TickType_t xTicksToWait,
+                          BaseType_t * const pxInheritanceOccurred ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after the lock is released, or a waiting writer gives up, to
+ * unblock the tasks that can now take it: the highest priority waiting writer
+ * if the lock is free, otherwise all the waiting readers if no writer holds or
+ * is waiting for the lock.  Must be called from within a critical section.
+ * Returns pdTRUE if a task that was unblocked has a priority above the calling
+ * task.
+ */
+    static BaseType_t prvWakeWaitingTasks( RwLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task waiting to take the lock
+ * for either reading or writing, or the idle priority if no task is waiting.
+ */
+    static UBaseType_t prvGetHighestPriorityOfWaitingTasks( const RwLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when a task gives up waiting for the lock.  Disinherits any priority
+ * the writer inherited from the calling task, and lets readers that were held
+ * back by the calling task, if it was a writer, take the lock.
+ */
+    static void prvStopWaiting( RwLock_t * const pxLock,
+                                BaseType_t xWriting,
+                                BaseType_t xInheritanceOccurred ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewRwLock( RwLock_t * const pxLock,
+                                        uint8_t ucStaticallyAllocated )
+    {
+        ( void ) memset( ( void * ) pxLock, 0x00, sizeof( RwLock_t ) );
+
+        vListInitialise( &( pxLock->xTasksWaitingToRead ) );
+        vListInitialise( &( pxLock->xTasksWaitingToWrite ) );
+        pxLock->ucStaticallyAllocated = ucStaticallyAllocated;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        RwLockHandle_t xRwLockCreate( void )
+        {
+            RwLock_t * pxLock;
+
+            traceENTER_xRwLockCreate();
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxLock = ( RwLock_t * ) pvPortMalloc( sizeof( RwLock_t ) );
+
+            if( pxLock != NULL )
+            {
+                prvInitialiseNewRwLock( pxLock, ( uint8_t ) pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xRwLockCreate( pxLock );
+
+            return pxLock;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        RwLockHandle_t xRwLockCreateStatic( StaticRwLock_t * pxStaticLock )
+        {
+            RwLockHandle_t xReturn = NULL;
+
+            traceENTER_xRwLockCreateStatic( pxStaticLock );
+
+            configASSERT( pxStaticLock );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticRwLock_t equals the size of the real
+                 * lock structure. */
+                volatile size_t xSize = sizeof( StaticRwLock_t );
+                configASSERT( xSize == sizeof( RwLock_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( pxStaticLock != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                prvInitialiseNewRwLock( ( RwLock_t * ) pxStaticLock, ( uint8_t ) pdTRUE );
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                xReturn = ( RwLockHandle_t ) pxStaticLock;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xRwLockCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vRwLockDelete( RwLockHandle_t xLock )
+    {
+        RwLock_t * const pxLock = xLock;
+
+        traceENTER_vRwLockDelete( xLock );
+
+        configASSERT( pxLock );
+        configASSERT( pxLock->xWriter == NULL );
+        configASSERT( pxLock->uxReaders == ( UBaseType_t ) 0U );
+        configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE );
+        configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+        if( pxLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( ( void * ) pxLock );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucStaticallyAllocated
+                 * must be corrupt.  Force an assert. */
+                configASSERT( xLock == ( RwLockHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The lock was statically allocated, so there is nothing to
+             * free. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vRwLockDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvIsAvailable( const RwLock_t * const pxLock,
+                                      BaseType_t xWriting )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxLock->xWriter == NULL ) && ( pxLock->xWokenWriter == NULL ) )
+        {
+            if( xWriting != pdFALSE )
+            {
+                if( pxLock->uxReaders == ( UBaseType_t ) 0U )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Readers wait behind any waiting writer so a steady stream of
+                 * readers cannot starve the writer. */
+                if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBlock( RwLock_t * const pxLock,
+                          BaseType_t xWriting,
+                          TickType_t xTicksToWait,
+                          BaseType_t * const pxInheritanceOccurred )
+    {
+        BaseType_t xBlocked = pdFALSE;
+
+        vTaskSuspendAll();
+        {
+            /* The kernel critical section stops the lock being released until
+             * the calling task is either on the event list or has decided not
+             * to block. */
+            taskENTER_CRITICAL();
+            {
+                if( prvIsAvailable( pxLock, xWriting ) == pdFALSE )
+                {
+                    if( pxLock->xWriter != NULL )
+                    {
+                        if( xTaskPriorityInherit( pxLock->xWriter ) != pdFALSE )
+                        {
+                            *pxInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xWriting != pdFALSE )
+                    {
+                        vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToWrite ), xTicksToWait );
+                    }
+                    else
+                    {
+                        vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToRead ), xTicksToWait );
+                    }
+
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( xTaskResumeAll() == pdFALSE )
+        {
+            if( xBlocked != pdFALSE )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWakeWaitingTasks( RwLock_t * const pxLock )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxLock->xWriter == NULL ) && ( pxLock->xWokenWriter == NULL ) )
+        {
+            if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+            {
+                if( pxLock->uxReaders == ( UBaseType_t ) 0U )
+                {
+                    /* Give the lock's next turn to the highest priority
+                     * waiting writer. */
+                    pxLock->xWokenWriter = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) );
+                    xReturn = xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToWrite ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* No writer is waiting, so every waiting reader can take the
+                 * lock. */
+                while( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetHighestPriorityOfWaitingTasks( const RwLock_t * const pxLock )
+    {
+        UBaseType_t uxHighestPriority = tskIDLE_PRIORITY;
+        UBaseType_t uxPriority;
+
+        /* Both event lists are ordered by priority, so the highest priority
+         * task on each list is at its head. */
+        if( listCURRENT_LIST_LENGTH( &( pxLock->xTasksWaitingToRead ) ) > 0U )
+        {
+            uxHighestPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToRead ) ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( listCURRENT_LIST_LENGTH( &( pxLock->xTasksWaitingToWrite ) ) > 0U )
+        {
+            uxPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) ) );
+
+            if( uxPriority > uxHighestPriority )
+            {
+                uxHighestPriority = uxPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxHighestPriority;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStopWaiting( RwLock_t * const pxLock,
+                                BaseType_t xWriting,
+                                BaseType_t xInheritanceOccurred )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( xInheritanceOccurred != pdFALSE )
+            {
+                /* This task blocking on the lock caused the writer to inherit
+                 * this task's priority.  Now this task has timed out the
+                 * priority should be disinherited again, but only as low as the
+                 * next highest priority task that is waiting for the lock.
+                 * vTaskPriorityDisinheritAfterTimeout() does nothing if the lock
+                 * is no longer held for writing. */
+                vTaskPriorityDisinheritAfterTimeout( pxLock->xWriter, prvGetHighestPriorityOfWaitingTasks( pxLock ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xWriting != pdFALSE )
+            {
+                /* Readers that were waiting behind this task may now be able
+                 * to take the lock. */
+                xYieldRequired = prvWakeWaitingTasks( pxLock );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            rwlockYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRwLockTakeRead( RwLockHandle_t xLock,
+                                TickType_t xTicksToWait )
+    {
+        RwLock_t * const pxLock = xLock;
+        BaseType_t xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE, xReturn;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xRwLockTakeRead( xLock, xTicksToWait );
+
+        configASSERT( pxLock );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvIsAvailable( pxLock, pdFALSE ) != pdFALSE )
+                {
+                    ( pxLock->uxReaders )++;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xReturn != pdFAIL )
+            {
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                prvStopWaiting( pxLock, pdFALSE, xInheritanceOccurred );
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvBlock( pxLock, pdFALSE, xTicksToWait, &xInheritanceOccurred );
+        }
+
+        traceRETURN_xRwLockTakeRead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRwLockGiveRead( RwLockHandle_t xLock )
+    {
+        RwLock_t * const pxLock = xLock;
+        BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+
+        traceENTER_xRwLockGiveRead( xLock );
+
+        configASSERT( pxLock );
+
+        taskENTER_CRITICAL();
+        {
+            /* The lock must be held for reading. */
+            configASSERT( pxLock->uxReaders > ( UBaseType_t ) 0U );
+
+            if( pxLock->uxReaders > ( UBaseType_t ) 0U )
+            {
+                ( pxLock->uxReaders )--;
+
+                if( pxLock->uxReaders == ( UBaseType_t ) 0U )
+                {
+                    xYieldRequired = prvWakeWaitingTasks( pxLock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            rwlockYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xRwLockGiveRead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRwLockTakeWrite( RwLockHandle_t xLock,
+                                 TickType_t xTicksToWait )
+    {
+        RwLock_t * const pxLock = xLock;
+        BaseType_t xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE, xReturn;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xRwLockTakeWrite( xLock, xTicksToWait );
+
+        configASSERT( pxLock );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* If this task was unblocked to take the lock's next turn then
+                 * the lock has been kept free for it. */
+                if( pxLock->xWokenWriter == xTaskGetCurrentTaskHandle() )
+                {
+                    pxLock->xWokenWriter = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( prvIsAvailable( pxLock, pdTRUE ) != pdFALSE )
+                {
+                    /* Record the holder so a higher priority task that blocks on
+                     * the lock can raise its priority, as for a mutex. */
+                    pxLock->xWriter = pvTaskIncrementMutexHeldCount();
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xReturn != pdFAIL )
+            {
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                prvStopWaiting( pxLock, pdTRUE, xInheritanceOccurred );
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvBlock( pxLock, pdTRUE, xTicksToWait, &xInheritanceOccurred );
+        }
+
+        traceRETURN_xRwLockTakeWrite( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRwLockGiveWrite( RwLockHandle_t xLock )
+    {
+        RwLock_t * const pxLock = xLock;
+        BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+
+        traceENTER_xRwLockGiveWrite( xLock );
+
+        configASSERT( pxLock );
+
+        taskENTER_CRITICAL();
+        {
+            /* Only the task that took the lock for writing can give it. */
+            if( pxLock->xWriter == xTaskGetCurrentTaskHandle() )
+            {
+                pxLock->xWriter = NULL;
+
+                /* Return to the base priority if a priority was inherited
+                 * while the lock was held. */
+                xYieldRequired = xTaskPriorityDisinherit( xTaskGetCurrentTaskHandle() );
+
+                if( prvWakeWaitingTasks( pxLock ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            rwlockYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xRwLockGiveWrite( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxRwLockGetReaderCount( RwLockHandle_t xLock )
+    {
+        const RwLock_t * const pxLock = xLock;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxRwLockGetReaderCount( xLock );
+
+        configASSERT( pxLock );
+
+        uxReturn = pxLock->uxReaders;
+
+        traceRETURN_uxRwLockGetReaderCount( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xRwLockGetWriter( RwLockHandle_t xLock )
+    {
+        const RwLock_t * const pxLock = xLock;
+        TaskHandle_t xReturn;
+
+        traceENTER_xRwLockGetWriter( xLock );
+
+        configASSERT( pxLock );
+
+        xReturn = pxLock->xWriter;
+
+        traceRETURN_xRwLockGetWriter( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer locks.  This #if is closed at the very bottom of
+ * this file.  If you want to include reader-writer locks then ensure
+ * configUSE_RW_LOCKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_RW_LOCKS == 1 */
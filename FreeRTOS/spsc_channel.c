@@ -0,0 +1,560 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_channel.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include channels.  This #if is closed at the very bottom of this file.  If
+ * you want to include channels then ensure configUSE_SPSC_CHANNELS is set to 1
+ * in FreeRTOSConfig.h. */
+#if ( configUSE_SPSC_CHANNELS == 1 )
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_channel.c
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_channel.c
+    #endif
+
+    #if ( configSPSC_CHANNEL_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configSPSC_CHANNEL_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+
+/* Orders the item copy against the index that publishes it, and the index
+ * update against the check for a waiting reader.  On a single core the writer
+ * and the reader only ever interleave by being interrupted or preempted, so
+ * stopping the compiler reordering the accesses is enough.  When there is more
+ * than one core the processor must not reorder them either, so a full fence
+ * is required. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define spscMEMORY_FENCE()    portMEMORY_BARRIER()
+    #elif defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ )
+        #include <stdatomic.h>
+        #define spscMEMORY_FENCE()    atomic_thread_fence( memory_order_seq_cst )
+    #elif defined( __GNUC__ )
+        #define spscMEMORY_FENCE()    __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #else
+        #error spsc_channel.c requires C11 atomics or a GCC compatible compiler when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+/* Bits used in ucFlags. */
+    #define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1U )
+
+/*
+ * The channel.  The fields are split into three groups, each padded to
+ * configSPSC_CHANNEL_CACHE_LINE_SIZE bytes, so the head index, which only the
+ * writer updates, never shares a cache line with the tail index or the waiting
+ * reader, which only the reader updates.  The first group is not changed after
+ * the channel is created.
+ *
+ * uxHead and uxTail are the number of items ever written to and read from the
+ * channel, so they are allowed to wrap and the channel holds
+ * ( uxHead - uxTail ) items.
+ */
+    typedef union SpscChannelConfig
+    {
+        struct
+        {
+            uint8_t * pucStorage;     /**< The storage area items are copied to and from. */
+            size_t uxItemSize;        /**< The size of each item in bytes. */
+            UBaseType_t uxLengthMask; /**< The length of the channel minus one.  The length is a power of 2. */
+            uint8_t ucFlags;          /**< A bit map of spscFLAGS_* values. */
+        } xFields;
+        uint8_t ucPadding[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } SpscChannelConfig_t;
+
+    typedef union SpscChannelWriter
+    {
+        volatile UBaseType_t uxHead; /**< Only written by the writer. */
+        uint8_t ucPadding[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } SpscChannelWriter_t;
+
+    typedef union SpscChannelReader
+    {
+        struct
+        {
+            volatile UBaseType_t uxTail;         /**< Only written by the reader. */
+            TaskHandle_t volatile xWaitingReader; /**< The reader task while it is blocked waiting for an item, otherwise NULL. */
+        } xFields;
+        uint8_t ucPadding[ configSPSC_CHANNEL_CACHE_LINE_SIZE ];
+    } SpscChannelReader_t;
+
+    typedef struct SpscChannelDef_t
+    {
+        SpscChannelConfig_t xConfig;
+        SpscChannelWriter_t xWriter;
+        SpscChannelReader_t xReader;
+    } SpscChannel_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both xSpscChannelCreate() and xSpscChannelCreateStatic() to
+ * initialise the members of a newly created channel.
+ */
+    static void prvInitialiseNewSpscChannel( SpscChannel_t * const pxChannel,
+                                             UBaseType_t uxLength,
+                                             size_t uxItemSize,
+                                             uint8_t * const pucStorage,
+                                             uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the channel if there is space.  Returns the reader task
+ * that must be notified in *pxReaderToNotify, or NULL if the reader is not
+ * waiting.
+ */
+    static BaseType_t prvWriteItem( SpscChannel_t * const pxChannel,
+                                    const void * pvItemToSend,
+                                    TaskHandle_t * const pxReaderToNotify ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the oldest item out of the channel if there is one.  Returns pdTRUE if
+ * an item was copied, otherwise pdFALSE.
+ */
+    static BaseType_t prvReadItem( SpscChannel_t * const pxChannel,
+                                   void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewSpscChannel( SpscChannel_t * const pxChannel,
+                                             UBaseType_t uxLength,
+                                             size_t uxItemSize,
+                                             uint8_t * const pucStorage,
+                                             uint8_t ucFlags )
+    {
+        ( void ) memset( ( void * ) pxChannel, 0x00, sizeof( SpscChannel_t ) );
+
+        pxChannel->xConfig.xFields.pucStorage = pucStorage;
+        pxChannel->xConfig.xFields.uxItemSize = uxItemSize;
+        pxChannel->xConfig.xFields.uxLengthMask = ( UBaseType_t ) ( uxLength - ( UBaseType_t ) 1U );
+        pxChannel->xConfig.xFields.ucFlags = ucFlags;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        SpscChannelHandle_t xSpscChannelCreate( UBaseType_t uxLength,
+                                                size_t uxItemSize )
+        {
+            void * pvAllocatedMemory = NULL;
+            size_t xStorageSize;
+
+            traceENTER_xSpscChannelCreate( uxLength, uxItemSize );
+
+            /* The length must be a power of 2 so an index can be converted to a
+             * slot with a mask, and no more than half the range of the indices
+             * plus one, so a full channel can be told apart from an empty one. */
+            configASSERT( uxLength > ( UBaseType_t ) 0U );
+            configASSERT( ( uxLength & ( UBaseType_t ) ( uxLength - ( UBaseType_t ) 1U ) ) == ( UBaseType_t ) 0U );
+            configASSERT( uxLength <= ( UBaseType_t ) ( ( ( ( UBaseType_t ) ~( UBaseType_t ) 0U ) >> 1 ) + ( UBaseType_t ) 1U ) );
+            configASSERT( uxItemSize > ( size_t ) 0U );
+
+            /* The channel structure and the storage area are allocated in a
+             * single call to pvPortMalloc(), with the storage area placed
+             * immediately after the structure.  Check the size calculation does
+             * not overflow. */
+            if( ( uxItemSize != ( size_t ) 0U ) &&
+                ( ( ( SIZE_MAX - sizeof( SpscChannel_t ) ) / uxItemSize ) >= ( size_t ) uxLength ) )
+            {
+                xStorageSize = ( size_t ) uxLength * uxItemSize;
+                pvAllocatedMemory = pvPortMalloc( sizeof( SpscChannel_t ) + xStorageSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pvAllocatedMemory != NULL )
+            {
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                prvInitialiseNewSpscChannel( ( SpscChannel_t * ) pvAllocatedMemory,
+                                             uxLength,
+                                             uxItemSize,
+                                             ( ( uint8_t * ) pvAllocatedMemory ) + sizeof( SpscChannel_t ),
+                                             ( uint8_t ) 0U );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xSpscChannelCreate( pvAllocatedMemory );
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            return ( SpscChannelHandle_t ) pvAllocatedMemory;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        SpscChannelHandle_t xSpscChannelCreateStatic( UBaseType_t uxLength,
+                                                      size_t uxItemSize,
+                                                      uint8_t * pucChannelStorage,
+                                                      StaticSpscChannel_t * pxStaticChannel )
+        {
+            SpscChannelHandle_t xReturn = NULL;
+
+            traceENTER_xSpscChannelCreateStatic( uxLength, uxItemSize, pucChannelStorage, pxStaticChannel );
+
+            configASSERT( uxLength > ( UBaseType_t ) 0U );
+            configASSERT( ( uxLength & ( UBaseType_t ) ( uxLength - ( UBaseType_t ) 1U ) ) == ( UBaseType_t ) 0U );
+            configASSERT( uxLength <= ( UBaseType_t ) ( ( ( ( UBaseType_t ) ~( UBaseType_t ) 0U ) >> 1 ) + ( UBaseType_t ) 1U ) );
+            configASSERT( uxItemSize > ( size_t ) 0U );
+            configASSERT( pucChannelStorage );
+            configASSERT( pxStaticChannel );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticSpscChannel_t equals the size of the
+                 * real channel structure. */
+                volatile size_t xSize = sizeof( StaticSpscChannel_t );
+                configASSERT( xSize == sizeof( SpscChannel_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucChannelStorage != NULL ) && ( pxStaticChannel != NULL ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                prvInitialiseNewSpscChannel( ( SpscChannel_t * ) pxStaticChannel,
+                                             uxLength,
+                                             uxItemSize,
+                                             pucChannelStorage,
+                                             spscFLAGS_IS_STATICALLY_ALLOCATED );
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                xReturn = ( SpscChannelHandle_t ) pxStaticChannel;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xSpscChannelCreateStatic( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vSpscChannelDelete( SpscChannelHandle_t xChannel )
+    {
+        SpscChannel_t * const pxChannel = xChannel;
+
+        traceENTER_vSpscChannelDelete( xChannel );
+
+        configASSERT( pxChannel );
+        configASSERT( pxChannel->xReader.xFields.xWaitingReader == NULL );
+
+        if( ( pxChannel->xConfig.xFields.ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0U )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* Both the structure and the storage area were allocated using
+                 * a single call to pvPortMalloc(), hence only one call to
+                 * vPortFree() is required. */
+                vPortFree( ( void * ) pxChannel );
+            }
+            #else
+            {
+                /* Should not be possible to get here, ucFlags must be corrupt.
+                 * Force an assert. */
+                configASSERT( xChannel == ( SpscChannelHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure and storage area were statically allocated, so
+             * there is nothing to free, just clear the structure. */
+            ( void ) memset( ( void * ) pxChannel, 0x00, sizeof( SpscChannel_t ) );
+        }
+
+        traceRETURN_vSpscChannelDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWriteItem( SpscChannel_t * const pxChannel,
+                                    const void * pvItemToSend,
+                                    TaskHandle_t * const pxReaderToNotify )
+    {
+        const UBaseType_t uxHead = pxChannel->xWriter.uxHead;
+        const UBaseType_t uxTail = pxChannel->xReader.xFields.uxTail;
+        const size_t uxItemSize = pxChannel->xConfig.xFields.uxItemSize;
+        BaseType_t xReturn;
+
+        *pxReaderToNotify = NULL;
+
+        if( ( UBaseType_t ) ( uxHead - uxTail ) <= pxChannel->xConfig.xFields.uxLengthMask )
+        {
+            /* The tail must be read before the slot it frees is overwritten. */
+            spscMEMORY_FENCE();
+
+            ( void ) memcpy( ( void * ) &( pxChannel->xConfig.xFields.pucStorage[ ( size_t ) ( uxHead & pxChannel->xConfig.xFields.uxLengthMask ) * uxItemSize ] ),
+                             pvItemToSend,
+                             uxItemSize );
+
+            /* The item must be in the storage area before the reader can see
+             * the new head. */
+            spscMEMORY_FENCE();
+            pxChannel->xWriter.uxHead = ( UBaseType_t ) ( uxHead + ( UBaseType_t ) 1U );
+
+            /* The new head must be visible before checking for a waiting
+             * reader.  The reader sets xWaitingReader before checking the head
+             * again, so either it sees the new item or the check below sees
+             * the reader. */
+            spscMEMORY_FENCE();
+            *pxReaderToNotify = pxChannel->xReader.xFields.xWaitingReader;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errQUEUE_FULL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscChannelSend( SpscChannelHandle_t xChannel,
+                                 const void * pvItemToSend )
+    {
+        SpscChannel_t * const pxChannel = xChannel;
+        TaskHandle_t xReaderToNotify;
+        BaseType_t xReturn;
+
+        traceENTER_xSpscChannelSend( xChannel, pvItemToSend );
+
+        configASSERT( pxChannel );
+        configASSERT( pvItemToSend );
+
+        xReturn = prvWriteItem( pxChannel, pvItemToSend, &xReaderToNotify );
+
+        if( xReaderToNotify != NULL )
+        {
+            ( void ) xTaskNotifyGiveIndexed( xReaderToNotify, configSPSC_CHANNEL_NOTIFICATION_INDEX );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscChannelSend( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscChannelSendFromISR( SpscChannelHandle_t xChannel,
+                                        const void * pvItemToSend,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        SpscChannel_t * const pxChannel = xChannel;
+        TaskHandle_t xReaderToNotify;
+        BaseType_t xReturn;
+
+        traceENTER_xSpscChannelSendFromISR( xChannel, pvItemToSend, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxChannel );
+        configASSERT( pvItemToSend );
+
+        xReturn = prvWriteItem( pxChannel, pvItemToSend, &xReaderToNotify );
+
+        if( xReaderToNotify != NULL )
+        {
+            vTaskNotifyGiveIndexedFromISR( xReaderToNotify, configSPSC_CHANNEL_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscChannelSendFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReadItem( SpscChannel_t * const pxChannel,
+                                   void * pvBuffer )
+    {
+        const UBaseType_t uxTail = pxChannel->xReader.xFields.uxTail;
+        const size_t uxItemSize = pxChannel->xConfig.xFields.uxItemSize;
+        BaseType_t xReturn;
+
+        if( pxChannel->xWriter.uxHead != uxTail )
+        {
+            /* The head must be read before the item it publishes. */
+            spscMEMORY_FENCE();
+
+            ( void ) memcpy( pvBuffer,
+                             ( const void * ) &( pxChannel->xConfig.xFields.pucStorage[ ( size_t ) ( uxTail & pxChannel->xConfig.xFields.uxLengthMask ) * uxItemSize ] ),
+                             uxItemSize );
+
+            /* The item must be copied out before the writer can see the slot
+             * is free. */
+            spscMEMORY_FENCE();
+            pxChannel->xReader.xFields.uxTail = ( UBaseType_t ) ( uxTail + ( UBaseType_t ) 1U );
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscChannelReceive( SpscChannelHandle_t xChannel,
+                                    void * pvBuffer,
+                                    TickType_t xTicksToWait )
+    {
+        SpscChannel_t * const pxChannel = xChannel;
+        TimeOut_t xTimeOut;
+        BaseType_t xReturn = errQUEUE_EMPTY;
+
+        traceENTER_xSpscChannelReceive( xChannel, pvBuffer, xTicksToWait );
+
+        configASSERT( pxChannel );
+        configASSERT( pvBuffer );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        if( prvReadItem( pxChannel, pvBuffer ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+        }
+        else if( xTicksToWait != ( TickType_t ) 0U )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            for( ; ; )
+            {
+                /* Tell the writer a notification is wanted, then check the
+                 * channel again, as an item written before xWaitingReader was
+                 * seen by the writer would not generate a notification. */
+                pxChannel->xReader.xFields.xWaitingReader = xTaskGetCurrentTaskHandle();
+                spscMEMORY_FENCE();
+
+                if( pxChannel->xWriter.uxHead == pxChannel->xReader.xFields.uxTail )
+                {
+                    ( void ) ulTaskNotifyTakeIndexed( configSPSC_CHANNEL_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxChannel->xReader.xFields.xWaitingReader = NULL;
+
+                if( prvReadItem( pxChannel, pvBuffer ) != pdFALSE )
+                {
+                    xReturn = pdPASS;
+                    break;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                {
+                    /* Timed out. */
+                    break;
+                }
+                else
+                {
+                    /* Woken by a notification left over from an earlier item,
+                     * or the wait was shorter than the remaining time. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscChannelReceive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxSpscChannelItemsWaiting( SpscChannelHandle_t xChannel )
+    {
+        const SpscChannel_t * const pxChannel = xChannel;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxSpscChannelItemsWaiting( xChannel );
+
+        configASSERT( pxChannel );
+
+        uxReturn = ( UBaseType_t ) ( pxChannel->xWriter.uxHead - pxChannel->xReader.xFields.uxTail );
+
+        traceRETURN_uxSpscChannelItemsWaiting( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include channels.  This #if is closed at the very bottom of this file.  If
+ * you want to include channels then ensure configUSE_SPSC_CHANNELS is set to 1
+ * in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_CHANNELS == 1 */
@@ -39,6 +39,10 @@
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( configUSE_ASYNC_COROUTINES == 1 )
+    #include "async.h"
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -58,11 +62,53 @@
         #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build stream_buffer.c
     #endif
 
+/* Macros to enter and exit a critical section that protects a stream buffer.
+ * When portUSING_GRANULAR_LOCKS is 1 each stream buffer is protected by its
+ * own spinlock, and task notification functions that are not interrupt safe
+ * must only be called from within the critical section after calling
+ * sbLOCK_KERNEL(). */
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        #define sbSPINLOCK( pxStreamBuffer )                                         ( ( portSPINLOCK_TYPE * ) &( ( pxStreamBuffer )->xStreamBufferSpinlock ) )
+        #define sbENTER_CRITICAL( pxStreamBuffer )                                   taskDATA_GROUP_ENTER_CRITICAL( sbSPINLOCK( pxStreamBuffer ) )
+        #define sbEXIT_CRITICAL( pxStreamBuffer )                                    taskDATA_GROUP_EXIT_CRITICAL( sbSPINLOCK( pxStreamBuffer ) )
+        #define sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer )                          taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( sbSPINLOCK( pxStreamBuffer ) )
+        #define sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer )    taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( ( uxSavedInterruptStatus ), sbSPINLOCK( pxStreamBuffer ) )
+        #define sbLOCK_KERNEL()                                                      taskDATA_GROUP_LOCK_KERNEL()
+        #define sbUNLOCK_KERNEL()                                                    taskDATA_GROUP_UNLOCK_KERNEL()
+    #else
+        #define sbENTER_CRITICAL( pxStreamBuffer )                                   taskENTER_CRITICAL()
+        #define sbEXIT_CRITICAL( pxStreamBuffer )                                    taskEXIT_CRITICAL()
+        #define sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer )                          taskENTER_CRITICAL_FROM_ISR()
+        #define sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+        #define sbLOCK_KERNEL()
+        #define sbUNLOCK_KERNEL()
+    #endif /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+
 /* If the user has not provided application specific Rx notification macros,
  * or #defined the notification macros away, then provide default implementations
  * that uses task notifications. */
     #ifndef sbRECEIVE_COMPLETED
-        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                                 \
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
+            #define sbRECEIVE_COMPLETED( pxStreamBuffer )                             \
+    do                                                                                \
+    {                                                                                 \
+        sbENTER_CRITICAL( pxStreamBuffer );                                           \
+        {                                                                             \
+            if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                      \
+            {                                                                         \
+                sbLOCK_KERNEL();                                                      \
+                ( void ) xTaskNotifyIndexed( ( pxStreamBuffer )->xTaskWaitingToSend,  \
+                                             ( pxStreamBuffer )->uxNotificationIndex, \
+                                             ( uint32_t ) 0,                          \
+                                             eNoAction );                             \
+                sbUNLOCK_KERNEL();                                                    \
+                ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                        \
+            }                                                                         \
+        }                                                                             \
+        sbEXIT_CRITICAL( pxStreamBuffer );                                            \
+    } while( 0 )
+        #else /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+            #define sbRECEIVE_COMPLETED( pxStreamBuffer )                             \
     do                                                                                \
     {                                                                                 \
         vTaskSuspendAll();                                                            \
@@ -78,6 +124,7 @@
         }                                                                             \
         ( void ) xTaskResumeAll();                                                    \
     } while( 0 )
+        #endif /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
     #endif /* sbRECEIVE_COMPLETED */
 
 /* If user has provided a per-instance receive complete callback, then
@@ -105,7 +152,7 @@
     do {                                                                                     \
         UBaseType_t uxSavedInterruptStatus;                                                  \
                                                                                              \
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();                              \
+        uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );                \
         {                                                                                    \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                             \
             {                                                                                \
@@ -117,7 +164,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                               \
             }                                                                                \
         }                                                                                    \
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                \
+        sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );                  \
     } while( 0 )
     #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -144,7 +191,27 @@
  * implementation that uses task notifications.
  */
     #ifndef sbSEND_COMPLETED
-        #define sbSEND_COMPLETED( pxStreamBuffer )                                  \
+        #if ( portUSING_GRANULAR_LOCKS == 1 )
+            #define sbSEND_COMPLETED( pxStreamBuffer )                                  \
+    do                                                                                  \
+    {                                                                                   \
+        sbENTER_CRITICAL( pxStreamBuffer );                                             \
+        {                                                                               \
+            if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
+            {                                                                           \
+                sbLOCK_KERNEL();                                                        \
+                ( void ) xTaskNotifyIndexed( ( pxStreamBuffer )->xTaskWaitingToReceive, \
+                                             ( pxStreamBuffer )->uxNotificationIndex,   \
+                                             ( uint32_t ) 0,                            \
+                                             eNoAction );                               \
+                sbUNLOCK_KERNEL();                                                      \
+                ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
+            }                                                                           \
+        }                                                                               \
+        sbEXIT_CRITICAL( pxStreamBuffer );                                              \
+    } while( 0 )
+        #else /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
+            #define sbSEND_COMPLETED( pxStreamBuffer )                              \
     vTaskSuspendAll();                                                              \
     {                                                                               \
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
@@ -157,6 +224,7 @@
         }                                                                           \
     }                                                                               \
     ( void ) xTaskResumeAll()
+        #endif /* if ( portUSING_GRANULAR_LOCKS == 1 ) */
     #endif /* sbSEND_COMPLETED */
 
 /* If user has provided a per-instance send completed callback, then
@@ -184,7 +252,7 @@
     do {                                                                                       \
         UBaseType_t uxSavedInterruptStatus;                                                    \
                                                                                                \
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();                                \
+        uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );                  \
         {                                                                                      \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                            \
             {                                                                                  \
@@ -196,7 +264,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                              \
             }                                                                                  \
         }                                                                                      \
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                  \
+        sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );                    \
     } while( 0 )
     #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -218,6 +286,34 @@
     sbSEND_COMPLETE_FROM_ISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
     #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
+/* Wake the async coroutines waiting for data or space in the stream buffer.
+ * Async wait lists are protected by the kernel critical section, so these are
+ * used after the stream buffer's own critical section has been exited. */
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        #define sbWAKE_ASYNC_WAITERS( pxWaitList )        \
+    do {                                                  \
+        if( *( pxWaitList ) != NULL )                     \
+        {                                                 \
+            vAsyncWakeWaiters( ( pxWaitList ), pdFALSE ); \
+        }                                                 \
+    } while( 0 )
+
+        #define sbWAKE_ASYNC_WAITERS_FROM_ISR( pxWaitList, pxHigherPriorityTaskWoken )          \
+    do {                                                                                        \
+        if( *( pxWaitList ) != NULL )                                                           \
+        {                                                                                       \
+            vAsyncWakeWaitersFromISR( ( pxWaitList ), pdFALSE, ( pxHigherPriorityTaskWoken ) ); \
+        }                                                                                       \
+    } while( 0 )
+
+        #define sbASYNC_WAITERS_PRESENT( pxStreamBuffer )                                                                                    \
+    ( ( ( ( pxStreamBuffer )->xAsyncWaitingToReceive != NULL ) || ( ( pxStreamBuffer )->xAsyncWaitingToSend != NULL ) ) ? pdTRUE : pdFALSE )
+    #else
+        #define sbWAKE_ASYNC_WAITERS( pxWaitList )
+        #define sbWAKE_ASYNC_WAITERS_FROM_ISR( pxWaitList, pxHigherPriorityTaskWoken )
+        #define sbASYNC_WAITERS_PRESENT( pxStreamBuffer )    pdFALSE
+    #endif
+
 /* The number of bytes used to hold the length of a message in the buffer. */
     #define sbBYTES_TO_STORE_MESSAGE_LENGTH    ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
 
@@ -249,6 +345,15 @@ typedef struct StreamBufferDef_t
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
     UBaseType_t uxNotificationIndex;                               /* The index we are using for notification, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xStreamBufferSpinlock; /* Protects the stream buffer when portUSING_GRANULAR_LOCKS is 1. */
+    #endif
+
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+        AsyncWaitList_t xAsyncWaitingToReceive; /* Async coroutines waiting for data. */
+        AsyncWaitList_t xAsyncWaitingToSend;    /* Async coroutines waiting for space. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -405,6 +510,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
+            #if ( portUSING_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( ( ( StreamBuffer_t * ) pvAllocatedMemory )->xStreamBufferSpinlock ) );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pvAllocatedMemory ), xStreamBufferType );
         }
         else
@@ -499,6 +610,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
              * again. */
             pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
 
+            #if ( portUSING_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( pxStreamBuffer->xStreamBufferSpinlock ) );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xStreamBufferType );
 
             /* MISRA Ref 11.3.1 [Misaligned access] */
@@ -613,10 +730,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
     }
     #endif
 
-    /* Can only reset a message buffer if there are no tasks blocked on it. */
-    taskENTER_CRITICAL();
+    /* Can only reset a message buffer if there are no tasks or async coroutines
+     * blocked on it. */
+    sbENTER_CRITICAL( pxStreamBuffer );
     {
-        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) &&
+            ( sbASYNC_WAITERS_PRESENT( pxStreamBuffer ) == pdFALSE ) )
         {
             #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
             {
@@ -644,7 +763,7 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             xReturn = pdPASS;
         }
     }
-    taskEXIT_CRITICAL();
+    sbEXIT_CRITICAL( pxStreamBuffer );
 
     traceRETURN_xStreamBufferReset( xReturn );
 
@@ -675,13 +794,15 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
     }
     #endif
 
-    /* Can only reset a message buffer if there are no tasks blocked on it. */
+    /* Can only reset a message buffer if there are no tasks or async coroutines
+     * blocked on it. */
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
-        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) &&
+            ( sbASYNC_WAITERS_PRESENT( pxStreamBuffer ) == pdFALSE ) )
         {
             #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
             {
@@ -709,7 +830,7 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             xReturn = pdPASS;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferResetFromISR( xReturn );
 
@@ -872,14 +993,16 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait until the required number of bytes are free in the message
              * buffer. */
-            taskENTER_CRITICAL();
+            sbENTER_CRITICAL( pxStreamBuffer );
             {
                 xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
                 if( xSpace < xRequiredSpace )
                 {
                     /* Clear notification state as going to wait for space. */
+                    sbLOCK_KERNEL();
                     ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+                    sbUNLOCK_KERNEL();
 
                     /* Should only be one writer. */
                     configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
@@ -887,11 +1010,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                 }
                 else
                 {
-                    taskEXIT_CRITICAL();
+                    sbEXIT_CRITICAL( pxStreamBuffer );
                     break;
                 }
             }
-            taskEXIT_CRITICAL();
+            sbEXIT_CRITICAL( pxStreamBuffer );
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
@@ -922,6 +1045,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETED( pxStreamBuffer );
+            sbWAKE_ASYNC_WAITERS( &( pxStreamBuffer->xAsyncWaitingToReceive ) );
         }
         else
         {
@@ -979,6 +1103,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
             /* coverity[misra_c_2012_directive_4_7_violation] */
             prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            sbWAKE_ASYNC_WAITERS_FROM_ISR( &( pxStreamBuffer->xAsyncWaitingToReceive ), pxHigherPriorityTaskWoken );
         }
         else
         {
@@ -1087,7 +1212,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     {
         /* Checking if there is data and clearing the notification state must be
          * performed atomically. */
-        taskENTER_CRITICAL();
+        sbENTER_CRITICAL( pxStreamBuffer );
         {
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
@@ -1101,7 +1226,9 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
             if( xBytesAvailable <= xBytesToStoreMessageLength )
             {
                 /* Clear notification state as going to wait for data. */
+                sbLOCK_KERNEL();
                 ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+                sbUNLOCK_KERNEL();
 
                 /* Should only be one reader. */
                 configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
@@ -1112,7 +1239,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        sbEXIT_CRITICAL( pxStreamBuffer );
 
         if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
@@ -1148,6 +1275,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         {
             traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
             prvRECEIVE_COMPLETED( xStreamBuffer );
+            sbWAKE_ASYNC_WAITERS( &( pxStreamBuffer->xAsyncWaitingToSend ) );
         }
         else
         {
@@ -1255,6 +1383,7 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
             /* coverity[misra_c_2012_directive_4_7_violation] */
             prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            sbWAKE_ASYNC_WAITERS_FROM_ISR( &( pxStreamBuffer->xAsyncWaitingToSend ), pxHigherPriorityTaskWoken );
         }
         else
         {
@@ -1409,7 +1538,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1426,7 +1555,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferSendCompletedFromISR( xReturn );
 
@@ -1448,7 +1577,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1465,7 +1594,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferReceiveCompletedFromISR( xReturn );
 
@@ -1709,6 +1838,35 @@ void vStreamBufferSetStreamBufferNotificationIndex( StreamBufferHandle_t xStream
     #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ASYNC_COROUTINES == 1 )
+
+    AsyncWaitList_t * pxStreamBufferGetAsyncWaitList( StreamBufferHandle_t xStreamBuffer,
+                                                      BaseType_t xWaitingToSend )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        AsyncWaitList_t * pxReturn;
+
+        traceENTER_pxStreamBufferGetAsyncWaitList( xStreamBuffer, xWaitingToSend );
+
+        configASSERT( pxStreamBuffer );
+
+        if( xWaitingToSend != pdFALSE )
+        {
+            pxReturn = &( pxStreamBuffer->xAsyncWaitingToSend );
+        }
+        else
+        {
+            pxReturn = &( pxStreamBuffer->xAsyncWaitingToReceive );
+        }
+
+        traceRETURN_pxStreamBufferGetAsyncWaitList( pxReturn );
+
+        return pxReturn;
+    }
+
+    #endif /* configUSE_ASYNC_COROUTINES */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
  * to include stream buffer functionality. This #if is closed at the very bottom
  * of this file. If you want to include stream buffers then ensure
@@ -64,6 +64,22 @@
     #include <stdio.h>
 #endif /* configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) */
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The ready tasks at configEDF_TASK_PRIORITY run in deadline order, so a task at
+ * that priority should also preempt a running task at that priority if its
+ * deadline is earlier. */
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )                                     \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||                      \
+      ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&    \
+        ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) && \
+        ( prvDeadlineIsEarlier( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+#else
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )    ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+#endif
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -86,7 +102,7 @@
 
         #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB ) \
     do {                                                        \
-        if( pxCurrentTCB->uxPriority < ( pxTCB )->uxPriority )  \
+        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )                \
         {                                                       \
             portYIELD_WITHIN_API();                             \
         }                                                       \
@@ -127,12 +143,18 @@
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
 #endif
 
+/* Values that can be assigned to the ucStackHighWaterMarkState member of the
+ * TCB. */
+#define tskSTACK_HIGH_WATER_MARK_STALE       ( ( uint8_t ) 0 )
+#define tskSTACK_HIGH_WATER_MARK_CHECKING    ( ( uint8_t ) 1 )
+#define tskSTACK_HIGH_WATER_MARK_CACHED      ( ( uint8_t ) 2 )
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -172,7 +194,31 @@
     #define taskRESERVED_TASK_NAME_LENGTH    1U
 #endif /* if ( ( configNUMBER_OF_CORES > 1 ) */
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The ready task at configEDF_TASK_PRIORITY with the earliest deadline is
+ * selected instead of sharing time between the tasks at that priority. */
+    #define taskSELECT_TASK_FROM_READY_LIST( uxPriority )                                          \
+    do {                                                                                           \
+        if( ( uxPriority ) == ( UBaseType_t ) configEDF_TASK_PRIORITY )                            \
+        {                                                                                          \
+            pxCurrentTCB = prvGetEarliestDeadlineTask();                                           \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) ); \
+        }                                                                                          \
+    } while( 0 )
+
+    #define taskPRIORITY_IS_TIME_SLICED( uxPriority )    ( ( uxPriority ) != ( UBaseType_t ) configEDF_TASK_PRIORITY )
+#else
+    #define taskSELECT_TASK_FROM_READY_LIST( uxPriority )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskPRIORITY_IS_TIME_SLICED( uxPriority )        ( pdTRUE )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -204,7 +250,7 @@
                                                                                          \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );                                     \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -221,6 +267,64 @@
     #define taskRESET_READY_PRIORITY( uxPriority )
     #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+/* If configUSE_READY_PRIORITY_BITMAP is 1 then the generic task selection
+ * records which priorities have Ready state tasks in a two level bitmap.  Bit
+ * ( n % 32 ) of ulReadyPriorityBitmap[ n / 32 ] is set while
+ * pxReadyTasksLists[ n ] is not empty, and bit m of ulReadyPriorityGroups is
+ * set while ulReadyPriorityBitmap[ m ] is not zero.  uxTopReadyPriority is
+ * recalculated from the bitmap whenever the highest ready list empties, so it
+ * always holds the exact priority of the highest priority Ready state task and
+ * selecting a task never has to search down through empty ready lists.  With
+ * 32 or fewer priorities the bitmap is a single word, and
+ * ulReadyPriorityGroups is left out. */
+    #define taskREADY_PRIORITY_GROUP( uxPriority )    ( ( UBaseType_t ) ( ( uxPriority ) >> 5U ) )
+    #define taskREADY_PRIORITY_BIT( uxPriority )      ( ( uint32_t ) 1U << ( ( uxPriority ) & ( UBaseType_t ) 0x1FU ) )
+
+    #if ( configMAX_PRIORITIES > 32 )
+        #define taskRECORD_READY_PRIORITY_GROUP( uxPriority )    ( ulReadyPriorityGroups |= ( uint32_t ) 1U << taskREADY_PRIORITY_GROUP( uxPriority ) )
+    #else
+        #define taskRECORD_READY_PRIORITY_GROUP( uxPriority )
+    #endif
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                                              \
+    do {                                                                                                         \
+        ulReadyPriorityBitmap[ taskREADY_PRIORITY_GROUP( uxPriority ) ] |= taskREADY_PRIORITY_BIT( uxPriority ); \
+        taskRECORD_READY_PRIORITY_GROUP( uxPriority );                                                           \
+                                                                                                                 \
+        if( ( uxPriority ) > uxTopReadyPriority )                                                                \
+        {                                                                                                        \
+            uxTopReadyPriority = ( uxPriority );                                                                 \
+        }                                                                                                        \
+    } while( 0 ) /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                       \
+    do {                                                                                             \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) > 0 ); \
+                                                                                                     \
+        /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of                     \
+         * the same priority get an equal share of the processor time. */                            \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopReadyPriority );                                       \
+    } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit of a priority whose ready list has become empty.  As with the
+ * port optimised version, portRESET_READY_PRIORITY() is only called when it is
+ * known that the task was removed from its ready list. */
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    do {                                                                                               \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            prvResetReadyPriority( uxPriority );                                                       \
+        }                                                                                              \
+    } while( 0 )
+
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )    prvResetReadyPriority( uxPriority )
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -239,7 +343,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );                                       \
     } while( 0 )
 
 /*-----------------------------------------------------------*/
@@ -259,9 +363,25 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) || ( configUSE_EVENT_LIST_BUCKETS == 1 ) || ( configUSE_TIMING_WHEEL == 1 ) )
+
+/* Returns the bit number of the most significant set bit in a non-zero 32-bit
+ * value. */
+    #if defined( __GNUC__ )
+        #define taskHIGHEST_SET_BIT( ulBits )    ( ( UBaseType_t ) ( ( ( sizeof( unsigned long ) * 8U ) - 1U ) - ( size_t ) __builtin_clzl( ( unsigned long ) ( ulBits ) ) ) )
+    #else
+        #define taskHIGHEST_SET_BIT( ulBits )    prvHighestSetBit( ulBits )
+    #endif
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
     do {                                                                          \
         List_t * pxTemp;                                                          \
                                                                                   \
@@ -275,19 +395,169 @@
         prvResetNextTaskUnblockTime();                                            \
     } while( 0 )
 
+#else /* if ( configUSE_TIMING_WHEEL == 0 ) */
+
+/* The timing wheel indexes its slots with the wrapping tick count so there are
+ * no lists to switch when the tick count overflows.  Tick 0 is aligned to the
+ * start of every wheel level, so force the wheel to be serviced on this tick
+ * rather than searching for the next slot that needs attention. */
+    #define taskSWITCH_DELAYED_LISTS()                            \
+    do {                                                          \
+        xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 ); \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;                 \
+    } while( 0 )
+
+/* Each wheel level has 2^configTIMING_WHEEL_SLOT_BITS slots.  Slot n of level
+ * L holds tasks whose wake time is between 2^(L * configTIMING_WHEEL_SLOT_BITS)
+ * and 2^((L + 1) * configTIMING_WHEEL_SLOT_BITS) ticks away, with n taken from
+ * the bits of the wake time that correspond to that level.  Tasks that wake
+ * beyond the span of the top level are held in one extra list that is
+ * re-examined each time the top level completes a revolution. */
+    #define taskTIMING_WHEEL_SLOTS         ( ( UBaseType_t ) 1U << configTIMING_WHEEL_SLOT_BITS )
+    #define taskTIMING_WHEEL_SLOT_MASK     ( ( TickType_t ) ( taskTIMING_WHEEL_SLOTS - 1U ) )
+    #define taskTIMING_WHEEL_FAR_LIST      ( ( UBaseType_t ) configTIMING_WHEEL_LEVELS * taskTIMING_WHEEL_SLOTS )
+    #define taskTIMING_WHEEL_LIST_COUNT    ( taskTIMING_WHEEL_FAR_LIST + 1U )
+
+/* Each level also has a bitmap of the slots that may hold tasks, one bit per
+ * slot in 32-bit words, so the next slot to service is found without looking
+ * at every slot.  Tasks leave slots from many places, so a bit is set when a
+ * task is placed in its slot and only cleared when the slot is next found to
+ * be empty. */
+    #define taskTIMING_WHEEL_BITMAP_WORDS    ( ( taskTIMING_WHEEL_SLOTS + 31U ) >> 5U )
+
+/* Is pxList one of the lists that make up the timing wheel? */
+    #define taskLIST_IS_TIMING_WHEEL_LIST( pxList )                      \
+    ( ( ( pxList ) >= &( xTimingWheel[ 0 ] ) ) &&                        \
+      ( ( pxList ) <= &( xTimingWheel[ taskTIMING_WHEEL_FAR_LIST ] ) ) )
+
+#endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HOME_CORE_READY_LISTS == 0 )
+
+/* All cores share a single ready list for each priority, so the core ID passed
+ * to taskREADY_LIST() is not used. */
+    #define taskREADY_LIST_COUNT                         ( ( BaseType_t ) 1 )
+    #define taskREADY_LIST( xCoreID, uxPriority )        ( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskREADY_LIST_LENGTH( uxPriority )          listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskIS_IN_READY_LIST( pxTCB, uxPriority )    listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ ( uxPriority ) ] ), &( ( pxTCB )->xStateListItem ) )
+
+#else
+
+/* Each core has its own ready list for each priority.  A task that becomes
+ * ready is added to the lists of its home core, which is the core on which it
+ * last ran, or a core it has affinity with, and a core that finds no task it
+ * can run in its own list at a priority takes one from another core's list at
+ * the same priority before looking at lower priorities.  A task is always in
+ * the lists of the core given by its xReadyListCoreID, so a task taken from
+ * another core's list is moved to the list of the core that runs it.  Every
+ * core's lists are protected by the same kernel locks as the shared lists. */
+    #define taskREADY_LIST_COUNT                         ( ( BaseType_t ) configNUMBER_OF_CORES )
+    #define taskREADY_LIST( xCoreID, uxPriority )        ( &( pxCoreReadyTasksLists[ ( xCoreID ) ][ ( uxPriority ) ] ) )
+    #define taskREADY_LIST_LENGTH( uxPriority )          prvGetReadyListLength( uxPriority )
+    #define taskIS_IN_READY_LIST( pxTCB, uxPriority )    listIS_CONTAINED_WITHIN( taskREADY_LIST( ( pxTCB )->xReadyListCoreID, ( uxPriority ) ), &( ( pxTCB )->xStateListItem ) )
+
+#endif /* if ( configUSE_HOME_CORE_READY_LISTS == 0 ) */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Record the time at which a task enters the Ready state, either by being
+ * added to a ready list or to the pending ready list.
+ */
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    #define taskRECORD_READY_TIME( pxTCB )    prvRecordReadyTime( pxTCB )
+
+    #if defined( portGET_LATENCY_TIMESTAMP )
+        #define taskGET_LATENCY_TIMESTAMP( ulTime )    ( ulTime ) = ( configRUN_TIME_COUNTER_TYPE ) portGET_LATENCY_TIMESTAMP()
+    #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+        #define taskGET_LATENCY_TIMESTAMP( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+    #else
+        #define taskGET_LATENCY_TIMESTAMP( ulTime )    ( ulTime ) = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+#else
+    #define taskRECORD_READY_TIME( pxTCB )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Must be called before a task's event list item is removed from an event
+ * list, so the buckets of the event list no longer reference the item.
+ */
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+    #define taskUNBUCKET_EVENT_LIST_ITEM( pxTCB )    prvUnbucketEventListItem( pxTCB )
+#else
+    #define taskUNBUCKET_EVENT_LIST_ITEM( pxTCB )
+#endif
+
+/*
+ * Must be called before a task is deleted, so the deadline heap no longer
+ * references the task.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define taskREMOVE_FROM_DEADLINE_HEAP( pxTCB )    prvDeadlineHeapRemove( pxTCB )
+#else
+    #define taskREMOVE_FROM_DEADLINE_HEAP( pxTCB )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Chooses the core whose ready lists a task that is becoming ready is added
+ * to.
+ */
+#if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+    #define taskSELECT_READY_LIST_CORE( pxTCB )    prvSelectReadyListCore( pxTCB )
+#else
+    #define taskSELECT_READY_LIST_CORE( pxTCB )
+#endif
+
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 0 )
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                     \
-    do {                                                                                                   \
-        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    #define prvAddTaskToReadyList( pxTCB )                                                                                      \
+    do {                                                                                                                        \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                                                \
+        taskRECORD_READY_TIME( pxTCB );                                                                                         \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                                     \
+        taskSELECT_READY_LIST_CORE( pxTCB );                                                                                    \
+        listINSERT_END( taskREADY_LIST( ( pxTCB )->xReadyListCoreID, ( pxTCB )->uxPriority ), &( ( pxTCB )->xStateListItem ) ); \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                                           \
+    } while( 0 )
+
+#else /* if ( configUSE_EDF_SCHEDULING == 0 ) */
+
+/*
+ * Place the task represented by pxTCB into the appropriate ready list for
+ * the task.  It is inserted at the end of the list, and tasks at
+ * configEDF_TASK_PRIORITY are also added to the deadline heap.
+ */
+    #define prvAddTaskToReadyList( pxTCB )                                                                     \
+    do {                                                                                                       \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                               \
+        taskRECORD_READY_TIME( pxTCB );                                                                        \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                    \
+                                                                                                               \
+        if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY )                                 \
+        {                                                                                                      \
+            prvAddTaskToDeadlineList( pxTCB );                                                                 \
+        }                                                                                                      \
+        else                                                                                                   \
+        {                                                                                                      \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                      \
+                                                                                                               \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                          \
     } while( 0 )
+
+#endif /* if ( configUSE_EDF_SCHEDULING == 0 ) */
 /*-----------------------------------------------------------*/
 
 /*
@@ -390,6 +660,9 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configNUMBER_OF_CORES > 1 )
         volatile BaseType_t xTaskRunState;      /**< Used to identify the core the task is running on, if the task is running. Otherwise, identifies the task's state - not running or yielding. */
         UBaseType_t uxTaskAttributes;           /**< Task's attributes - currently used to identify the idle tasks. */
+        #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+            BaseType_t xReadyListCoreID;        /**< The core whose ready lists the task is added to when it becomes ready - the core on which it last ran. */
+        #endif
     #endif
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /**< Descriptive name given to the task when created.  Facilitates debugging only. */
 
@@ -449,12 +722,73 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDeadline;          /**< The absolute deadline of the task's current job.  Only valid if xRelativeDeadline is not 0. */
+        TickType_t xRelativeDeadline;  /**< The deadline of each job relative to its release, or 0 if the task does not have a deadline. */
+        TickType_t xInheritedDeadline; /**< The deadline inherited from a task waiting for a mutex the task holds.  Only valid if ucDeadlineInherited is pdTRUE. */
+        UBaseType_t uxDeadlineMisses;  /**< The number of jobs that missed their deadline. */
+        struct tskTaskControlBlock * pxDeadlineChild;    /**< The first child of the task in the deadline heap. */
+        struct tskTaskControlBlock * pxDeadlineSibling;  /**< The next sibling of the task in the deadline heap. */
+        struct tskTaskControlBlock * pxDeadlinePrevious; /**< The previous sibling of the task in the deadline heap, or its parent if it is the first child.  NULL if the task is the root or is not in the heap. */
+        uint32_t ulDeadlineOrder;                        /**< Orders tasks with equal deadlines by when they were added to the deadline heap. */
+        uint8_t ucDeadlineMissCounted;                   /**< Set to pdTRUE once the current job has been counted as a deadline miss. */
+        uint8_t ucDeadlineInherited;                     /**< Set to pdTRUE while the task runs to the deadline in xInheritedDeadline, which is earlier than its own. */
+    #endif
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulReadyTime;                         /**< The run time counter value when the task last entered the Ready state. */
+        BaseType_t xReadyTimeRecorded;                                   /**< Set to pdTRUE when ulReadyTime is recorded, and back to pdFALSE when the task next runs. */
+        UBaseType_t uxLatencyHistogramEpoch;                             /**< The value of uxLatencyHistogramEpoch when ulLatencyHistogram was last cleared. */
+        uint32_t ulLatencyHistogram[ configLATENCY_HISTOGRAM_BUCKETS ]; /**< Counts of the task's scheduling latencies, bucketed by base 2 logarithm. */
+    #endif
+
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        ListItem_t xSnapshotListItem; /**< Used to reference the task from xSnapshotTaskList for the whole of the task's life. */
+    #endif
+
+    #if ( configUSE_TASK_POOLS == 1 )
+        struct tskTaskPool * pxTaskPool; /**< The pool the task's TCB and stack were taken from, or NULL if the task was not created in a pool. */
+    #endif
+
+    #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+        struct xEVENT_LIST_BUCKETS * pxEventListBuckets; /**< The buckets of the event list the task was placed on by vTaskPlaceOnBucketedEventList(), or NULL if the event list item is not bucketed. */
+        UBaseType_t uxEventListBucket;                   /**< The bucket within pxEventListBuckets that holds the task's event list item. */
+    #endif
+
+    #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        configSTACK_DEPTH_TYPE uxCachedStackHighWaterMark; /**< The stack high water mark last measured for the task.  Only valid while ucStackHighWaterMarkState is tskSTACK_HIGH_WATER_MARK_CACHED. */
+        uint8_t ucStackHighWaterMarkState;                 /**< Set to tskSTACK_HIGH_WATER_MARK_STALE each time the task is switched in, so the cached high water mark is only used if the task has not run since it was measured. */
+    #endif
+
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        TaskHandle_t * pxBlockingMutexHolder; /**< Points to the holder of the mutex the task is waiting for, or NULL if the task is not waiting for a mutex.  Only followed while the task's event list item is in an event list. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if ( configUSE_TASK_POOLS == 1 )
+
+/*
+ * Definition of a task pool.  The TCB of each free slot is referenced from
+ * xFreeTaskList through its xStateListItem, and keeps a pointer to the slot's
+ * stack in its pxStack member while the slot is free.
+ */
+    typedef struct tskTaskPool
+    {
+        List_t xFreeTaskList;                /**< The slots that are not in use. */
+        configSTACK_DEPTH_TYPE uxStackDepth; /**< The depth of the stack of each slot, in words. */
+        UBaseType_t uxSlots;                 /**< The number of slots in the pool. */
+        UBaseType_t uxMinimumEverFreeSlots;  /**< The lowest length xFreeTaskList has had. */
+        uint32_t ulAllocations;              /**< The number of tasks created in the pool. */
+        uint32_t ulFailedAllocations;        /**< The number of times a task could not be created because the pool had no free slot. */
+    } TaskPool_t;
+
+#endif /* configUSE_TASK_POOLS */
+
 #if ( configNUMBER_OF_CORES == 1 )
     /* MISRA Ref 8.4.1 [Declaration shall be visible] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-84 */
@@ -472,11 +806,21 @@ typedef tskTCB TCB_t;
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /**< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_HOME_CORE_READY_LISTS == 0 )
+    PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
+#else
+    PRIVILEGED_DATA static List_t pxCoreReadyTasksLists[ configNUMBER_OF_CORES ][ configMAX_PRIORITIES ]; /**< Prioritised ready tasks, held in the lists of the core on which each task last ran. */
+    PRIVILEGED_DATA static UBaseType_t uxReadyListCoreMasks[ configMAX_PRIORITIES ];                     /**< Bit n is set if core n's ready list at the priority may not be empty.  Set when a task is added and cleared when the list is found to be empty while selecting a task. */
+#endif
+#if ( configUSE_TIMING_WHEEL == 0 )
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                    /**< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                    /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;         /**< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList; /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+    PRIVILEGED_DATA static List_t xTimingWheel[ taskTIMING_WHEEL_LIST_COUNT ];                                             /**< Delayed tasks, held in unordered per-slot lists of the timing wheel. */
+    PRIVILEGED_DATA static uint32_t ulTimingWheelOccupied[ configTIMING_WHEEL_LEVELS ][ taskTIMING_WHEEL_BITMAP_WORDS ]; /**< Slots of each wheel level that may hold tasks. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -492,6 +836,16 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 
 #endif
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+/* uxSnapshotGeneration is incremented each time a task is removed from
+ * xSnapshotTaskList, so a snapshot can tell whether the last item it returned
+ * might no longer be in the list. */
+    PRIVILEGED_DATA static List_t xSnapshotTaskList; /**< All the tasks that have not been deleted, in the order in which they were created. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxSnapshotGeneration = ( UBaseType_t ) 0U;
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -510,6 +864,38 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];       /**< Holds the handles of the idle tasks.  The idle tasks are created automatically when the scheduler is started. */
 
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) )
+    #if ( configMAX_PRIORITIES > 32 )
+        PRIVILEGED_DATA static uint32_t ulReadyPriorityGroups = 0U;                                        /**< Bit n is set while ulReadyPriorityBitmap[ n ] is not zero. */
+    #endif
+    PRIVILEGED_DATA static uint32_t ulReadyPriorityBitmap[ ( configMAX_PRIORITIES + 31U ) / 32U ] = { 0U }; /**< Bit n % 32 of word n / 32 is set while pxReadyTasksLists[ n ] is not empty. */
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The ready tasks at configEDF_TASK_PRIORITY that have a deadline are also
+ * held in a pairing heap ordered by deadline, so the task with the earliest
+ * deadline is found without keeping the ready list sorted.  Tasks are not
+ * removed from the heap when they leave the ready list.  Instead a task found
+ * at the root that is no longer in the ready list is removed then. */
+    PRIVILEGED_DATA static TCB_t * pxDeadlineHeap = NULL;
+    PRIVILEGED_DATA static uint32_t ulDeadlineHeapInsertions = 0U;
+
+/* A task that holds a mutex wanted by a task with an earlier deadline runs to
+ * the waiting task's deadline instead of its own, so a task is in the heap if
+ * it has a deadline of its own or has inherited one. */
+    #define taskHAS_DEADLINE( pxTCB )           ( ( ( pxTCB )->xRelativeDeadline != ( TickType_t ) 0U ) || ( ( pxTCB )->ucDeadlineInherited != ( uint8_t ) pdFALSE ) )
+    #define taskSCHEDULING_DEADLINE( pxTCB )    ( ( ( pxTCB )->ucDeadlineInherited != ( uint8_t ) pdFALSE ) ? ( pxTCB )->xInheritedDeadline : ( pxTCB )->xDeadline )
+#endif
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+/* The number of data group critical sections each core is inside.  Yields
+ * requested while a core holds a data group spinlock are held pending until
+ * the outermost data group critical section is exited. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxDataGroupCriticalNesting[ configNUMBER_OF_CORES ] = { 0U };
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -538,6 +924,17 @@ PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ conf
 
 #endif
 
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+/* The histogram of a task is only valid if its uxLatencyHistogramEpoch matches
+ * uxLatencyHistogramEpoch, so incrementing uxLatencyHistogramEpoch clears the
+ * histograms of all the tasks without visiting each task. */
+PRIVILEGED_DATA static uint32_t ulLatencyHistogram[ configLATENCY_HISTOGRAM_BUCKETS ] = { 0U }; /**< Counts of the scheduling latencies of all tasks, bucketed by base 2 logarithm. */
+PRIVILEGED_DATA static UBaseType_t uxLatencyHistogramEpoch = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static volatile BaseType_t xLatencyHistogramResetPending = pdFALSE;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* File private functions. --------------------------------*/
@@ -625,9 +1022,9 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * Used by the idle task, and by xTaskCreateFromPool() when a pool has no free
+ * slot.  This checks to see if anything has been placed in the list of tasks
+ * waiting to be deleted.  If so the task is cleaned up and its TCB deleted.
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
@@ -638,6 +1035,52 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+/*
+ * Record the time at which the task pointed to by pxTCB entered the Ready
+ * state, unless a time is already recorded or the task is running.
+ */
+    static void prvRecordReadyTime( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the task pointed to by pxTCB is switched in.  Adds the time
+ * since the task entered the Ready state to the task's and the global
+ * scheduling latency histograms.
+ */
+    static void prvRecordSchedulingLatency( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/*
+ * Place pxListItem, the value of which is the tick count at which the owning
+ * task must leave the Blocked state, into the timing wheel slot that will be
+ * serviced at or before that time.  Returns the tick count at which that slot
+ * will next be serviced.
+ */
+    static TickType_t prvTimingWheelInsert( ListItem_t * const pxListItem,
+                                            const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Cascade the tasks held in the wheel slots that are aligned with xTimeNow
+ * down to lower levels, then return the level 0 slot that holds the tasks
+ * that must leave the Blocked state at xTimeNow.
+ */
+    static List_t * prvTimingWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return how many slots after uxFirstSlot, in the order they are serviced, the
+ * first slot of wheel level uxLevel that holds tasks is, or
+ * taskTIMING_WHEEL_SLOTS if none of the level's slots hold tasks.  Clears the
+ * bits of any empty slots it finds marked as occupied.
+ */
+    static UBaseType_t prvTimingWheelNextOccupiedSlot( const UBaseType_t uxLevel,
+                                                       const UBaseType_t uxFirstSlot ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_TIMING_WHEEL == 1 ) */
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -654,6 +1097,19 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Writes the least significant xBytes bytes of ulValue to pucBuffer, least
+ * significant byte first, and returns a pointer to the byte after the last one
+ * written.  Used to build the records written by xTaskSnapshotEncode().
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    static uint8_t * prvSnapshotPutValue( uint8_t * pucBuffer,
+                                          configRUN_TIME_COUNTER_TYPE ulValue,
+                                          size_t xBytes ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -670,9 +1126,27 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const StackType_t * pxStackWord ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the stack high water mark of the task pointed to by pxTCB, using the
+ * cached value if configUSE_STACK_HIGH_WATER_MARK_CACHE is 1 and the task has
+ * not run since its stack was last checked.
+ */
+    static configSTACK_DEPTH_TYPE prvGetStackHighWaterMark( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills in a TaskStackHighWaterMark_t structure for each task in pxList.
+ * Returns the number of structures filled in.
+ */
+#if ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvStackHighWaterMarksWithinSingleList( TaskStackHighWaterMark_t * pxHighWaterMarkArray,
+                                                                List_t * pxList ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -698,119 +1172,319 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
-#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) )
 
 /*
- * Helper function used to pad task names with spaces when printing out
- * human readable tables of task information.
+ * Clear the ready priority bitmap bit of a priority whose ready list has become
+ * empty, recalculating uxTopReadyPriority if it was the highest ready priority.
  */
-    static char * prvWriteNameToBuffer( char * pcBuffer,
-                                        const char * pcTaskName ) PRIVILEGED_FUNCTION;
-
+    static void prvResetReadyPriority( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) || ( configUSE_EVENT_LIST_BUCKETS == 1 ) || ( configUSE_TIMING_WHEEL == 1 ) ) && !defined( __GNUC__ ) )
+
 /*
- * Called after a Task_t structure has been allocated either statically or
- * dynamically to fill in the structure's members.
+ * Portable fallback for taskHIGHEST_SET_BIT() on compilers that do not provide
+ * a count leading zeros builtin.
  */
-static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName,
-                                  const configSTACK_DEPTH_TYPE uxStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask,
-                                  TCB_t * pxNewTCB,
-                                  const MemoryRegion_t * const xRegions ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvHighestSetBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
 
 /*
- * Called after a new task has been created and initialised to place the task
- * under the control of the scheduler.
+ * Remove any reference to the event list item of the task pointed to by pxTCB
+ * from the buckets of the event list the item is in.
  */
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+    static void prvUnbucketEventListItem( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 /*
- * Create a task with static buffer for both TCB and stack. Returns a handle to
- * the task if it is created successfully. Otherwise, returns NULL.
+ * Insert the event list item of the task pointed to by pxTCB into pxEventList
+ * at the position for the task's priority, using pxBuckets to find the
+ * position without searching the list.
  */
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
-                                        const char * const pcName,
-                                        const configSTACK_DEPTH_TYPE uxStackDepth,
-                                        void * const pvParameters,
-                                        UBaseType_t uxPriority,
-                                        StackType_t * const puxStackBuffer,
-                                        StaticTask_t * const pxTaskBuffer,
-                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
-#endif /* #if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    static void prvInsertIntoBucketedEventList( TCB_t * const pxTCB,
+                                                List_t * const pxEventList,
+                                                EventListBuckets_t * const pxBuckets ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
 
 /*
- * Create a restricted task with static buffer for both TCB and stack. Returns
- * a handle to the task if it is created successfully. Otherwise, returns NULL.
+ * Returns pdTRUE if the task pointed to by pxTCB is blocked waiting for a
+ * mutex, otherwise pdFALSE.
  */
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    static TCB_t * prvCreateRestrictedStaticTask( const TaskParameters_t * const pxTaskDefinition,
-                                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
-#endif /* #if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+    static BaseType_t prvIsBlockedOnMutex( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 /*
- * Create a restricted task with static buffer for task stack and allocated buffer
- * for TCB. Returns a handle to the task if it is created successfully. Otherwise,
- * returns NULL.
+ * Moves the event list item of a task that is blocked on a mutex to the
+ * position for the task's current priority.
  */
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-    static TCB_t * prvCreateRestrictedTask( const TaskParameters_t * const pxTaskDefinition,
-                                            TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
-#endif /* #if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+    static void prvRepositionEventListItem( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 /*
- * Create a task with allocated buffer for both TCB and stack. Returns a handle to
- * the task if it is created successfully. Otherwise, returns NULL.
+ * Changes the priority of a mutex holder that is not the calling task,
+ * moving it between ready lists if necessary.
  */
-#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName,
-                                  const configSTACK_DEPTH_TYPE uxStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
-#endif /* #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+    static void prvSetMutexHolderPriority( TCB_t * const pxTCB,
+                                           UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
 /*
- * freertos_tasks_c_additions_init() should only be called if the user definable
- * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
- * called by the function.
+ * Called after the task pointed to by pxTCB inherited uxPriority.  If the task
+ * is itself blocked on a mutex, the holder of that mutex inherits uxPriority
+ * too, and so on along the chain of blocked mutex holders, up to
+ * configMAX_PRIORITY_INHERITANCE_DEPTH tasks in total.
  */
-#ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+    static void prvInheritAlongChain( TCB_t * pxTCB,
+                                      UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
 
-    static void freertos_tasks_c_additions_init( void ) PRIVILEGED_FUNCTION;
+/*
+ * Called after the priority of the task pointed to by pxTCB was lowered
+ * because a task waiting for a mutex it holds timed out.  If the task is itself
+ * blocked on a mutex, the priority of the holder of that mutex is lowered to
+ * the higher of its base priority and the priority of the highest priority
+ * task still waiting for it, and so on along the chain.
+ */
+    static void prvDisinheritAlongChain( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
-#if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
-    extern void vApplicationPassiveIdleHook( void );
-#endif /* #if ( configUSE_PASSIVE_IDLE_HOOK == 1 ) */
+#if ( configUSE_HOME_CORE_READY_LISTS == 1 )
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+/*
+ * Returns the total number of tasks in the ready lists of all cores at
+ * uxPriority.  Only the lists of cores whose bit is set in
+ * uxReadyListCoreMasks[ uxPriority ] are read.
+ */
+    static UBaseType_t prvGetReadyListLength( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
 
 /*
- * Convert the snprintf return value to the number of characters
- * written. The following are the possible cases:
- *
- * 1. The buffer supplied to snprintf is large enough to hold the
- *    generated string. The return value in this case is the number
- *    of characters actually written, not counting the terminating
- *    null character.
- * 2. The buffer supplied to snprintf is NOT large enough to hold
- *    the generated string. The return value in this case is the
- *    number of characters that would have been written if the
- *    buffer had been sufficiently large, not counting the
- *    terminating null character.
- * 3. Encoding error. The return value in this case is a negative
- *    number.
- *
- * From 1 and 2 above ==> Only when the return value is non-negative
- * and less than the supplied buffer length, the string has been
- * completely written.
+ * Sets the xReadyListCoreID of a task that is about to be added to a ready
+ * list.  The task stays with the core on which it last ran unless its
+ * affinity no longer allows it to run there.
+ */
+    static void prvSelectReadyListCore( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move pxTCB, which must be in a ready list, to the end of the ready list of
+ * xCoreID at its priority.
+ */
+    static void prvMoveTaskToCoreReadyList( TCB_t * const pxTCB,
+                                            BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if pxTCB must run before pxOtherTCB when both are ready at
+ * configEDF_TASK_PRIORITY - that is, if pxTCB has a deadline and pxOtherTCB
+ * either has no deadline or has a later one.
+ */
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                            const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxTCB comes before pxOtherTCB in the deadline heap - that
+ * is, if pxTCB has the earlier deadline, or the deadlines are equal and pxTCB
+ * was added to the heap first.  Both tasks must have a deadline.
+ */
+    static BaseType_t prvDeadlineHeapPrecedes( const TCB_t * const pxTCB,
+                                               const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Link the roots of two deadline heaps, returning the root of the combined
+ * heap.
+ */
+    static TCB_t * prvDeadlineHeapLink( TCB_t * pxTCB,
+                                        TCB_t * pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Combine a list of sibling heaps, starting at pxFirst, into a single heap and
+ * return its root, or NULL if pxFirst is NULL.
+ */
+    static TCB_t * prvDeadlineHeapMergePairs( TCB_t * pxFirst ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add pxTCB to the deadline heap, removing it first if it is already in the
+ * heap.  pxTCB must have a deadline.
+ */
+    static void prvDeadlineHeapInsert( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxTCB from the deadline heap if it is in the heap.
+ */
+    static void prvDeadlineHeapRemove( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the ready task at configEDF_TASK_PRIORITY with the earliest
+ * deadline, or, if none of the ready tasks at that priority have a deadline,
+ * the task at the head of the ready list.  The ready list must not be empty.
+ */
+    static TCB_t * prvGetEarliestDeadlineTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert pxTCB into the ready list at configEDF_TASK_PRIORITY, and into the
+ * deadline heap if the task has a deadline.
+ */
+    static void prvAddTaskToDeadlineList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the absolute deadline of pxTCB, which releases a new job of the task,
+ * moving the task to its new position in the deadline heap if it is ready at
+ * configEDF_TASK_PRIORITY.
+ */
+    static void prvSetTaskDeadline( TCB_t * const pxTCB,
+                                    const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add pxTCB to, move it within, or remove it from the deadline heap after its
+ * deadline changed, depending on whether it now has a deadline and is ready at
+ * configEDF_TASK_PRIORITY.
+ */
+    static void prvRepositionInDeadlineHeap( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_MUTEXES == 1 )
+
+/*
+ * Called when the calling task is about to block on a mutex held by
+ * pxMutexHolderTCB.  If both tasks are at configEDF_TASK_PRIORITY and the
+ * calling task's deadline is earlier, the holder runs to the calling task's
+ * deadline until it no longer holds any mutexes, so it cannot be starved by
+ * tasks with deadlines between the two.
+ */
+        static void prvInheritDeadline( TCB_t * const pxMutexHolderTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pxTCB to its own deadline, or to having no deadline, once it holds
+ * no mutexes.  Returns pdTRUE if pxTCB had inherited a deadline.
+ */
+        static BaseType_t prvDisinheritDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Count the current job of pxTCB as a deadline miss if its deadline has
+ * passed and the job has not already been counted.
+ */
+    static void prvCheckDeadlineMissed( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+/*
+ * Helper function used to pad task names with spaces when printing out
+ * human readable tables of task information.
+ */
+    static char * prvWriteNameToBuffer( char * pcBuffer,
+                                        const char * pcTaskName ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called after a Task_t structure has been allocated either statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName,
+                                  const configSTACK_DEPTH_TYPE uxStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask,
+                                  TCB_t * pxNewTCB,
+                                  const MemoryRegion_t * const xRegions ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a new task has been created and initialised to place the task
+ * under the control of the scheduler.
+ */
+static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Create a task with static buffer for both TCB and stack. Returns a handle to
+ * the task if it is created successfully. Otherwise, returns NULL.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName,
+                                        const configSTACK_DEPTH_TYPE uxStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+/*
+ * Create a restricted task with static buffer for both TCB and stack. Returns
+ * a handle to the task if it is created successfully. Otherwise, returns NULL.
+ */
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    static TCB_t * prvCreateRestrictedStaticTask( const TaskParameters_t * const pxTaskDefinition,
+                                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+
+/*
+ * Create a restricted task with static buffer for task stack and allocated buffer
+ * for TCB. Returns a handle to the task if it is created successfully. Otherwise,
+ * returns NULL.
+ */
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    static TCB_t * prvCreateRestrictedTask( const TaskParameters_t * const pxTaskDefinition,
+                                            TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+
+/*
+ * Create a task with allocated buffer for both TCB and stack. Returns a handle to
+ * the task if it is created successfully. Otherwise, returns NULL.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName,
+                                  const configSTACK_DEPTH_TYPE uxStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif /* #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+
+/*
+ * freertos_tasks_c_additions_init() should only be called if the user definable
+ * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
+ * called by the function.
+ */
+#ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+
+    static void freertos_tasks_c_additions_init( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+    extern void vApplicationPassiveIdleHook( void );
+#endif /* #if ( configUSE_PASSIVE_IDLE_HOOK == 1 ) */
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+/*
+ * Convert the snprintf return value to the number of characters
+ * written. The following are the possible cases:
+ *
+ * 1. The buffer supplied to snprintf is large enough to hold the
+ *    generated string. The return value in this case is the number
+ *    of characters actually written, not counting the terminating
+ *    null character.
+ * 2. The buffer supplied to snprintf is NOT large enough to hold
+ *    the generated string. The return value in this case is the
+ *    number of characters that would have been written if the
+ *    buffer had been sufficiently large, not counting the
+ *    terminating null character.
+ * 3. Encoding error. The return value in this case is a negative
+ *    number.
+ *
+ * From 1 and 2 above ==> Only when the return value is non-negative
+ * and less than the supplied buffer length, the string has been
+ * completely written.
  */
     static size_t prvSnprintfReturnValueToCharsWritten( int iSnprintfReturnValue,
                                                         size_t n );
@@ -1029,12 +1703,19 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
          *
          * To fix these problems, the running task should be put to the end of the
          * ready list before searching for the ready task in the ready list. */
-        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
-                                     &pxCurrentTCBs[ xCoreID ]->xStateListItem ) == pdTRUE )
+        if( taskIS_IN_READY_LIST( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->uxPriority ) == pdTRUE )
         {
-            ( void ) uxListRemove( &pxCurrentTCBs[ xCoreID ]->xStateListItem );
-            vListInsertEnd( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
-                            &pxCurrentTCBs[ xCoreID ]->xStateListItem );
+            #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+            {
+                prvMoveTaskToCoreReadyList( pxCurrentTCBs[ xCoreID ], xCoreID );
+            }
+            #else
+            {
+                ( void ) uxListRemove( &pxCurrentTCBs[ xCoreID ]->xStateListItem );
+                vListInsertEnd( taskREADY_LIST( xCoreID, pxCurrentTCBs[ xCoreID ]->uxPriority ),
+                                &pxCurrentTCBs[ xCoreID ]->xStateListItem );
+            }
+            #endif
         }
 
         while( xTaskScheduled == pdFALSE )
@@ -1051,77 +1732,120 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif
 
-            if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+            if( taskREADY_LIST_LENGTH( uxCurrentPriority ) > 0U )
             {
-                const List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
-                const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
-                ListItem_t * pxIterator;
+                BaseType_t xReadyListIndex;
 
                 /* The ready task list for uxCurrentPriority is not empty, so uxTopReadyPriority
                  * must not be decremented any further. */
                 xDecrementTopPriority = pdFALSE;
 
-                for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                /* Search this core's ready list first.  If each core has its
+                 * own ready lists then continue with those of the other
+                 * cores, taking a task this core can run from whichever core
+                 * has one. */
+                for( xReadyListIndex = ( BaseType_t ) 0; ( xReadyListIndex < taskREADY_LIST_COUNT ) && ( xTaskScheduled == pdFALSE ); xReadyListIndex++ )
                 {
-                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-                    /* coverity[misra_c_2012_rule_11_5_violation] */
-                    pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+                    const BaseType_t xReadyListCoreID = ( BaseType_t ) ( ( xCoreID + xReadyListIndex ) % ( BaseType_t ) configNUMBER_OF_CORES );
+                    const List_t * const pxReadyList = taskREADY_LIST( xReadyListCoreID, uxCurrentPriority );
+                    const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
+                    ListItem_t * pxIterator;
 
-                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                    #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
                     {
-                        /* When falling back to the idle priority because only one priority
-                         * level is allowed to run at a time, we should ONLY schedule the true
-                         * idle tasks, not user tasks at the idle priority. */
-                        if( uxCurrentPriority < uxTopReadyPriority )
+                        /* Skip the lists of cores that have no tasks at this
+                         * priority without reading them, and forget lists
+                         * that have become empty. */
+                        if( ( uxReadyListCoreMasks[ uxCurrentPriority ] & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xReadyListCoreID ) ) == 0U )
                         {
-                            if( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U )
-                            {
-                                continue;
-                            }
+                            continue;
+                        }
+
+                        if( listLIST_IS_EMPTY( pxReadyList ) != pdFALSE )
+                        {
+                            uxReadyListCoreMasks[ uxCurrentPriority ] &= ( UBaseType_t ) ~( ( UBaseType_t ) 1U << ( UBaseType_t ) xReadyListCoreID );
+                            continue;
                         }
                     }
-                    #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
+                    #else
+                    {
+                        /* There is only the one shared list. */
+                        ( void ) xReadyListCoreID;
+                    }
+                    #endif /* if ( configUSE_HOME_CORE_READY_LISTS == 1 ) */
 
-                    if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
                     {
-                        #if ( configUSE_CORE_AFFINITY == 1 )
-                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                        #endif
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+                        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                        {
+                            /* When falling back to the idle priority because only one priority
+                             * level is allowed to run at a time, we should ONLY schedule the true
+                             * idle tasks, not user tasks at the idle priority. */
+                            if( uxCurrentPriority < uxTopReadyPriority )
+                            {
+                                if( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U )
+                                {
+                                    continue;
+                                }
+                            }
+                        }
+                        #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
+
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
                         {
-                            /* If the task is not being executed by any core swap it in. */
-                            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
                             #if ( configUSE_CORE_AFFINITY == 1 )
-                                pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
                             #endif
-                            pxTCB->xTaskRunState = xCoreID;
-                            pxCurrentTCBs[ xCoreID ] = pxTCB;
-                            xTaskScheduled = pdTRUE;
+                            {
+                                /* If the task is not being executed by any core swap it in. */
+                                pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                                #if ( configUSE_CORE_AFFINITY == 1 )
+                                    pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                                #endif
+                                pxTCB->xTaskRunState = xCoreID;
+                                #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+                                {
+                                    /* A task taken from another core's list
+                                     * now belongs to this core. */
+                                    if( xReadyListCoreID != xCoreID )
+                                    {
+                                        prvMoveTaskToCoreReadyList( pxTCB, xCoreID );
+                                    }
+                                }
+                                #endif
+                                pxCurrentTCBs[ xCoreID ] = pxTCB;
+                                xTaskScheduled = pdTRUE;
+                            }
                         }
-                    }
-                    else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
-                    {
-                        configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+                        else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                        {
+                            configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
 
-                        #if ( configUSE_CORE_AFFINITY == 1 )
-                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                        #endif
+                            #if ( configUSE_CORE_AFFINITY == 1 )
+                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                            #endif
+                            {
+                                /* The task is already running on this core, mark it as scheduled. */
+                                pxTCB->xTaskRunState = xCoreID;
+                                xTaskScheduled = pdTRUE;
+                            }
+                        }
+                        else
                         {
-                            /* The task is already running on this core, mark it as scheduled. */
-                            pxTCB->xTaskRunState = xCoreID;
-                            xTaskScheduled = pdTRUE;
+                            /* This task is running on the core other than xCoreID. */
+                            mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                    else
-                    {
-                        /* This task is running on the core other than xCoreID. */
-                        mtCOVERAGE_TEST_MARKER();
-                    }
 
-                    if( xTaskScheduled != pdFALSE )
-                    {
-                        /* A task has been selected to run on this core. */
-                        break;
+                        if( xTaskScheduled != pdFALSE )
+                        {
+                            /* A task has been selected to run on this core. */
+                            break;
+                        }
                     }
                 }
             }
@@ -1181,7 +1905,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         {
             if( xTaskScheduled == pdTRUE )
             {
-                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+                if( ( pxPreviousTCB != NULL ) && ( taskIS_IN_READY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ) != pdFALSE ) )
                 {
                     /* A ready task was just evicted from this core. See if it can be
                      * scheduled on any other core. */
@@ -1403,27 +2127,225 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    static TCB_t * prvCreateRestrictedStaticTask( const TaskParameters_t * const pxTaskDefinition,
-                                                  TaskHandle_t * const pxCreatedTask )
+#if ( configUSE_TASK_POOLS == 1 )
+
+    TaskPoolHandle_t xTaskPoolCreateStatic( UBaseType_t uxSlots,
+                                            configSTACK_DEPTH_TYPE uxStackDepth,
+                                            StackType_t * const puxStackBuffers,
+                                            StaticTask_t * const pxTaskBuffers,
+                                            StaticTaskPool_t * const pxTaskPoolBuffer )
     {
-        TCB_t * pxNewTCB;
+        TaskPool_t * pxPool = NULL;
+        TCB_t * pxTCB;
+        UBaseType_t uxSlot;
 
-        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
-        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+        traceENTER_xTaskPoolCreateStatic( uxSlots, uxStackDepth, puxStackBuffers, pxTaskBuffers, pxTaskPoolBuffer );
 
-        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        configASSERT( puxStackBuffers != NULL );
+        configASSERT( pxTaskBuffers != NULL );
+        configASSERT( pxTaskPoolBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
-            ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTaskPool_t equals the size of the real
+             * task pool structure. */
+            volatile size_t xSize = sizeof( StaticTaskPool_t );
+            configASSERT( xSize == sizeof( TaskPool_t ) );
+            ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
 
-            /* Store the stack location in the TCB. */
-            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+        if( ( puxStackBuffers != NULL ) && ( pxTaskBuffers != NULL ) && ( pxTaskPoolBuffer != NULL ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxPool = ( TaskPool_t * ) pxTaskPoolBuffer;
 
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            vListInitialise( &( pxPool->xFreeTaskList ) );
+            pxPool->uxStackDepth = uxStackDepth;
+            pxPool->uxSlots = uxSlots;
+            pxPool->uxMinimumEverFreeSlots = uxSlots;
+            pxPool->ulAllocations = 0U;
+            pxPool->ulFailedAllocations = 0U;
+
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < uxSlots; uxSlot++ )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxTCB = ( TCB_t * ) &( pxTaskBuffers[ uxSlot ] );
+                pxTCB->pxStack = &( puxStackBuffers[ ( size_t ) uxSlot * ( size_t ) uxStackDepth ] );
+
+                vListInitialiseItem( &( pxTCB->xStateListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxTCB->xStateListItem ), pxTCB );
+                vListInsertEnd( &( pxPool->xFreeTaskList ), &( pxTCB->xStateListItem ) );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskPoolCreateStatic( pxPool );
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+                                      TaskFunction_t pxTaskCode,
+                                      const char * const pcName,
+                                      void * const pvParameters,
+                                      UBaseType_t uxPriority )
+    {
+        TaskPool_t * const pxPool = xTaskPool;
+        TaskHandle_t xReturn = NULL;
+        TCB_t * pxSlotTCB = NULL;
+        TCB_t * pxNewTCB;
+        UBaseType_t uxFreeSlots;
+
+        traceENTER_xTaskCreateFromPool( xTaskPool, pxTaskCode, pcName, pvParameters, uxPriority );
+
+        configASSERT( pxPool != NULL );
+
+        #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            /* The slot of a task that deleted itself is only returned to its
+             * pool when the task is cleaned up, which is normally done by the
+             * idle task.  Rather than fail, clean up such tasks now. */
+            if( listLIST_IS_EMPTY( &( pxPool->xFreeTaskList ) ) != pdFALSE )
+            {
+                if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+                {
+                    prvCheckTasksWaitingTermination();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_vTaskDelete */
+
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_IS_EMPTY( &( pxPool->xFreeTaskList ) ) == pdFALSE )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxSlotTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxPool->xFreeTaskList ) );
+                uxFreeSlots = uxListRemove( &( pxSlotTCB->xStateListItem ) );
+
+                if( uxFreeSlots < pxPool->uxMinimumEverFreeSlots )
+                {
+                    pxPool->uxMinimumEverFreeSlots = uxFreeSlots;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxPool->ulAllocations++;
+            }
+            else
+            {
+                pxPool->ulFailedAllocations++;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxSlotTCB != NULL )
+        {
+            /* The slot is no longer referenced from the pool, so can be
+             * initialised outside of the critical section. */
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, pxPool->uxStackDepth, pvParameters, uxPriority, pxSlotTCB->pxStack, ( StaticTask_t * ) pxSlotTCB, &xReturn );
+
+            if( pxNewTCB != NULL )
+            {
+                pxNewTCB->pxTaskPool = pxPool;
+
+                #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+                {
+                    /* Set the task's affinity before scheduling it. */
+                    pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+                }
+                #endif
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskCreateFromPool( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPoolGetStats( TaskPoolHandle_t xTaskPool,
+                            TaskPoolStats_t * pxTaskPoolStats )
+    {
+        const TaskPool_t * const pxPool = xTaskPool;
+
+        traceENTER_vTaskPoolGetStats( xTaskPool, pxTaskPoolStats );
+
+        configASSERT( pxPool != NULL );
+        configASSERT( pxTaskPoolStats != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxTaskPoolStats->uxSlots = pxPool->uxSlots;
+            pxTaskPoolStats->uxFreeSlots = listCURRENT_LIST_LENGTH( &( pxPool->xFreeTaskList ) );
+            pxTaskPoolStats->uxMinimumEverFreeSlots = pxPool->uxMinimumEverFreeSlots;
+            pxTaskPoolStats->ulAllocations = pxPool->ulAllocations;
+            pxTaskPoolStats->ulFailedAllocations = pxPool->ulFailedAllocations;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskPoolGetStats();
+    }
+
+#endif /* configUSE_TASK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    static TCB_t * prvCreateRestrictedStaticTask( const TaskParameters_t * const pxTaskDefinition,
+                                                  TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
+        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        {
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+            ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+            /* Store the stack location in the TCB. */
+            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
             {
                 /* Tasks can be created statically or dynamically, so note this
                  * task was created statically in case the task is later deleted. */
@@ -1809,6 +2731,44 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         }
     #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+                                        const char * const pcName,
+                                        const configSTACK_DEPTH_TYPE uxStackDepth,
+                                        void * const pvParameters,
+                                        TickType_t xRelativeDeadline,
+                                        TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
+
+            traceENTER_xTaskCreateDeadline( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, pxCreatedTask );
+
+            configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, ( UBaseType_t ) configEDF_TASK_PRIORITY, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
+            {
+                /* Set the task's deadline before scheduling it.  The first job
+                 * is released now. */
+                pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+                pxNewTCB->xDeadline = ( TickType_t ) ( xTickCount + xRelativeDeadline );
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+            }
+
+            traceRETURN_xTaskCreateDeadline( xReturn );
+
+            return xReturn;
+        }
+    #endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
@@ -1940,6 +2900,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xSnapshotListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xSnapshotListItem ), pxNewTCB );
+    }
+    #endif
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, uxStackDepth );
@@ -2096,6 +3063,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            #if ( configUSE_TASK_SNAPSHOT == 1 )
+            {
+                vListInsertEnd( &xSnapshotTaskList, &( pxNewTCB->xSnapshotListItem ) );
+            }
+            #endif
+
             prvAddTaskToReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -2153,6 +3126,20 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            #if ( configUSE_TASK_SNAPSHOT == 1 )
+            {
+                vListInsertEnd( &xSnapshotTaskList, &( pxNewTCB->xSnapshotListItem ) );
+            }
+            #endif
+
+            #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+            {
+                /* A new task has not run on any core yet, so new tasks are
+                 * spread over the cores in turn. */
+                pxNewTCB->xReadyListCoreID = ( BaseType_t ) ( uxTaskNumber % ( UBaseType_t ) configNUMBER_OF_CORES );
+            }
+            #endif
+
             prvAddTaskToReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -2235,9 +3222,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            taskREMOVE_FROM_DEADLINE_HEAP( pxTCB );
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
+                taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
                 ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
             }
             else
@@ -2245,6 +3235,15 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_TASK_SNAPSHOT == 1 )
+            {
+                /* The task is no longer reported by snapshots.  Any snapshot
+                 * that last returned this task must find its position again. */
+                ( void ) uxListRemove( &( pxTCB->xSnapshotListItem ) );
+                uxSnapshotGeneration++;
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -2419,6 +3418,24 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                if( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0U )
+                {
+                    /* Calling this function completes the task's current job,
+                     * which missed its deadline if the deadline has passed. */
+                    prvCheckDeadlineMissed( pxCurrentTCB );
+
+                    /* The next job is released at the wake time. */
+                    prvSetTaskDeadline( pxCurrentTCB, ( TickType_t ) ( xTimeToWake + pxCurrentTCB->xRelativeDeadline ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+
             if( xShouldDelay != pdFALSE )
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -2510,8 +3527,11 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         eTaskState eReturn;
         List_t const * pxStateList;
         List_t const * pxEventList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+
+        #if ( configUSE_TIMING_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+        #endif
         const TCB_t * const pxTCB = xTask;
 
         traceENTER_eTaskGetState( xTask );
@@ -2531,8 +3551,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
                 pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+
+                #if ( configUSE_TIMING_WHEEL == 0 )
+                {
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                }
+                #endif
             }
             taskEXIT_CRITICAL();
 
@@ -2543,7 +3568,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * item is currently placed on. */
                 eReturn = eReady;
             }
-            else if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+
+            #if ( configUSE_TIMING_WHEEL == 0 )
+                else if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #else
+                else if( taskLIST_IS_TIMING_WHEEL_LIST( pxStateList ) )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -2936,7 +3966,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * nothing more than change its priority variable. However, if
                  * the task is in a ready list it needs to be removed and placed
                  * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                if( taskIS_IN_READY_LIST( pxTCB, uxPriorityUsedOnEntry ) != pdFALSE )
                 {
                     /* The task is currently in its ready list - remove before
                      * adding it to its new ready list.  As we are in a critical
@@ -3006,6 +4036,50 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskSetDeadline( xTask, xRelativeDeadline );
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            /* Releasing a new job completes the current one. */
+            prvCheckDeadlineMissed( pxTCB );
+
+            pxTCB->xRelativeDeadline = xRelativeDeadline;
+            prvSetTaskDeadline( pxTCB, ( TickType_t ) ( xTickCount + xRelativeDeadline ) );
+
+            /* The running task should yield if it was running at
+             * configEDF_TASK_PRIORITY and no longer has the earliest
+             * deadline. */
+            if( ( xSchedulerRunning != pdFALSE ) &&
+                ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&
+                ( prvGetEarliestDeadlineTask() != pxCurrentTCB ) )
+            {
+                taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxCurrentTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetDeadline();
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
     void vTaskCoreAffinitySet( const TaskHandle_t xTask,
                                UBaseType_t uxCoreAffinityMask )
@@ -3175,6 +4249,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
+                taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
                 ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
             }
             else
@@ -3484,7 +4559,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         /* Ready lists can be accessed so move the task from the
                          * suspended list to the ready list directly. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             xYieldRequired = pdTRUE;
 
@@ -3509,6 +4584,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                      * is held in the pending ready list until the scheduler is
                      * unsuspended. */
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
@@ -3676,6 +4752,12 @@ static BaseType_t prvCreateIdleTasks( void )
                 /* Assign idle task to each core before SMP scheduler is running. */
                 xIdleTaskHandles[ xCoreID ]->xTaskRunState = xCoreID;
                 pxCurrentTCBs[ xCoreID ] = xIdleTaskHandles[ xCoreID ];
+
+                #if ( configUSE_HOME_CORE_READY_LISTS == 1 )
+                {
+                    prvMoveTaskToCoreReadyList( xIdleTaskHandles[ xCoreID ], xCoreID );
+                }
+                #endif
             }
             #endif
         }
@@ -3982,7 +5064,7 @@ void vTaskSuspendAll( void )
         {
             xReturn = 0;
         }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1U )
+        else if( taskREADY_LIST_LENGTH( tskIDLE_PRIORITY ) > 1U )
         {
             /* There are other idle priority tasks in the ready state.  If
              * time slicing is used then the very next tick interrupt must be
@@ -4056,7 +5138,7 @@ BaseType_t xTaskResumeAll( void )
                         {
                             /* If the moved task has a priority higher than the current
                              * task then a yield must be performed. */
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xYieldPendings[ xCoreID ] = pdTRUE;
                             }
@@ -4317,7 +5399,8 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery )
     {
         UBaseType_t uxQueue = configMAX_PRIORITIES;
-        TCB_t * pxTCB;
+        TCB_t * pxTCB = NULL;
+        BaseType_t xReadyListIndex;
 
         traceENTER_xTaskGetHandle( pcNameToQuery );
 
@@ -4330,7 +5413,11 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
             do
             {
                 uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                for( xReadyListIndex = ( BaseType_t ) 0; ( xReadyListIndex < taskREADY_LIST_COUNT ) && ( pxTCB == NULL ); xReadyListIndex++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) taskREADY_LIST( xReadyListIndex, uxQueue ), pcNameToQuery );
+                }
 
                 if( pxTCB != NULL )
                 {
@@ -4340,15 +5427,28 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
             /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            #if ( configUSE_TIMING_WHEEL == 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
 
-            if( pxTCB == NULL )
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #else /* if ( configUSE_TIMING_WHEEL == 0 ) */
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                UBaseType_t uxWheelList;
+
+                for( uxWheelList = 0U; ( uxWheelList < taskTIMING_WHEEL_LIST_COUNT ) && ( pxTCB == NULL ); uxWheelList++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xTimingWheel[ uxWheelList ] ), pcNameToQuery );
+                }
             }
+            #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -4442,6 +5542,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
     {
         UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        BaseType_t xReadyListIndex;
 
         traceENTER_uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
 
@@ -4455,13 +5556,28 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 do
                 {
                     uxQueue--;
-                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady ) );
+
+                    for( xReadyListIndex = ( BaseType_t ) 0; xReadyListIndex < taskREADY_LIST_COUNT; xReadyListIndex++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), taskREADY_LIST( xReadyListIndex, uxQueue ), eReady ) );
+                    }
                 } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked ) );
+                #if ( configUSE_TIMING_WHEEL == 0 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked ) );
+                }
+                #else
+                {
+                    for( uxQueue = 0U; uxQueue < taskTIMING_WHEEL_LIST_COUNT; uxQueue++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheel[ uxQueue ] ), eBlocked ) );
+                    }
+                }
+                #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -4514,22 +5630,206 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configUSE_TASK_SNAPSHOT == 1 )
 
-    #if ( configNUMBER_OF_CORES == 1 )
-        TaskHandle_t xTaskGetIdleTaskHandle( void )
-        {
-            traceENTER_xTaskGetIdleTaskHandle();
+    void vTaskSnapshotBegin( TaskSnapshot_t * const pxSnapshot )
+    {
+        traceENTER_vTaskSnapshotBegin( pxSnapshot );
 
-            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-             * started, then xIdleTaskHandles will be NULL. */
-            configASSERT( ( xIdleTaskHandles[ 0 ] != NULL ) );
+        configASSERT( pxSnapshot != NULL );
 
-            traceRETURN_xTaskGetIdleTaskHandle( xIdleTaskHandles[ 0 ] );
+        /* A NULL last item means no task has been returned yet. */
+        pxSnapshot->pvLastItem = NULL;
+        pxSnapshot->uxLastTaskNumber = ( UBaseType_t ) 0U;
+        pxSnapshot->uxGeneration = ( UBaseType_t ) 0U;
 
-            return xIdleTaskHandles[ 0 ];
-        }
-    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        traceRETURN_vTaskSnapshotBegin();
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    UBaseType_t uxTaskSnapshotNext( TaskSnapshot_t * const pxSnapshot,
+                                    TaskStatus_t * const pxTaskStatusArray,
+                                    const UBaseType_t uxArraySize,
+                                    const BaseType_t xGetFreeStackSpace )
+    {
+        UBaseType_t uxTask = 0;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+
+        traceENTER_uxTaskSnapshotNext( pxSnapshot, pxTaskStatusArray, uxArraySize, xGetFreeStackSpace );
+
+        configASSERT( pxSnapshot != NULL );
+        configASSERT( ( pxTaskStatusArray != NULL ) || ( uxArraySize == 0U ) );
+
+        vTaskSuspendAll();
+        {
+            pxEndMarker = listGET_END_MARKER( &xSnapshotTaskList );
+
+            if( pxSnapshot->pvLastItem == NULL )
+            {
+                pxIterator = listGET_HEAD_ENTRY( &xSnapshotTaskList );
+            }
+            else if( pxSnapshot->uxGeneration == uxSnapshotGeneration )
+            {
+                /* No task has been removed from the list since the previous
+                 * call, so the last item returned is still in the list and the
+                 * snapshot can continue from the item that follows it. */
+                pxIterator = listGET_NEXT( ( ListItem_t * ) pxSnapshot->pvLastItem );
+            }
+            else
+            {
+                /* The last item returned may have been removed, so find the
+                 * first task created after it instead.  Tasks are appended to
+                 * the list as they are created, so the list is in task number
+                 * order. */
+                for( pxIterator = listGET_HEAD_ENTRY( &xSnapshotTaskList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                    if( pxTCB->uxTCBNumber > pxSnapshot->uxLastTaskNumber )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+
+            while( ( uxTask < uxArraySize ) && ( pxIterator != pxEndMarker ) )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                vTaskGetInfo( ( TaskHandle_t ) pxTCB, &( pxTaskStatusArray[ uxTask ] ), xGetFreeStackSpace, eInvalid );
+                uxTask++;
+
+                pxSnapshot->pvLastItem = ( void * ) pxIterator;
+                pxSnapshot->uxLastTaskNumber = pxTCB->uxTCBNumber;
+                pxIterator = listGET_NEXT( pxIterator );
+            }
+
+            pxSnapshot->uxGeneration = uxSnapshotGeneration;
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxTaskSnapshotNext( uxTask );
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    static uint8_t * prvSnapshotPutValue( uint8_t * pucBuffer,
+                                          configRUN_TIME_COUNTER_TYPE ulValue,
+                                          size_t xBytes )
+    {
+        size_t x;
+
+        /* Values are stored little endian.  Bytes beyond the width of the
+         * value are written as zero. */
+        for( x = 0U; x < xBytes; x++ )
+        {
+            pucBuffer[ x ] = ( uint8_t ) ( ulValue & ( configRUN_TIME_COUNTER_TYPE ) 0xFFU );
+            ulValue >>= 8U;
+        }
+
+        return &( pucBuffer[ xBytes ] );
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    size_t xTaskSnapshotEncode( const TaskStatus_t * const pxTaskStatusArray,
+                                const UBaseType_t uxArraySize,
+                                uint8_t * const pucBuffer,
+                                const size_t xBufferLength )
+    {
+        size_t xBytesWritten = 0U;
+        size_t x;
+        UBaseType_t uxTask;
+        uint8_t * pucRecord;
+        const TaskStatus_t * pxStatus;
+
+        traceENTER_xTaskSnapshotEncode( pxTaskStatusArray, uxArraySize, pucBuffer, xBufferLength );
+
+        for( uxTask = 0U; uxTask < uxArraySize; uxTask++ )
+        {
+            if( ( xBufferLength - xBytesWritten ) < tskSNAPSHOT_RECORD_LENGTH )
+            {
+                break;
+            }
+
+            pxStatus = &( pxTaskStatusArray[ uxTask ] );
+            pucRecord = &( pucBuffer[ xBytesWritten ] );
+
+            pucRecord = prvSnapshotPutValue( pucRecord, ( configRUN_TIME_COUNTER_TYPE ) pxStatus->xTaskNumber, 4U );
+            pucRecord = prvSnapshotPutValue( pucRecord, pxStatus->ulRunTimeCounter, 8U );
+            pucRecord = prvSnapshotPutValue( pucRecord, ( configRUN_TIME_COUNTER_TYPE ) pxStatus->usStackHighWaterMark, 4U );
+            pucRecord = prvSnapshotPutValue( pucRecord, ( configRUN_TIME_COUNTER_TYPE ) pxStatus->uxCurrentPriority, 2U );
+            pucRecord = prvSnapshotPutValue( pucRecord, ( configRUN_TIME_COUNTER_TYPE ) pxStatus->uxBasePriority, 2U );
+            pucRecord = prvSnapshotPutValue( pucRecord, ( configRUN_TIME_COUNTER_TYPE ) pxStatus->eCurrentState, 1U );
+
+            /* The name is copied up to its terminator, then padded with
+             * zeros. */
+            for( x = 0U; x < ( size_t ) configMAX_TASK_NAME_LEN; x++ )
+            {
+                if( pxStatus->pcTaskName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+
+                pucRecord[ x ] = ( uint8_t ) pxStatus->pcTaskName[ x ];
+            }
+
+            for( ; x < ( size_t ) configMAX_TASK_NAME_LEN; x++ )
+            {
+                pucRecord[ x ] = 0U;
+            }
+
+            xBytesWritten += tskSNAPSHOT_RECORD_LENGTH;
+        }
+
+        traceRETURN_xTaskSnapshotEncode( xBytesWritten );
+
+        return xBytesWritten;
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            traceENTER_xTaskGetIdleTaskHandle();
+
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandles will be NULL. */
+            configASSERT( ( xIdleTaskHandles[ 0 ] != NULL ) );
+
+            traceRETURN_xTaskGetIdleTaskHandle( xIdleTaskHandles[ 0 ] );
+
+            return xIdleTaskHandles[ 0 ];
+        }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
     TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
     {
@@ -4658,6 +5958,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 {
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
                     {
+                        taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
                         ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 
                         /* This lets the task know it was forcibly removed from the
@@ -4684,7 +5985,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          * performed if the unblocked task has a priority that is
                          * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -4764,16 +6065,40 @@ BaseType_t xTaskIncrementTick( void )
          * look any further down the list. */
         if( xConstTickCount >= xNextTaskUnblockTime )
         {
+            /* The list is accessed through a volatile pointer, as
+             * pxDelayedTaskList is, so its head is read again after each task
+             * is removed.  listREMOVE_ITEM() updates the list's end marker
+             * through a ListItem_t pointer, which the compiler may otherwise
+             * assume does not change the end marker's MiniListItem_t. */
+            #if ( configUSE_TIMING_WHEEL == 0 )
+                List_t * const volatile pxExpiredList = pxDelayedTaskList;
+            #else
+
+                /* Every task in the level 0 slot for this tick must leave the
+                 * Blocked state, so the loop below empties the slot. */
+                List_t * const volatile pxExpiredList = prvTimingWheelAdvance( xConstTickCount );
+            #endif
+
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                if( listLIST_IS_EMPTY( pxExpiredList ) != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY;
+                    #if ( configUSE_TIMING_WHEEL == 0 )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY;
+                    }
+                    #else
+                    {
+                        /* Find the next tick at which a wheel slot holds
+                         * tasks that must either be cascaded or unblocked. */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif
                     break;
                 }
                 else
@@ -4785,7 +6110,7 @@ BaseType_t xTaskIncrementTick( void )
                     /* MISRA Ref 11.5.3 [Void pointer assignment] */
                     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                     /* coverity[misra_c_2012_rule_11_5_violation] */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxExpiredList );
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -4810,6 +6135,7 @@ BaseType_t xTaskIncrementTick( void )
                      * it from the event list. */
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
                     {
+                        taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
                         listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
                     }
                     else
@@ -4835,7 +6161,7 @@ BaseType_t xTaskIncrementTick( void )
                              * processing time (which happens when both
                              * preemption and time slicing are on) is
                              * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xSwitchRequired = pdTRUE;
                             }
@@ -4862,7 +6188,8 @@ BaseType_t xTaskIncrementTick( void )
         {
             #if ( configNUMBER_OF_CORES == 1 )
             {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U ) &&
+                    ( taskPRIORITY_IS_TIME_SLICED( pxCurrentTCB->uxPriority ) ) )
                 {
                     xSwitchRequired = pdTRUE;
                 }
@@ -4877,7 +6204,7 @@ BaseType_t xTaskIncrementTick( void )
 
                 for( xCoreID = 0; xCoreID < ( ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
                 {
-                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > 1U )
+                    if( taskREADY_LIST_LENGTH( pxCurrentTCBs[ xCoreID ]->uxPriority ) > 1U )
                     {
                         xYieldPendings[ xCoreID ] = pdTRUE;
                     }
@@ -5167,6 +6494,19 @@ BaseType_t xTaskIncrementTick( void )
             taskSELECT_HIGHEST_PRIORITY_TASK();
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+            {
+                /* The task is about to use its stack. */
+                pxCurrentTCB->ucStackHighWaterMarkState = tskSTACK_HIGH_WATER_MARK_STALE;
+            }
+            #endif
+
+            #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+            {
+                prvRecordSchedulingLatency( pxCurrentTCB );
+            }
+            #endif
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5264,6 +6604,19 @@ BaseType_t xTaskIncrementTick( void )
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
                 traceTASK_SWITCHED_IN();
 
+                #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+                {
+                    /* The task is about to use its stack. */
+                    pxCurrentTCBs[ xCoreID ]->ucStackHighWaterMarkState = tskSTACK_HIGH_WATER_MARK_STALE;
+                }
+                #endif
+
+                #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+                {
+                    prvRecordSchedulingLatency( pxCurrentTCBs[ xCoreID ] );
+                }
+                #endif
+
                 /* Macro to inject port specific behaviour immediately after
                  * switching tasks, such as setting an end of stack watchpoint
                  * or reconfiguring the MPU. */
@@ -5322,6 +6675,170 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+
+    static void prvInsertIntoBucketedEventList( TCB_t * const pxTCB,
+                                                List_t * const pxEventList,
+                                                EventListBuckets_t * const pxBuckets )
+    {
+        ListItem_t * const pxNewListItem = &( pxTCB->xEventListItem );
+        ListItem_t * pxPosition;
+        UBaseType_t uxBucket;
+        UBaseType_t uxGroup;
+        uint32_t ulBits;
+
+        /* The task must go after every task of equal or higher priority that
+         * is already in the list, so after the last item of the nearest
+         * occupied bucket at or below the task's own bucket.  Buckets are
+         * numbered so the highest priority is bucket 0. */
+        uxBucket = ( UBaseType_t ) ( ( ( UBaseType_t ) configMAX_PRIORITIES - 1U ) - pxTCB->uxPriority );
+        uxGroup = ( UBaseType_t ) ( uxBucket >> 5U );
+        ulBits = pxBuckets->ulOccupied[ uxGroup ] & ( ( uint32_t ) 0xFFFFFFFFU >> ( 31U - ( uxBucket & 31U ) ) );
+
+        if( ulBits == 0U )
+        {
+            ulBits = pxBuckets->ulOccupiedGroups & ( ( ( uint32_t ) 1U << uxGroup ) - 1U );
+
+            if( ulBits != 0U )
+            {
+                uxGroup = taskHIGHEST_SET_BIT( ulBits );
+                ulBits = pxBuckets->ulOccupied[ uxGroup ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulBits != 0U )
+        {
+            pxPosition = pxBuckets->pxLastItem[ ( ( size_t ) uxGroup << 5U ) + ( size_t ) taskHIGHEST_SET_BIT( ulBits ) ];
+        }
+        else
+        {
+            /* No task of equal or higher priority is waiting, so the task
+             * goes at the head of the list. */
+            pxPosition = ( ListItem_t * ) &( pxEventList->xListEnd );
+        }
+
+        listINSERT_AFTER( pxEventList, pxPosition, pxNewListItem );
+
+        /* The task is now the last item of its own bucket. */
+        uxGroup = ( UBaseType_t ) ( uxBucket >> 5U );
+        pxBuckets->pxLastItem[ uxBucket ] = pxNewListItem;
+        pxBuckets->ulOccupied[ uxGroup ] |= ( uint32_t ) 1U << ( uxBucket & 31U );
+        pxBuckets->ulOccupiedGroups |= ( uint32_t ) 1U << uxGroup;
+        pxTCB->pxEventListBuckets = pxBuckets;
+        pxTCB->uxEventListBucket = uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPlaceOnBucketedEventList( List_t * const pxEventList,
+                                        EventListBuckets_t * const pxBuckets,
+                                        const TickType_t xTicksToWait )
+    {
+        traceENTER_vTaskPlaceOnBucketedEventList( pxEventList, pxBuckets, xTicksToWait );
+
+        configASSERT( pxEventList );
+        configASSERT( pxBuckets );
+
+        /* THIS FUNCTION MUST BE CALLED WITH THE
+         * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+        prvInsertIntoBucketedEventList( pxCurrentTCB, pxEventList, pxBuckets );
+
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+
+        traceRETURN_vTaskPlaceOnBucketedEventList();
+    }
+
+#endif /* configUSE_EVENT_LIST_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+
+    static void prvUnbucketEventListItem( TCB_t * const pxTCB )
+    {
+        EventListBuckets_t * const pxBuckets = pxTCB->pxEventListBuckets;
+        const UBaseType_t uxBucket = pxTCB->uxEventListBucket;
+        ListItem_t * pxNewLastItem = NULL;
+        ListItem_t * pxPrevious;
+        const TCB_t * pxPreviousTCB;
+        List_t * pxEventList;
+
+        if( pxBuckets != NULL )
+        {
+            /* Nothing needs to change if a later task in the same bucket is
+             * the last item of the bucket. */
+            if( pxBuckets->pxLastItem[ uxBucket ] == &( pxTCB->xEventListItem ) )
+            {
+                /* The previous item becomes the last item of the bucket if it
+                 * is in the same bucket.  The end of the list marker has no
+                 * owner so must be checked for first. */
+                pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+                pxPrevious = pxTCB->xEventListItem.pxPrevious;
+
+                if( pxPrevious != ( ListItem_t * ) &( pxEventList->xListEnd ) )
+                {
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    pxPreviousTCB = listGET_LIST_ITEM_OWNER( pxPrevious );
+
+                    if( ( pxPreviousTCB->pxEventListBuckets == pxBuckets ) && ( pxPreviousTCB->uxEventListBucket == uxBucket ) )
+                    {
+                        pxNewLastItem = pxPrevious;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBuckets->pxLastItem[ uxBucket ] = pxNewLastItem;
+
+                if( pxNewLastItem == NULL )
+                {
+                    pxBuckets->ulOccupied[ uxBucket >> 5U ] &= ~( ( uint32_t ) 1U << ( uxBucket & 31U ) );
+
+                    if( pxBuckets->ulOccupied[ uxBucket >> 5U ] == 0U )
+                    {
+                        pxBuckets->ulOccupiedGroups &= ~( ( uint32_t ) 1U << ( uxBucket >> 5U ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->pxEventListBuckets = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_EVENT_LIST_BUCKETS */
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
                                      const TickType_t xTicksToWait )
@@ -5416,6 +6933,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     /* coverity[misra_c_2012_rule_11_5_violation] */
     pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
     configASSERT( pxUnblockedTCB );
+    taskUNBUCKET_EVENT_LIST_ITEM( pxUnblockedTCB );
     listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
 
     if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
@@ -5442,11 +6960,12 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         /* The delayed and ready lists cannot be accessed, so hold this task
          * pending until the scheduler is resumed. */
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        taskRECORD_READY_TIME( pxUnblockedTCB );
     }
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* Return true if the task removed from the event list has a higher
              * priority than the calling task.  This allows the calling task to know if
@@ -5529,7 +7048,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* The unblocked task has a priority above that of the calling task, so
              * a context switch is required.  This function is called with the
@@ -5758,7 +7277,7 @@ void vTaskMissedYield( void )
                  * the ready list at the idle priority contains one more task than the
                  * number of idle tasks, which is equal to the configured numbers of cores
                  * then a task other than the idle task is ready to execute. */
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                if( taskREADY_LIST_LENGTH( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
                 {
                     taskYIELD();
                 }
@@ -5825,6 +7344,27 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
          * is responsible for freeing the deleted task's TCB and stack. */
         prvCheckTasksWaitingTermination();
 
+        #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+        {
+            /* Latency histograms are only cleared from the idle task so
+             * vTaskResetLatencyHistograms() never delays other tasks. */
+            if( xLatencyHistogramResetPending != pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    ( void ) memset( ulLatencyHistogram, 0x00, sizeof( ulLatencyHistogram ) );
+                    uxLatencyHistogramEpoch++;
+                    xLatencyHistogramResetPending = pdFALSE;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_LATENCY_HISTOGRAMS */
+
         #if ( configUSE_PREEMPTION == 0 )
         {
             /* If we are not using preemption we keep forcing a task switch to
@@ -5847,7 +7387,7 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * the ready list at the idle priority contains one more task than the
              * number of idle tasks, which is equal to the configured numbers of cores
              * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+            if( taskREADY_LIST_LENGTH( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -6070,17 +7610,44 @@ static void prvInitialiseTaskLists( void )
 
     for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+        #if ( configUSE_HOME_CORE_READY_LISTS == 0 )
+        {
+            vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        }
+        #else
+        {
+            BaseType_t xCoreID;
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                vListInitialise( taskREADY_LIST( xCoreID, uxPriority ) );
+            }
 
-    #if ( INCLUDE_vTaskDelete == 1 )
-    {
-        vListInitialise( &xTasksWaitingTermination );
-    }
+            uxReadyListCoreMasks[ uxPriority ] = 0U;
+        }
+        #endif
+    }
+
+    #if ( configUSE_TIMING_WHEEL == 0 )
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+    }
+    #else
+    {
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < taskTIMING_WHEEL_LIST_COUNT; uxPriority++ )
+        {
+            vListInitialise( &( xTimingWheel[ uxPriority ] ) );
+        }
+    }
+    #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
+
+    vListInitialise( &xPendingReadyList );
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        vListInitialise( &xTasksWaitingTermination );
+    }
     #endif /* INCLUDE_vTaskDelete */
 
     #if ( INCLUDE_vTaskSuspend == 1 )
@@ -6089,16 +7656,27 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+    {
+        vListInitialise( &xSnapshotTaskList );
+    }
+    #endif
+
+    #if ( configUSE_TIMING_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 static void prvCheckTasksWaitingTermination( void )
 {
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK, AND FROM
+     * xTaskCreateFromPool() **/
 
     #if ( INCLUDE_vTaskDelete == 1 )
     {
@@ -6203,6 +7781,14 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+        {
+            pxTaskStatus->xDeadline = pxTCB->xDeadline;
+            pxTaskStatus->xRelativeDeadline = pxTCB->xRelativeDeadline;
+            pxTaskStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+        }
+        #endif
+
         #if ( configUSE_MUTEXES == 1 )
         {
             pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
@@ -6299,15 +7885,7 @@ static void prvCheckTasksWaitingTermination( void )
          * parameter is provided to allow it to be skipped. */
         if( xGetFreeStackSpace != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+            pxTaskStatus->usStackHighWaterMark = prvGetStackHighWaterMark( pxTCB );
         }
         else
         {
@@ -6359,24 +7937,106 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const StackType_t * pxStackWord )
     {
         configSTACK_DEPTH_TYPE uxCount = 0U;
+        StackType_t xFillWord;
+
+        /* The stack was filled a byte at a time, but is made up of whole
+         * StackType_t words, so it can be checked a word at a time.  A word
+         * that has only been partly overwritten is not free, so the result
+         * is the same as counting the free bytes and rounding down. */
+        ( void ) memset( &xFillWord, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillWord ) );
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        while( *pxStackWord == xFillWord )
         {
-            pucStackByte -= portSTACK_GROWTH;
+            pxStackWord -= portSTACK_GROWTH;
             uxCount++;
         }
 
-        uxCount /= ( configSTACK_DEPTH_TYPE ) sizeof( StackType_t );
-
         return uxCount;
     }
+/*-----------------------------------------------------------*/
+
+    static configSTACK_DEPTH_TYPE prvGetStackHighWaterMark( TCB_t * const pxTCB )
+    {
+        const StackType_t * pxEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            pxEndOfStack = pxTCB->pxStack;
+        }
+        #else
+        {
+            pxEndOfStack = pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        #if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 )
+        {
+            BaseType_t xCached = pdFALSE;
+
+            /* A task's stack does not change while the task is not running, so
+             * the high water mark measured the last time the task was not
+             * running is still valid if the task has not been switched in
+             * since. */
+            taskENTER_CRITICAL();
+            {
+                if( pxTCB->ucStackHighWaterMarkState == tskSTACK_HIGH_WATER_MARK_CACHED )
+                {
+                    xCached = pdTRUE;
+                }
+                else if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+                {
+                    pxTCB->ucStackHighWaterMarkState = tskSTACK_HIGH_WATER_MARK_CHECKING;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxReturn = pxTCB->uxCachedStackHighWaterMark;
+            }
+            taskEXIT_CRITICAL();
+
+            if( xCached == pdFALSE )
+            {
+                uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack );
+
+                /* Only cache the result if the task was not running, and was
+                 * not switched in while its stack was being checked. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxTCB->ucStackHighWaterMarkState == tskSTACK_HIGH_WATER_MARK_CHECKING )
+                    {
+                        pxTCB->uxCachedStackHighWaterMark = uxReturn;
+                        pxTCB->ucStackHighWaterMarkState = tskSTACK_HIGH_WATER_MARK_CACHED;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 ) */
+        {
+            uxReturn = prvTaskCheckFreeStackSpace( pxEndOfStack );
+        }
+        #endif /* if ( configUSE_STACK_HIGH_WATER_MARK_CACHE == 1 ) */
+
+        return uxReturn;
+    }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
@@ -6389,7 +8049,6 @@ static void prvCheckTasksWaitingTermination( void )
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         configSTACK_DEPTH_TYPE uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark2( xTask );
@@ -6404,17 +8063,7 @@ static void prvCheckTasksWaitingTermination( void )
         pxTCB = prvGetTCBFromHandle( xTask );
         configASSERT( pxTCB != NULL );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = prvGetStackHighWaterMark( pxTCB );
 
         traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
 
@@ -6429,7 +8078,6 @@ static void prvCheckTasksWaitingTermination( void )
     UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         UBaseType_t uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark( xTask );
@@ -6437,24 +8085,109 @@ static void prvCheckTasksWaitingTermination( void )
         pxTCB = prvGetTCBFromHandle( xTask );
         configASSERT( pxTCB != NULL );
 
-        #if portSTACK_GROWTH < 0
+        uxReturn = ( UBaseType_t ) prvGetStackHighWaterMark( pxTCB );
+
+        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetAllStackHighWaterMarks == 1 )
+
+    static UBaseType_t prvStackHighWaterMarksWithinSingleList( TaskStackHighWaterMark_t * pxHighWaterMarkArray,
+                                                                List_t * pxList )
+    {
+        UBaseType_t uxTask = 0;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+            pxHighWaterMarkArray[ uxTask ].xHandle = pxTCB;
+            pxHighWaterMarkArray[ uxTask ].uxStackHighWaterMark = prvGetStackHighWaterMark( pxTCB );
+            uxTask++;
         }
-        #else
+
+        return uxTask;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetAllStackHighWaterMarks( TaskStackHighWaterMark_t * const pxHighWaterMarkArray,
+                                                 const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        BaseType_t xReadyListIndex;
+
+        traceENTER_uxTaskGetAllStackHighWaterMarks( pxHighWaterMarkArray, uxArraySize );
+
+        configASSERT( pxHighWaterMarkArray != NULL );
+
+        vTaskSuspendAll();
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Every task is referenced from exactly one of the following
+                 * lists.  Tasks in the pending ready list are also referenced
+                 * from a delayed or suspended list. */
+                do
+                {
+                    uxQueue--;
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+                    for( xReadyListIndex = ( BaseType_t ) 0; xReadyListIndex < taskREADY_LIST_COUNT; xReadyListIndex++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), taskREADY_LIST( xReadyListIndex, uxQueue ) ) );
+                    }
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
-        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+                #if ( configUSE_TIMING_WHEEL == 0 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList ) );
+                    uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList ) );
+                }
+                #else
+                {
+                    for( uxQueue = 0U; uxQueue < taskTIMING_WHEEL_LIST_COUNT; uxQueue++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), &( xTimingWheel[ uxQueue ] ) ) );
+                    }
+                }
+                #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
 
-        return uxReturn;
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), &xTasksWaitingTermination ) );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvStackHighWaterMarksWithinSingleList( &( pxHighWaterMarkArray[ uxTask ] ), &xSuspendedTaskList ) );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxTaskGetAllStackHighWaterMarks( uxTask );
+
+        return uxTask;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* INCLUDE_uxTaskGetAllStackHighWaterMarks */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -6507,84 +8240,859 @@ static void prvCheckTasksWaitingTermination( void )
             }
         }
         #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        #if ( configUSE_TASK_POOLS == 1 )
+        {
+            TaskPool_t * const pxPool = pxTCB->pxTaskPool;
+
+            if( pxPool != NULL )
+            {
+                /* The TCB and stack came from a pool, so return the slot to
+                 * the pool instead.  The TCB's xStateListItem is not in any
+                 * list once the task has been deleted, and pxStack still
+                 * points to the slot's stack. */
+                taskENTER_CRITICAL();
+                {
+                    vListInsertEnd( &( pxPool->xFreeTaskList ), &( pxTCB->xStateListItem ) );
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_POOLS */
     }
 
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
-    }
-}
-/*-----------------------------------------------------------*/
+#if ( configUSE_HOME_CORE_READY_LISTS == 1 )
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
+    static UBaseType_t prvGetReadyListLength( UBaseType_t uxPriority )
+    {
+        UBaseType_t uxLength = 0U;
+        UBaseType_t uxCoreMask = uxReadyListCoreMasks[ uxPriority ];
+        BaseType_t xCoreID;
 
-    #if ( configNUMBER_OF_CORES == 1 )
-        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        for( xCoreID = ( BaseType_t ) 0; uxCoreMask != 0U; xCoreID++ )
         {
-            TaskHandle_t xReturn;
-
-            traceENTER_xTaskGetCurrentTaskHandle();
+            if( ( uxCoreMask & ( UBaseType_t ) 1U ) != 0U )
+            {
+                uxLength = ( UBaseType_t ) ( uxLength + listCURRENT_LIST_LENGTH( taskREADY_LIST( xCoreID, uxPriority ) ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-            /* A critical section is not required as this is not called from
-             * an interrupt and the current TCB will always be the same for any
-             * individual execution thread. */
-            xReturn = pxCurrentTCB;
+            uxCoreMask >>= 1U;
+        }
 
-            traceRETURN_xTaskGetCurrentTaskHandle( xReturn );
+        return uxLength;
+    }
+/*-----------------------------------------------------------*/
 
-            return xReturn;
-        }
-    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
-        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+    static void prvSelectReadyListCore( TCB_t * const pxTCB )
+    {
+        #if ( configUSE_CORE_AFFINITY == 1 )
         {
-            TaskHandle_t xReturn;
-            UBaseType_t uxSavedInterruptStatus;
+            BaseType_t xCoreID;
 
-            traceENTER_xTaskGetCurrentTaskHandle();
-
-            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) pxTCB->xReadyListCoreID ) ) == 0U )
             {
-                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    {
+                        pxTCB->xReadyListCoreID = xCoreID;
+                        break;
+                    }
+                }
             }
-            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_CORE_AFFINITY == 1 ) */
 
-            traceRETURN_xTaskGetCurrentTaskHandle( xReturn );
+        uxReadyListCoreMasks[ pxTCB->uxPriority ] |= ( UBaseType_t ) 1U << ( UBaseType_t ) pxTCB->xReadyListCoreID;
+    }
+/*-----------------------------------------------------------*/
 
-            return xReturn;
-        }
-    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+    static void prvMoveTaskToCoreReadyList( TCB_t * const pxTCB,
+                                            BaseType_t xCoreID )
+    {
+        /* The task is added back at the same priority, so the ready priority
+         * does not need to be reset if its old list becomes empty. */
+        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+        pxTCB->xReadyListCoreID = xCoreID;
+        uxReadyListCoreMasks[ pxTCB->uxPriority ] |= ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID;
+        vListInsertEnd( taskREADY_LIST( xCoreID, pxTCB->uxPriority ), &( pxTCB->xStateListItem ) );
+    }
 
-    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+#endif /* if ( configUSE_HOME_CORE_READY_LISTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) )
+
+    static void prvResetReadyPriority( UBaseType_t uxPriority )
     {
-        TaskHandle_t xReturn = NULL;
+        const UBaseType_t uxGroup = taskREADY_PRIORITY_GROUP( uxPriority );
 
-        traceENTER_xTaskGetCurrentTaskHandleForCore( xCoreID );
+        ulReadyPriorityBitmap[ uxGroup ] &= ~taskREADY_PRIORITY_BIT( uxPriority );
 
-        if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+        #if ( configMAX_PRIORITIES > 32 )
         {
-            #if ( configNUMBER_OF_CORES == 1 )
-                xReturn = pxCurrentTCB;
-            #else /* #if ( configNUMBER_OF_CORES == 1 ) */
-                xReturn = pxCurrentTCBs[ xCoreID ];
-            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
-        }
+            if( ulReadyPriorityBitmap[ uxGroup ] == 0U )
+            {
+                ulReadyPriorityGroups &= ~( ( uint32_t ) 1U << uxGroup );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        /* Only the highest ready priority is cached, so it only needs to be
+         * recalculated if it is the priority that no longer has ready tasks.
+         * No task being ready can only be transient - for example before the
+         * idle task has been created. */
+        if( uxPriority == uxTopReadyPriority )
+        {
+            #if ( configMAX_PRIORITIES > 32 )
+            {
+                if( ulReadyPriorityGroups != 0U )
+                {
+                    UBaseType_t uxTopGroup = taskHIGHEST_SET_BIT( ulReadyPriorityGroups );
+
+                    uxTopReadyPriority = ( UBaseType_t ) ( ( uxTopGroup << 5U ) + taskHIGHEST_SET_BIT( ulReadyPriorityBitmap[ uxTopGroup ] ) );
+                }
+                else
+                {
+                    uxTopReadyPriority = tskIDLE_PRIORITY;
+                }
+            }
+            #else
+            {
+                if( ulReadyPriorityBitmap[ 0 ] != 0U )
+                {
+                    uxTopReadyPriority = taskHIGHEST_SET_BIT( ulReadyPriorityBitmap[ 0 ] );
+                }
+                else
+                {
+                    uxTopReadyPriority = tskIDLE_PRIORITY;
+                }
+            }
+            #endif /* if ( configMAX_PRIORITIES > 32 ) */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) || ( configUSE_EVENT_LIST_BUCKETS == 1 ) || ( configUSE_TIMING_WHEEL == 1 ) ) && !defined( __GNUC__ ) )
+
+    static UBaseType_t prvHighestSetBit( uint32_t ulBits )
+    {
+        /* The most significant set bit of each value from 0 to 15. */
+        static const uint8_t ucHighestBitInNibble[ 16 ] = { 0U, 0U, 1U, 1U, 2U, 2U, 2U, 2U, 3U, 3U, 3U, 3U, 3U, 3U, 3U, 3U };
+        UBaseType_t uxBit = 0U;
+
+        configASSERT( ulBits != 0U );
+
+        /* Narrow down to the nibble that holds the most significant set
+         * bit, then look up its position within that nibble. */
+        if( ( ulBits & 0xFFFF0000UL ) != 0U )
+        {
+            ulBits >>= 16U;
+            uxBit = ( UBaseType_t ) ( uxBit + 16U );
+        }
+
+        if( ( ulBits & 0x0000FF00UL ) != 0U )
+        {
+            ulBits >>= 8U;
+            uxBit = ( UBaseType_t ) ( uxBit + 8U );
+        }
+
+        if( ( ulBits & 0x000000F0UL ) != 0U )
+        {
+            ulBits >>= 4U;
+            uxBit = ( UBaseType_t ) ( uxBit + 4U );
+        }
+
+        return ( UBaseType_t ) ( uxBit + ( UBaseType_t ) ucHighestBitInNibble[ ulBits & 0x0FU ] );
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                            const TCB_t * const pxOtherTCB )
+    {
+        TickType_t xDifference;
+        BaseType_t xReturn;
+
+        if( taskHAS_DEADLINE( pxTCB ) == pdFALSE )
+        {
+            /* Tasks without a deadline never run before other tasks. */
+            xReturn = pdFALSE;
+        }
+        else if( taskHAS_DEADLINE( pxOtherTCB ) == pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* The deadlines are compared with each other rather than with the
+             * tick count, so the result is correct across a tick count overflow
+             * as long as the deadlines are less than half the range of
+             * TickType_t apart. */
+            xDifference = ( TickType_t ) ( taskSCHEDULING_DEADLINE( pxOtherTCB ) - taskSCHEDULING_DEADLINE( pxTCB ) );
+
+            if( ( xDifference != ( TickType_t ) 0U ) && ( xDifference <= ( portMAX_DELAY >> 1U ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvDeadlineHeapPrecedes( const TCB_t * const pxTCB,
+                                               const TCB_t * const pxOtherTCB )
+    {
+        BaseType_t xReturn;
+
+        if( taskSCHEDULING_DEADLINE( pxTCB ) != taskSCHEDULING_DEADLINE( pxOtherTCB ) )
+        {
+            xReturn = prvDeadlineIsEarlier( pxTCB, pxOtherTCB );
+        }
+        else
+        {
+            /* Tasks with equal deadlines run in the order in which they were
+             * added to the heap.  The difference is interpreted as signed so
+             * the order is correct across an overflow of the insertion
+             * count. */
+            if( ( ( uint32_t ) ( pxTCB->ulDeadlineOrder - pxOtherTCB->ulDeadlineOrder ) & 0x80000000U ) != 0U )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDeadlineHeapLink( TCB_t * pxTCB,
+                                        TCB_t * pxOtherTCB )
+    {
+        TCB_t * pxSwap;
+
+        if( prvDeadlineHeapPrecedes( pxOtherTCB, pxTCB ) != pdFALSE )
+        {
+            pxSwap = pxTCB;
+            pxTCB = pxOtherTCB;
+            pxOtherTCB = pxSwap;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* pxOtherTCB becomes the first child of pxTCB.  The caller sets the
+         * sibling and previous links of pxTCB. */
+        pxOtherTCB->pxDeadlineSibling = pxTCB->pxDeadlineChild;
+
+        if( pxTCB->pxDeadlineChild != NULL )
+        {
+            pxTCB->pxDeadlineChild->pxDeadlinePrevious = pxOtherTCB;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxOtherTCB->pxDeadlinePrevious = pxTCB;
+        pxTCB->pxDeadlineChild = pxOtherTCB;
+
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDeadlineHeapMergePairs( TCB_t * pxFirst )
+    {
+        TCB_t * pxPairs = NULL;
+        TCB_t * pxRoot;
+        TCB_t * pxNext;
+
+        /* Link the siblings in pairs from the left, stacking the result of
+         * each link on pxPairs, then link the stacked heaps from the right.
+         * This is what bounds the amortised cost of removing the root to
+         * O(log n). */
+        while( pxFirst != NULL )
+        {
+            pxRoot = pxFirst;
+            pxNext = pxFirst->pxDeadlineSibling;
+
+            if( pxNext != NULL )
+            {
+                pxFirst = pxNext->pxDeadlineSibling;
+                pxRoot = prvDeadlineHeapLink( pxRoot, pxNext );
+            }
+            else
+            {
+                pxFirst = NULL;
+            }
+
+            pxRoot->pxDeadlineSibling = pxPairs;
+            pxPairs = pxRoot;
+        }
+
+        pxRoot = pxPairs;
+
+        if( pxRoot != NULL )
+        {
+            pxPairs = pxRoot->pxDeadlineSibling;
+
+            while( pxPairs != NULL )
+            {
+                pxNext = pxPairs->pxDeadlineSibling;
+                pxRoot = prvDeadlineHeapLink( pxPairs, pxRoot );
+                pxPairs = pxNext;
+            }
+
+            pxRoot->pxDeadlineSibling = NULL;
+            pxRoot->pxDeadlinePrevious = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxRoot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDeadlineHeapInsert( TCB_t * const pxTCB )
+    {
+        prvDeadlineHeapRemove( pxTCB );
+
+        pxTCB->ulDeadlineOrder = ulDeadlineHeapInsertions;
+        ulDeadlineHeapInsertions++;
+
+        if( pxDeadlineHeap == NULL )
+        {
+            pxDeadlineHeap = pxTCB;
+        }
+        else
+        {
+            pxDeadlineHeap = prvDeadlineHeapLink( pxDeadlineHeap, pxTCB );
+            pxDeadlineHeap->pxDeadlinePrevious = NULL;
+            pxDeadlineHeap->pxDeadlineSibling = NULL;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDeadlineHeapRemove( TCB_t * const pxTCB )
+    {
+        TCB_t * pxChildren;
+
+        if( pxTCB == pxDeadlineHeap )
+        {
+            pxDeadlineHeap = prvDeadlineHeapMergePairs( pxTCB->pxDeadlineChild );
+        }
+        else if( pxTCB->pxDeadlinePrevious != NULL )
+        {
+            /* Unlink the task from its parent or previous sibling, then merge
+             * its children and link them back in at the root. */
+            if( pxTCB->pxDeadlinePrevious->pxDeadlineChild == pxTCB )
+            {
+                pxTCB->pxDeadlinePrevious->pxDeadlineChild = pxTCB->pxDeadlineSibling;
+            }
+            else
+            {
+                pxTCB->pxDeadlinePrevious->pxDeadlineSibling = pxTCB->pxDeadlineSibling;
+            }
+
+            if( pxTCB->pxDeadlineSibling != NULL )
+            {
+                pxTCB->pxDeadlineSibling->pxDeadlinePrevious = pxTCB->pxDeadlinePrevious;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxChildren = prvDeadlineHeapMergePairs( pxTCB->pxDeadlineChild );
+
+            if( pxChildren != NULL )
+            {
+                pxDeadlineHeap = prvDeadlineHeapLink( pxDeadlineHeap, pxChildren );
+                pxDeadlineHeap->pxDeadlinePrevious = NULL;
+                pxDeadlineHeap->pxDeadlineSibling = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* The task is not in the heap. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->pxDeadlineChild = NULL;
+        pxTCB->pxDeadlineSibling = NULL;
+        pxTCB->pxDeadlinePrevious = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvGetEarliestDeadlineTask( void )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] );
+        TCB_t * pxTCB;
+
+        /* Tasks that left the ready list since they were added to the heap
+         * are removed when they reach the root.  Each task is added to the
+         * heap once each time it becomes ready, so this does not change the
+         * amortised cost. */
+        while( ( pxDeadlineHeap != NULL ) &&
+               ( listIS_CONTAINED_WITHIN( pxList, &( pxDeadlineHeap->xStateListItem ) ) == pdFALSE ) )
+        {
+            prvDeadlineHeapRemove( pxDeadlineHeap );
+        }
+
+        if( pxDeadlineHeap != NULL )
+        {
+            pxTCB = pxDeadlineHeap;
+        }
+        else
+        {
+            /* None of the ready tasks have a deadline, so they run in the order
+             * in which they became ready. */
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList );
+        }
+
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddTaskToDeadlineList( TCB_t * const pxTCB )
+    {
+        listINSERT_END( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxTCB->xStateListItem ) );
+
+        if( taskHAS_DEADLINE( pxTCB ) != pdFALSE )
+        {
+            prvDeadlineHeapInsert( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetTaskDeadline( TCB_t * const pxTCB,
+                                    const TickType_t xDeadline )
+    {
+        pxTCB->xDeadline = xDeadline;
+        pxTCB->ucDeadlineMissCounted = ( uint8_t ) pdFALSE;
+
+        prvRepositionInDeadlineHeap( pxTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRepositionInDeadlineHeap( TCB_t * const pxTCB )
+    {
+        /* The position of the task in the heap depends on its deadline, and
+         * only ready tasks that have a deadline are in the heap. */
+        if( ( taskHAS_DEADLINE( pxTCB ) != pdFALSE ) &&
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_TASK_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            prvDeadlineHeapInsert( pxTCB );
+        }
+        else
+        {
+            prvDeadlineHeapRemove( pxTCB );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MUTEXES == 1 )
+
+        static void prvInheritDeadline( TCB_t * const pxMutexHolderTCB )
+        {
+            /* Only tasks at configEDF_TASK_PRIORITY are ordered by deadline.
+             * The holder is at that priority if it was already, or has just
+             * inherited it from the calling task. */
+            if( ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&
+                ( pxMutexHolderTCB->uxPriority == ( UBaseType_t ) configEDF_TASK_PRIORITY ) &&
+                ( prvDeadlineIsEarlier( pxCurrentTCB, pxMutexHolderTCB ) != pdFALSE ) )
+            {
+                pxMutexHolderTCB->xInheritedDeadline = taskSCHEDULING_DEADLINE( pxCurrentTCB );
+                pxMutexHolderTCB->ucDeadlineInherited = ( uint8_t ) pdTRUE;
+                prvRepositionInDeadlineHeap( pxMutexHolderTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MUTEXES == 1 )
+
+        static BaseType_t prvDisinheritDeadline( TCB_t * const pxTCB )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            if( pxTCB->ucDeadlineInherited != ( uint8_t ) pdFALSE )
+            {
+                pxTCB->ucDeadlineInherited = ( uint8_t ) pdFALSE;
+                prvRepositionInDeadlineHeap( pxTCB );
+
+                /* A ready task with an earlier deadline than the task's own
+                 * may now run first. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+    static void prvCheckDeadlineMissed( TCB_t * const pxTCB )
+    {
+        TickType_t xLateness;
+
+        if( ( pxTCB->xRelativeDeadline != ( TickType_t ) 0U ) &&
+            ( pxTCB->ucDeadlineMissCounted == ( uint8_t ) pdFALSE ) )
+        {
+            xLateness = ( TickType_t ) ( xTickCount - pxTCB->xDeadline );
+
+            if( ( xLateness != ( TickType_t ) 0U ) && ( xLateness <= ( portMAX_DELAY >> 1U ) ) )
+            {
+                traceTASK_DEADLINE_MISSED( pxTCB );
+                pxTCB->uxDeadlineMisses++;
+                pxTCB->ucDeadlineMissCounted = ( uint8_t ) pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+
+#else /* if ( configUSE_TIMING_WHEEL == 0 ) */
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        const TickType_t xTimeNow = xTickCount;
+        TickType_t xShiftedTime = xTimeNow;
+        TickType_t xTicksToService = portMAX_DELAY;
+        TickType_t xSlotTime;
+        UBaseType_t uxLevel, uxOffset, uxShift = 0U;
+
+        /* With the timing wheel xNextTaskUnblockTime is the next tick at which
+         * a slot holding tasks will be serviced - either to move the tasks
+         * from the Blocked state or to cascade them to a lower level.  The
+         * first occupied slot on each level, in the order in which they will be
+         * serviced, is the earliest one for that level.  The current level 0
+         * slot has already been serviced so the search starts from the slot
+         * after it. */
+        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+        {
+            uxOffset = prvTimingWheelNextOccupiedSlot( uxLevel, ( UBaseType_t ) ( ( xShiftedTime + ( TickType_t ) 1U ) & taskTIMING_WHEEL_SLOT_MASK ) );
+
+            if( uxOffset < taskTIMING_WHEEL_SLOTS )
+            {
+                xSlotTime = ( TickType_t ) ( xShiftedTime + ( TickType_t ) uxOffset + ( TickType_t ) 1U );
+                xSlotTime = ( TickType_t ) ( ( TickType_t ) ( xSlotTime << uxShift ) - xTimeNow );
+
+                if( xSlotTime < xTicksToService )
+                {
+                    xTicksToService = xSlotTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xShiftedTime >>= configTIMING_WHEEL_SLOT_BITS;
+            uxShift = ( UBaseType_t ) ( uxShift + ( UBaseType_t ) configTIMING_WHEEL_SLOT_BITS );
+        }
+
+        /* The far list is serviced when the top level next wraps. */
+        if( listLIST_IS_EMPTY( &( xTimingWheel[ taskTIMING_WHEEL_FAR_LIST ] ) ) == pdFALSE )
+        {
+            xSlotTime = ( TickType_t ) ( ( TickType_t ) ( ( TickType_t ) ( xShiftedTime + ( TickType_t ) 1U ) << uxShift ) - xTimeNow );
+
+            if( xSlotTime < xTicksToService )
+            {
+                xTicksToService = xSlotTime;
+            }
+        }
+
+        /* If nothing is due before the tick count overflows then set
+         * xNextTaskUnblockTime to the maximum possible value - the wheel is
+         * serviced again when the tick count wraps to 0. */
+        xNextTaskUnblockTime = ( TickType_t ) ( xTimeNow + xTicksToService );
+
+        if( xNextTaskUnblockTime < xTimeNow )
+        {
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvTimingWheelInsert( ListItem_t * const pxListItem,
+                                            const TickType_t xTimeNow )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        TickType_t xTicksRemaining = ( TickType_t ) ( ( TickType_t ) ( xTimeToWake - xTimeNow ) >> configTIMING_WHEEL_SLOT_BITS );
+        TickType_t xShiftedTime = xTimeToWake;
+        TickType_t xServiceTime;
+        UBaseType_t uxLevel = 0U, uxShift = 0U, uxList, uxSlot;
+
+        /* Each level covers configTIMING_WHEEL_SLOT_BITS more bits of the
+         * number of ticks remaining until the wake time. */
+        while( ( xTicksRemaining != ( TickType_t ) 0U ) && ( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS ) )
+        {
+            xTicksRemaining >>= configTIMING_WHEEL_SLOT_BITS;
+            xShiftedTime >>= configTIMING_WHEEL_SLOT_BITS;
+            uxShift = ( UBaseType_t ) ( uxShift + ( UBaseType_t ) configTIMING_WHEEL_SLOT_BITS );
+            uxLevel++;
+        }
+
+        if( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS )
+        {
+            uxSlot = ( UBaseType_t ) ( xShiftedTime & taskTIMING_WHEEL_SLOT_MASK );
+            uxList = ( UBaseType_t ) ( ( uxLevel * taskTIMING_WHEEL_SLOTS ) + uxSlot );
+            ulTimingWheelOccupied[ uxLevel ][ uxSlot >> 5U ] |= ( uint32_t ) ( ( uint32_t ) 1U << ( uxSlot & 31U ) );
+
+            /* The slot is serviced when the tick count reaches the wake time
+             * with the bits below this level cleared. */
+            xServiceTime = ( TickType_t ) ( xShiftedTime << uxShift );
+        }
+        else
+        {
+            /* The wake time is beyond the span of the wheel. */
+            uxList = taskTIMING_WHEEL_FAR_LIST;
+            xServiceTime = ( TickType_t ) ( ( TickType_t ) ( ( TickType_t ) ( xTimeNow >> uxShift ) + ( TickType_t ) 1U ) << uxShift );
+        }
+
+        listINSERT_END( &( xTimingWheel[ uxList ] ), pxListItem );
+
+        return xServiceTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvTimingWheelAdvance( const TickType_t xTimeNow )
+    {
+        TickType_t xShiftedTime = xTimeNow;
+        UBaseType_t uxLevel, uxList, uxItems;
+        ListItem_t * pxListItem;
+
+        /* A level is serviced when all the tick count bits below it are zero.
+         * The tasks in the current slot of that level are then re-inserted,
+         * which moves them to a lower level as they are now closer to their
+         * wake time.  Lower levels are serviced first - a task never moves
+         * into a slot that has already been serviced on this tick. */
+        for( uxLevel = 1U; uxLevel <= ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+        {
+            if( ( xShiftedTime & taskTIMING_WHEEL_SLOT_MASK ) != ( TickType_t ) 0U )
+            {
+                break;
+            }
+
+            xShiftedTime >>= configTIMING_WHEEL_SLOT_BITS;
+
+            if( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS )
+            {
+                uxList = ( UBaseType_t ) ( ( uxLevel * taskTIMING_WHEEL_SLOTS ) + ( UBaseType_t ) ( xShiftedTime & taskTIMING_WHEEL_SLOT_MASK ) );
+            }
+            else
+            {
+                uxList = taskTIMING_WHEEL_FAR_LIST;
+            }
+
+            /* Tasks in the far list may be placed back into the far list, so
+             * only move the number of tasks that were in the slot on entry. */
+            uxItems = listCURRENT_LIST_LENGTH( &( xTimingWheel[ uxList ] ) );
+
+            while( uxItems > 0U )
+            {
+                pxListItem = listGET_HEAD_ENTRY( &( xTimingWheel[ uxList ] ) );
+                ( void ) uxListRemove( pxListItem );
+                ( void ) prvTimingWheelInsert( pxListItem, xTimeNow );
+                uxItems--;
+            }
+        }
+
+        return &( xTimingWheel[ ( UBaseType_t ) ( xTimeNow & taskTIMING_WHEEL_SLOT_MASK ) ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvTimingWheelNextOccupiedSlot( const UBaseType_t uxLevel,
+                                                       const UBaseType_t uxFirstSlot )
+    {
+        uint32_t * const pulOccupied = ulTimingWheelOccupied[ uxLevel ];
+        UBaseType_t uxWord = uxFirstSlot >> 5U;
+        UBaseType_t uxWordsMovedOn = 0U, uxSlot, uxOffset = taskTIMING_WHEEL_SLOTS;
+        uint32_t ulBits = pulOccupied[ uxWord ] & ( uint32_t ) ( ( uint32_t ) 0xFFFFFFFFU << ( uxFirstSlot & 31U ) );
+
+        /* Check the slots from uxFirstSlot to the end of the level, then wrap
+         * round to check those before it.  The word holding uxFirstSlot is
+         * read again after wrapping for the slots below uxFirstSlot. */
+        while( uxWordsMovedOn <= taskTIMING_WHEEL_BITMAP_WORDS )
+        {
+            if( ulBits == 0U )
+            {
+                uxWord = ( uxWord + 1U ) % taskTIMING_WHEEL_BITMAP_WORDS;
+                ulBits = pulOccupied[ uxWord ];
+                uxWordsMovedOn++;
+            }
+            else
+            {
+                /* The lowest set bit is the first slot to be serviced. */
+                uxSlot = ( UBaseType_t ) ( ( uxWord << 5U ) + taskHIGHEST_SET_BIT( ulBits & ( uint32_t ) ( ~ulBits + 1U ) ) );
+
+                if( listLIST_IS_EMPTY( &( xTimingWheel[ ( uxLevel * taskTIMING_WHEEL_SLOTS ) + uxSlot ] ) ) == pdFALSE )
+                {
+                    uxOffset = ( UBaseType_t ) ( ( uxSlot - uxFirstSlot ) & ( taskTIMING_WHEEL_SLOTS - 1U ) );
+                    break;
+                }
+                else
+                {
+                    /* Every task placed in the slot has since left it. */
+                    pulOccupied[ uxWord ] &= ( uint32_t ) ~( ( uint32_t ) 1U << ( uxSlot & 31U ) );
+                    ulBits &= ( uint32_t ) ( ulBits - 1U );
+                }
+            }
+        }
+
+        return uxOffset;
+    }
+
+#endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+
+            traceENTER_xTaskGetCurrentTaskHandle();
+
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+
+            traceRETURN_xTaskGetCurrentTaskHandle( xReturn );
+
+            return xReturn;
+        }
+    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xTaskGetCurrentTaskHandle();
+
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            {
+                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+            }
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+            traceRETURN_xTaskGetCurrentTaskHandle( xReturn );
+
+            return xReturn;
+        }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+    {
+        TaskHandle_t xReturn = NULL;
+
+        traceENTER_xTaskGetCurrentTaskHandleForCore( xCoreID );
+
+        if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+                xReturn = pxCurrentTCB;
+            #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                xReturn = pxCurrentTCBs[ xCoreID ];
+            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+        }
 
         traceRETURN_xTaskGetCurrentTaskHandleForCore( xReturn );
 
@@ -6666,7 +9174,7 @@ static void prvResetNextTaskUnblockTime( void )
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( taskIS_IN_READY_LIST( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority ) != pdFALSE )
                 {
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
@@ -6702,6 +9210,15 @@ static void prvResetNextTaskUnblockTime( void )
 
                 traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
+                #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                {
+                    /* If the mutex holder is itself waiting for a mutex, the
+                     * holder of that mutex must run for this task to get the
+                     * mutex it wants, so pass the priority on. */
+                    prvInheritAlongChain( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+                }
+                #endif
+
                 /* Inheritance occurred. */
                 xReturn = pdTRUE;
             }
@@ -6723,6 +9240,15 @@ static void prvResetNextTaskUnblockTime( void )
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                /* Raising the holder to configEDF_TASK_PRIORITY is not enough
+                 * on its own, as tasks at that priority run in deadline
+                 * order. */
+                prvInheritDeadline( pxMutexHolderTCB );
+            }
+            #endif
         }
         else
         {
@@ -6756,6 +9282,21 @@ static void prvResetNextTaskUnblockTime( void )
             configASSERT( pxTCB->uxMutexesHeld );
             ( pxTCB->uxMutexesHeld )--;
 
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                /* An inherited deadline is kept until no mutexes are held, as
+                 * for an inherited priority. */
+                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                {
+                    xReturn = prvDisinheritDeadline( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Has the holder of the mutex inherited the priority of another
              * task? */
             if( pxTCB->uxPriority != pxTCB->uxBasePriority )
@@ -6899,7 +9440,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * from its current state list if it is in the Ready state as
                      * the task's priority is going to change and there is one
                      * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    if( taskIS_IN_READY_LIST( pxTCB, uxPriorityUsedOnEntry ) != pdFALSE )
                     {
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
@@ -6913,27 +9454,417 @@ static void prvResetNextTaskUnblockTime( void )
                             mtCOVERAGE_TEST_MARKER();
                         }
 
-                        prvAddTaskToReadyList( pxTCB );
-                        #if ( configNUMBER_OF_CORES > 1 )
-                        {
-                            /* The priority of the task is dropped. Yield the core on
-                             * which the task is running. */
-                            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                            {
-                                prvYieldCore( pxTCB->xTaskRunState );
-                            }
-                        }
-                        #endif /* if ( configNUMBER_OF_CORES > 1 ) */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                        prvAddTaskToReadyList( pxTCB );
+                        #if ( configNUMBER_OF_CORES > 1 )
+                        {
+                            /* The priority of the task is dropped. Yield the core on
+                             * which the task is running. */
+                            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                            {
+                                prvYieldCore( pxTCB->xTaskRunState );
+                            }
+                        }
+                        #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                    {
+                        /* If the mutex holder is itself waiting for a mutex,
+                         * the priority it passed on to the holder of that mutex
+                         * may no longer be needed either. */
+                        prvDisinheritAlongChain( pxTCB );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder )
+    {
+        traceENTER_vTaskSetBlockingMutexHolder( pxMutexHolder );
+
+        pxCurrentTCB->pxBlockingMutexHolder = pxMutexHolder;
+
+        traceRETURN_vTaskSetBlockingMutexHolder();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvIsBlockedOnMutex( const TCB_t * const pxTCB )
+    {
+        const List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+        BaseType_t xReturn = pdFALSE;
+
+        /* The link to the mutex is left set until the task runs again, so it
+         * is only valid while the task is still in the mutex's event list.  A
+         * task that was unblocked while the scheduler was suspended is in
+         * xPendingReadyList instead. */
+        if( ( pxTCB->pxBlockingMutexHolder != NULL ) && ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRepositionEventListItem( TCB_t * const pxTCB )
+    {
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+            EventListBuckets_t * const pxBuckets = pxTCB->pxEventListBuckets;
+        #endif
+
+        /* The event list of a mutex is ordered by priority, and the item value
+         * was updated when the priority changed, so the item must move for the
+         * list to stay in order. */
+        taskUNBUCKET_EVENT_LIST_ITEM( pxTCB );
+        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+        #if ( configUSE_EVENT_LIST_BUCKETS == 1 )
+        {
+            if( pxBuckets != NULL )
+            {
+                prvInsertIntoBucketedEventList( pxTCB, pxEventList, pxBuckets );
+            }
+            else
+            {
+                vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+            }
+        }
+        #else /* if ( configUSE_EVENT_LIST_BUCKETS == 1 ) */
+        {
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+        }
+        #endif /* if ( configUSE_EVENT_LIST_BUCKETS == 1 ) */
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetMutexHolderPriority( TCB_t * const pxTCB,
+                                           UBaseType_t uxNewPriority )
+    {
+        const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+        /* Only reset the event list item value if the value is not being used
+         * for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( taskIS_IN_READY_LIST( pxTCB, uxPriorityUsedOnEntry ) != pdFALSE )
+        {
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->uxPriority = uxNewPriority;
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                if( uxNewPriority > uxPriorityUsedOnEntry )
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) != pdTRUE )
+                    {
+                        prvYieldForTask( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                {
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+        }
+        else
+        {
+            pxTCB->uxPriority = uxNewPriority;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInheritAlongChain( TCB_t * pxTCB,
+                                      UBaseType_t uxPriority )
+    {
+        TCB_t * pxNextTCB;
+        UBaseType_t uxTasksRaised = ( UBaseType_t ) 1U;
+        BaseType_t xFollowChain = pdTRUE;
+
+        /* Each pass starts with a task that has just inherited uxPriority.  The
+         * walk stops at a task that is not blocked on a mutex, or at a mutex
+         * holder that already has at least uxPriority - which any further
+         * holders must also have, as the priority was passed on when that
+         * holder's priority was raised. */
+        while( xFollowChain != pdFALSE )
+        {
+            xFollowChain = pdFALSE;
+
+            if( prvIsBlockedOnMutex( pxTCB ) != pdFALSE )
+            {
+                prvRepositionEventListItem( pxTCB );
+                pxNextTCB = *( pxTCB->pxBlockingMutexHolder );
+
+                if( ( uxTasksRaised < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ) &&
+                    ( pxNextTCB != NULL ) &&
+                    ( pxNextTCB->uxPriority < uxPriority ) )
+                {
+                    prvSetMutexHolderPriority( pxNextTCB, uxPriority );
+                    traceTASK_PRIORITY_INHERIT( pxNextTCB, uxPriority );
+
+                    pxTCB = pxNextTCB;
+                    uxTasksRaised++;
+                    xFollowChain = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDisinheritAlongChain( TCB_t * pxTCB )
+    {
+        TCB_t * pxNextTCB;
+        List_t * pxEventList;
+        UBaseType_t uxPriorityToUse;
+        UBaseType_t uxTasksLowered = ( UBaseType_t ) 1U;
+        BaseType_t xFollowChain = pdTRUE;
+
+        while( xFollowChain != pdFALSE )
+        {
+            xFollowChain = pdFALSE;
+
+            if( prvIsBlockedOnMutex( pxTCB ) != pdFALSE )
+            {
+                prvRepositionEventListItem( pxTCB );
+                pxNextTCB = *( pxTCB->pxBlockingMutexHolder );
+
+                /* As in vTaskPriorityDisinheritAfterTimeout(), only a holder
+                 * that holds just the one mutex is lowered, as any other mutex
+                 * it holds may be the cause of its raised priority.  The
+                 * calling task is running, so can only be in the chain if the
+                 * tasks in the chain are deadlocked, and is left alone. */
+                if( ( uxTasksLowered < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ) &&
+                    ( pxNextTCB != NULL ) &&
+                    ( pxNextTCB != pxCurrentTCB ) &&
+                    ( pxNextTCB->uxMutexesHeld == ( UBaseType_t ) 1 ) )
+                {
+                    /* The head of the event list is the highest priority task
+                     * still waiting for the mutex. */
+                    pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+                    uxPriorityToUse = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxEventList ) );
+
+                    if( uxPriorityToUse < pxNextTCB->uxBasePriority )
+                    {
+                        uxPriorityToUse = pxNextTCB->uxBasePriority;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( uxPriorityToUse < pxNextTCB->uxPriority )
+                    {
+                        traceTASK_PRIORITY_DISINHERIT( pxNextTCB, uxPriorityToUse );
+                        prvSetMutexHolderPriority( pxNextTCB, uxPriorityToUse );
+
+                        pxTCB = pxNextTCB;
+                        uxTasksLowered++;
+                        xFollowChain = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority );
+
+        /* If the mutex is taken before any tasks have been created then
+         * pxCurrentTCB will be NULL. */
+        if( pxTCB != NULL )
+        {
+            /* The ceiling of a mutex must be at least the priority of every
+             * task that takes it, otherwise a task using the mutex can be
+             * preempted while holding it by another that wants it. */
+            configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+            if( pxTCB->uxPriority < uxCeilingPriority )
+            {
+                /* The calling task is running, so is in its ready list and
+                 * its event list item value is not in use for any other
+                 * purpose. */
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceTASK_PRIORITY_RAISED_TO_CEILING( pxTCB, uxCeilingPriority );
+                pxTCB->uxPriority = uxCeilingPriority;
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskPriorityRaiseToCeiling();
+    }
+
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityRestoreAfterCeiling( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskPriorityRestoreAfterCeiling( pxMutexHolder );
+
+        if( pxMutexHolder != NULL )
+        {
+            /* As in xTaskPriorityDisinherit(), a mutex that is held can only be
+             * given by the holding task, which must be the running state
+             * task. */
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                /* An inherited deadline is kept until no mutexes are held, as
+                 * for an inherited priority. */
+                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                {
+                    xReturn = prvDisinheritDeadline( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            /* Only restore the base priority once no other mutexes are held.
+             * Any mutex still held may have a ceiling, or have caused the task
+             * to inherit a priority, at least as high as the current priority,
+             * and mutexes can be given in any order, so the priority the task
+             * had when it took this mutex is not necessarily safe to return
+             * to. */
+            if( ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 ) && ( pxTCB->uxPriority != pxTCB->uxBasePriority ) )
+            {
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                traceTASK_PRIORITY_RESTORED_AFTER_CEILING( pxTCB, pxTCB->uxBasePriority );
+                pxTCB->uxPriority = pxTCB->uxBasePriority;
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority );
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* The priority of the task is dropped. Yield the core on
+                     * which the task is running. */
+                    if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+                /* A task that was ready at a priority between the old and new
+                 * priorities may now be able to run. */
+                xReturn = pdTRUE;
             }
             else
             {
@@ -6945,10 +9876,50 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+        traceRETURN_xTaskPriorityRestoreAfterCeiling( xReturn );
+
+        return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+    BaseType_t xTaskIsRunningOnOtherCore( TaskHandle_t xTask )
+    {
+        const TCB_t * const pxTCB = xTask;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskIsRunningOnOtherCore( xTask );
+
+        /* The TCB may belong to a task running on another core, so the kernel
+         * locks must be held while its run state is read. */
+        configASSERT( portGET_CRITICAL_NESTING_COUNT( ( BaseType_t ) portGET_CORE_ID() ) > 0U );
+
+        /* A mutex taken by an interrupt has no holder. */
+        if( pxTCB != NULL )
+        {
+            if( ( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE ) && ( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskIsRunningOnOtherCore( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES > 1 )
@@ -6967,7 +9938,11 @@ static void prvResetNextTaskUnblockTime( void )
         {
             const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
 
-            if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
+            #if ( portUSING_GRANULAR_LOCKS == 1 )
+                if( ( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U ) && ( uxDataGroupCriticalNesting[ xCoreID ] == 0U ) )
+            #else
+                if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
+            #endif
             {
                 portYIELD();
             }
@@ -7175,72 +10150,287 @@ static void prvResetNextTaskUnblockTime( void )
                 {
                     BaseType_t xYieldCurrentTask;
 
-                    /* Get the xYieldPending stats inside the critical section. */
-                    xYieldCurrentTask = xYieldPendings[ xCoreID ];
+                    /* Get the xYieldPending stats inside the critical section. */
+                    xYieldCurrentTask = xYieldPendings[ xCoreID ];
+
+                    portRELEASE_ISR_LOCK( xCoreID );
+                    portRELEASE_TASK_LOCK( xCoreID );
+                    portENABLE_INTERRUPTS();
+
+                    /* When a task yields in a critical section it just sets
+                     * xYieldPending to true. So now that we have exited the
+                     * critical section check if xYieldPending is true, and
+                     * if so yield. */
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskExitCritical();
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        BaseType_t xCoreID;
+
+        traceENTER_vTaskExitCriticalFromISR( uxSavedInterruptStatus );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            /* If critical nesting count is zero then this function
+             * does not match a previous call to vTaskEnterCritical(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT( xCoreID ) > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT( xCoreID );
+
+                if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
+                {
+                    portRELEASE_ISR_LOCK( xCoreID );
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskExitCriticalFromISR();
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupEnterCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskDataGroupEnterCritical( pxSpinlock );
+
+        portDISABLE_INTERRUPTS();
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* Taking a data group spinlock while holding the kernel locks
+                 * would reverse the lock order used by the kernel. */
+                configASSERT( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U );
+
+                portGET_SPINLOCK( xCoreID, pxSpinlock );
+                uxDataGroupCriticalNesting[ xCoreID ]++;
+
+                if( uxDataGroupCriticalNesting[ xCoreID ] == 1U )
+                {
+                    portASSERT_IF_IN_ISR();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        traceRETURN_vTaskDataGroupEnterCritical();
+    }
+
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    UBaseType_t uxTaskDataGroupEnterCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        traceENTER_uxTaskDataGroupEnterCriticalFromISR( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            configASSERT( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U );
+
+            portGET_SPINLOCK( xCoreID, pxSpinlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxTaskDataGroupEnterCriticalFromISR( uxSavedInterruptStatus );
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupExitCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+        traceENTER_vTaskDataGroupExitCritical( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the nesting count is zero then this function does not match a
+             * previous call to vTaskDataGroupEnterCritical(). */
+            configASSERT( uxDataGroupCriticalNesting[ xCoreID ] > 0U );
+
+            portASSERT_IF_IN_ISR();
+
+            if( uxDataGroupCriticalNesting[ xCoreID ] > 0U )
+            {
+                uxDataGroupCriticalNesting[ xCoreID ]--;
+                portRELEASE_SPINLOCK( xCoreID, pxSpinlock );
+
+                if( uxDataGroupCriticalNesting[ xCoreID ] == 0U )
+                {
+                    BaseType_t xYieldCurrentTask;
+
+                    /* Tasks unblocked from within the data group critical
+                     * section may have requested a yield on this core. */
+                    xYieldCurrentTask = xYieldPendings[ xCoreID ];
+
+                    portENABLE_INTERRUPTS();
+
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDataGroupExitCritical();
+    }
+
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus,
+                                            portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskDataGroupExitCriticalFromISR( uxSavedInterruptStatus, pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            portRELEASE_SPINLOCK( ( BaseType_t ) portGET_CORE_ID(), pxSpinlock );
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDataGroupExitCriticalFromISR();
+    }
+
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupLockKernel( void )
+    {
+        traceENTER_vTaskDataGroupLockKernel();
 
-                    portRELEASE_ISR_LOCK( xCoreID );
-                    portRELEASE_TASK_LOCK( xCoreID );
-                    portENABLE_INTERRUPTS();
+        /* Interrupts are already masked by the data group critical section.
+         * Only the ISR lock is taken, so, as when called from an ISR, the task
+         * lists are only modified directly if the scheduler is not suspended.
+         * Incrementing the critical nesting count also means any kernel
+         * critical section entered before vTaskDataGroupUnlockKernel() is
+         * called nests inside this one rather than taking the task lock. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
 
-                    /* When a task yields in a critical section it just sets
-                     * xYieldPending to true. So now that we have exited the
-                     * critical section check if xYieldPending is true, and
-                     * if so yield. */
-                    if( xYieldCurrentTask != pdFALSE )
-                    {
-                        portYIELD();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+            if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
             {
-                mtCOVERAGE_TEST_MARKER();
+                portGET_ISR_LOCK( xCoreID );
             }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT( xCoreID );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskExitCritical();
+        traceRETURN_vTaskDataGroupLockKernel();
     }
 
-#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configNUMBER_OF_CORES > 1 )
+#if ( portUSING_GRANULAR_LOCKS == 1 )
 
-    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    void vTaskDataGroupUnlockKernel( void )
     {
-        BaseType_t xCoreID;
-
-        traceENTER_vTaskExitCriticalFromISR( uxSavedInterruptStatus );
+        traceENTER_vTaskDataGroupUnlockKernel();
 
         if( xSchedulerRunning != pdFALSE )
         {
-            xCoreID = ( BaseType_t ) portGET_CORE_ID();
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
 
-            /* If critical nesting count is zero then this function
-             * does not match a previous call to vTaskEnterCritical(). */
             configASSERT( portGET_CRITICAL_NESTING_COUNT( xCoreID ) > 0U );
 
-            if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) > 0U )
-            {
-                portDECREMENT_CRITICAL_NESTING_COUNT( xCoreID );
+            portDECREMENT_CRITICAL_NESTING_COUNT( xCoreID );
 
-                if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
-                {
-                    portRELEASE_ISR_LOCK( xCoreID );
-                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            if( portGET_CRITICAL_NESTING_COUNT( xCoreID ) == 0U )
+            {
+                portRELEASE_ISR_LOCK( xCoreID );
             }
             else
             {
@@ -7252,10 +10442,10 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskExitCriticalFromISR();
+        traceRETURN_vTaskDataGroupUnlockKernel();
     }
 
-#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+#endif /* #if ( portUSING_GRANULAR_LOCKS == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
@@ -8152,11 +11342,12 @@ TickType_t uxTaskResetEventItemValue( void )
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8286,11 +11477,12 @@ TickType_t uxTaskResetEventItemValue( void )
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8576,13 +11768,192 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    static void prvRecordReadyTime( TCB_t * const pxTCB )
+    {
+        /* Tasks that are readied before the scheduler starts, and so before
+         * the timestamp source is necessarily configured, are not timed.  A running task
+         * that is moved between ready lists has not become ready. */
+        if( ( xSchedulerRunning != pdFALSE ) &&
+            ( pxTCB->xReadyTimeRecorded == pdFALSE ) &&
+            ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) )
+        {
+            taskGET_LATENCY_TIMESTAMP( pxTCB->ulReadyTime );
+            pxTCB->xReadyTimeRecorded = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    static void prvRecordSchedulingLatency( TCB_t * const pxTCB )
+    {
+        configRUN_TIME_COUNTER_TYPE ulSwitchedInTime, ulLatency;
+        UBaseType_t uxBucket = 0U;
+
+        if( pxTCB->xReadyTimeRecorded != pdFALSE )
+        {
+            pxTCB->xReadyTimeRecorded = pdFALSE;
+            taskGET_LATENCY_TIMESTAMP( ulSwitchedInTime );
+
+            /* As with the run time stats there is no overflow protection, so
+             * a latency that spans a wrap of the timestamp is discarded. */
+            if( ulSwitchedInTime >= pxTCB->ulReadyTime )
+            {
+                ulLatency = ulSwitchedInTime - pxTCB->ulReadyTime;
+
+                while( ( ulLatency > ( configRUN_TIME_COUNTER_TYPE ) 1 ) && ( uxBucket < ( UBaseType_t ) ( configLATENCY_HISTOGRAM_BUCKETS - 1 ) ) )
+                {
+                    ulLatency >>= 1;
+                    uxBucket++;
+                }
+
+                if( pxTCB->uxLatencyHistogramEpoch != uxLatencyHistogramEpoch )
+                {
+                    /* The histograms were reset since the task's histogram
+                     * was last updated. */
+                    ( void ) memset( pxTCB->ulLatencyHistogram, 0x00, sizeof( pxTCB->ulLatencyHistogram ) );
+                    pxTCB->uxLatencyHistogramEpoch = uxLatencyHistogramEpoch;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ( pxTCB->ulLatencyHistogram[ uxBucket ] )++;
+                ( ulLatencyHistogram[ uxBucket ] )++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    BaseType_t xTaskGetLatencyHistogram( TaskHandle_t xTask,
+                                         uint32_t * pulHistogram,
+                                         UBaseType_t uxHistogramLength )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxBucket;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGetLatencyHistogram( xTask, pulHistogram, uxHistogramLength );
+
+        configASSERT( pulHistogram );
+
+        if( uxHistogramLength >= ( UBaseType_t ) configLATENCY_HISTOGRAM_BUCKETS )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = prvGetTCBFromHandle( xTask );
+
+                for( uxBucket = 0U; uxBucket < ( UBaseType_t ) configLATENCY_HISTOGRAM_BUCKETS; uxBucket++ )
+                {
+                    if( pxTCB->uxLatencyHistogramEpoch == uxLatencyHistogramEpoch )
+                    {
+                        pulHistogram[ uxBucket ] = pxTCB->ulLatencyHistogram[ uxBucket ];
+                    }
+                    else
+                    {
+                        pulHistogram[ uxBucket ] = 0U;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xTaskGetLatencyHistogram( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    BaseType_t xTaskGetGlobalLatencyHistogram( uint32_t * pulHistogram,
+                                               UBaseType_t uxHistogramLength )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGetGlobalLatencyHistogram( pulHistogram, uxHistogramLength );
+
+        configASSERT( pulHistogram );
+
+        if( uxHistogramLength >= ( UBaseType_t ) configLATENCY_HISTOGRAM_BUCKETS )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( void ) memcpy( pulHistogram, ulLatencyHistogram, sizeof( ulLatencyHistogram ) );
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xTaskGetGlobalLatencyHistogram( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+
+    void vTaskResetLatencyHistograms( void )
+    {
+        traceENTER_vTaskResetLatencyHistograms();
+
+        /* The histograms are cleared by the idle task. */
+        xLatencyHistogramResetPending = pdTRUE;
+
+        traceRETURN_vTaskResetLatencyHistograms();
+    }
+
+#endif /* configUSE_LATENCY_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
     TickType_t xTimeToWake;
     const TickType_t xConstTickCount = xTickCount;
-    List_t * const pxDelayedList = pxDelayedTaskList;
-    List_t * const pxOverflowDelayedList = pxOverflowDelayedTaskList;
+
+    #if ( configUSE_TIMING_WHEEL == 0 )
+        List_t * const pxDelayedList = pxDelayedTaskList;
+        List_t * const pxOverflowDelayedList = pxOverflowDelayedTaskList;
+    #else
+        TickType_t xServiceTime;
+    #endif
 
     #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
@@ -8593,6 +11964,14 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+    {
+        /* However the task blocks, its current job missed its deadline if the
+         * deadline has already passed. */
+        prvCheckDeadlineMissed( pxCurrentTCB );
+    }
+    #endif
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -8622,26 +12001,93 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
              * kernel will manage it correctly. */
             xTimeToWake = xConstTickCount + xTicksToWait;
 
+            #if ( configUSE_TIMING_WHEEL == 0 )
+            {
+                /* The list item will be inserted in wake time order. */
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+                if( xTimeToWake < xConstTickCount )
+                {
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                    vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                else
+                {
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    traceMOVED_TASK_TO_DELAYED_LIST();
+                    vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #else /* if ( configUSE_TIMING_WHEEL == 0 ) */
+            {
+                /* The current tick has already been processed, so a task
+                 * cannot be woken any earlier than the next tick. */
+                if( xTimeToWake == xConstTickCount )
+                {
+                    xTimeToWake++;
+                }
+
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+                traceMOVED_TASK_TO_DELAYED_LIST();
+                xServiceTime = prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+
+                /* A service time that has overflowed is picked up when the
+                 * tick count wraps to 0. */
+                if( ( xServiceTime > xConstTickCount ) && ( xServiceTime < xNextTaskUnblockTime ) )
+                {
+                    xNextTaskUnblockTime = xServiceTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
+        }
+    }
+    #else /* INCLUDE_vTaskSuspend */
+    {
+        /* Calculate the time at which the task should be woken if the event
+         * does not occur.  This may overflow but this doesn't matter, the kernel
+         * will manage it correctly. */
+        xTimeToWake = xConstTickCount + xTicksToWait;
+
+        #if ( configUSE_TIMING_WHEEL == 0 )
+        {
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
             if( xTimeToWake < xConstTickCount )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
                 traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                /* Wake time has overflowed.  Place this item in the overflow list. */
                 vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
                 traceMOVED_TASK_TO_DELAYED_LIST();
+                /* The wake time has not overflowed, so the current block list is used. */
                 vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
 
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
                 if( xTimeToWake < xNextTaskUnblockTime )
                 {
                     xNextTaskUnblockTime = xTimeToWake;
@@ -8652,41 +12098,32 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 }
             }
         }
-    }
-    #else /* INCLUDE_vTaskSuspend */
-    {
-        /* Calculate the time at which the task should be woken if the event
-         * does not occur.  This may overflow but this doesn't matter, the kernel
-         * will manage it correctly. */
-        xTimeToWake = xConstTickCount + xTicksToWait;
+        #else /* if ( configUSE_TIMING_WHEEL == 0 ) */
+        {
+            /* The current tick has already been processed, so a task cannot be
+             * woken any earlier than the next tick. */
+            if( xTimeToWake == xConstTickCount )
+            {
+                xTimeToWake++;
+            }
 
-        /* The list item will be inserted in wake time order. */
-        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-        if( xTimeToWake < xConstTickCount )
-        {
-            traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
-        }
-        else
-        {
             traceMOVED_TASK_TO_DELAYED_LIST();
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            xServiceTime = prvTimingWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
 
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            /* A service time that has overflowed is picked up when the tick
+             * count wraps to 0. */
+            if( ( xServiceTime > xConstTickCount ) && ( xServiceTime < xNextTaskUnblockTime ) )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                xNextTaskUnblockTime = xServiceTime;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif /* if ( configUSE_TIMING_WHEEL == 0 ) */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
@@ -8848,6 +12285,33 @@ void vTaskResetState( void )
 
     uxSchedulerSuspended = ( UBaseType_t ) 0U;
 
+    #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 1 ) )
+    {
+        #if ( configMAX_PRIORITIES > 32 )
+        {
+            ulReadyPriorityGroups = 0U;
+        }
+        #endif
+        ( void ) memset( ulReadyPriorityBitmap, 0x00, sizeof( ulReadyPriorityBitmap ) );
+    }
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+    {
+        pxDeadlineHeap = NULL;
+        ulDeadlineHeapInsertions = 0U;
+    }
+    #endif
+
+    #if ( portUSING_GRANULAR_LOCKS == 1 )
+    {
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            uxDataGroupCriticalNesting[ xCoreID ] = 0U;
+        }
+    }
+    #endif
+
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
     {
         for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
@@ -8857,5 +12321,19 @@ void vTaskResetState( void )
         }
     }
     #endif /* #if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+
+    #if ( configUSE_LATENCY_HISTOGRAMS == 1 )
+    {
+        ( void ) memset( ulLatencyHistogram, 0x00, sizeof( ulLatencyHistogram ) );
+        uxLatencyHistogramEpoch = ( UBaseType_t ) 0U;
+        xLatencyHistogramResetPending = pdFALSE;
+    }
+    #endif
+
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+    {
+        uxSnapshotGeneration = ( UBaseType_t ) 0U;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,368 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace buffer.  This #if is closed at the very bottom of this
+ * file.  If you want to include the trace buffer then ensure
+ * configUSE_TRACE_BUFFER is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TRACE_BUFFER == 1 )
+
+    #if ( configUSE_STREAM_BUFFERS != 1 )
+        #error configUSE_STREAM_BUFFERS must be set to 1 to build trace_buffer.c
+    #endif
+
+/* The timestamp stored in each record.  The port can provide a dedicated
+ * source with portGET_TRACE_TIMESTAMP(), otherwise the source used for
+ * scheduling latency measurements or run time statistics is used. */
+    #if defined( portGET_TRACE_TIMESTAMP )
+        #define tbGET_TIMESTAMP( ulTime )    ( ulTime ) = ( uint32_t ) portGET_TRACE_TIMESTAMP()
+    #elif defined( portGET_LATENCY_TIMESTAMP )
+        #define tbGET_TIMESTAMP( ulTime )    ( ulTime ) = ( uint32_t ) portGET_LATENCY_TIMESTAMP()
+    #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+        #define tbGET_TIMESTAMP( ulTime )                       \
+    do {                                                        \
+        configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;           \
+        portALT_GET_RUN_TIME_COUNTER_VALUE( ulRunTimeCounter ); \
+        ( ulTime ) = ( uint32_t ) ulRunTimeCounter;             \
+    } while( 0 )
+    #elif defined( portGET_RUN_TIME_COUNTER_VALUE )
+        #define tbGET_TIMESTAMP( ulTime )    ( ulTime ) = ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE()
+    #else
+        #error configUSE_TRACE_BUFFER requires the port to define portGET_TRACE_TIMESTAMP(), portGET_LATENCY_TIMESTAMP() or a run time counter.
+    #endif
+
+/* Mask interrupts on the calling core, so a record cannot be interleaved with
+ * a record written by an interrupt on the same core, and the calling task
+ * cannot move to a different core while it is writing to a core's buffer. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define tbMASK_INTERRUPTS()                              portSET_INTERRUPT_MASK_FROM_ISR()
+        #define tbUNMASK_INTERRUPTS( uxSavedInterruptStatus )    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus )
+        #define tbGET_CORE_ID()                                  ( ( BaseType_t ) 0 )
+    #else
+        #define tbMASK_INTERRUPTS()                              portSET_INTERRUPT_MASK()
+        #define tbUNMASK_INTERRUPTS( uxSavedInterruptStatus )    portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus )
+        #define tbGET_CORE_ID()                                  ( ( BaseType_t ) portGET_CORE_ID() )
+    #endif
+
+/* The number of records xTraceBufferDrain() copies out of a buffer at a
+ * time. */
+    #define tbDRAIN_BATCH_LENGTH    ( ( uint32_t ) 16U )
+
+/* The number of characters of a task name held by each tbEVENT_TASK_NAME
+ * record. */
+    #define tbCHARACTERS_PER_NAME_RECORD    ( 4U )
+
+/*
+ * The trace buffer of a single core.  Only the core itself writes records and
+ * ulHead, and only the task that calls xTraceBufferDrain() writes ulTail, so
+ * the two sides never need to lock each other out.
+ */
+    typedef struct TraceBufferRing
+    {
+        volatile uint32_t ulHead; /**< The number of records ever written to the buffer.  The next record is written to xRecords[ ulHead % configTRACE_BUFFER_LENGTH ]. */
+        uint32_t ulTail;          /**< The number of records ever drained from, or lost from, the buffer. */
+        uint32_t ulLost;          /**< The number of lost records not yet reported by a tbEVENT_RECORDS_LOST record. */
+        TraceBufferRecord_t xRecords[ configTRACE_BUFFER_LENGTH ];
+    } TraceBufferRing_t;
+
+/*-----------------------------------------------------------*/
+
+    PRIVILEGED_DATA static TraceBufferRing_t xTraceBufferRings[ configNUMBER_OF_CORES ];
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write a record to the buffer of the calling core.  Must be called with
+ * interrupts masked.
+ */
+    static void prvWriteRecord( BaseType_t xCoreID,
+                                uint8_t ucEvent,
+                                UBaseType_t uxObject,
+                                uint32_t ulTimestamp ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write ulCount records from pxRecords to the stream buffer.
+ */
+    static size_t prvSendRecords( StreamBufferHandle_t xStreamBuffer,
+                                  const TraceBufferRecord_t * pxRecords,
+                                  uint32_t ulCount ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvWriteRecord( BaseType_t xCoreID,
+                                uint8_t ucEvent,
+                                UBaseType_t uxObject,
+                                uint32_t ulTimestamp )
+    {
+        TraceBufferRing_t * const pxRing = &( xTraceBufferRings[ xCoreID ] );
+        const uint32_t ulHead = pxRing->ulHead;
+        TraceBufferRecord_t * const pxRecord = &( pxRing->xRecords[ ulHead & ( ( uint32_t ) configTRACE_BUFFER_LENGTH - 1U ) ] );
+
+        pxRecord->ulTimestamp = ulTimestamp;
+        pxRecord->usObject = ( uint16_t ) uxObject;
+        pxRecord->ucEvent = ucEvent;
+        pxRecord->ucCoreID = ( uint8_t ) xCoreID;
+
+        /* The record must be complete before it can be seen by
+         * xTraceBufferDrain(). */
+        portMEMORY_BARRIER();
+        pxRing->ulHead = ulHead + 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceBufferRecord( uint8_t ucEvent,
+                             UBaseType_t uxObject )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulTimestamp;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) tbMASK_INTERRUPTS();
+        {
+            tbGET_TIMESTAMP( ulTimestamp );
+            prvWriteRecord( tbGET_CORE_ID(), ucEvent, uxObject, ulTimestamp );
+        }
+        tbUNMASK_INTERRUPTS( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceBufferRecordTaskCreate( UBaseType_t uxTaskNumber,
+                                       const char * pcName )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xCoreID;
+        uint32_t ulTimestamp, ulCharacters;
+        UBaseType_t uxCharacter;
+        size_t x = 0U;
+        BaseType_t xEndOfName = pdFALSE;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) tbMASK_INTERRUPTS();
+        {
+            xCoreID = tbGET_CORE_ID();
+            tbGET_TIMESTAMP( ulTimestamp );
+            prvWriteRecord( xCoreID, tbEVENT_TASK_CREATE, uxTaskNumber, ulTimestamp );
+
+            /* Follow the create record with the name, so the records are
+             * consecutive in the buffer.  The name ends at the first null
+             * character, or after configMAX_TASK_NAME_LEN characters. */
+            while( xEndOfName == pdFALSE )
+            {
+                ulCharacters = 0U;
+
+                for( uxCharacter = 0U; uxCharacter < ( UBaseType_t ) tbCHARACTERS_PER_NAME_RECORD; uxCharacter++ )
+                {
+                    if( ( xEndOfName == pdFALSE ) && ( x < ( size_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ x ] != ( char ) 0x00 ) )
+                    {
+                        ulCharacters |= ( ( uint32_t ) ( uint8_t ) pcName[ x ] ) << ( uxCharacter * 8U );
+                        x++;
+                    }
+                    else
+                    {
+                        xEndOfName = pdTRUE;
+                    }
+                }
+
+                prvWriteRecord( xCoreID, tbEVENT_TASK_NAME, uxTaskNumber, ulCharacters );
+            }
+        }
+        tbUNMASK_INTERRUPTS( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvSendRecords( StreamBufferHandle_t xStreamBuffer,
+                                  const TraceBufferRecord_t * pxRecords,
+                                  uint32_t ulCount )
+    {
+        size_t xBytesSent = 0U;
+
+        if( ulCount > 0U )
+        {
+            xBytesSent = xStreamBufferSend( xStreamBuffer, pxRecords, ( size_t ) ulCount * sizeof( TraceBufferRecord_t ), 0U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xBytesSent;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xTraceBufferDrain( StreamBufferHandle_t xStreamBuffer )
+    {
+        TraceBufferRecord_t xBatch[ tbDRAIN_BATCH_LENGTH ];
+        TraceBufferRecord_t xLostRecord;
+        TraceBufferRing_t * pxRing;
+        BaseType_t xCoreID;
+        uint32_t ulHead, ulTail, ulCount, ulSpace, ulLost, ulOverwritten, x;
+        size_t xBytesSent = 0U;
+        BaseType_t xStreamBufferFull = pdFALSE;
+
+        configASSERT( xStreamBuffer != NULL );
+
+        for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xStreamBufferFull == pdFALSE ); xCoreID++ )
+        {
+            pxRing = &( xTraceBufferRings[ xCoreID ] );
+            ulTail = pxRing->ulTail;
+            ulLost = pxRing->ulLost;
+
+            for( ; ; )
+            {
+                ulHead = pxRing->ulHead;
+                portMEMORY_BARRIER();
+
+                /* Records more than a buffer length behind the head have been
+                 * overwritten.  The slot at the head may be being written by
+                 * the core right now, so the record a whole buffer length
+                 * behind the head, which shares that slot, is treated as
+                 * overwritten too. */
+                if( ( ulHead + 1U - ulTail ) > ( uint32_t ) configTRACE_BUFFER_LENGTH )
+                {
+                    ulLost += ( ulHead + 1U - ulTail ) - ( uint32_t ) configTRACE_BUFFER_LENGTH;
+                    ulTail = ulHead + 1U - ( uint32_t ) configTRACE_BUFFER_LENGTH;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulCount = ulHead - ulTail;
+
+                if( ulCount > tbDRAIN_BATCH_LENGTH )
+                {
+                    ulCount = tbDRAIN_BATCH_LENGTH;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Leave room for a record that reports lost records. */
+                ulSpace = ( uint32_t ) ( xStreamBufferSpacesAvailable( xStreamBuffer ) / sizeof( TraceBufferRecord_t ) );
+
+                if( ulSpace <= 1U )
+                {
+                    xStreamBufferFull = pdTRUE;
+                    break;
+                }
+                else if( ulCount >= ulSpace )
+                {
+                    ulCount = ulSpace - 1U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( ulCount == 0U ) && ( ulLost == 0U ) )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                for( x = 0U; x < ulCount; x++ )
+                {
+                    xBatch[ x ] = pxRing->xRecords[ ( ulTail + x ) & ( ( uint32_t ) configTRACE_BUFFER_LENGTH - 1U ) ];
+                }
+
+                /* The core may have overwritten some of the records while they
+                 * were being copied, or be part way through writing the slot at
+                 * the head, in which case the copies of those records cannot be
+                 * trusted. */
+                portMEMORY_BARRIER();
+                ulHead = pxRing->ulHead;
+                ulOverwritten = 0U;
+
+                if( ( ulHead + 1U - ulTail ) > ( uint32_t ) configTRACE_BUFFER_LENGTH )
+                {
+                    ulOverwritten = ( ulHead + 1U - ulTail ) - ( uint32_t ) configTRACE_BUFFER_LENGTH;
+
+                    if( ulOverwritten > ulCount )
+                    {
+                        ulOverwritten = ulCount;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ulLost += ulOverwritten;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ulLost > 0U )
+                {
+                    xLostRecord.ulTimestamp = ulLost;
+                    xLostRecord.usObject = 0U;
+                    xLostRecord.ucEvent = tbEVENT_RECORDS_LOST;
+                    xLostRecord.ucCoreID = ( uint8_t ) xCoreID;
+                    xBytesSent += prvSendRecords( xStreamBuffer, &xLostRecord, 1U );
+                    ulLost = 0U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xBytesSent += prvSendRecords( xStreamBuffer, &( xBatch[ ulOverwritten ] ), ulCount - ulOverwritten );
+                ulTail += ulCount;
+            }
+
+            pxRing->ulTail = ulTail;
+            pxRing->ulLost = ulLost;
+        }
+
+        return xBytesSent;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace buffer.  This #if is closed at the very bottom of this
+ * file.  If you want to include the trace buffer then ensure
+ * configUSE_TRACE_BUFFER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TRACE_BUFFER == 1 */